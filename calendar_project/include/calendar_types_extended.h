@@ -3,13 +3,9 @@
 
 #include "calendar_types.h"
 
-// Extended calendar type enumeration
+// Extended calendar type enumeration (continues CalendarType)
 typedef enum {
-    CALENDAR_GREGORIAN,
-    CALENDAR_ISLAMIC,
-    CALENDAR_CHINESE,
-    CALENDAR_HEBREW,
-    CALENDAR_PERSIAN,           // NEW: Persian/Iranian Solar Hijri
+    CALENDAR_PERSIAN = CALENDAR_HEBREW + 1, // NEW: Persian/Iranian Solar Hijri
     CALENDAR_BUDDHIST,          // NEW: Buddhist calendar
     CALENDAR_ETHIOPIAN,         // NEW: Ethiopian calendar
     CALENDAR_MAYA,              // NEW: Maya calendar system
@@ -20,7 +16,9 @@ typedef enum {
     CALENDAR_CUSTOM             // NEW: User-defined calendar
 } ExtendedCalendarType;
 
-// Persian date structure (already defined in persian.h)
+// Persian date structure (also defined in persian.h)
+#ifndef PERSIAN_DATE_DEFINED
+#define PERSIAN_DATE_DEFINED
 typedef struct {
     Date base;
     int day_of_week;
@@ -28,6 +26,7 @@ typedef struct {
     int is_leap_year;
     char season[20];
 } PersianDate;
+#endif
 
 // Buddhist date structure
 typedef struct {
@@ -72,7 +71,9 @@ typedef struct {
     int calendar_round_day;     // Position in 52-year cycle
 } MayaDate;
 
-// Enhanced lunar phase information
+// Enhanced lunar phase information (also defined in lunar_base.h)
+#ifndef LUNAR_PHASE_DEFINED
+#define LUNAR_PHASE_DEFINED
 typedef enum {
     LUNAR_NEW_MOON,
     LUNAR_WAXING_CRESCENT,
@@ -83,6 +84,7 @@ typedef enum {
     LUNAR_LAST_QUARTER,
     LUNAR_WANING_CRESCENT
 } LunarPhase;
+#endif
 
 // Enhanced astronomical event types
 typedef enum {
@@ -95,7 +97,15 @@ typedef enum {
     ASTRO_EVENT_PLANET_CONJUNCTION,
     ASTRO_EVENT_METEOR_SHOWER,
     ASTRO_EVENT_SUPERMOON,
-    ASTRO_EVENT_BLUE_MOON
+    ASTRO_EVENT_BLUE_MOON,
+    ASTRO_EVENT_MICROMOON,
+    ASTRO_EVENT_LUNAR_PERIGEE,
+    ASTRO_EVENT_LUNAR_APOGEE,
+    ASTRO_EVENT_PLANET_OPPOSITION,
+    ASTRO_EVENT_NEW_MOON,
+    ASTRO_EVENT_FIRST_QUARTER,
+    ASTRO_EVENT_FULL_MOON,
+    ASTRO_EVENT_LAST_QUARTER
 } AstronomicalEventType;
 
 // Astronomical event structure
@@ -203,16 +213,9 @@ typedef struct {
     CalendarConvertToJulianFunc to_julian;
 } CalendarSystemEntry;
 
-// Enhanced result codes
+// Enhanced result codes (continues CalendarResult)
 typedef enum {
-    CALENDAR_SUCCESS,
-    CALENDAR_ERROR_INVALID_DATE,
-    CALENDAR_ERROR_INVALID_MONTH,
-    CALENDAR_ERROR_INVALID_YEAR,
-    CALENDAR_ERROR_CONVERSION_FAILED,
-    CALENDAR_ERROR_MEMORY_ALLOCATION,
-    CALENDAR_ERROR_NULL_POINTER,
-    CALENDAR_ERROR_UNSUPPORTED_CALENDAR,
+    CALENDAR_ERROR_UNSUPPORTED_CALENDAR = CALENDAR_ERROR_NULL_POINTER + 1,
     CALENDAR_ERROR_UNSUPPORTED_OPERATION,
     CALENDAR_ERROR_ASTRONOMICAL_CALCULATION,
     CALENDAR_ERROR_TIMEZONE_INVALID,
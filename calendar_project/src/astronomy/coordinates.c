@@ -0,0 +1,293 @@
+// src/astronomy/coordinates.c
+#include "coordinates.h"
+#include "solar_calc.h"
+#include "time_scale.h"
+#include <string.h>
+
+#define COORD_DEG_TO_RAD (M_PI / 180.0)
+#define COORD_RAD_TO_DEG (180.0 / M_PI)
+#define COORD_ARCSEC_TO_DEG (1.0 / 3600.0)
+#define COORD_J2000 2451545.0
+#define COORD_BLOCK 256             // Points per pass through the stack buffers
+
+#if defined(__GNUC__)
+#define COORD_THREAD_LOCAL __thread
+#else
+#define COORD_THREAD_LOCAL
+#endif
+
+static COORD_THREAD_LOCAL CoordEpoch coord_cached_epoch;
+static COORD_THREAD_LOCAL int coord_cache_valid = 0;
+
+// Elementary frame rotations (angle in radians)
+static void coord_rotation_x(double angle, double m[3][3]) {
+    double c = cos(angle), s = sin(angle);
+    double r[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, c, s }, { 0.0, -s, c } };
+    memcpy(m, r, sizeof(r));
+}
+
+static void coord_rotation_y(double angle, double m[3][3]) {
+    double c = cos(angle), s = sin(angle);
+    double r[3][3] = { { c, 0.0, -s }, { 0.0, 1.0, 0.0 }, { s, 0.0, c } };
+    memcpy(m, r, sizeof(r));
+}
+
+static void coord_rotation_z(double angle, double m[3][3]) {
+    double c = cos(angle), s = sin(angle);
+    double r[3][3] = { { c, s, 0.0 }, { -s, c, 0.0 }, { 0.0, 0.0, 1.0 } };
+    memcpy(m, r, sizeof(r));
+}
+
+// out = a * b (out may alias either operand)
+static void coord_multiply(const double a[3][3], const double b[3][3], double out[3][3]) {
+    double r[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+        }
+    }
+    memcpy(out, r, sizeof(r));
+}
+
+void coord_epoch_init(double julian_day, CoordEpoch* epoch) {
+    if (!epoch) return;
+    
+    double t = (julian_day - COORD_J2000) / 36525.0;
+    
+    // Nutation, low-accuracy terms (Meeus ch. 22): within 0.5" in longitude
+    double omega = (125.04452 - 1934.136261 * t) * COORD_DEG_TO_RAD;
+    double L = (280.4665 + 36000.7698 * t) * COORD_DEG_TO_RAD;
+    double Lp = (218.3165 + 481267.8813 * t) * COORD_DEG_TO_RAD;
+    double dpsi = -17.20 * sin(omega) - 1.32 * sin(2.0 * L) - 0.23 * sin(2.0 * Lp) + 0.21 * sin(2.0 * omega);
+    double deps = 9.20 * cos(omega) + 0.57 * cos(2.0 * L) + 0.10 * cos(2.0 * Lp) - 0.09 * cos(2.0 * omega);
+    
+    epoch->julian_day = julian_day;
+    epoch->mean_obliquity = 23.0 + 26.0 / 60.0 +
+                            (21.448 - t * (46.8150 + t * (0.00059 - t * 0.001813))) * COORD_ARCSEC_TO_DEG;
+    epoch->nutation_longitude = dpsi * COORD_ARCSEC_TO_DEG;
+    epoch->nutation_obliquity = deps * COORD_ARCSEC_TO_DEG;
+    epoch->true_obliquity = epoch->mean_obliquity + epoch->nutation_obliquity;
+    
+    // Ecliptic of date: add delta-psi along the ecliptic, then tilt by the true obliquity
+    double m[3][3];
+    coord_rotation_z(-epoch->nutation_longitude * COORD_DEG_TO_RAD, epoch->from_date);
+    coord_rotation_x(-epoch->true_obliquity * COORD_DEG_TO_RAD, m);
+    coord_multiply(m, epoch->from_date, epoch->from_date);
+    
+    // J2000: to the J2000 equator, precess (IAU 1976, Meeus 21.2), then nutate
+    double zeta = (2306.2181 + (0.30188 + 0.017998 * t) * t) * t * COORD_ARCSEC_TO_DEG * COORD_DEG_TO_RAD;
+    double z = (2306.2181 + (1.09468 + 0.018203 * t) * t) * t * COORD_ARCSEC_TO_DEG * COORD_DEG_TO_RAD;
+    double theta = (2004.3109 - (0.42665 + 0.041833 * t) * t) * t * COORD_ARCSEC_TO_DEG * COORD_DEG_TO_RAD;
+    double epsilon0 = (23.0 + 26.0 / 60.0 + 21.448 * COORD_ARCSEC_TO_DEG) * COORD_DEG_TO_RAD;
+    
+    coord_rotation_x(-epsilon0, epoch->from_j2000);
+    coord_rotation_z(-zeta, m);
+    coord_multiply(m, epoch->from_j2000, epoch->from_j2000);
+    coord_rotation_y(theta, m);
+    coord_multiply(m, epoch->from_j2000, epoch->from_j2000);
+    coord_rotation_z(-z, m);
+    coord_multiply(m, epoch->from_j2000, epoch->from_j2000);
+    coord_rotation_x(epoch->mean_obliquity * COORD_DEG_TO_RAD, m);
+    coord_multiply(m, epoch->from_j2000, epoch->from_j2000);
+    coord_multiply(epoch->from_date, epoch->from_j2000, epoch->from_j2000);
+}
+
+const CoordEpoch* coord_epoch_get(double julian_day) {
+    if (!coord_cache_valid || coord_cached_epoch.julian_day != julian_day) {
+        coord_epoch_init(julian_day, &coord_cached_epoch);
+        coord_cache_valid = 1;
+    }
+    return &coord_cached_epoch;
+}
+
+CoordObserverSet* coord_observers_create(const double* latitudes, const double* longitudes, int count) {
+    if (!latitudes || !longitudes || count <= 0) return NULL;
+    
+    CoordObserverSet* observers = malloc(sizeof(CoordObserverSet));
+    double* block = malloc(sizeof(double) * 6 * count);
+    if (!observers || !block) {
+        free(observers);
+        free(block);
+        return NULL;
+    }
+    
+    observers->count = count;
+    observers->latitude = block;
+    observers->longitude = block + count;
+    observers->sin_lat = block + 2 * count;
+    observers->cos_lat = block + 3 * count;
+    observers->sin_lon = block + 4 * count;
+    observers->cos_lon = block + 5 * count;
+    for (int i = 0; i < count; i++) {
+        double phi = latitudes[i] * COORD_DEG_TO_RAD;
+        double lambda = longitudes[i] * COORD_DEG_TO_RAD;
+        observers->latitude[i] = latitudes[i];
+        observers->longitude[i] = longitudes[i];
+        observers->sin_lat[i] = sin(phi);
+        observers->cos_lat[i] = cos(phi);
+        observers->sin_lon[i] = sin(lambda);
+        observers->cos_lon[i] = cos(lambda);
+    }
+    return observers;
+}
+
+void coord_observers_destroy(CoordObserverSet* observers) {
+    if (!observers) return;
+    free(observers->latitude);
+    free(observers);
+}
+
+void coord_spherical_to_vectors(const double* longitude, const double* latitude, int count,
+                                double* x, double* y, double* z) {
+    #pragma omp simd
+    for (int i = 0; i < count; i++) {
+        double lambda = longitude[i] * COORD_DEG_TO_RAD;
+        double beta = latitude[i] * COORD_DEG_TO_RAD;
+        double cos_beta = cos(beta);
+        x[i] = cos_beta * cos(lambda);
+        y[i] = cos_beta * sin(lambda);
+        z[i] = sin(beta);
+    }
+}
+
+void coord_vectors_to_spherical(const double* x, const double* y, const double* z, int count,
+                                double* longitude, double* latitude) {
+    for (int i = 0; i < count; i++) {
+        double lambda = atan2(y[i], x[i]) * COORD_RAD_TO_DEG;
+        longitude[i] = lambda < 0.0 ? lambda + 360.0 : lambda;
+        latitude[i] = atan2(z[i], sqrt(x[i] * x[i] + y[i] * y[i])) * COORD_RAD_TO_DEG;
+    }
+}
+
+void coord_rotate_vectors(const double matrix[3][3], const double* x, const double* y, const double* z,
+                          int count, double* out_x, double* out_y, double* out_z) {
+    const double m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2];
+    const double m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2];
+    const double m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2];
+    
+    #pragma omp simd
+    for (int i = 0; i < count; i++) {
+        double vx = x[i], vy = y[i], vz = z[i];
+        out_x[i] = m00 * vx + m01 * vy + m02 * vz;
+        out_y[i] = m10 * vx + m11 * vy + m12 * vz;
+        out_z[i] = m20 * vx + m21 * vy + m22 * vz;
+    }
+}
+
+// Equatorial of date -> (north, east, up) at local sidereal angle theta and latitude phi
+static void coord_horizon_matrix(double lst_hours, double latitude, double m[3][3]) {
+    double theta = lst_hours * 15.0 * COORD_DEG_TO_RAD;
+    double phi = latitude * COORD_DEG_TO_RAD;
+    double ct = cos(theta), st = sin(theta), cp = cos(phi), sp = sin(phi);
+    double r[3][3] = {
+        { -sp * ct, -sp * st, cp },
+        { -st, ct, 0.0 },
+        { cp * ct, cp * st, sp }
+    };
+    memcpy(m, r, sizeof(r));
+}
+
+// Azimuth (from north through east) and altitude from local (north, east, up) vectors
+static void coord_local_to_horizontal(const double* north, const double* east, const double* up, int count,
+                                      double* azimuth, double* altitude) {
+    coord_vectors_to_spherical(north, east, up, count, azimuth, altitude);
+}
+
+static const double (*coord_frame_matrix(const CoordEpoch* epoch, CoordEclipticFrame frame))[3] {
+    return frame == COORD_ECLIPTIC_J2000 ? epoch->from_j2000 : epoch->from_date;
+}
+
+CalendarResult coord_ecliptic_to_equatorial_batch(const CoordEpoch* epoch, CoordEclipticFrame frame,
+                                                  const double* longitude, const double* latitude,
+                                                  int count, double* ra, double* dec) {
+    if (!epoch || !longitude || !latitude || !ra || !dec) return CALENDAR_ERROR_NULL_POINTER;
+    if (count < 0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    double x[COORD_BLOCK], y[COORD_BLOCK], z[COORD_BLOCK];
+    for (int start = 0; start < count; start += COORD_BLOCK) {
+        int n = count - start < COORD_BLOCK ? count - start : COORD_BLOCK;
+        coord_spherical_to_vectors(longitude + start, latitude + start, n, x, y, z);
+        coord_rotate_vectors(coord_frame_matrix(epoch, frame), x, y, z, n, x, y, z);
+        coord_vectors_to_spherical(x, y, z, n, ra + start, dec + start);
+        for (int i = start; i < start + n; i++) ra[i] /= 15.0;
+    }
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult coord_equatorial_to_horizontal_batch(double lst, double latitude,
+                                                    const double* ra, const double* dec, int count,
+                                                    double* azimuth, double* altitude) {
+    if (!ra || !dec || !azimuth || !altitude) return CALENDAR_ERROR_NULL_POINTER;
+    if (count < 0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    double m[3][3];
+    coord_horizon_matrix(lst, latitude, m);
+    
+    double x[COORD_BLOCK], y[COORD_BLOCK], z[COORD_BLOCK], degrees[COORD_BLOCK];
+    for (int start = 0; start < count; start += COORD_BLOCK) {
+        int n = count - start < COORD_BLOCK ? count - start : COORD_BLOCK;
+        for (int i = 0; i < n; i++) degrees[i] = ra[start + i] * 15.0;
+        coord_spherical_to_vectors(degrees, dec + start, n, x, y, z);
+        coord_rotate_vectors(m, x, y, z, n, x, y, z);
+        coord_local_to_horizontal(x, y, z, n, azimuth + start, altitude + start);
+    }
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult coord_ecliptic_to_horizontal_batch(const CoordEpoch* epoch, CoordEclipticFrame frame,
+                                                  double lst, double latitude,
+                                                  const double* longitude, const double* latitude_ecl,
+                                                  int count, double* azimuth, double* altitude) {
+    if (!epoch || !longitude || !latitude_ecl || !azimuth || !altitude) return CALENDAR_ERROR_NULL_POINTER;
+    if (count < 0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    double m[3][3];
+    coord_horizon_matrix(lst, latitude, m);
+    coord_multiply(m, coord_frame_matrix(epoch, frame), m);
+    
+    double x[COORD_BLOCK], y[COORD_BLOCK], z[COORD_BLOCK];
+    for (int start = 0; start < count; start += COORD_BLOCK) {
+        int n = count - start < COORD_BLOCK ? count - start : COORD_BLOCK;
+        coord_spherical_to_vectors(longitude + start, latitude_ecl + start, n, x, y, z);
+        coord_rotate_vectors(m, x, y, z, n, x, y, z);
+        coord_local_to_horizontal(x, y, z, n, azimuth + start, altitude + start);
+    }
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult coord_horizontal_for_observers(const CoordObserverSet* observers, double julian_day,
+                                              double ra, double dec,
+                                              double* azimuth, double* altitude) {
+    if (!observers || !azimuth || !altitude) return CALENDAR_ERROR_NULL_POINTER;
+    
+    // Apparent sidereal time: mean plus the equation of the equinoxes
+    const CoordEpoch* epoch = coord_epoch_get(time_ut_to_tt(julian_day));
+    double gast = solar_greenwich_sidereal_time(julian_day) +
+                  epoch->nutation_longitude * cos(epoch->true_obliquity * COORD_DEG_TO_RAD) / 15.0;
+    
+    // Body in the Earth-fixed frame; each observer then needs only products
+    double greenwich_hour = (gast - ra) * 15.0 * COORD_DEG_TO_RAD;
+    double delta = dec * COORD_DEG_TO_RAD;
+    double gx = cos(delta) * cos(greenwich_hour);
+    double gy = -cos(delta) * sin(greenwich_hour);
+    double gz = sin(delta);
+    
+    double north[COORD_BLOCK], east[COORD_BLOCK], up[COORD_BLOCK];
+    for (int start = 0; start < observers->count; start += COORD_BLOCK) {
+        int n = observers->count - start < COORD_BLOCK ? observers->count - start : COORD_BLOCK;
+        const double* sin_lat = observers->sin_lat + start;
+        const double* cos_lat = observers->cos_lat + start;
+        const double* sin_lon = observers->sin_lon + start;
+        const double* cos_lon = observers->cos_lon + start;
+        
+        #pragma omp simd
+        for (int i = 0; i < n; i++) {
+            double meridian = cos_lon[i] * gx + sin_lon[i] * gy;    // cos(dec) cos(H)
+            east[i] = cos_lon[i] * gy - sin_lon[i] * gx;            // -cos(dec) sin(H)
+            north[i] = cos_lat[i] * gz - sin_lat[i] * meridian;
+            up[i] = sin_lat[i] * gz + cos_lat[i] * meridian;
+        }
+        coord_local_to_horizontal(north, east, up, n, azimuth + start, altitude + start);
+    }
+    return CALENDAR_SUCCESS;
+}
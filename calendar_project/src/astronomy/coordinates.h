@@ -0,0 +1,74 @@
+// src/astronomy/coordinates.h
+#ifndef COORDINATES_H
+#define COORDINATES_H
+
+#include "../../include/calendar_types.h"
+
+// Ecliptic frames accepted by the batch transforms
+typedef enum {
+    COORD_ECLIPTIC_J2000,       // Mean ecliptic and equinox of J2000.0 (catalogs)
+    COORD_ECLIPTIC_OF_DATE      // Mean equinox of date (the lunar and solar series)
+} CoordEclipticFrame;
+
+// Frame rotations of one epoch (Meeus ch. 21-22). Matrices act on column
+// vectors and end in the true equator and equinox of date.
+typedef struct {
+    double julian_day;              // TT
+    double mean_obliquity;          // Degrees
+    double true_obliquity;
+    double nutation_longitude;      // Delta-psi, degrees
+    double nutation_obliquity;      // Delta-epsilon, degrees
+    double from_j2000[3][3];        // J2000 ecliptic -> true equator of date (precession, nutation)
+    double from_date[3][3];         // Ecliptic of date -> true equator of date (nutation)
+} CoordEpoch;
+
+// Rotations at a TT instant. coord_epoch_get() keeps the last epoch per thread
+// and recomputes only when the instant changes.
+void coord_epoch_init(double julian_day, CoordEpoch* epoch);
+const CoordEpoch* coord_epoch_get(double julian_day);
+
+// Observer locations with their trigonometry precomputed once
+typedef struct {
+    int count;
+    double* latitude;               // Degrees
+    double* longitude;              // Degrees, east positive
+    double* sin_lat;
+    double* cos_lat;
+    double* sin_lon;
+    double* cos_lon;
+} CoordObserverSet;
+
+CoordObserverSet* coord_observers_create(const double* latitudes, const double* longitudes, int count);
+void coord_observers_destroy(CoordObserverSet* observers);
+
+// Array kernels: spherical <-> unit vectors (degrees) and a 3x3 rotation
+void coord_spherical_to_vectors(const double* longitude, const double* latitude, int count,
+                                double* x, double* y, double* z);
+void coord_vectors_to_spherical(const double* x, const double* y, const double* z, int count,
+                                double* longitude, double* latitude);
+void coord_rotate_vectors(const double matrix[3][3], const double* x, const double* y, const double* z,
+                          int count, double* out_x, double* out_y, double* out_z);
+
+// Ecliptic longitude/latitude (degrees) to right ascension (hours) and declination
+CalendarResult coord_ecliptic_to_equatorial_batch(const CoordEpoch* epoch, CoordEclipticFrame frame,
+                                                  const double* longitude, const double* latitude,
+                                                  int count, double* ra, double* dec);
+
+// Many bodies, one observer: local sidereal time in hours; azimuth from north through east
+CalendarResult coord_equatorial_to_horizontal_batch(double lst, double latitude,
+                                                    const double* ra, const double* dec, int count,
+                                                    double* azimuth, double* altitude);
+
+// Many bodies, one observer, straight from ecliptic coordinates with the
+// frame and horizon rotations combined into one matrix
+CalendarResult coord_ecliptic_to_horizontal_batch(const CoordEpoch* epoch, CoordEclipticFrame frame,
+                                                  double lst, double latitude,
+                                                  const double* longitude, const double* latitude_ecl,
+                                                  int count, double* azimuth, double* altitude);
+
+// One body, many observers at a UT instant
+CalendarResult coord_horizontal_for_observers(const CoordObserverSet* observers, double julian_day,
+                                              double ra, double dec,
+                                              double* azimuth, double* altitude);
+
+#endif // COORDINATES_H
@@ -0,0 +1,398 @@
+// src/astronomy/crescent.c
+#include "crescent.h"
+#include "lunar_calc.h"
+#include "solar_calc.h"
+#include "time_scale.h"
+
+#define CRESCENT_DEG_TO_RAD (M_PI / 180.0)
+#define CRESCENT_RAD_TO_DEG (180.0 / M_PI)
+#define CRESCENT_EARTH_RADIUS_KM 6378.14
+#define CRESCENT_MOON_RADIUS_ER (1737.4 / 6378.14)
+#define CRESCENT_AU_EARTH_RADII (149597870.7 / 6378.14)
+
+// Geocentric positions are tabulated hourly for the night window and
+// interpolated per grid cell, so cells never evaluate the series
+#define CRESCENT_TABLE_STEP (1.0 / 24.0)
+
+#define CRESCENT_SUN_SET_ALTITUDE -0.8333
+#define CRESCENT_SUN_HOUR_RATE 360.0        // Degrees of hour angle per day
+#define CRESCENT_MOON_HOUR_RATE 347.81
+#define CRESCENT_CIRCUMPOLAR_DELAY (20.0 / 1440.0)  // Best time when the moon does not set
+
+typedef struct {
+    double start_jd;            // UT of the first node
+    int count;
+    double (*sun)[3];           // Geocentric equatorial vectors, Earth radii
+    double (*moon)[3];
+} CrescentTable;
+
+static void crescent_ecliptic_vector(double longitude, double latitude, double distance, double v[3]) {
+    double ra, dec;
+    solar_ecliptic_to_equatorial(longitude, latitude, &ra, &dec);
+    
+    double alpha = ra * 15.0 * CRESCENT_DEG_TO_RAD;
+    double delta = dec * CRESCENT_DEG_TO_RAD;
+    v[0] = distance * cos(delta) * cos(alpha);
+    v[1] = distance * cos(delta) * sin(alpha);
+    v[2] = distance * sin(delta);
+}
+
+static CalendarResult crescent_table_build(CrescentTable* table, double start_jd, double end_jd) {
+    table->start_jd = start_jd - CRESCENT_TABLE_STEP;
+    table->count = (int)ceil((end_jd - start_jd) / CRESCENT_TABLE_STEP) + 4;
+    table->sun = malloc(sizeof(double[3]) * table->count);
+    table->moon = malloc(sizeof(double[3]) * table->count);
+    double* jde = malloc(sizeof(double) * table->count);
+    LunarPosition* moon = malloc(sizeof(LunarPosition) * table->count);
+    
+    if (!table->sun || !table->moon || !jde || !moon) {
+        free(table->sun);
+        free(table->moon);
+        free(jde);
+        free(moon);
+        return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    for (int i = 0; i < table->count; i++) {
+        jde[i] = time_ut_to_tt(table->start_jd + i * CRESCENT_TABLE_STEP);
+    }
+    lunar_calculate_position_batch(jde, table->count, moon);
+    
+    for (int i = 0; i < table->count; i++) {
+        crescent_ecliptic_vector(moon[i].longitude, moon[i].latitude,
+                                 moon[i].distance_km / CRESCENT_EARTH_RADIUS_KM, table->moon[i]);
+        crescent_ecliptic_vector(solar_calculate_longitude(jde[i]), 0.0,
+                                 solar_calculate_distance(jde[i]) * CRESCENT_AU_EARTH_RADII, table->sun[i]);
+    }
+    
+    free(jde);
+    free(moon);
+    return CALENDAR_SUCCESS;
+}
+
+static void crescent_table_free(CrescentTable* table) {
+    free(table->sun);
+    free(table->moon);
+}
+
+// Four-point Lagrange interpolation of a tabulated vector
+static void crescent_interpolate(const CrescentTable* table, const double (*nodes)[3], double t, double out[3]) {
+    double x = (t - table->start_jd) / CRESCENT_TABLE_STEP;
+    int i = (int)floor(x);
+    if (i < 1) i = 1;
+    if (i > table->count - 3) i = table->count - 3;
+    double p = x - i;
+    
+    double w0 = -p * (p - 1.0) * (p - 2.0) / 6.0;
+    double w1 = (p + 1.0) * (p - 1.0) * (p - 2.0) / 2.0;
+    double w2 = -(p + 1.0) * p * (p - 2.0) / 2.0;
+    double w3 = (p + 1.0) * p * (p - 1.0) / 6.0;
+    
+    for (int k = 0; k < 3; k++) {
+        out[k] = w0 * nodes[i - 1][k] + w1 * nodes[i][k] + w2 * nodes[i + 1][k] + w3 * nodes[i + 2][k];
+    }
+}
+
+static double crescent_dot(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static double crescent_angle(const double a[3], const double b[3]) {
+    double c = crescent_dot(a, b) / sqrt(crescent_dot(a, a) * crescent_dot(b, b));
+    return acos(fmin(1.0, fmax(-1.0, c))) * CRESCENT_RAD_TO_DEG;
+}
+
+// Local horizon frame of an observer on a spherical Earth at a UT instant
+typedef struct {
+    double zenith[3];           // Also the observer's position in Earth radii
+    double east[3];
+    double north[3];
+} CrescentFrame;
+
+static void crescent_frame(double julian_day, double latitude, double longitude, CrescentFrame* frame) {
+    double theta = (solar_greenwich_sidereal_time(julian_day) * 15.0 + longitude) * CRESCENT_DEG_TO_RAD;
+    double phi = latitude * CRESCENT_DEG_TO_RAD;
+    
+    frame->zenith[0] = cos(phi) * cos(theta);
+    frame->zenith[1] = cos(phi) * sin(theta);
+    frame->zenith[2] = sin(phi);
+    frame->east[0] = -sin(theta);
+    frame->east[1] = cos(theta);
+    frame->east[2] = 0.0;
+    frame->north[0] = -sin(phi) * cos(theta);
+    frame->north[1] = -sin(phi) * sin(theta);
+    frame->north[2] = cos(phi);
+}
+
+static double crescent_altitude(const CrescentFrame* frame, const double v[3]) {
+    return asin(crescent_dot(frame->zenith, v) / sqrt(crescent_dot(v, v))) * CRESCENT_RAD_TO_DEG;
+}
+
+static double crescent_azimuth(const CrescentFrame* frame, const double v[3]) {
+    double az = atan2(crescent_dot(frame->east, v), crescent_dot(frame->north, v)) * CRESCENT_RAD_TO_DEG;
+    return az < 0.0 ? az + 360.0 : az;
+}
+
+static double crescent_wrap180(double angle) {
+    angle = fmod(angle, 360.0);
+    if (angle >= 180.0) angle -= 360.0;
+    if (angle < -180.0) angle += 360.0;
+    return angle;
+}
+
+typedef enum {
+    CRESCENT_CROSSING_FOUND,
+    CRESCENT_CROSSING_NEVER_UP,
+    CRESCENT_CROSSING_ALWAYS_UP,
+    CRESCENT_CROSSING_ALREADY_SET
+} CrescentCrossing;
+
+// Setting time of the sun or moon after t (hour angle iteration on interpolated positions)
+static CrescentCrossing crescent_set_time(const CrescentTable* table, int is_moon, double t,
+                                          double latitude, double longitude, double* result) {
+    double phi = latitude * CRESCENT_DEG_TO_RAD;
+    double rate = is_moon ? CRESCENT_MOON_HOUR_RATE : CRESCENT_SUN_HOUR_RATE;
+    double v[3];
+    
+    for (int iter = 0; iter < 4; iter++) {
+        crescent_interpolate(table, is_moon ? table->moon : table->sun, t, v);
+        double r = sqrt(crescent_dot(v, v));
+        double delta = asin(v[2] / r);
+        double ra = atan2(v[1], v[0]) * CRESCENT_RAD_TO_DEG;
+        
+        // Moon: parallax, refraction and semidiameter (Meeus ch. 15)
+        double h0 = is_moon ? 0.7275 * asin(1.0 / r) * CRESCENT_RAD_TO_DEG - 0.5667 : CRESCENT_SUN_SET_ALTITUDE;
+        double cos_h0 = (sin(h0 * CRESCENT_DEG_TO_RAD) - sin(phi) * sin(delta)) / (cos(phi) * cos(delta));
+        if (cos_h0 > 1.0) return CRESCENT_CROSSING_NEVER_UP;
+        if (cos_h0 < -1.0) return CRESCENT_CROSSING_ALWAYS_UP;
+        
+        double H = solar_greenwich_sidereal_time(t) * 15.0 + longitude - ra;
+        double step = crescent_wrap180(acos(cos_h0) * CRESCENT_RAD_TO_DEG - H);
+        if (is_moon && iter == 0 && step < 0.0) return CRESCENT_CROSSING_ALREADY_SET;
+        t += step / rate;
+    }
+    
+    *result = t;
+    return CRESCENT_CROSSING_FOUND;
+}
+
+static CrescentVisibility crescent_classify(CrescentCriterion criterion, double value) {
+    if (criterion == CRESCENT_CRITERION_ODEH) {
+        if (value >= 5.65) return CRESCENT_EASILY_VISIBLE;
+        if (value >= 2.0) return CRESCENT_OPTICAL_AID_HELPS;
+        if (value >= -0.96) return CRESCENT_OPTICAL_AID_ONLY;
+        return CRESCENT_NOT_VISIBLE;
+    }
+    if (value > 0.216) return CRESCENT_EASILY_VISIBLE;
+    if (value > -0.014) return CRESCENT_VISIBLE_PERFECT;
+    if (value > -0.160) return CRESCENT_OPTICAL_AID_HELPS;
+    if (value > -0.232) return CRESCENT_OPTICAL_AID_ONLY;
+    return CRESCENT_NOT_VISIBLE;
+}
+
+// Evaluates the criterion on the evening of the civil date starting at date_jd (0h UT)
+static void crescent_observe(const CrescentTable* table, double date_jd, double latitude, double longitude,
+                             double conjunction_jd, CrescentCriterion criterion, CrescentObservation* obs) {
+    memset(obs, 0, sizeof(*obs));
+    obs->visibility = CRESCENT_BELOW_HORIZON;
+    obs->criterion_value = -99.0;
+    
+    // Start from 18h local mean time
+    double t = date_jd + 0.75 - longitude / 360.0;
+    if (crescent_set_time(table, 0, t - 0.25, latitude, longitude, &obs->sunset_jd) != CRESCENT_CROSSING_FOUND) {
+        return;
+    }
+    
+    double best;
+    CrescentCrossing moonset = crescent_set_time(table, 1, obs->sunset_jd, latitude, longitude, &obs->moonset_jd);
+    if (moonset == CRESCENT_CROSSING_FOUND) {
+        obs->lag_minutes = (obs->moonset_jd - obs->sunset_jd) * 1440.0;
+        best = obs->sunset_jd + 4.0 / 9.0 * (obs->moonset_jd - obs->sunset_jd);
+    } else if (moonset == CRESCENT_CROSSING_ALWAYS_UP) {
+        obs->moonset_jd = 0.0;
+        best = obs->sunset_jd + CRESCENT_CIRCUMPOLAR_DELAY;
+    } else {
+        return;
+    }
+    obs->best_time_jd = best;
+    obs->moon_age_hours = (best - conjunction_jd) * 24.0;
+    
+    double sun[3], moon[3], topo_moon[3], topo_sun[3];
+    crescent_interpolate(table, table->sun, best, sun);
+    crescent_interpolate(table, table->moon, best, moon);
+    
+    CrescentFrame frame;
+    crescent_frame(best, latitude, longitude, &frame);
+    for (int k = 0; k < 3; k++) {
+        topo_moon[k] = moon[k] - frame.zenith[k];
+        topo_sun[k] = sun[k] - frame.zenith[k];
+    }
+    
+    double sun_alt = crescent_altitude(&frame, sun);
+    double moon_alt = crescent_altitude(&frame, moon);
+    double topo_moon_alt = crescent_altitude(&frame, topo_moon);
+    
+    obs->arcl = crescent_angle(sun, moon);
+    obs->daz = crescent_wrap180(crescent_azimuth(&frame, sun) - crescent_azimuth(&frame, moon));
+    
+    // Topocentric crescent width in arcminutes
+    double semidiameter = asin(CRESCENT_MOON_RADIUS_ER / sqrt(crescent_dot(topo_moon, topo_moon))) *
+                          CRESCENT_RAD_TO_DEG * 60.0;
+    double W = semidiameter * (1.0 - cos(crescent_angle(topo_sun, topo_moon) * CRESCENT_DEG_TO_RAD));
+    obs->width_arcmin = W;
+    
+    double curve = -6.3226 * W + 0.7319 * W * W - 0.1018 * W * W * W;
+    if (criterion == CRESCENT_CRITERION_ODEH) {
+        obs->arcv = topo_moon_alt - sun_alt;
+        obs->criterion_value = obs->arcv - (7.1651 + curve);
+    } else {
+        obs->arcv = moon_alt - sun_alt;
+        obs->criterion_value = (obs->arcv - (11.8371 + curve)) / 10.0;
+    }
+    
+    obs->visibility = obs->moon_age_hours < 0.0 ? CRESCENT_NOT_VISIBLE
+                                                : crescent_classify(criterion, obs->criterion_value);
+}
+
+CalendarResult crescent_evaluate(double julian_day, double latitude, double longitude,
+                                 CrescentCriterion criterion, CrescentObservation* observation) {
+    if (!observation) return CALENDAR_ERROR_NULL_POINTER;
+    if (latitude < -90.0 || latitude > 90.0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    double date_jd = floor(julian_day - 0.5) + 0.5;
+    
+    // Latest conjunction before the end of that evening
+    double evening_end = date_jd + 1.5;
+    double conjunction = lunar_find_next_phase(evening_end - 30.0, 0.0);
+    if (conjunction == 0.0) return CALENDAR_ERROR_CONVERSION_FAILED;
+    double next = lunar_find_next_phase(conjunction + 1.0, 0.0);
+    if (next == 0.0) return CALENDAR_ERROR_CONVERSION_FAILED;
+    if (next < evening_end) conjunction = next;
+    
+    CrescentTable table;
+    CalendarResult result = crescent_table_build(&table, date_jd - 0.5, date_jd + 2.0);
+    if (result != CALENDAR_SUCCESS) return result;
+    
+    crescent_observe(&table, date_jd, latitude, longitude, conjunction, criterion, observation);
+    crescent_table_free(&table);
+    return CALENDAR_SUCCESS;
+}
+
+CrescentMap* crescent_map_create(double conjunction_jd,
+                                 double lat_min, double lat_max,
+                                 double lon_min, double lon_max,
+                                 double step, CrescentCriterion criterion) {
+    if (step <= 0.0 || lat_max < lat_min || lon_max < lon_min) return NULL;
+    
+    CrescentMap* map = malloc(sizeof(CrescentMap));
+    if (!map) return NULL;
+    
+    map->conjunction_jd = conjunction_jd;
+    map->first_evening_jd = floor(conjunction_jd - 0.5) + 0.5;
+    map->nights = CRESCENT_MAP_NIGHTS;
+    map->criterion = criterion;
+    map->lat_min = lat_min;
+    map->lon_min = lon_min;
+    map->step = step;
+    map->rows = (int)floor((lat_max - lat_min) / step + 1e-9) + 1;
+    map->cols = (int)floor((lon_max - lon_min) / step + 1e-9) + 1;
+    
+    size_t cells = (size_t)map->rows * map->cols;
+    map->visibility = malloc(cells * map->nights);
+    map->criterion_value = malloc(sizeof(float) * cells * map->nights);
+    
+    CrescentTable table;
+    if (!map->visibility || !map->criterion_value ||
+        crescent_table_build(&table, map->first_evening_jd - 0.5,
+                             map->first_evening_jd + map->nights + 1.5) != CALENDAR_SUCCESS) {
+        crescent_map_destroy(map);
+        return NULL;
+    }
+    
+    // Cells only interpolate the shared table, so they are independent
+    int cell_count = (int)cells;
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 64)
+    #endif
+    for (int cell = 0; cell < cell_count; cell++) {
+        double latitude = lat_min + (cell / map->cols) * step;
+        double longitude = lon_min + (cell % map->cols) * step;
+        
+        for (int night = 0; night < map->nights; night++) {
+            CrescentObservation obs;
+            crescent_observe(&table, map->first_evening_jd + night, latitude, longitude,
+                             conjunction_jd, criterion, &obs);
+            map->visibility[night * cells + cell] = (unsigned char)obs.visibility;
+            map->criterion_value[night * cells + cell] = (float)obs.criterion_value;
+        }
+    }
+    
+    crescent_table_free(&table);
+    return map;
+}
+
+void crescent_map_destroy(CrescentMap* map) {
+    if (!map) return;
+    
+    free(map->visibility);
+    free(map->criterion_value);
+    free(map);
+}
+
+// Nearest grid cell, clamped to the map
+static size_t crescent_map_cell(const CrescentMap* map, double latitude, double longitude) {
+    long row = lround((latitude - map->lat_min) / map->step);
+    long col = lround((longitude - map->lon_min) / map->step);
+    if (row < 0) row = 0;
+    if (row >= map->rows) row = map->rows - 1;
+    if (col < 0) col = 0;
+    if (col >= map->cols) col = map->cols - 1;
+    return (size_t)row * map->cols + col;
+}
+
+CrescentVisibility crescent_map_visibility(const CrescentMap* map, int night,
+                                           double latitude, double longitude) {
+    if (!map || night < 0 || night >= map->nights) return CRESCENT_BELOW_HORIZON;
+    
+    size_t cells = (size_t)map->rows * map->cols;
+    return (CrescentVisibility)map->visibility[night * cells + crescent_map_cell(map, latitude, longitude)];
+}
+
+long crescent_map_month_start(const CrescentMap* map, double latitude, double longitude,
+                              CrescentVisibility threshold) {
+    if (!map) return 0;
+    
+    long first_jdn = (long)(map->first_evening_jd + 0.5);
+    size_t cells = (size_t)map->rows * map->cols;
+    size_t cell = crescent_map_cell(map, latitude, longitude);
+    
+    for (int night = 0; night < map->nights; night++) {
+        if (map->visibility[night * cells + cell] <= threshold) return first_jdn + night + 1;
+    }
+    
+    // Not sighted on any evening evaluated: the month starts after the last one
+    return first_jdn + map->nights;
+}
+
+long crescent_month_start(double conjunction_jd, double latitude, double longitude,
+                          CrescentCriterion criterion, CrescentVisibility threshold) {
+    CrescentMap* map = crescent_map_create(conjunction_jd, latitude, latitude, longitude, longitude,
+                                           1.0, criterion);
+    if (!map) return 0;
+    
+    long start = crescent_map_month_start(map, latitude, longitude, threshold);
+    crescent_map_destroy(map);
+    return start;
+}
+
+const char* crescent_visibility_name(CrescentVisibility visibility) {
+    switch (visibility) {
+        case CRESCENT_EASILY_VISIBLE:    return "Easily visible";
+        case CRESCENT_VISIBLE_PERFECT:   return "Visible under perfect conditions";
+        case CRESCENT_OPTICAL_AID_HELPS: return "May need optical aid";
+        case CRESCENT_OPTICAL_AID_ONLY:  return "Optical aid only";
+        case CRESCENT_NOT_VISIBLE:       return "Not visible";
+        case CRESCENT_BELOW_HORIZON:     return "Moon below horizon";
+        default:                         return "Unknown";
+    }
+}
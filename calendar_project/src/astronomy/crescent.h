@@ -0,0 +1,83 @@
+// src/astronomy/crescent.h
+#ifndef CRESCENT_H
+#define CRESCENT_H
+
+#include "../../include/calendar_types.h"
+
+// Crescent visibility criteria
+typedef enum {
+    CRESCENT_CRITERION_YALLOP,  // Yallop (1997) q-test, geocentric ARCV
+    CRESCENT_CRITERION_ODEH     // Odeh (2004) V-test, topocentric ARCV
+} CrescentCriterion;
+
+// Visibility classes, best first (Yallop A-F; Odeh zones map onto the same scale)
+typedef enum {
+    CRESCENT_EASILY_VISIBLE,        // Yallop A; Odeh V >= 5.65
+    CRESCENT_VISIBLE_PERFECT,       // Yallop B: naked eye under perfect conditions
+    CRESCENT_OPTICAL_AID_HELPS,     // Yallop C; Odeh 2 <= V < 5.65
+    CRESCENT_OPTICAL_AID_ONLY,      // Yallop D; Odeh -0.96 <= V < 2
+    CRESCENT_NOT_VISIBLE,           // Yallop E/F; Odeh V < -0.96; or before conjunction
+    CRESCENT_BELOW_HORIZON          // Moon sets before the sun, or the sun does not set
+} CrescentVisibility;
+
+// Defaults used for location-dependent Islamic month starts
+#define CRESCENT_DEFAULT_CRITERION CRESCENT_CRITERION_YALLOP
+#define CRESCENT_DEFAULT_THRESHOLD CRESCENT_VISIBLE_PERFECT
+
+// Evenings evaluated per map, starting with the civil date of the conjunction
+#define CRESCENT_MAP_NIGHTS 3
+
+// Circumstances at the Yallop "best time" (sunset + 4/9 of the moonset lag)
+typedef struct {
+    double sunset_jd;           // UT
+    double moonset_jd;          // UT
+    double best_time_jd;        // UT
+    double lag_minutes;
+    double moon_age_hours;      // Since conjunction, at the best time
+    double arcl;                // Sun-moon elongation, degrees
+    double arcv;                // Moon-sun altitude difference, degrees (criterion's frame)
+    double daz;                 // Sun-moon azimuth difference, degrees
+    double width_arcmin;        // Topocentric crescent width
+    double criterion_value;     // Yallop q or Odeh V
+    CrescentVisibility visibility;
+} CrescentObservation;
+
+// Visibility of the crescent on the evening of the civil date containing julian_day
+CalendarResult crescent_evaluate(double julian_day, double latitude, double longitude,
+                                 CrescentCriterion criterion, CrescentObservation* observation);
+
+// Visibility over a latitude/longitude grid for the evenings after a conjunction
+typedef struct {
+    double conjunction_jd;      // UT
+    double first_evening_jd;    // 0h UT of the first civil date evaluated
+    int nights;
+    CrescentCriterion criterion;
+    double lat_min;
+    double lon_min;
+    double step;                // Grid spacing in degrees
+    int rows;                   // Latitudes
+    int cols;                   // Longitudes
+    unsigned char* visibility;  // CrescentVisibility, [night][row][col]
+    float* criterion_value;     // Same layout
+} CrescentMap;
+
+CrescentMap* crescent_map_create(double conjunction_jd,
+                                 double lat_min, double lat_max,
+                                 double lon_min, double lon_max,
+                                 double step, CrescentCriterion criterion);
+void crescent_map_destroy(CrescentMap* map);
+CrescentVisibility crescent_map_visibility(const CrescentMap* map, int night,
+                                           double latitude, double longitude);
+
+// Julian Day Number of the first day of the month at a location: the day after
+// the first evening the crescent reaches threshold
+long crescent_map_month_start(const CrescentMap* map, double latitude, double longitude,
+                              CrescentVisibility threshold);
+
+// Single-location month start for the conjunction
+long crescent_month_start(double conjunction_jd, double latitude, double longitude,
+                          CrescentCriterion criterion, CrescentVisibility threshold);
+
+const char* crescent_visibility_name(CrescentVisibility visibility);
+
+#endif // CRESCENT_H
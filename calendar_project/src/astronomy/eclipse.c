@@ -0,0 +1,260 @@
+// src/astronomy/eclipse.c
+#include "eclipse.h"
+#include "lunar_calc.h"
+#include "solar_calc.h"
+#include "time_scale.h"
+#include "../utils/date_utils.h"
+
+#define ECLIPSE_DEG_TO_RAD (M_PI / 180.0)
+#define ECLIPSE_RAD_TO_DEG (180.0 / M_PI)
+#define ECLIPSE_SYNODIC_MONTH 29.530588861
+#define ECLIPSE_EPOCH_JDE 2451550.09766   // New moon of 2000 January 6, k = 0
+#define ECLIPSE_NODE_LIMIT 0.36           // |sin F| above this: no eclipse possible
+#define ECLIPSE_EARTH_RADIUS_KM 6378.14
+#define ECLIPSE_MOON_RADIUS_KM 1737.4
+#define ECLIPSE_SUN_RADIUS_KM 696000.0
+#define ECLIPSE_AU_KM 149597870.7
+
+static double eclipse_normalize_longitude(double angle) {
+    angle = fmod(angle + 180.0, 360.0);
+    return (angle < 0 ? angle + 360.0 : angle) - 180.0;
+}
+
+// Unit vector (or scaled) from right ascension in hours and declination in degrees
+static void eclipse_equatorial_vector(double ra_hours, double dec, double scale, double v[3]) {
+    double alpha = ra_hours * 15.0 * ECLIPSE_DEG_TO_RAD;
+    double delta = dec * ECLIPSE_DEG_TO_RAD;
+    v[0] = scale * cos(delta) * cos(alpha);
+    v[1] = scale * cos(delta) * sin(alpha);
+    v[2] = scale * sin(delta);
+}
+
+// Geographic position under a geocentric direction at the given instant (TT)
+static void eclipse_subpoint(const double v[3], double julian_day, double* latitude, double* longitude) {
+    double r = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    *latitude = asin(v[2] / r) * ECLIPSE_RAD_TO_DEG;
+    double ra = atan2(v[1], v[0]) * ECLIPSE_RAD_TO_DEG;
+    double gmst = solar_greenwich_sidereal_time(time_tt_to_ut(julian_day));
+    *longitude = eclipse_normalize_longitude(ra - gmst * 15.0);
+}
+
+// Geocentric moon and sun vectors in Earth radii
+static void eclipse_body_vectors(double julian_day, double moon[3], double sun[3]) {
+    LunarPosition pos;
+    double ra, dec;
+    
+    lunar_calculate_position(julian_day, &pos);
+    solar_ecliptic_to_equatorial(pos.longitude, pos.latitude, &ra, &dec);
+    eclipse_equatorial_vector(ra, dec, pos.distance_km / ECLIPSE_EARTH_RADIUS_KM, moon);
+    
+    solar_ecliptic_to_equatorial(solar_calculate_longitude(julian_day), 0.0, &ra, &dec);
+    eclipse_equatorial_vector(ra, dec, solar_calculate_distance(julian_day) * ECLIPSE_AU_KM / ECLIPSE_EARTH_RADIUS_KM, sun);
+}
+
+// Point of greatest eclipse (solar) or sub-lunar point (lunar), plus the
+// magnitude of a central solar eclipse from the apparent diameters there
+static void eclipse_fill_geometry(EclipseInfo* info) {
+    double moon[3], sun[3];
+    eclipse_body_vectors(info->greatest_jd, moon, sun);
+    
+    if (info->kind == ECLIPSE_LUNAR) {
+        eclipse_subpoint(moon, info->greatest_jd, &info->latitude_center, &info->longitude_center);
+        return;
+    }
+    
+    // Shadow axis runs through the moon towards the sun; find where it meets the Earth
+    double sun_dist = sqrt(sun[0] * sun[0] + sun[1] * sun[1] + sun[2] * sun[2]);
+    double s[3] = {sun[0] / sun_dist, sun[1] / sun_dist, sun[2] / sun_dist};
+    double along = moon[0] * s[0] + moon[1] * s[1] + moon[2] * s[2];
+    double p[3] = {moon[0] - along * s[0], moon[1] - along * s[1], moon[2] - along * s[2]};
+    double offset = sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    double height = offset < 1.0 ? sqrt(1.0 - offset * offset) : 0.0;
+    double point[3] = {p[0] + height * s[0], p[1] + height * s[1], p[2] + height * s[2]};
+    eclipse_subpoint(point, info->greatest_jd, &info->latitude_center, &info->longitude_center);
+    
+    if (info->is_central) {
+        double moon_km = (along - height) * ECLIPSE_EARTH_RADIUS_KM;
+        double sun_km = (sun_dist - height) * ECLIPSE_EARTH_RADIUS_KM;
+        info->magnitude = asin(ECLIPSE_MOON_RADIUS_KM / moon_km) / asin(ECLIPSE_SUN_RADIUS_KM / sun_km);
+    }
+}
+
+int eclipse_evaluate(double k, EclipseInfo* info) {
+    double T = k / 1236.85;
+    double T2 = T * T;
+    
+    // Node proximity test first: most syzygies are rejected here
+    double F = 160.7108 + 390.67050284 * k - 0.0016118 * T2 - 0.00000227 * T2 * T + 0.000000011 * T2 * T2;
+    if (!info || fabs(sin(F * ECLIPSE_DEG_TO_RAD)) > ECLIPSE_NODE_LIMIT) return 0;
+    
+    int is_solar = floor(k) == k;
+    double jde = ECLIPSE_EPOCH_JDE + ECLIPSE_SYNODIC_MONTH * k + 0.00015437 * T2 -
+                 0.000000150 * T2 * T + 0.00000000073 * T2 * T2;
+    double M = (2.5534 + 29.10535670 * k - 0.0000014 * T2 - 0.00000011 * T2 * T) * ECLIPSE_DEG_TO_RAD;
+    double Mp = (201.5643 + 385.81693528 * k + 0.0107582 * T2 + 0.00001238 * T2 * T -
+                 0.000000058 * T2 * T2) * ECLIPSE_DEG_TO_RAD;
+    double omega = (124.7746 - 1.56375588 * k + 0.0020672 * T2 + 0.00000215 * T2 * T) * ECLIPSE_DEG_TO_RAD;
+    double E = 1.0 - 0.002516 * T - 0.0000074 * T2;
+    double F1 = F * ECLIPSE_DEG_TO_RAD - 0.02665 * ECLIPSE_DEG_TO_RAD * sin(omega);
+    double A1 = (299.77 + 0.107408 * k - 0.009173 * T2) * ECLIPSE_DEG_TO_RAD;
+    
+    // Time of greatest eclipse
+    jde += (is_solar ? -0.4075 : -0.4065) * sin(Mp) +
+           (is_solar ? 0.1721 : 0.1727) * E * sin(M) +
+           0.0161 * sin(2.0 * Mp) - 0.0097 * sin(2.0 * F1) +
+           0.0073 * E * sin(Mp - M) - 0.0050 * E * sin(Mp + M) -
+           0.0023 * sin(Mp - 2.0 * F1) + 0.0021 * E * sin(2.0 * M) +
+           0.0012 * sin(Mp + 2.0 * F1) + 0.0006 * E * sin(2.0 * Mp + M) -
+           0.0004 * sin(3.0 * Mp) - 0.0003 * E * sin(M + 2.0 * F1) +
+           0.0003 * sin(A1) - 0.0002 * E * sin(M - 2.0 * F1) -
+           0.0002 * E * sin(2.0 * Mp - M) - 0.0002 * sin(omega);
+    
+    double P = 0.2070 * E * sin(M) + 0.0024 * E * sin(2.0 * M) - 0.0392 * sin(Mp) +
+               0.0116 * sin(2.0 * Mp) - 0.0073 * E * sin(Mp + M) + 0.0067 * E * sin(Mp - M) +
+               0.0118 * sin(2.0 * F1);
+    double Q = 5.2207 - 0.0048 * E * cos(M) + 0.0020 * E * cos(2.0 * M) - 0.3299 * cos(Mp) -
+               0.0060 * E * cos(Mp + M) + 0.0041 * E * cos(Mp - M);
+    double W = fabs(cos(F1));
+    double gamma = (P * cos(F1) + Q * sin(F1)) * (1.0 - 0.0048 * W);
+    double u = 0.0059 + 0.0046 * E * cos(M) - 0.0182 * cos(Mp) + 0.0004 * cos(2.0 * Mp) -
+               0.0005 * cos(M + Mp);
+    double abs_gamma = fabs(gamma);
+    double n = 0.5458 + 0.0400 * cos(Mp);   // Hourly motion of the moon relative to the shadow
+    
+    memset(info, 0, sizeof(*info));
+    info->lunation = k;
+    info->greatest_jd = jde;
+    info->gamma = gamma;
+    
+    if (is_solar) {
+        double penumbra = 1.5433 + u;
+        if (abs_gamma > penumbra) return 0;
+        
+        info->kind = ECLIPSE_SOLAR;
+        info->duration_minutes = 120.0 / n * sqrt(penumbra * penumbra - gamma * gamma);
+        info->is_central = abs_gamma < 0.9972;
+        
+        if (info->is_central) {
+            if (u < 0.0) {
+                info->type = ECLIPSE_TYPE_TOTAL;
+            } else if (u > 0.0047 || u >= 0.00464 * sqrt(1.0 - gamma * gamma)) {
+                info->type = ECLIPSE_TYPE_ANNULAR;
+            } else {
+                info->type = ECLIPSE_TYPE_HYBRID;
+            }
+        } else if (abs_gamma < 0.9972 + fabs(u)) {
+            // Non-central: the umbra or antumbra only grazes a polar region
+            info->type = u < 0.0 ? ECLIPSE_TYPE_TOTAL : ECLIPSE_TYPE_ANNULAR;
+            info->magnitude = u < 0.0 ? 1.0 : 0.99;
+        } else {
+            info->type = ECLIPSE_TYPE_PARTIAL;
+            info->magnitude = (penumbra - abs_gamma) / (0.5461 + 2.0 * u);
+        }
+    } else {
+        info->kind = ECLIPSE_LUNAR;
+        info->penumbral_magnitude = (1.5573 + u - abs_gamma) / 0.5450;
+        if (info->penumbral_magnitude <= 0.0) return 0;
+        info->magnitude = (1.0128 - u - abs_gamma) / 0.5450;
+        
+        double h = 1.5573 + u;
+        double p = 1.0128 - u;
+        double t = 0.4678 - u;
+        info->duration_minutes = 120.0 / n * sqrt(h * h - gamma * gamma);
+        if (abs_gamma < p) info->partial_minutes = 120.0 / n * sqrt(p * p - gamma * gamma);
+        if (abs_gamma < t) info->total_minutes = 120.0 / n * sqrt(t * t - gamma * gamma);
+        
+        if (info->magnitude >= 1.0) {
+            info->type = ECLIPSE_TYPE_TOTAL;
+        } else if (info->magnitude > 0.0) {
+            info->type = ECLIPSE_TYPE_PARTIAL;
+        } else {
+            info->type = ECLIPSE_TYPE_PENUMBRAL;
+        }
+    }
+    
+    eclipse_fill_geometry(info);
+    return 1;
+}
+
+// First lunation index of the given kind at or before julian_day
+static double eclipse_lunation_before(EclipseKind kind, double julian_day) {
+    double k = floor((julian_day - ECLIPSE_EPOCH_JDE) / ECLIPSE_SYNODIC_MONTH) - 1.0;
+    return kind == ECLIPSE_LUNAR ? k + 0.5 : k;
+}
+
+CalendarResult eclipse_find_next(EclipseKind kind, double julian_day, EclipseInfo* info) {
+    if (!info) return CALENDAR_ERROR_NULL_POINTER;
+    
+    // Eclipse seasons recur every ~173 days; never more than a year apart
+    double k = eclipse_lunation_before(kind, julian_day);
+    for (int i = 0; i < 16; i++, k += 1.0) {
+        if (eclipse_evaluate(k, info) && info->greatest_jd > julian_day) {
+            return CALENDAR_SUCCESS;
+        }
+    }
+    return CALENDAR_ERROR_CONVERSION_FAILED;
+}
+
+AstronomicalEvent* eclipse_generate_catalog(double start_jd, double end_jd, int* count) {
+    if (!count) return NULL;
+    *count = 0;
+    if (end_jd < start_jd) return NULL;
+    
+    // At most seven eclipses per calendar year
+    int capacity = (int)((end_jd - start_jd) / 365.25 * 7.0) + 8;
+    AstronomicalEvent* events = malloc(sizeof(AstronomicalEvent) * capacity);
+    if (!events) return NULL;
+    
+    // Syzygies alternate new/full every half lunation
+    double k = eclipse_lunation_before(ECLIPSE_SOLAR, start_jd);
+    double last_k = floor((end_jd - ECLIPSE_EPOCH_JDE) / ECLIPSE_SYNODIC_MONTH) + 1.0;
+    EclipseInfo info;
+    
+    for (; k <= last_k; k += 0.5) {
+        if (!eclipse_evaluate(k, &info)) continue;
+        if (info.greatest_jd < start_jd || info.greatest_jd > end_jd) continue;
+        if (*count >= capacity) break;
+        eclipse_to_astronomical_event(&info, &events[(*count)++]);
+    }
+    
+    return events;
+}
+
+void eclipse_destroy_catalog(AstronomicalEvent* events) {
+    if (events) free(events);
+}
+
+const char* eclipse_type_name(EclipseType type) {
+    switch (type) {
+        case ECLIPSE_TYPE_PARTIAL: return "Partial";
+        case ECLIPSE_TYPE_TOTAL: return "Total";
+        case ECLIPSE_TYPE_ANNULAR: return "Annular";
+        case ECLIPSE_TYPE_HYBRID: return "Hybrid";
+        case ECLIPSE_TYPE_PENUMBRAL: return "Penumbral";
+        default: return "Unknown";
+    }
+}
+
+void eclipse_to_astronomical_event(const EclipseInfo* info, AstronomicalEvent* event) {
+    if (!info || !event) return;
+    
+    int is_solar = info->kind == ECLIPSE_SOLAR;
+    long jdn = (long)floor(info->greatest_jd + 0.5);
+    double minutes = (info->greatest_jd + 0.5 - jdn) * 1440.0;
+    int day, month, year;
+    julian_day_to_date(jdn, &day, &month, &year);
+    
+    event->type = is_solar ? ASTRO_EVENT_ECLIPSE_SOLAR : ASTRO_EVENT_ECLIPSE_LUNAR;
+    event->julian_day = info->greatest_jd;
+    snprintf(event->name, sizeof(event->name), "%s %s Eclipse",
+             eclipse_type_name(info->type), is_solar ? "Solar" : "Lunar");
+    snprintf(event->description, sizeof(event->description),
+             "Greatest eclipse %04d-%02d-%02d %02d:%02d TT, magnitude %.3f, gamma %.4f",
+             year, month, day, (int)(minutes / 60.0), (int)fmod(minutes, 60.0),
+             info->magnitude, info->gamma);
+    event->magnitude = info->magnitude;
+    event->duration_hours = info->duration_minutes / 60.0;
+    event->visibility_global = 0;
+    event->latitude_center = info->latitude_center;
+    event->longitude_center = info->longitude_center;
+}
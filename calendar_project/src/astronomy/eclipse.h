@@ -0,0 +1,52 @@
+// src/astronomy/eclipse.h
+#ifndef ECLIPSE_H
+#define ECLIPSE_H
+
+#include "../../include/calendar_types.h"
+#include "../../include/calendar_types_extended.h"
+
+typedef enum {
+    ECLIPSE_SOLAR,
+    ECLIPSE_LUNAR
+} EclipseKind;
+
+// Matches SolarEclipse.eclipse_type for solar eclipses
+typedef enum {
+    ECLIPSE_TYPE_PARTIAL,
+    ECLIPSE_TYPE_TOTAL,
+    ECLIPSE_TYPE_ANNULAR,
+    ECLIPSE_TYPE_HYBRID,
+    ECLIPSE_TYPE_PENUMBRAL
+} EclipseType;
+
+// Eclipse circumstances at greatest eclipse (Meeus ch. 54)
+typedef struct {
+    EclipseKind kind;
+    EclipseType type;
+    double lunation;            // Lunation index k (x.5 for full moons)
+    double greatest_jd;         // Greatest eclipse, dynamical time
+    double gamma;               // Least distance of the shadow axis from Earth's center, Earth radii
+    double magnitude;           // Solar: fraction of the sun's diameter covered; lunar: umbral
+    double penumbral_magnitude; // Lunar eclipses only
+    double duration_minutes;    // Solar: penumbra on Earth; lunar: penumbral phase
+    double partial_minutes;     // Lunar: umbral phase
+    double total_minutes;       // Lunar: total phase
+    int is_central;             // Solar: shadow axis meets the Earth
+    double latitude_center;     // Solar: point of greatest eclipse; lunar: moon at zenith
+    double longitude_center;    // Degrees, east positive
+} EclipseInfo;
+
+// Circumstances of the eclipse at lunation k, if any (returns 1 for an eclipse)
+int eclipse_evaluate(double lunation, EclipseInfo* info);
+
+// Next eclipse of the given kind after julian_day
+CalendarResult eclipse_find_next(EclipseKind kind, double julian_day, EclipseInfo* info);
+
+// All solar and lunar eclipses in [start_jd, end_jd], in time order
+AstronomicalEvent* eclipse_generate_catalog(double start_jd, double end_jd, int* count);
+void eclipse_destroy_catalog(AstronomicalEvent* events);
+
+void eclipse_to_astronomical_event(const EclipseInfo* info, AstronomicalEvent* event);
+const char* eclipse_type_name(EclipseType type);
+
+#endif // ECLIPSE_H
@@ -0,0 +1,273 @@
+// src/astronomy/ephemeris.c
+#include "ephemeris.h"
+#include "lunar_calc.h"
+#include "solar_calc.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Mean longitude models removed before fitting (degrees at J2000.0, degrees/day),
+// which leaves small residuals that float32 coefficients store without loss.
+#define EPHEMERIS_SUN_L0 280.46646
+#define EPHEMERIS_SUN_RATE (36000.76983 / 36525.0)
+#define EPHEMERIS_MOON_L0 218.3164477
+#define EPHEMERIS_MOON_RATE (481267.88123421 / 36525.0)
+#define EPHEMERIS_MOON_MEAN_DISTANCE 385000.56
+#define EPHEMERIS_SUN_MEAN_DISTANCE 1.0
+
+void ephemeris_series_position(EphemerisBody body, double julian_day, EphemerisPosition* position) {
+    if (!position) return;
+    
+    if (body == EPHEMERIS_BODY_SUN) {
+        position->longitude = solar_calculate_longitude(julian_day);
+        position->latitude = 0.0;
+        position->distance = solar_calculate_distance(julian_day);
+    } else {
+        LunarPosition moon;
+        lunar_calculate_position(julian_day, &moon);
+        position->longitude = moon.longitude;
+        position->latitude = moon.latitude;
+        position->distance = moon.distance_km;
+    }
+}
+
+// Longitude minus the linear model, wrapped to [-180, 180)
+static double ephemeris_longitude_residual(const EphemerisBodyHeader* bh, double julian_day,
+                                           double longitude) {
+    double model = bh->longitude_at_epoch + bh->longitude_rate * (julian_day - 2451545.0);
+    double r = fmod(longitude - model, 360.0);
+    if (r < -180.0) r += 360.0;
+    if (r >= 180.0) r -= 360.0;
+    return r;
+}
+
+static void ephemeris_init_body_header(EphemerisBodyHeader* bh, EphemerisBody body,
+                                       double start_jd, double end_jd) {
+    memset(bh, 0, sizeof(*bh));
+    bh->body = body;
+    if (body == EPHEMERIS_BODY_SUN) {
+        bh->components = 2;
+        bh->coefficients = EPHEMERIS_SUN_COEFFICIENTS;
+        bh->segment_days = EPHEMERIS_SUN_SEGMENT_DAYS;
+        bh->longitude_at_epoch = EPHEMERIS_SUN_L0;
+        bh->longitude_rate = EPHEMERIS_SUN_RATE;
+        bh->distance_offset = EPHEMERIS_SUN_MEAN_DISTANCE;
+    } else {
+        bh->components = 3;
+        bh->coefficients = EPHEMERIS_MOON_COEFFICIENTS;
+        bh->segment_days = EPHEMERIS_MOON_SEGMENT_DAYS;
+        bh->longitude_at_epoch = EPHEMERIS_MOON_L0;
+        bh->longitude_rate = EPHEMERIS_MOON_RATE;
+        bh->distance_offset = EPHEMERIS_MOON_MEAN_DISTANCE;
+    }
+    bh->segment_count = (uint32_t)ceil((end_jd - start_jd) / bh->segment_days);
+}
+
+// Fit one segment: sample the series at the Chebyshev nodes and project onto
+// T_0..T_{n-1} with the discrete cosine transform.
+static void ephemeris_fit_segment(const EphemerisBodyHeader* bh, double segment_start, float* out) {
+    int n = (int)bh->coefficients;
+    double jds[EPHEMERIS_MAX_COEFFICIENTS];
+    double values[EPHEMERIS_MAX_COMPONENTS][EPHEMERIS_MAX_COEFFICIENTS];
+    
+    for (int k = 0; k < n; k++) {
+        double x = cos(M_PI * (k + 0.5) / n);
+        jds[k] = segment_start + bh->segment_days * (x + 1.0) / 2.0;
+    }
+    
+    if (bh->body == EPHEMERIS_BODY_MOON) {
+        LunarPosition moon[EPHEMERIS_MAX_COEFFICIENTS];
+        lunar_calculate_position_batch(jds, n, moon);
+        for (int k = 0; k < n; k++) {
+            values[0][k] = ephemeris_longitude_residual(bh, jds[k], moon[k].longitude);
+            values[1][k] = moon[k].latitude;
+            values[2][k] = moon[k].distance_km - bh->distance_offset;
+        }
+    } else {
+        for (int k = 0; k < n; k++) {
+            EphemerisPosition sun;
+            ephemeris_series_position(EPHEMERIS_BODY_SUN, jds[k], &sun);
+            values[0][k] = ephemeris_longitude_residual(bh, jds[k], sun.longitude);
+            values[1][k] = sun.distance - bh->distance_offset;
+        }
+    }
+    
+    for (uint32_t c = 0; c < bh->components; c++) {
+        for (int j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < n; k++) {
+                sum += values[c][k] * cos(M_PI * j * (k + 0.5) / n);
+            }
+            double coeff = 2.0 * sum / n;
+            if (j == 0) coeff /= 2.0;
+            out[c * n + j] = (float)coeff;
+        }
+    }
+}
+
+CalendarResult ephemeris_build_file(const char* filename, double start_jd, double end_jd) {
+    if (!filename) return CALENDAR_ERROR_NULL_POINTER;
+    if (end_jd <= start_jd) return CALENDAR_ERROR_INVALID_DATE;
+    
+    EphemerisFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EPHEMERIS_MAGIC, sizeof(EPHEMERIS_MAGIC));
+    header.version = EPHEMERIS_FORMAT_VERSION;
+    header.body_count = EPHEMERIS_BODY_COUNT;
+    header.start_jd = start_jd;
+    header.end_jd = end_jd;
+    
+    uint64_t offset = sizeof(header);
+    for (int b = 0; b < EPHEMERIS_BODY_COUNT; b++) {
+        EphemerisBodyHeader* bh = &header.bodies[b];
+        ephemeris_init_body_header(bh, (EphemerisBody)b, start_jd, end_jd);
+        bh->data_offset = offset;
+        offset += (uint64_t)bh->segment_count * bh->components * bh->coefficients * sizeof(float);
+        offset = (offset + 7) & ~(uint64_t)7;
+    }
+    
+    FILE* file = fopen(filename, "wb");
+    if (!file) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    CalendarResult result = CALENDAR_SUCCESS;
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        result = CALENDAR_ERROR_CONVERSION_FAILED;
+    }
+    
+    float segment[EPHEMERIS_MAX_COMPONENTS * EPHEMERIS_MAX_COEFFICIENTS];
+    for (int b = 0; b < EPHEMERIS_BODY_COUNT && result == CALENDAR_SUCCESS; b++) {
+        const EphemerisBodyHeader* bh = &header.bodies[b];
+        size_t floats = bh->components * bh->coefficients;
+        
+        // Pad up to the aligned block start
+        static const char zeros[8] = {0};
+        long pos = ftell(file);
+        if (pos < 0 || (uint64_t)pos > bh->data_offset ||
+            fwrite(zeros, 1, bh->data_offset - (uint64_t)pos, file) != bh->data_offset - (uint64_t)pos) {
+            result = CALENDAR_ERROR_CONVERSION_FAILED;
+            break;
+        }
+        
+        for (uint32_t s = 0; s < bh->segment_count; s++) {
+            ephemeris_fit_segment(bh, start_jd + s * bh->segment_days, segment);
+            if (fwrite(segment, sizeof(float), floats, file) != floats) {
+                result = CALENDAR_ERROR_CONVERSION_FAILED;
+                break;
+            }
+        }
+    }
+    
+    if (fclose(file) != 0) result = CALENDAR_ERROR_CONVERSION_FAILED;
+    return result;
+}
+
+Ephemeris* ephemeris_open(const char* filename) {
+    if (!filename) return NULL;
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(EphemerisFileHeader)) {
+        close(fd);
+        return NULL;
+    }
+    
+    void* mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+    
+    const EphemerisFileHeader* header = (const EphemerisFileHeader*)mapping;
+    int valid = memcmp(header->magic, EPHEMERIS_MAGIC, sizeof(EPHEMERIS_MAGIC)) == 0 &&
+                header->version == EPHEMERIS_FORMAT_VERSION &&
+                header->body_count == EPHEMERIS_BODY_COUNT;
+    
+    for (int b = 0; valid && b < EPHEMERIS_BODY_COUNT; b++) {
+        const EphemerisBodyHeader* bh = &header->bodies[b];
+        uint64_t bytes = (uint64_t)bh->segment_count * bh->components * bh->coefficients * sizeof(float);
+        valid = bh->components >= 1 && bh->components <= EPHEMERIS_MAX_COMPONENTS &&
+                bh->coefficients >= 1 && bh->coefficients <= EPHEMERIS_MAX_COEFFICIENTS &&
+                bh->segment_count >= 1 &&
+                bh->segment_days > 0.0 &&
+                bh->data_offset + bytes <= (uint64_t)st.st_size;
+    }
+    
+    Ephemeris* eph = valid ? malloc(sizeof(Ephemeris)) : NULL;
+    if (!eph) {
+        munmap(mapping, (size_t)st.st_size);
+        return NULL;
+    }
+    
+    eph->header = header;
+    eph->mapping = mapping;
+    eph->mapping_size = (size_t)st.st_size;
+    for (int b = 0; b < EPHEMERIS_BODY_COUNT; b++) {
+        eph->data[b] = (const float*)((const char*)mapping + header->bodies[b].data_offset);
+    }
+    
+    return eph;
+}
+
+void ephemeris_close(Ephemeris* eph) {
+    if (eph) {
+        munmap(eph->mapping, eph->mapping_size);
+        free(eph);
+    }
+}
+
+// Clenshaw recurrence for sum c_j T_j(x), run for all components of a segment
+// at once so the independent recurrences overlap in the pipeline.
+static void ephemeris_clenshaw(const float* c, int n, int components, double x, double* out) {
+    double b1[EPHEMERIS_MAX_COMPONENTS] = {0.0, 0.0, 0.0};
+    double b2[EPHEMERIS_MAX_COMPONENTS] = {0.0, 0.0, 0.0};
+    double two_x = 2.0 * x;
+    for (int j = n - 1; j >= 1; j--) {
+        for (int k = 0; k < components; k++) {
+            double b0 = c[k * n + j] + two_x * b1[k] - b2[k];
+            b2[k] = b1[k];
+            b1[k] = b0;
+        }
+    }
+    for (int k = 0; k < components; k++) {
+        out[k] = c[k * n] + x * b1[k] - b2[k];
+    }
+}
+
+CalendarResult ephemeris_evaluate(const Ephemeris* eph, EphemerisBody body,
+                                  double julian_day, EphemerisPosition* position) {
+    if (!eph || !position) return CALENDAR_ERROR_NULL_POINTER;
+    if (body < 0 || body >= EPHEMERIS_BODY_COUNT) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    const EphemerisFileHeader* header = eph->header;
+    if (julian_day < header->start_jd || julian_day > header->end_jd) {
+        return CALENDAR_ERROR_INVALID_DATE;
+    }
+    
+    // Pick the segment by index, then map the instant onto [-1, 1]
+    const EphemerisBodyHeader* bh = &header->bodies[body];
+    double offset = (julian_day - header->start_jd) / bh->segment_days;
+    uint32_t index = (uint32_t)offset;
+    if (index >= bh->segment_count) index = bh->segment_count - 1;
+    double x = 2.0 * (offset - index) - 1.0;
+    
+    int n = (int)bh->coefficients;
+    const float* c = eph->data[body] + (size_t)index * bh->components * n;
+    
+    double values[EPHEMERIS_MAX_COMPONENTS];
+    ephemeris_clenshaw(c, n, (int)bh->components, x, values);
+    
+    double longitude = bh->longitude_at_epoch + bh->longitude_rate * (julian_day - 2451545.0) +
+                       values[0];
+    position->longitude = longitude - 360.0 * floor(longitude / 360.0);
+    
+    if (bh->components == 3) {
+        position->latitude = values[1];
+        position->distance = bh->distance_offset + values[2];
+    } else {
+        position->latitude = 0.0;
+        position->distance = bh->distance_offset + values[1];
+    }
+    
+    return CALENDAR_SUCCESS;
+}
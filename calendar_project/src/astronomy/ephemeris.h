@@ -0,0 +1,76 @@
+// src/astronomy/ephemeris.h
+#ifndef EPHEMERIS_H
+#define EPHEMERIS_H
+
+#include "../../include/calendar_types.h"
+#include <stdint.h>
+
+// Chebyshev-compressed sun/moon ephemeris (JPL DE style piecewise fits)
+#define EPHEMERIS_MAGIC "CALEPHM"
+#define EPHEMERIS_FORMAT_VERSION 1
+#define EPHEMERIS_MAX_COMPONENTS 3
+#define EPHEMERIS_MAX_COEFFICIENTS 32
+
+// Default fit layout: segment length in days and coefficients per component
+#define EPHEMERIS_SUN_SEGMENT_DAYS 32.0
+#define EPHEMERIS_SUN_COEFFICIENTS 8
+#define EPHEMERIS_MOON_SEGMENT_DAYS 16.0
+#define EPHEMERIS_MOON_COEFFICIENTS 16
+
+typedef enum {
+    EPHEMERIS_BODY_SUN,
+    EPHEMERIS_BODY_MOON,
+    EPHEMERIS_BODY_COUNT
+} EphemerisBody;
+
+// Position returned by the evaluator
+typedef struct {
+    double longitude;           // Ecliptic longitude in degrees (0-360)
+    double latitude;            // Ecliptic latitude in degrees
+    double distance;            // AU for the sun, kilometers for the moon
+} EphemerisPosition;
+
+// Per-body table description, stored in the file header
+typedef struct {
+    uint32_t body;              // EphemerisBody
+    uint32_t components;        // 2 = longitude, distance; 3 = longitude, latitude, distance
+    uint32_t coefficients;      // Chebyshev coefficients per component
+    uint32_t segment_count;
+    double segment_days;
+    double longitude_at_epoch;  // Linear longitude model removed before fitting
+    double longitude_rate;      // degrees per day
+    double distance_offset;     // Removed from distance before fitting
+    uint64_t data_offset;       // Byte offset of the float32 coefficient block
+} EphemerisBodyHeader;
+
+// Versioned file header; coefficient blocks follow it
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t body_count;
+    double start_jd;
+    double end_jd;
+    EphemerisBodyHeader bodies[EPHEMERIS_BODY_COUNT];
+} EphemerisFileHeader;
+
+// Memory-mapped ephemeris handle
+typedef struct {
+    const EphemerisFileHeader* header;
+    const float* data[EPHEMERIS_BODY_COUNT];
+    void* mapping;
+    size_t mapping_size;
+} Ephemeris;
+
+// Building ephemeris files from the analytical series
+CalendarResult ephemeris_build_file(const char* filename, double start_jd, double end_jd);
+
+// Loading and evaluation
+Ephemeris* ephemeris_open(const char* filename);
+void ephemeris_close(Ephemeris* eph);
+CalendarResult ephemeris_evaluate(const Ephemeris* eph, EphemerisBody body,
+                                  double julian_day, EphemerisPosition* position);
+
+// Reference values from the analytical series the file was fitted to
+void ephemeris_series_position(EphemerisBody body, double julian_day, EphemerisPosition* position);
+
+#endif // EPHEMERIS_H
@@ -0,0 +1,406 @@
+// src/astronomy/event_catalog.c
+#include "event_catalog.h"
+#include "eclipse.h"
+#include "lunar_apsides.h"
+#include "lunar_calc.h"
+#include "planetary_calc.h"
+#include "solar_calc.h"
+#include "time_scale.h"
+#include "../utils/date_utils.h"
+#include "../utils/string_pool.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Growable event list for one chunk
+typedef struct {
+    AstronomicalEvent* events;
+    int count;
+    int capacity;
+    int failed;
+} EventCatalogList;
+
+static AstronomicalEvent* event_catalog_append(EventCatalogList* list) {
+    if (list->failed) return NULL;
+    if (list->count >= list->capacity) {
+        int grown = list->capacity ? list->capacity * 2 : 256;
+        AstronomicalEvent* larger = realloc(list->events, sizeof(AstronomicalEvent) * grown);
+        if (!larger) {
+            list->failed = 1;
+            return NULL;
+        }
+        list->events = larger;
+        list->capacity = grown;
+    }
+    AstronomicalEvent* event = &list->events[list->count++];
+    memset(event, 0, sizeof(*event));
+    return event;
+}
+
+// Copies the events that fall in [start_jd, end_jd) and frees the source
+static void event_catalog_merge(EventCatalogList* list, AstronomicalEvent* events, int count,
+                                double start_jd, double end_jd) {
+    if (!events) {
+        list->failed = 1;
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        if (events[i].julian_day < start_jd || events[i].julian_day >= end_jd) continue;
+        AstronomicalEvent* event = event_catalog_append(list);
+        if (!event) break;
+        *event = events[i];
+    }
+    free(events);
+}
+
+// "YYYY-MM-DD HH:MM" of a UT instant
+static void event_catalog_format_ut(double julian_day, char* buffer, size_t size) {
+    long jdn = (long)floor(julian_day + 0.5);
+    int minutes = (int)floor((julian_day + 0.5 - jdn) * 1440.0);
+    int day, month, year;
+    julian_day_to_date(jdn, &day, &month, &year);
+    snprintf(buffer, size, "%04d-%02d-%02d %02d:%02d", year, month, day, minutes / 60, minutes % 60);
+}
+
+static void event_catalog_add_instant(EventCatalogList* list, AstronomicalEventType type, const char* name,
+                                      double julian_day_ut, const char* detail) {
+    AstronomicalEvent* event = event_catalog_append(list);
+    if (!event) return;
+    
+    char when[32];
+    event_catalog_format_ut(julian_day_ut, when, sizeof(when));
+    event->type = type;
+    event->julian_day = time_ut_to_tt(julian_day_ut);
+    snprintf(event->name, sizeof(event->name), "%s", name);
+    snprintf(event->description, sizeof(event->description), "%s UT, %s", when, detail);
+    event->visibility_global = 1;
+}
+
+static void event_catalog_add_phases(EventCatalogList* list, double start_jd, double end_jd) {
+    static const AstronomicalEventType types[4] = {
+        ASTRO_EVENT_NEW_MOON, ASTRO_EVENT_FIRST_QUARTER, ASTRO_EVENT_FULL_MOON, ASTRO_EVENT_LAST_QUARTER
+    };
+    static const char* names[4] = { "New Moon", "First Quarter", "Full Moon", "Last Quarter" };
+    static const char* details[4] = {
+        "elongation 0 degrees", "elongation 90 degrees", "elongation 180 degrees", "elongation 270 degrees"
+    };
+    
+    // Each phase recurs every 29.5 days, so one day past a find is safely past it
+    double start_ut = time_tt_to_ut(start_jd);
+    for (int p = 0; p < 4; p++) {
+        double cursor = start_ut;
+        for (;;) {
+            double ut = lunar_find_next_phase(cursor, p * 90.0);
+            if (ut == 0.0 || time_ut_to_tt(ut) >= end_jd) break;
+            event_catalog_add_instant(list, types[p], names[p], ut, details[p]);
+            cursor = ut + 1.0;
+        }
+    }
+}
+
+static void event_catalog_add_seasons(EventCatalogList* list, int first_year, int last_year) {
+    for (int year = first_year; year <= last_year; year++) {
+        event_catalog_add_instant(list, ASTRO_EVENT_EQUINOX_SPRING, "Vernal Equinox",
+                                  solar_calculate_equinox(year, 0), "solar longitude 0 degrees");
+        event_catalog_add_instant(list, ASTRO_EVENT_SOLSTICE_SUMMER, "Summer Solstice",
+                                  solar_calculate_solstice(year, 0), "solar longitude 90 degrees");
+        event_catalog_add_instant(list, ASTRO_EVENT_EQUINOX_AUTUMN, "Autumnal Equinox",
+                                  solar_calculate_equinox(year, 1), "solar longitude 180 degrees");
+        event_catalog_add_instant(list, ASTRO_EVENT_SOLSTICE_WINTER, "Winter Solstice",
+                                  solar_calculate_solstice(year, 1), "solar longitude 270 degrees");
+    }
+}
+
+static void event_catalog_add_full_moons(EventCatalogList* list, int first_year, int last_year,
+                                         unsigned int kinds, double start_jd, double end_jd) {
+    int count = 0;
+    AstronomicalEvent* events = lunar_apsides_generate_catalog(first_year, last_year,
+                                                               (kinds & EVENT_CATALOG_APSIDES) != 0, &count);
+    if (!events) {
+        list->failed = 1;
+        return;
+    }
+    
+    // Drop the full moon flags when only the apsides were asked for
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        int is_apsis = events[i].type == ASTRO_EVENT_LUNAR_PERIGEE || events[i].type == ASTRO_EVENT_LUNAR_APOGEE;
+        if (is_apsis || (kinds & EVENT_CATALOG_FULL_MOONS)) events[kept++] = events[i];
+    }
+    event_catalog_merge(list, events, kept, start_jd, end_jd);
+}
+
+static int event_catalog_compare(const void* a, const void* b) {
+    double ja = ((const AstronomicalEvent*)a)->julian_day;
+    double jb = ((const AstronomicalEvent*)b)->julian_day;
+    return (ja > jb) - (ja < jb);
+}
+
+// Start of a calendar year (0h UT) in TT
+static double event_catalog_year_start(int year) {
+    return time_ut_to_tt(julian_day_from_date(1, 1, year) - 0.5);
+}
+
+static void event_catalog_generate_chunk(EventCatalogList* list, int first_year, int last_year, unsigned int kinds) {
+    double start_jd = event_catalog_year_start(first_year);
+    double end_jd = event_catalog_year_start(last_year + 1);
+    
+    if (kinds & EVENT_CATALOG_PHASES) event_catalog_add_phases(list, start_jd, end_jd);
+    if (kinds & EVENT_CATALOG_SEASONS) event_catalog_add_seasons(list, first_year, last_year);
+    if (kinds & EVENT_CATALOG_ECLIPSES) {
+        int count = 0;
+        AstronomicalEvent* events = eclipse_generate_catalog(start_jd, end_jd, &count);
+        event_catalog_merge(list, events, count, start_jd, end_jd);
+    }
+    if (kinds & (EVENT_CATALOG_FULL_MOONS | EVENT_CATALOG_APSIDES)) {
+        event_catalog_add_full_moons(list, first_year, last_year, kinds, start_jd, end_jd);
+    }
+    if (kinds & EVENT_CATALOG_PLANETS) {
+        double from = fmax(start_jd, PLANETARY_VALID_FROM_JD);
+        double to = fmin(end_jd, PLANETARY_VALID_TO_JD);
+        if (from < to) {
+            int count = 0;
+            AstronomicalEvent* events = planetary_generate_catalog(from, to, &count);
+            event_catalog_merge(list, events, count, from, to);
+        }
+    }
+    
+    if (!list->failed) qsort(list->events, list->count, sizeof(AstronomicalEvent), event_catalog_compare);
+}
+
+AstronomicalEvent* event_catalog_generate(int start_year, int end_year, unsigned int kinds, int* count) {
+    if (!count) return NULL;
+    *count = 0;
+    if (end_year < start_year) return NULL;
+    
+    int chunk_count = (end_year - start_year) / EVENT_CATALOG_CHUNK_YEARS + 1;
+    EventCatalogList* chunks = calloc(chunk_count, sizeof(EventCatalogList));
+    if (!chunks) return NULL;
+    
+    // Build the Delta-T table here rather than inside the first chunk
+    time_scale_init();
+    
+    // Chunks cover disjoint years, so each is sorted on its own and the
+    // concatenation in chunk order is sorted as a whole
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+    #endif
+    for (int c = 0; c < chunk_count; c++) {
+        int first_year = start_year + c * EVENT_CATALOG_CHUNK_YEARS;
+        int last_year = first_year + EVENT_CATALOG_CHUNK_YEARS - 1;
+        if (last_year > end_year) last_year = end_year;
+        event_catalog_generate_chunk(&chunks[c], first_year, last_year, kinds);
+    }
+    
+    int total = 0, failed = 0;
+    for (int c = 0; c < chunk_count; c++) {
+        total += chunks[c].count;
+        failed |= chunks[c].failed;
+    }
+    
+    AstronomicalEvent* events = failed ? NULL : malloc(sizeof(AstronomicalEvent) * (total + 1));
+    if (events) {
+        for (int c = 0; c < chunk_count; c++) {
+            if (chunks[c].count) memcpy(events + *count, chunks[c].events, sizeof(AstronomicalEvent) * chunks[c].count);
+            *count += chunks[c].count;
+        }
+    }
+    for (int c = 0; c < chunk_count; c++) free(chunks[c].events);
+    free(chunks);
+    return events;
+}
+
+CalendarResult event_catalog_write(const char* filename, const AstronomicalEvent* events, int count,
+                                   int start_year, int end_year, unsigned int kinds) {
+    if (!filename || (!events && count > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    if (count < 0 || end_year < start_year) return CALENDAR_ERROR_INVALID_DATE;
+    
+    // The string section is the pool's flat image
+    StringPool* pool = string_pool_create();
+    char* string_image = NULL;
+    EventCatalogRecord* records = malloc(sizeof(EventCatalogRecord) * (count + 1));
+    
+    CalendarResult result = pool && records ? CALENDAR_SUCCESS : CALENDAR_ERROR_CONVERSION_FAILED;
+    for (int i = 0; i < count && result == CALENDAR_SUCCESS; i++) {
+        const AstronomicalEvent* event = &events[i];
+        EventCatalogRecord* record = &records[i];
+        if (i > 0 && event->julian_day < events[i - 1].julian_day) {
+            result = CALENDAR_ERROR_INVALID_DATE;
+            break;
+        }
+        
+        memset(record, 0, sizeof(*record));
+        record->julian_day = event->julian_day;
+        record->magnitude = event->magnitude;
+        record->duration_hours = event->duration_hours;
+        record->latitude_center = event->latitude_center;
+        record->longitude_center = event->longitude_center;
+        record->type = (uint32_t)event->type;
+        record->visibility_global = (uint32_t)event->visibility_global;
+        record->name_offset = string_pool_offset(pool, string_pool_intern(pool, event->name));
+        record->description_offset = string_pool_offset(pool, string_pool_intern(pool, event->description));
+        if (record->name_offset == UINT32_MAX || record->description_offset == UINT32_MAX) {
+            result = CALENDAR_ERROR_CONVERSION_FAILED;
+        }
+    }
+    if (result == CALENDAR_SUCCESS) {
+        string_image = malloc(pool->bytes > 0 ? pool->bytes : 1);
+        if (string_image) string_pool_flatten(pool, string_image);
+        else result = CALENDAR_ERROR_CONVERSION_FAILED;
+    }
+    
+    EventCatalogFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EVENT_CATALOG_MAGIC, sizeof(EVENT_CATALOG_MAGIC));
+    header.version = EVENT_CATALOG_FORMAT_VERSION;
+    header.kinds = kinds;
+    header.start_year = start_year;
+    header.end_year = end_year;
+    header.record_count = (uint64_t)count;
+    header.record_offset = sizeof(header);
+    header.string_offset = header.record_offset + (uint64_t)count * sizeof(EventCatalogRecord);
+    header.string_bytes = pool ? pool->bytes : 0;
+    
+    FILE* file = result == CALENDAR_SUCCESS ? fopen(filename, "wb") : NULL;
+    if (result == CALENDAR_SUCCESS && !file) result = CALENDAR_ERROR_CONVERSION_FAILED;
+    if (file) {
+        if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+            fwrite(records, sizeof(EventCatalogRecord), count, file) != (size_t)count ||
+            fwrite(string_image, 1, pool->bytes, file) != pool->bytes) {
+            result = CALENDAR_ERROR_CONVERSION_FAILED;
+        }
+        if (fclose(file) != 0) result = CALENDAR_ERROR_CONVERSION_FAILED;
+    }
+    
+    free(records);
+    free(string_image);
+    string_pool_destroy(pool);
+    return result;
+}
+
+CalendarResult event_catalog_build_file(const char* filename, int start_year, int end_year, unsigned int kinds) {
+    if (!filename) return CALENDAR_ERROR_NULL_POINTER;
+    
+    int count = 0;
+    AstronomicalEvent* events = event_catalog_generate(start_year, end_year, kinds, &count);
+    if (!events) return end_year < start_year ? CALENDAR_ERROR_INVALID_DATE : CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    CalendarResult result = event_catalog_write(filename, events, count, start_year, end_year, kinds);
+    free(events);
+    return result;
+}
+
+EventCatalog* event_catalog_open(const char* filename) {
+    if (!filename) return NULL;
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(EventCatalogFileHeader)) {
+        close(fd);
+        return NULL;
+    }
+    
+    void* mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+    
+    const EventCatalogFileHeader* header = (const EventCatalogFileHeader*)mapping;
+    uint64_t size = (uint64_t)st.st_size;
+    int valid = memcmp(header->magic, EVENT_CATALOG_MAGIC, sizeof(EVENT_CATALOG_MAGIC)) == 0 &&
+                header->version == EVENT_CATALOG_FORMAT_VERSION &&
+                header->record_offset % sizeof(double) == 0 &&
+                header->record_count <= size / sizeof(EventCatalogRecord) &&
+                header->record_offset + header->record_count * sizeof(EventCatalogRecord) <= header->string_offset &&
+                header->string_offset <= size && header->string_bytes <= size - header->string_offset;
+    
+    // Every string reference must land inside the NUL-terminated pool
+    const EventCatalogRecord* records = valid ? (const EventCatalogRecord*)((const char*)mapping + header->record_offset) : NULL;
+    const char* strings = valid ? (const char*)mapping + header->string_offset : NULL;
+    if (valid && header->record_count > 0) {
+        valid = header->string_bytes > 0 && strings[header->string_bytes - 1] == '\0';
+    }
+    for (uint64_t i = 0; valid && i < header->record_count; i++) {
+        valid = records[i].name_offset < header->string_bytes &&
+                records[i].description_offset < header->string_bytes;
+    }
+    
+    EventCatalog* catalog = valid ? malloc(sizeof(EventCatalog)) : NULL;
+    if (!catalog) {
+        munmap(mapping, (size_t)st.st_size);
+        return NULL;
+    }
+    
+    catalog->header = header;
+    catalog->records = records;
+    catalog->strings = strings;
+    catalog->count = (size_t)header->record_count;
+    catalog->mapping = mapping;
+    catalog->mapping_size = (size_t)st.st_size;
+    return catalog;
+}
+
+EventCatalog* event_catalog_open_or_build(const char* filename, int start_year, int end_year, unsigned int kinds) {
+    EventCatalog* catalog = event_catalog_open(filename);
+    if (catalog) {
+        const EventCatalogFileHeader* header = catalog->header;
+        if (header->start_year <= start_year && header->end_year >= end_year && (kinds & ~header->kinds) == 0) {
+            return catalog;
+        }
+        event_catalog_close(catalog);
+    }
+    
+    if (event_catalog_build_file(filename, start_year, end_year, kinds) != CALENDAR_SUCCESS) return NULL;
+    return event_catalog_open(filename);
+}
+
+void event_catalog_close(EventCatalog* catalog) {
+    if (catalog) {
+        munmap(catalog->mapping, catalog->mapping_size);
+        free(catalog);
+    }
+}
+
+// First record at or after julian_day
+static size_t event_catalog_lower_bound(const EventCatalog* catalog, double julian_day) {
+    size_t low = 0, high = catalog->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (catalog->records[mid].julian_day < julian_day) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+CalendarResult event_catalog_query(const EventCatalog* catalog, double start_jd, double end_jd,
+                                   size_t* first, size_t* count) {
+    if (!catalog || !first || !count) return CALENDAR_ERROR_NULL_POINTER;
+    if (end_jd < start_jd) return CALENDAR_ERROR_INVALID_DATE;
+    
+    *first = event_catalog_lower_bound(catalog, start_jd);
+    *count = event_catalog_lower_bound(catalog, end_jd) - *first;
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult event_catalog_get(const EventCatalog* catalog, size_t index, AstronomicalEvent* event) {
+    if (!catalog || !event) return CALENDAR_ERROR_NULL_POINTER;
+    if (index >= catalog->count) return CALENDAR_ERROR_INVALID_DATE;
+    
+    const EventCatalogRecord* record = &catalog->records[index];
+    memset(event, 0, sizeof(*event));
+    event->type = (AstronomicalEventType)record->type;
+    event->julian_day = record->julian_day;
+    snprintf(event->name, sizeof(event->name), "%s", catalog->strings + record->name_offset);
+    snprintf(event->description, sizeof(event->description), "%s", catalog->strings + record->description_offset);
+    event->magnitude = record->magnitude;
+    event->duration_hours = record->duration_hours;
+    event->visibility_global = (int)record->visibility_global;
+    event->latitude_center = record->latitude_center;
+    event->longitude_center = record->longitude_center;
+    return CALENDAR_SUCCESS;
+}
@@ -0,0 +1,81 @@
+// src/astronomy/event_catalog.h
+#ifndef EVENT_CATALOG_H
+#define EVENT_CATALOG_H
+
+#include "../../include/calendar_types.h"
+#include "../../include/calendar_types_extended.h"
+#include <stdint.h>
+
+// Precomputed, time-sorted astronomical event file
+#define EVENT_CATALOG_MAGIC "CALEVTS"
+#define EVENT_CATALOG_FORMAT_VERSION 1
+#define EVENT_CATALOG_CHUNK_YEARS 5     // Years generated per parallel work item
+
+// Event families, combined as a bit mask
+#define EVENT_CATALOG_PHASES      0x01u // New moon, quarters, full moon
+#define EVENT_CATALOG_ECLIPSES    0x02u
+#define EVENT_CATALOG_SEASONS     0x04u // Equinoxes and solstices
+#define EVENT_CATALOG_FULL_MOONS  0x08u // Supermoons, micromoons, blue moons
+#define EVENT_CATALOG_APSIDES     0x10u // Every lunar perigee and apogee
+#define EVENT_CATALOG_PLANETS     0x20u // Conjunctions and oppositions, 1800-2050 only
+#define EVENT_CATALOG_ALL         0x3Fu
+
+// On-disk event; the strings live once each in the string pool
+typedef struct {
+    double julian_day;              // TT
+    double magnitude;
+    double duration_hours;
+    double latitude_center;
+    double longitude_center;
+    uint32_t type;                  // AstronomicalEventType
+    uint32_t visibility_global;
+    uint32_t name_offset;           // Byte offsets into the string pool
+    uint32_t description_offset;
+} EventCatalogRecord;
+
+// Versioned file header; the records follow it, then the string pool
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t kinds;                 // EVENT_CATALOG_* mask
+    int32_t start_year;
+    int32_t end_year;
+    uint64_t record_count;
+    uint64_t record_offset;
+    uint64_t string_offset;
+    uint64_t string_bytes;
+} EventCatalogFileHeader;
+
+// Memory-mapped catalog handle
+typedef struct {
+    const EventCatalogFileHeader* header;
+    const EventCatalogRecord* records;
+    const char* strings;
+    size_t count;
+    void* mapping;
+    size_t mapping_size;
+} EventCatalog;
+
+// Every selected event in the calendar years [start_year, end_year], computed
+// in parallel chunks and sorted by time; free() the result
+AstronomicalEvent* event_catalog_generate(int start_year, int end_year, unsigned int kinds, int* count);
+
+// Building catalog files
+CalendarResult event_catalog_write(const char* filename, const AstronomicalEvent* events, int count,
+                                   int start_year, int end_year, unsigned int kinds);
+CalendarResult event_catalog_build_file(const char* filename, int start_year, int end_year, unsigned int kinds);
+
+// Loading: open() maps an existing file; open_or_build() rebuilds it first
+// when it is missing or does not cover the years and kinds asked for
+EventCatalog* event_catalog_open(const char* filename);
+EventCatalog* event_catalog_open_or_build(const char* filename, int start_year, int end_year, unsigned int kinds);
+void event_catalog_close(EventCatalog* catalog);
+
+// Records with start_jd <= julian_day < end_jd (TT) are [*first, *first + *count)
+CalendarResult event_catalog_query(const EventCatalog* catalog, double start_jd, double end_jd,
+                                   size_t* first, size_t* count);
+
+// Record expanded back into an event
+CalendarResult event_catalog_get(const EventCatalog* catalog, size_t index, AstronomicalEvent* event);
+
+#endif // EVENT_CATALOG_H
@@ -0,0 +1,179 @@
+// src/astronomy/event_finder.c
+#include "event_finder.h"
+
+#define EVENT_MAX_BRENT_ITERATIONS 100
+#define EVENT_PREDICT_MARGIN 0.9  // Fraction of the +/-180 wrap a predicted bracket may span
+
+// Signed offset of the function from the target; angles wrap to [-180, 180)
+static double event_offset(const EventSearchSpec* spec, double julian_day, long* evaluations) {
+    double value = spec->function(julian_day, spec->context) - spec->target;
+    if (evaluations) (*evaluations)++;
+    
+    if (spec->kind == EVENT_VALUE_ANGLE) {
+        value = fmod(value, 360.0);
+        if (value < -180.0) value += 360.0;
+        if (value >= 180.0) value -= 360.0;
+    }
+    return value;
+}
+
+// A sign change is a crossing unless an angle jumped across the wrap point
+static int event_is_crossing(const EventSearchSpec* spec, double fa, double fb) {
+    if ((fa < 0.0) == (fb < 0.0)) return 0;
+    if (spec->kind == EVENT_VALUE_ANGLE && fabs(fb - fa) > 180.0) return 0;
+    return 1;
+}
+
+// Brent's method on a bracket [a, b] whose offsets have opposite signs
+static double event_brent(const EventSearchSpec* spec, double a, double b,
+                          double fa, double fb, long* evaluations) {
+    double c = a, fc = fa;
+    double d = b - a, e = d;
+    
+    for (int iter = 0; iter < EVENT_MAX_BRENT_ITERATIONS; iter++) {
+        if ((fb > 0.0) == (fc > 0.0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (fabs(fc) < fabs(fb)) {
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+        
+        double tol = 0.5 * spec->tolerance_days;
+        double m = 0.5 * (c - b);
+        if (fabs(m) <= tol || fb == 0.0) return b;
+        
+        if (fabs(e) >= tol && fabs(fa) > fabs(fb)) {
+            // Secant or inverse quadratic interpolation
+            double s = fb / fa, p, q;
+            if (a == c) {
+                p = 2.0 * m * s;
+                q = 1.0 - s;
+            } else {
+                double r = fb / fc;
+                q = fa / fc;
+                p = s * (2.0 * m * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) q = -q; else p = -p;
+            
+            if (2.0 * p < fmin(3.0 * m * q - fabs(tol * q), fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = m;
+            }
+        } else {
+            // Fall back to bisection
+            d = m;
+            e = m;
+        }
+        
+        a = b;
+        fa = fb;
+        b += fabs(d) > tol ? d : (m > 0.0 ? tol : -tol);
+        fb = event_offset(spec, b, evaluations);
+    }
+    
+    return b;
+}
+
+double event_refine_root(const EventSearchSpec* spec, double a, double b, long* evaluations) {
+    if (!spec || !spec->function) return a;
+    
+    double fa = event_offset(spec, a, evaluations);
+    double fb = event_offset(spec, b, evaluations);
+    if (!event_is_crossing(spec, fa, fb)) {
+        return fabs(fa) < fabs(fb) ? a : b;
+    }
+    return event_brent(spec, a, b, fa, fb, evaluations);
+}
+
+void event_search_init(EventSearch* search, const EventSearchSpec* spec,
+                       double start_jd, double end_jd) {
+    if (!search || !spec) return;
+    
+    search->spec = *spec;
+    search->cursor_jd = start_jd;
+    search->end_jd = end_jd;
+    search->evaluations = 0;
+    search->cursor_value = event_offset(&search->spec, start_jd, &search->evaluations);
+}
+
+// Next bracket end. Increasing angles with rate bounds jump by the remaining
+// angular distance, so a search costs evaluations per event rather than per
+// step; everything else advances by the fixed step.
+static double event_next_probe(EventSearch* search) {
+    const EventSearchSpec* spec = &search->spec;
+    
+    if (spec->kind == EVENT_VALUE_ANGLE && spec->min_rate > 0.0 && spec->max_rate >= spec->min_rate) {
+        double distance = -search->cursor_value;
+        if (distance <= 0.0) distance += 360.0;
+        
+        // At the fastest rate the bracket overshoots by max/min; keep its span below 180
+        double max_distance = EVENT_PREDICT_MARGIN * 180.0 * spec->min_rate / spec->max_rate;
+        
+        // Far from the target: advance by a distance the angle cannot cover yet
+        while (distance > max_distance && search->cursor_jd < search->end_jd) {
+            search->cursor_jd += (distance - max_distance / 2.0) / spec->max_rate;
+            if (search->cursor_jd > search->end_jd) search->cursor_jd = search->end_jd;
+            search->cursor_value = event_offset(spec, search->cursor_jd, &search->evaluations);
+            distance = -search->cursor_value;
+            if (distance <= 0.0) distance += 360.0;
+        }
+        
+        // The slowest possible motion still passes the target by this instant
+        return search->cursor_jd + distance / spec->min_rate + spec->tolerance_days;
+    }
+    
+    return search->cursor_jd + spec->step_days;
+}
+
+int event_search_next(EventSearch* search, EventCrossing* crossing) {
+    if (!search || !crossing || !search->spec.function) return 0;
+    if (search->spec.step_days <= 0.0 && search->spec.min_rate <= 0.0) return 0;
+    
+    const EventSearchSpec* spec = &search->spec;
+    
+    while (search->cursor_jd < search->end_jd) {
+        double b = event_next_probe(search);
+        
+        // The probe may have advanced the cursor
+        double a = search->cursor_jd;
+        double fa = search->cursor_value;
+        if (a >= search->end_jd) break;
+        if (b > search->end_jd) b = search->end_jd;
+        
+        double fb = event_offset(spec, b, &search->evaluations);
+        
+        search->cursor_jd = b;
+        search->cursor_value = fb;
+        
+        if (event_is_crossing(spec, fa, fb)) {
+            crossing->julian_day = event_brent(spec, a, b, fa, fb, &search->evaluations);
+            crossing->direction = fb > fa ? 1 : -1;
+            
+            // Resume just after the root so the same crossing is not reported twice
+            double resume = crossing->julian_day + spec->tolerance_days;
+            if (resume > search->cursor_jd) {
+                search->cursor_jd = resume;
+                search->cursor_value = event_offset(spec, resume, &search->evaluations);
+            }
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+CalendarResult event_find_next(const EventSearchSpec* spec, double start_jd, double end_jd,
+                               EventCrossing* crossing) {
+    if (!spec || !crossing) return CALENDAR_ERROR_NULL_POINTER;
+    
+    EventSearch search;
+    event_search_init(&search, spec, start_jd, end_jd);
+    return event_search_next(&search, crossing) ? CALENDAR_SUCCESS : CALENDAR_ERROR_CONVERSION_FAILED;
+}
@@ -0,0 +1,53 @@
+// src/astronomy/event_finder.h
+#ifndef EVENT_FINDER_H
+#define EVENT_FINDER_H
+
+#include "../../include/calendar_types.h"
+
+// Quantity whose crossings of a target value are searched for
+typedef double (*EventFunction)(double julian_day, void* context);
+
+// How function values are compared with the target
+typedef enum {
+    EVENT_VALUE_SCALAR,         // Plain real-valued function
+    EVENT_VALUE_ANGLE           // Angle in degrees, compared modulo 360
+} EventValueKind;
+
+// Search description
+typedef struct {
+    EventFunction function;
+    void* context;
+    EventValueKind kind;
+    double target;              // Value whose crossings are reported
+    double step_days;           // Coarse bracketing step; must be below the spacing of events
+    double tolerance_days;      // Refinement tolerance
+    double min_rate;            // Increasing angles only: rate bounds in degrees/day that let
+    double max_rate;            // the search jump straight to the next crossing (0 = fixed steps)
+} EventSearchSpec;
+
+// Crossing found by the search
+typedef struct {
+    double julian_day;
+    int direction;              // +1 crossing upwards, -1 crossing downwards
+} EventCrossing;
+
+// Streaming search state
+typedef struct {
+    EventSearchSpec spec;
+    double cursor_jd;
+    double cursor_value;        // Signed offset from the target at cursor_jd
+    double end_jd;
+    long evaluations;           // Function evaluations performed so far
+} EventSearch;
+
+// Streaming enumeration of all crossings in [start_jd, end_jd]
+void event_search_init(EventSearch* search, const EventSearchSpec* spec,
+                       double start_jd, double end_jd);
+int event_search_next(EventSearch* search, EventCrossing* crossing);
+
+// Convenience wrappers
+CalendarResult event_find_next(const EventSearchSpec* spec, double start_jd, double end_jd,
+                               EventCrossing* crossing);
+double event_refine_root(const EventSearchSpec* spec, double a, double b, long* evaluations);
+
+#endif // EVENT_FINDER_H
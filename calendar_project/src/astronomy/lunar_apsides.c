@@ -0,0 +1,384 @@
+// src/astronomy/lunar_apsides.c
+#include "lunar_apsides.h"
+#include "lunar_calc.h"
+#include "solar_calc.h"
+#include "time_scale.h"
+#include "../utils/date_utils.h"
+
+#define APSIDES_DEG_TO_RAD (M_PI / 180.0)
+#define APSIDES_ARCSEC_TO_RAD (M_PI / 648000.0)
+#define APSIDES_EARTH_RADIUS_KM 6378.14
+#define APSIDES_EPOCH_JDE 2451534.6698      // Perigee of 1999 December 22, k = 0
+#define APSIDES_ANOMALISTIC_MONTH 27.55454989
+#define APSIDES_PHASE_EPOCH_JDE 2451550.09766   // New moon of 2000 January 6
+#define APSIDES_SYNODIC_MONTH 29.530588861
+#define APSIDES_MEAN_DISTANCE_KM 385000.56
+#define APSIDES_SEASON_PAD_DAYS 100.0       // Covers the season that straddles each end of the range
+
+// Periodic term: coefficient * (sin or cos)(d*D + m*M + f*F), coefficient + per_t * T
+typedef struct {
+    signed char d, m, f;
+    double coefficient;
+    double per_t;
+} ApsisTerm;
+
+// Table 50.A, perigee time corrections (days)
+static const ApsisTerm apsides_perigee_time[] = {
+    { 2, 0, 0, -1.6769, 0.0 },      { 4, 0, 0, 0.4589, 0.0 },       { 6, 0, 0, -0.1856, 0.0 },
+    { 8, 0, 0, 0.0883, 0.0 },       { 2, -1, 0, -0.0773, 0.00019 }, { 0, 1, 0, 0.0502, -0.00013 },
+    { 10, 0, 0, -0.0460, 0.0 },     { 4, -1, 0, 0.0422, -0.00011 }, { 6, -1, 0, -0.0256, 0.0 },
+    { 12, 0, 0, 0.0253, 0.0 },      { 1, 0, 0, 0.0237, 0.0 },       { 8, -1, 0, 0.0162, 0.0 },
+    { 14, 0, 0, -0.0145, 0.0 },     { 0, 0, 2, 0.0129, 0.0 },       { 3, 0, 0, -0.0112, 0.0 },
+    { 10, -1, 0, -0.0104, 0.0 },    { 16, 0, 0, 0.0086, 0.0 },      { 12, -1, 0, 0.0069, 0.0 },
+    { 5, 0, 0, 0.0066, 0.0 },       { 2, 0, 2, -0.0053, 0.0 },      { 18, 0, 0, -0.0052, 0.0 },
+    { 14, -1, 0, -0.0046, 0.0 },    { 7, 0, 0, -0.0041, 0.0 },      { 2, 1, 0, 0.0040, 0.0 },
+    { 20, 0, 0, 0.0032, 0.0 },      { 1, 1, 0, -0.0032, 0.0 },      { 16, -1, 0, 0.0031, 0.0 },
+    { 4, 1, 0, -0.0029, 0.0 },      { 9, 0, 0, 0.0027, 0.0 },       { 4, 0, 2, 0.0027, 0.0 },
+    { 2, -2, 0, -0.0027, 0.0 },     { 4, -2, 0, 0.0024, 0.0 },      { 6, -2, 0, -0.0021, 0.0 },
+    { 22, 0, 0, -0.0021, 0.0 },     { 18, -1, 0, -0.0021, 0.0 },    { 6, 1, 0, 0.0019, 0.0 },
+    { 11, 0, 0, -0.0018, 0.0 },     { 8, 1, 0, -0.0014, 0.0 },      { 4, 0, -2, -0.0014, 0.0 },
+    { 6, 0, 2, -0.0014, 0.0 },      { 3, 1, 0, 0.0014, 0.0 },       { 5, 1, 0, -0.0014, 0.0 },
+    { 13, 0, 0, 0.0013, 0.0 },      { 20, -1, 0, 0.0013, 0.0 },     { 3, 2, 0, 0.0011, 0.0 },
+    { 4, -2, 2, -0.0011, 0.0 },     { 1, 2, 0, -0.0010, 0.0 },      { 22, -1, 0, -0.0009, 0.0 },
+    { 0, 0, 4, -0.0008, 0.0 },      { 6, 0, -2, 0.0008, 0.0 },      { 2, 1, -2, 0.0008, 0.0 },
+    { 0, 2, 0, 0.0007, 0.0 },       { 0, -1, 2, 0.0007, 0.0 },      { 2, 0, 4, 0.0007, 0.0 },
+    { 0, -2, 2, -0.0006, 0.0 },     { 2, 2, -2, -0.0006, 0.0 },     { 24, 0, 0, 0.0006, 0.0 },
+    { 4, 0, -4, 0.0005, 0.0 },      { 2, 2, 0, 0.0005, 0.0 },       { 1, -1, 0, -0.0004, 0.0 }
+};
+
+// Table 50.A, apogee time corrections (days)
+static const ApsisTerm apsides_apogee_time[] = {
+    { 2, 0, 0, 0.4392, 0.0 },       { 4, 0, 0, 0.0684, 0.0 },       { 0, 1, 0, 0.0456, -0.00011 },
+    { 2, -1, 0, 0.0426, -0.00011 }, { 0, 0, 2, 0.0212, 0.0 },       { 1, 0, 0, -0.0189, 0.0 },
+    { 6, 0, 0, 0.0144, 0.0 },       { 4, -1, 0, 0.0113, 0.0 },      { 2, 0, 2, 0.0047, 0.0 },
+    { 1, 1, 0, 0.0036, 0.0 },       { 8, 0, 0, 0.0035, 0.0 },       { 6, -1, 0, 0.0034, 0.0 },
+    { 2, 0, -2, -0.0034, 0.0 },     { 2, -2, 0, 0.0022, 0.0 },      { 3, 0, 0, -0.0017, 0.0 },
+    { 4, 0, 2, 0.0013, 0.0 },       { 8, -1, 0, 0.0011, 0.0 },      { 4, -2, 0, 0.0010, 0.0 },
+    { 10, 0, 0, 0.0009, 0.0 },      { 3, 1, 0, 0.0007, 0.0 },       { 0, 2, 0, 0.0006, 0.0 },
+    { 2, 1, 0, 0.0005, 0.0 },       { 2, 2, 0, 0.0005, 0.0 },       { 6, 0, 2, 0.0004, 0.0 },
+    { 6, -2, 0, 0.0004, 0.0 },      { 10, -1, 0, 0.0004, 0.0 },     { 5, 0, 0, -0.0004, 0.0 },
+    { 4, 0, -2, -0.0004, 0.0 },     { 0, 1, 2, 0.0003, 0.0 },       { 12, 0, 0, 0.0003, 0.0 },
+    { 2, -1, 2, 0.0003, 0.0 },      { 1, -1, 0, -0.0003, 0.0 }
+};
+
+// Table 50.B, perigee parallax terms (arcseconds, cosine arguments)
+static const ApsisTerm apsides_perigee_parallax[] = {
+    { 2, 0, 0, 63.224, 0.0 },       { 4, 0, 0, -6.990, 0.0 },       { 2, -1, 0, 2.834, -0.0071 },
+    { 6, 0, 0, 1.927, 0.0 },        { 1, 0, 0, -1.263, 0.0 },       { 8, 0, 0, -0.702, 0.0 },
+    { 0, 1, 0, 0.696, -0.0017 },    { 0, 0, 2, -0.690, 0.0 },       { 4, -1, 0, -0.629, 0.0016 },
+    { 2, 0, -2, -0.392, 0.0 },      { 10, 0, 0, 0.297, 0.0 },       { 6, -1, 0, 0.260, 0.0 },
+    { 3, 0, 0, 0.201, 0.0 },        { 2, 1, 0, -0.161, 0.0 },       { 1, 1, 0, 0.157, 0.0 },
+    { 12, 0, 0, -0.138, 0.0 },      { 8, -1, 0, -0.127, 0.0 },      { 2, 0, 2, 0.104, 0.0 },
+    { 2, -2, 0, 0.104, 0.0 },       { 5, 0, 0, -0.079, 0.0 },       { 14, 0, 0, 0.068, 0.0 },
+    { 10, -1, 0, 0.067, 0.0 },      { 4, 1, 0, 0.054, 0.0 },        { 12, -1, 0, -0.038, 0.0 },
+    { 4, -2, 0, -0.038, 0.0 },      { 7, 0, 0, 0.037, 0.0 },        { 4, 0, 2, -0.037, 0.0 },
+    { 16, 0, 0, -0.035, 0.0 },      { 3, 1, 0, -0.030, 0.0 },       { 1, -1, 0, 0.029, 0.0 },
+    { 6, 1, 0, -0.025, 0.0 },       { 0, 2, 0, 0.023, 0.0 },        { 14, -1, 0, 0.023, 0.0 },
+    { 2, 2, 0, -0.023, 0.0 },       { 6, -2, 0, 0.022, 0.0 },       { 2, -1, -2, -0.021, 0.0 },
+    { 9, 0, 0, -0.020, 0.0 },       { 18, 0, 0, 0.019, 0.0 },       { 6, 0, 2, 0.017, 0.0 },
+    { 0, -1, 2, 0.014, 0.0 },       { 16, -1, 0, -0.014, 0.0 },     { 4, 0, -2, 0.013, 0.0 },
+    { 8, 1, 0, 0.012, 0.0 },        { 11, 0, 0, 0.011, 0.0 },       { 5, 1, 0, 0.010, 0.0 },
+    { 20, 0, 0, -0.010, 0.0 }
+};
+
+// Table 50.B, apogee parallax terms (arcseconds, cosine arguments)
+static const ApsisTerm apsides_apogee_parallax[] = {
+    { 2, 0, 0, -9.147, 0.0 },       { 1, 0, 0, -0.841, 0.0 },       { 0, 0, 2, 0.697, 0.0 },
+    { 0, 1, 0, -0.656, 0.0016 },    { 4, 0, 0, 0.355, 0.0 },        { 2, -1, 0, 0.159, 0.0 },
+    { 1, 1, 0, 0.127, 0.0 },        { 4, -1, 0, 0.065, 0.0 },       { 6, 0, 0, 0.052, 0.0 },
+    { 2, 1, 0, 0.043, 0.0 },        { 2, 0, 2, 0.031, 0.0 },        { 2, 0, -2, -0.023, 0.0 },
+    { 2, -2, 0, 0.022, 0.0 },       { 2, 2, 0, 0.019, 0.0 },        { 0, 2, 0, -0.016, 0.0 },
+    { 6, -1, 0, 0.014, 0.0 },       { 8, 0, 0, 0.010, 0.0 }
+};
+
+#define APSIDES_TERM_COUNT(table) ((int)(sizeof(table) / sizeof(table[0])))
+
+static double apsides_sum(const ApsisTerm* terms, int count, double D, double M, double F,
+                          double T, int use_cos) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        double arg = terms[i].d * D + terms[i].m * M + terms[i].f * F;
+        sum += (terms[i].coefficient + terms[i].per_t * T) * (use_cos ? cos(arg) : sin(arg));
+    }
+    return sum;
+}
+
+CalendarResult lunar_apsis_evaluate(double k, LunarApsis* apsis) {
+    if (!apsis) return CALENDAR_ERROR_NULL_POINTER;
+    
+    double T = k / 1325.55;
+    double T2 = T * T;
+    double D = (171.9179 + 335.9106046 * k - 0.0100383 * T2 - 0.00001156 * T2 * T +
+                0.000000055 * T2 * T2) * APSIDES_DEG_TO_RAD;
+    double M = (347.3477 + 27.1577721 * k - 0.0008130 * T2 - 0.0000010 * T2 * T) * APSIDES_DEG_TO_RAD;
+    double F = (316.6109 + 364.5287911 * k - 0.0125053 * T2 - 0.0000148 * T2 * T) * APSIDES_DEG_TO_RAD;
+    double jde = APSIDES_EPOCH_JDE + APSIDES_ANOMALISTIC_MONTH * k - 0.0006691 * T2 -
+                 0.000001098 * T2 * T + 0.0000000052 * T2 * T2;
+    
+    apsis->is_apogee = floor(k) != k;
+    apsis->index = k;
+    if (apsis->is_apogee) {
+        apsis->julian_day = jde + apsides_sum(apsides_apogee_time, APSIDES_TERM_COUNT(apsides_apogee_time),
+                                              D, M, F, T, 0);
+        apsis->parallax_arcsec = 3245.251 + apsides_sum(apsides_apogee_parallax,
+                                                        APSIDES_TERM_COUNT(apsides_apogee_parallax), D, M, F, T, 1);
+    } else {
+        apsis->julian_day = jde + apsides_sum(apsides_perigee_time, APSIDES_TERM_COUNT(apsides_perigee_time),
+                                              D, M, F, T, 0);
+        apsis->parallax_arcsec = 3629.215 + apsides_sum(apsides_perigee_parallax,
+                                                        APSIDES_TERM_COUNT(apsides_perigee_parallax), D, M, F, T, 1);
+    }
+    apsis->distance_km = APSIDES_EARTH_RADIUS_KM / sin(apsis->parallax_arcsec * APSIDES_ARCSEC_TO_RAD);
+    return CALENDAR_SUCCESS;
+}
+
+// Index of the last perigee at least one anomalistic month before julian_day
+static double apsides_index_before(double julian_day) {
+    return floor((julian_day - APSIDES_EPOCH_JDE) / APSIDES_ANOMALISTIC_MONTH) - 1.0;
+}
+
+CalendarResult lunar_apsis_find_next(int is_apogee, double julian_day, LunarApsis* apsis) {
+    if (!apsis) return CALENDAR_ERROR_NULL_POINTER;
+    
+    // Periodic terms shift an apsis by at most about two days from its mean time
+    double k = apsides_index_before(julian_day) + (is_apogee ? 0.5 : 0.0);
+    for (int i = 0; i < 4; i++, k += 1.0) {
+        lunar_apsis_evaluate(k, apsis);
+        if (apsis->julian_day > julian_day) return CALENDAR_SUCCESS;
+    }
+    return CALENDAR_ERROR_CONVERSION_FAILED;
+}
+
+LunarApsis* lunar_apsides_in_range(double start_jd, double end_jd, int* count) {
+    if (!count) return NULL;
+    *count = 0;
+    if (end_jd < start_jd) return NULL;
+    
+    int capacity = (int)((end_jd - start_jd) / APSIDES_ANOMALISTIC_MONTH * 2.0) + 8;
+    LunarApsis* apsides = malloc(sizeof(LunarApsis) * capacity);
+    if (!apsides) return NULL;
+    
+    // Perigees and apogees alternate every half index; their order never changes
+    double last_k = floor((end_jd - APSIDES_EPOCH_JDE) / APSIDES_ANOMALISTIC_MONTH) + 1.0;
+    for (double k = apsides_index_before(start_jd); k <= last_k && *count < capacity; k += 0.5) {
+        LunarApsis* apsis = &apsides[*count];
+        lunar_apsis_evaluate(k, apsis);
+        if (apsis->julian_day >= start_jd && apsis->julian_day <= end_jd) (*count)++;
+    }
+    return apsides;
+}
+
+// Nearest apsis of the requested kind, walking forward from *cursor
+static const LunarApsis* apsides_nearest(const LunarApsis* apsides, int count, int is_apogee,
+                                         double julian_day, int* cursor) {
+    const LunarApsis* best = NULL;
+    for (int i = *cursor; i < count; i++) {
+        if (apsides[i].is_apogee != is_apogee) continue;
+        if (best && fabs(apsides[i].julian_day - julian_day) >= fabs(best->julian_day - julian_day)) break;
+        best = &apsides[i];
+        if (apsides[i].julian_day < julian_day) *cursor = i;
+    }
+    return best;
+}
+
+// Civil (UT) calendar month of a TT instant, as year * 12 + month
+static long apsides_civil_month(double julian_day) {
+    int day, month, year;
+    julian_day_to_date((long)floor(time_tt_to_ut(julian_day) + 0.5), &day, &month, &year);
+    return (long)year * 12 + month;
+}
+
+// Flag the third full moon of every season (solstice or equinox to the next) with
+// four; seasons not wholly inside the list are skipped
+static void apsides_flag_seasonal_blue(LunarFullMoon* moons, int count, int first_year, int last_year) {
+    int m = 0;
+    for (int year = first_year; year <= last_year + 1; year++) {
+        double bounds[5] = {
+            time_ut_to_tt(solar_calculate_solstice(year - 1, 1)),
+            time_ut_to_tt(solar_calculate_equinox(year, 0)),
+            time_ut_to_tt(solar_calculate_solstice(year, 0)),
+            time_ut_to_tt(solar_calculate_equinox(year, 1)),
+            time_ut_to_tt(solar_calculate_solstice(year, 1))
+        };
+        for (int s = 0; s < 4; s++) {
+            while (m < count && moons[m].julian_day < bounds[s]) m++;
+            int first = m, n = 0;
+            while (first + n < count && moons[first + n].julian_day < bounds[s + 1]) n++;
+            if (first > 0 && n == 4 && first + n < count) moons[first + 2].is_blue_seasonal = 1;
+        }
+    }
+}
+
+LunarFullMoon* lunar_full_moons_for_years(int start_year, int end_year, int* count) {
+    if (!count) return NULL;
+    *count = 0;
+    if (end_year < start_year) return NULL;
+    
+    // Pad the range so the seasons and orbits at both ends are complete
+    double first_jd = time_ut_to_tt(julian_day_from_date(1, 1, start_year) - 0.5);
+    double last_jd = time_ut_to_tt(julian_day_from_date(31, 12, end_year) + 0.5);
+    double pad_start = first_jd - APSIDES_SEASON_PAD_DAYS;
+    double pad_end = last_jd + APSIDES_SEASON_PAD_DAYS;
+    
+    int capacity = (int)((pad_end - pad_start) / APSIDES_SYNODIC_MONTH) + 4;
+    LunarFullMoon* moons = malloc(sizeof(LunarFullMoon) * capacity);
+    int apsis_count = 0;
+    LunarApsis* apsides = lunar_apsides_in_range(pad_start - APSIDES_ANOMALISTIC_MONTH,
+                                                 pad_end + APSIDES_ANOMALISTIC_MONTH, &apsis_count);
+    if (!moons || !apsides) {
+        free(moons);
+        free(apsides);
+        return NULL;
+    }
+    
+    // Full moons by lunation index: the mean phase seeds the search for the true one
+    int n = 0, perigee_cursor = 0, apogee_cursor = 0;
+    double k = floor((pad_start - APSIDES_PHASE_EPOCH_JDE) / APSIDES_SYNODIC_MONTH) + 0.5;
+    for (; n < capacity; k += 1.0) {
+        double mean_jde = APSIDES_PHASE_EPOCH_JDE + APSIDES_SYNODIC_MONTH * k;
+        if (mean_jde > pad_end + 1.0) break;
+        
+        double full_ut = lunar_find_next_phase(time_tt_to_ut(mean_jde - 2.0), 180.0);
+        if (full_ut == 0.0) continue;
+        double jd = time_ut_to_tt(full_ut);
+        if (jd < pad_start || jd > pad_end) continue;
+        
+        LunarFullMoon* moon = &moons[n++];
+        memset(moon, 0, sizeof(*moon));
+        moon->lunation = k;
+        moon->julian_day = jd;
+        LunarPosition pos;
+        lunar_calculate_position(jd, &pos);
+        moon->distance_km = pos.distance_km;
+        
+        const LunarApsis* perigee = apsides_nearest(apsides, apsis_count, 0, jd, &perigee_cursor);
+        const LunarApsis* apogee = apsides_nearest(apsides, apsis_count, 1, jd, &apogee_cursor);
+        if (perigee && apogee) {
+            moon->perigee_km = perigee->distance_km;
+            moon->apogee_km = apogee->distance_km;
+            double margin = LUNAR_SUPERMOON_FRACTION * (apogee->distance_km - perigee->distance_km);
+            moon->is_supermoon = moon->distance_km <= perigee->distance_km + margin;
+            moon->is_micromoon = moon->distance_km >= apogee->distance_km - margin;
+        }
+        if (n > 1 && apsides_civil_month(moons[n - 2].julian_day) == apsides_civil_month(jd)) {
+            moon->is_blue_calendar = 1;
+        }
+    }
+    free(apsides);
+    apsides_flag_seasonal_blue(moons, n, start_year, end_year);
+    
+    // Keep the moons inside the requested years
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        if (moons[i].julian_day >= first_jd && moons[i].julian_day < last_jd) moons[kept++] = moons[i];
+    }
+    *count = kept;
+    return moons;
+}
+
+// "YYYY-MM-DD HH:MM" of a TT instant in UT
+static void apsides_format_ut(double julian_day, char* buffer, size_t size) {
+    double ut = time_tt_to_ut(julian_day);
+    long jdn = (long)floor(ut + 0.5);
+    int minutes = (int)floor((ut + 0.5 - jdn) * 1440.0);
+    int day, month, year;
+    julian_day_to_date(jdn, &day, &month, &year);
+    snprintf(buffer, size, "%04d-%02d-%02d %02d:%02d", year, month, day, minutes / 60, minutes % 60);
+}
+
+static void apsides_moon_event(const LunarFullMoon* moon, AstronomicalEventType type,
+                               const char* name, const char* detail, AstronomicalEvent* event) {
+    char when[32];
+    apsides_format_ut(moon->julian_day, when, sizeof(when));
+    
+    memset(event, 0, sizeof(*event));
+    event->type = type;
+    event->julian_day = moon->julian_day;
+    snprintf(event->name, sizeof(event->name), "%s", name);
+    snprintf(event->description, sizeof(event->description), "Full moon %s UT, %s, distance %.0f km",
+             when, detail, moon->distance_km);
+    event->magnitude = APSIDES_MEAN_DISTANCE_KM / moon->distance_km;   // Apparent size vs. mean
+    event->visibility_global = 1;
+}
+
+void lunar_apsis_to_astronomical_event(const LunarApsis* apsis, AstronomicalEvent* event) {
+    if (!apsis || !event) return;
+    
+    char when[32];
+    apsides_format_ut(apsis->julian_day, when, sizeof(when));
+    
+    memset(event, 0, sizeof(*event));
+    event->type = apsis->is_apogee ? ASTRO_EVENT_LUNAR_APOGEE : ASTRO_EVENT_LUNAR_PERIGEE;
+    event->julian_day = apsis->julian_day;
+    snprintf(event->name, sizeof(event->name), "Lunar %s", apsis->is_apogee ? "Apogee" : "Perigee");
+    snprintf(event->description, sizeof(event->description), "%s UT, distance %.0f km, parallax %.3f\"",
+             when, apsis->distance_km, apsis->parallax_arcsec);
+    event->magnitude = APSIDES_MEAN_DISTANCE_KM / apsis->distance_km;
+    event->visibility_global = 1;
+}
+
+static int apsides_compare_events(const void* a, const void* b) {
+    double ja = ((const AstronomicalEvent*)a)->julian_day;
+    double jb = ((const AstronomicalEvent*)b)->julian_day;
+    return (ja > jb) - (ja < jb);
+}
+
+AstronomicalEvent* lunar_apsides_generate_catalog(int start_year, int end_year,
+                                                  int include_apsides, int* count) {
+    if (!count) return NULL;
+    *count = 0;
+    
+    int moon_count = 0, apsis_count = 0;
+    LunarFullMoon* moons = lunar_full_moons_for_years(start_year, end_year, &moon_count);
+    if (!moons) return NULL;
+    
+    LunarApsis* apsides = NULL;
+    if (include_apsides) {
+        double first_jd = time_ut_to_tt(julian_day_from_date(1, 1, start_year) - 0.5);
+        double last_jd = time_ut_to_tt(julian_day_from_date(31, 12, end_year) + 0.5);
+        apsides = lunar_apsides_in_range(first_jd, last_jd, &apsis_count);
+        if (!apsides) {
+            free(moons);
+            return NULL;
+        }
+    }
+    
+    // A full moon yields at most three events (size class and both blue moon rules)
+    AstronomicalEvent* events = malloc(sizeof(AstronomicalEvent) * (3 * moon_count + apsis_count + 1));
+    if (!events) {
+        free(moons);
+        free(apsides);
+        return NULL;
+    }
+    
+    int n = 0;
+    for (int i = 0; i < moon_count; i++) {
+        const LunarFullMoon* moon = &moons[i];
+        if (moon->is_supermoon) {
+            apsides_moon_event(moon, ASTRO_EVENT_SUPERMOON, "Supermoon", "near perigee", &events[n++]);
+        } else if (moon->is_micromoon) {
+            apsides_moon_event(moon, ASTRO_EVENT_MICROMOON, "Micromoon", "near apogee", &events[n++]);
+        }
+        if (moon->is_blue_calendar) {
+            apsides_moon_event(moon, ASTRO_EVENT_BLUE_MOON, "Blue Moon",
+                               "second full moon of the month", &events[n++]);
+        }
+        if (moon->is_blue_seasonal) {
+            apsides_moon_event(moon, ASTRO_EVENT_BLUE_MOON, "Seasonal Blue Moon",
+                               "third of four full moons in the season", &events[n++]);
+        }
+    }
+    for (int i = 0; i < apsis_count; i++) {
+        lunar_apsis_to_astronomical_event(&apsides[i], &events[n++]);
+    }
+    free(moons);
+    free(apsides);
+    
+    qsort(events, n, sizeof(AstronomicalEvent), apsides_compare_events);
+    *count = n;
+    return events;
+}
+
+void lunar_apsides_destroy_catalog(AstronomicalEvent* events) {
+    if (events) free(events);
+}
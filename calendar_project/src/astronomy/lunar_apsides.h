@@ -0,0 +1,55 @@
+// src/astronomy/lunar_apsides.h
+#ifndef LUNAR_APSIDES_H
+#define LUNAR_APSIDES_H
+
+#include "../../include/calendar_types.h"
+#include "../../include/calendar_types_extended.h"
+
+// A full moon within this fraction of the perigee-apogee range of its orbit
+// from the nearest perigee is a supermoon, from the nearest apogee a micromoon
+#define LUNAR_SUPERMOON_FRACTION 0.1
+
+// Perigee or apogee of the moon (Meeus ch. 50)
+typedef struct {
+    int is_apogee;
+    double index;               // k: integer for perigees, x.5 for apogees
+    double julian_day;          // Dynamical time (TT)
+    double parallax_arcsec;     // Equatorial horizontal parallax
+    double distance_km;
+} LunarApsis;
+
+// Full moon joined with the apsides that bracket its orbit
+typedef struct {
+    double lunation;            // k of the full moon (x.5, new moon of 2000 January 6 = 0)
+    double julian_day;          // TT
+    double distance_km;
+    double perigee_km;          // Nearest perigee and apogee
+    double apogee_km;
+    int is_supermoon;
+    int is_micromoon;
+    int is_blue_calendar;       // Second full moon in a calendar month (UT)
+    int is_blue_seasonal;       // Third full moon of a season that has four
+} LunarFullMoon;
+
+// Apsis with index k (perigee for integer k, apogee for k + 0.5)
+CalendarResult lunar_apsis_evaluate(double k, LunarApsis* apsis);
+
+// Next perigee or apogee after julian_day (TT)
+CalendarResult lunar_apsis_find_next(int is_apogee, double julian_day, LunarApsis* apsis);
+
+// Perigees and apogees in [start_jd, end_jd] (TT), in time order; free() the result
+LunarApsis* lunar_apsides_in_range(double start_jd, double end_jd, int* count);
+
+// Full moons of the Gregorian years [start_year, end_year] with their
+// supermoon, micromoon and blue moon flags; free() the result
+LunarFullMoon* lunar_full_moons_for_years(int start_year, int end_year, int* count);
+
+// Supermoons, micromoons and blue moons of [start_year, end_year], in time order.
+// With include_apsides every perigee and apogee is listed as well.
+AstronomicalEvent* lunar_apsides_generate_catalog(int start_year, int end_year,
+                                                  int include_apsides, int* count);
+void lunar_apsides_destroy_catalog(AstronomicalEvent* events);
+
+void lunar_apsis_to_astronomical_event(const LunarApsis* apsis, AstronomicalEvent* event);
+
+#endif // LUNAR_APSIDES_H
@@ -1,16 +1,782 @@
 // src/astronomy/lunar_calc.c (Fixed with proper constants and signatures)
 #include "lunar_calc.h"
 #include "../calendars/islamic.h"
+#include "event_finder.h"
+#include "time_scale.h"
+#include "crescent.h"
+#include "../utils/date_utils.h"
 #include <math.h>
 
-double lunar_calculate_moon_age(long julian_day) {
-    // Calculate days since last new moon using precise epoch
-    double days_since_new_moon = (julian_day - LUNAR_EPOCH_JD);
-    days_since_new_moon = fmod(days_since_new_moon, LUNAR_MONTH_PRECISE);
-    if (days_since_new_moon < 0) {
-        days_since_new_moon += LUNAR_MONTH_PRECISE;
+#define LUNAR_DEG_TO_RAD (M_PI / 180.0)
+#define LUNAR_AU_KM 149597870.7
+
+// Lunar series layout
+#define LUNAR_LR_TERMS 60            // Longitude/distance terms (Meeus table 47.A)
+#define LUNAR_B_TERMS 60             // Latitude terms (Meeus table 47.B)
+#define LUNAR_MAX_MULTIPLE 4         // Largest multiple of D, M, M' or F in the tables
+#define LUNAR_HARMONIC_ROWS (2 * LUNAR_MAX_MULTIPLE + 1)
+#define LUNAR_BATCH_BLOCK 32         // Instants evaluated together by the batch kernel
+
+// Elongation of the moon from the sun advances between these rates (degrees/day)
+#define LUNAR_ELONGATION_MIN_RATE 10.0
+#define LUNAR_ELONGATION_MAX_RATE 16.0
+#define LUNAR_EVENT_TOLERANCE_DAYS (1.0 / 86400.0)
+#define LUNAR_SOLAR_ABERRATION 0.00569
+
+// Range mode re-evaluates the rotated phasors exactly at most every this many
+// steps or days, whichever comes first
+#define LUNAR_RANGE_MAX_STEPS 512
+#define LUNAR_RANGE_MAX_DAYS 512.0
+#define LUNAR_RANGE_UNROLL 4         // Steps summed per pass over the terms
+#define LUNAR_MOON_MEAN_RATE 13.176396   // Mean motions, degrees per day
+#define LUNAR_SUN_MEAN_RATE 0.985647
+
+// Leading rows of table 47.A used by the STANDARD tier (|coefficient| >= 0.01 deg)
+#define LUNAR_STANDARD_TERMS 14
+
+#if defined(__GNUC__)
+#define LUNAR_THREAD_LOCAL __thread
+#else
+#define LUNAR_THREAD_LOCAL
+#endif
+
+static LUNAR_THREAD_LOCAL LunarPrecision lunar_default_precision = LUNAR_PRECISION_STANDARD;
+
+// Table 47.A stored as struct-of-arrays: multiples of D, M, M', F and the
+// sine (longitude, 1e-6 deg) and cosine (distance, 1e-3 km) coefficients.
+static const signed char lunar_lr_d[LUNAR_LR_TERMS] = {
+    0, 2, 2, 0, 0, 0, 2, 2, 2, 2, 0, 1, 0, 2, 0, 0, 4, 0, 4, 2,
+    2, 1, 1, 2, 2, 4, 2, 0, 2, 2, 1, 2, 0, 0, 2, 2, 2, 4, 0, 3,
+    2, 4, 0, 2, 2, 2, 4, 0, 4, 1, 2, 0, 1, 3, 4, 2, 0, 1, 2, 2
+};
+static const signed char lunar_lr_m[LUNAR_LR_TERMS] = {
+    0, 0, 0, 0, 1, 0, 0,-1, 0,-1, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1,
+    1, 0, 1,-1, 0, 0, 0, 1, 0,-1, 0,-2, 1, 2,-2, 0, 0,-1, 0, 0,
+    1,-1, 2, 2, 1,-1, 0, 0,-1, 0, 1, 0, 1, 0, 0,-1, 2, 1, 0, 0
+};
+static const signed char lunar_lr_mp[LUNAR_LR_TERMS] = {
+    1,-1, 0, 2, 0, 0,-2,-1, 1, 0,-1, 0, 1, 0, 1, 1,-1, 3,-2,-1,
+    0,-1, 0, 1, 2, 0,-3,-2,-1,-2, 1, 0, 2, 0,-1, 1, 0,-1, 2,-1,
+    1,-2,-1,-1,-2, 0, 1, 4, 0,-2, 0, 2, 1,-2,-3, 2, 1,-1, 3,-1
+};
+static const signed char lunar_lr_f[LUNAR_LR_TERMS] = {
+    0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0,-2, 2,-2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0,-2, 2, 0, 2, 0,
+    0, 0, 0, 0, 0,-2, 0, 0, 0, 0,-2,-2, 0, 0, 0, 0, 0, 0, 0,-2
+};
+static const double lunar_lr_sin_l[LUNAR_LR_TERMS] = {
+    6288774, 1274027, 658314, 213618, -185116, -114332, 58793, 57066, 53322, 45758,
+    -40923, -34720, -30383, 15327, -12528, 10980, 10675, 10034, 8548, -7888,
+    -6766, -5163, 4987, 4036, 3994, 3861, 3665, -2689, -2602, 2390,
+    -2348, 2236, -2120, -2069, 2048, -1773, -1595, 1215, -1110, -892,
+    -810, 759, -713, -700, 691, 596, 549, 537, 520, -487,
+    -399, -381, 351, -340, 330, 327, -323, 299, 294, 0
+};
+static const double lunar_lr_cos_r[LUNAR_LR_TERMS] = {
+    -20905355, -3699111, -2955968, -569925, 48888, -3149, 246158, -152138, -170733, -204586,
+    -129620, 108743, 104755, 10321, 0, 79661, -34782, -23210, -21636, 24208,
+    30824, -8379, -16675, -12831, -10445, -11650, 14403, -7003, 0, 10056,
+    6322, -9884, 5751, 0, -4950, 4130, 0, -3958, 0, 3258,
+    2616, -1897, -2117, 2354, 0, 0, -1423, -1117, -1571, -1739,
+    0, -4421, 0, 0, 0, 0, 1165, 0, 0, 8752
+};
+
+// Table 47.B: multiples of D, M, M', F and sine coefficients (latitude, 1e-6 deg)
+static const signed char lunar_b_d[LUNAR_B_TERMS] = {
+    0, 0, 0, 2, 2, 2, 2, 0, 2, 0, 2, 2, 2, 2, 2, 2, 2, 0, 4, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, 4, 4, 0, 4, 2, 2, 2, 2, 0, 2, 2, 2,
+    2, 4, 2, 2, 0, 2, 1, 1, 0, 2, 1, 2, 0, 4, 4, 1, 4, 1, 4, 2
+};
+static const signed char lunar_b_m[LUNAR_B_TERMS] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,-1, 0, 0, 1,-1,-1,-1, 1, 0, 1,
+    0, 1, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,-1, 0, 0, 0, 0, 1,
+    1, 0,-1,-2, 0, 1, 1, 1, 1, 1, 0,-1, 1, 0,-1, 0, 0, 0,-1,-2
+};
+static const signed char lunar_b_mp[LUNAR_B_TERMS] = {
+    0, 1, 1, 0,-1,-1, 0, 2, 1, 2, 0,-2, 1, 0,-1, 0,-1,-1,-1, 0,
+    0,-1, 0, 1, 1, 0, 0, 3, 0,-1, 1,-2, 0, 2, 1,-2, 3, 2,-3,-1,
+    0, 0, 1, 0, 1, 1, 0, 0,-2,-1, 1,-2, 2,-2,-1, 1, 1,-1, 0, 0
+};
+static const signed char lunar_b_f[LUNAR_B_TERMS] = {
+    1, 1,-1,-1, 1,-1, 1, 1,-1,-1,-1,-1, 1,-1, 1, 1,-1,-1,-1, 1,
+    3, 1, 1, 1,-1,-1,-1, 1,-1, 1,-3, 1,-3,-1,-1, 1,-1, 1,-1, 1,
+    1, 1, 1,-1, 3,-1,-1, 1,-1,-1, 1,-1, 1,-1,-1,-1,-1,-1,-1, 1
+};
+static const double lunar_b_sin_b[LUNAR_B_TERMS] = {
+    5128122, 280602, 277693, 173237, 55413, 46271, 32573, 17198, 9266, 8822,
+    8216, 4324, 4200, -3359, 2463, 2211, 2065, -1870, 1828, -1794,
+    -1749, -1565, -1491, -1475, -1410, -1344, -1335, 1107, 1021, 833,
+    777, 671, 607, 596, 491, -451, 439, 422, 421, -366,
+    -351, 331, 315, 302, -283, -229, 223, 223, -220, -220,
+    -185, 181, -177, 176, 166, -164, 132, -119, 115, 107
+};
+
+// Reduce an angle in degrees to [0, 360)
+static double lunar_normalize_degrees(double angle) {
+    angle = fmod(angle, 360.0);
+    return angle < 0 ? angle + 360.0 : angle;
+}
+
+// Inputs of the series kernel for one block of instants. The unit phasors of
+// the fundamental arguments come either from trigonometric calls or, for
+// evenly spaced ranges, from rotation recurrences.
+typedef struct {
+    double julian_day[LUNAR_BATCH_BLOCK];
+    double Lp[LUNAR_BATCH_BLOCK];               // Mean longitude of the moon, degrees
+    double e_pow[3][LUNAR_BATCH_BLOCK];         // Powers of the eccentricity factor E
+    double cos1[4][LUNAR_BATCH_BLOCK];          // cos/sin of D, M, M', F
+    double sin1[4][LUNAR_BATCH_BLOCK];
+    double add_l[LUNAR_BATCH_BLOCK];            // Additive terms, 1e-6 degrees
+    double add_b[LUNAR_BATCH_BLOCK];
+} LunarSeriesInput;
+
+enum { LUNAR_ARG_D, LUNAR_ARG_M, LUNAR_ARG_MP, LUNAR_ARG_F };
+
+// Fundamental arguments in degrees (Meeus 47.1 - 47.5), not reduced
+static void lunar_fundamental_arguments(double t, double* Lp, double* D, double* M, double* Mp, double* F) {
+    double t2 = t * t, t3 = t2 * t, t4 = t3 * t;
+    *Lp = 218.3164477 + 481267.88123421 * t - 0.0015786 * t2 + t3 / 538841.0 - t4 / 65194000.0;
+    *D = 297.8501921 + 445267.1114034 * t - 0.0018819 * t2 + t3 / 545868.0 - t4 / 113065000.0;
+    *M = 357.5291092 + 35999.0502909 * t - 0.0001536 * t2 + t3 / 24490000.0;
+    *Mp = 134.9633964 + 477198.8675055 * t + 0.0087414 * t2 + t3 / 69699.0 - t4 / 14712000.0;
+    *F = 93.2720950 + 483202.0175233 * t - 0.0036539 * t2 - t3 / 3526000.0 + t4 / 863310000.0;
+}
+
+// Eccentricity of Earth's orbit scales terms containing M
+static void lunar_set_eccentricity(LunarSeriesInput* in, int j, double t) {
+    double E = 1.0 - 0.002516 * t - 0.0000074 * t * t;
+    in->e_pow[0][j] = 1.0;
+    in->e_pow[1][j] = E;
+    in->e_pow[2][j] = E * E;
+}
+
+// Series inputs from trigonometric calls (any instants)
+static void lunar_series_input_direct(const double* julian_days, int n, int with_latitude,
+                                      LunarSeriesInput* in) {
+    for (int j = 0; j < n; j++) {
+        double t = (julian_days[j] - 2451545.0) / 36525.0;
+        double Lp, args[4];
+        lunar_fundamental_arguments(t, &Lp, &args[LUNAR_ARG_D], &args[LUNAR_ARG_M],
+                                    &args[LUNAR_ARG_MP], &args[LUNAR_ARG_F]);
+        in->julian_day[j] = julian_days[j];
+        in->Lp[j] = lunar_normalize_degrees(Lp);
+        for (int a = 0; a < 4; a++) {
+            double rad = lunar_normalize_degrees(args[a]) * LUNAR_DEG_TO_RAD;
+            in->cos1[a][j] = cos(rad);
+            in->sin1[a][j] = sin(rad);
+        }
+        lunar_set_eccentricity(in, j, t);
+        
+        // Additive terms: Venus (A1), Jupiter (A2) and flattening of the Earth
+        double A1 = (119.75 + 131.849 * t) * LUNAR_DEG_TO_RAD;
+        double A2 = (53.09 + 479264.290 * t) * LUNAR_DEG_TO_RAD;
+        double A3 = (313.45 + 481266.484 * t) * LUNAR_DEG_TO_RAD;
+        double Lp_rad = in->Lp[j] * LUNAR_DEG_TO_RAD;
+        double Mp_rad = lunar_normalize_degrees(args[LUNAR_ARG_MP]) * LUNAR_DEG_TO_RAD;
+        double F_rad = lunar_normalize_degrees(args[LUNAR_ARG_F]) * LUNAR_DEG_TO_RAD;
+        
+        in->add_l[j] = 3958.0 * sin(A1) + 1962.0 * sin(Lp_rad - F_rad) + 318.0 * sin(A2);
+        in->add_b[j] = 0.0;
+        if (with_latitude) {
+            in->add_b[j] = -2235.0 * sin(Lp_rad) + 382.0 * sin(A3) +
+                           175.0 * sin(A1 - F_rad) + 175.0 * sin(A1 + F_rad) +
+                           127.0 * sin(Lp_rad - Mp_rad) - 115.0 * sin(Lp_rad + Mp_rad);
+        }
+    }
+}
+
+// Fill cos/sin of k*angle for k = -LUNAR_MAX_MULTIPLE..LUNAR_MAX_MULTIPLE by
+// angle addition, so each series term needs no trigonometric call of its own.
+// Row k + LUNAR_MAX_MULTIPLE holds the multiple k, column j the instant j.
+static void lunar_fill_harmonics(const double* cos1, const double* sin1, int n,
+                                 double cos_rows[][LUNAR_BATCH_BLOCK],
+                                 double sin_rows[][LUNAR_BATCH_BLOCK]) {
+    const int zero = LUNAR_MAX_MULTIPLE;
+    for (int j = 0; j < n; j++) {
+        double c1 = cos1[j];
+        double s1 = sin1[j];
+        cos_rows[zero][j] = 1.0;
+        sin_rows[zero][j] = 0.0;
+        for (int k = 1; k <= LUNAR_MAX_MULTIPLE; k++) {
+            double c = cos_rows[zero + k - 1][j];
+            double s = sin_rows[zero + k - 1][j];
+            cos_rows[zero + k][j] = c * c1 - s * s1;
+            sin_rows[zero + k][j] = s * c1 + c * s1;
+            cos_rows[zero - k][j] = cos_rows[zero + k][j];
+            sin_rows[zero - k][j] = -sin_rows[zero + k][j];
+        }
+    }
+}
+
+// Evaluate table 47.A/47.B for up to LUNAR_BATCH_BLOCK instants. Terms form the
+// outer loop and instants the inner one, so every inner loop is a straight
+// multiply-add over contiguous columns that the compiler can vectorize.
+// lr_terms and b_terms select leading rows of each table (precision tiers).
+static void lunar_series_evaluate(const LunarSeriesInput* in, int n, int lr_terms, int b_terms,
+                                  LunarPosition* out) {
+    double sum_l[LUNAR_BATCH_BLOCK], sum_r[LUNAR_BATCH_BLOCK], sum_b[LUNAR_BATCH_BLOCK];
+    double d_cos[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK], d_sin[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK];
+    double m_cos[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK], m_sin[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK];
+    double mp_cos[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK], mp_sin[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK];
+    double f_cos[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK], f_sin[LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK];
+    
+    for (int j = 0; j < n; j++) {
+        sum_l[j] = in->add_l[j];
+        sum_r[j] = 0.0;
+        sum_b[j] = in->add_b[j];
+    }
+    
+    lunar_fill_harmonics(in->cos1[LUNAR_ARG_D], in->sin1[LUNAR_ARG_D], n, d_cos, d_sin);
+    lunar_fill_harmonics(in->cos1[LUNAR_ARG_M], in->sin1[LUNAR_ARG_M], n, m_cos, m_sin);
+    lunar_fill_harmonics(in->cos1[LUNAR_ARG_MP], in->sin1[LUNAR_ARG_MP], n, mp_cos, mp_sin);
+    lunar_fill_harmonics(in->cos1[LUNAR_ARG_F], in->sin1[LUNAR_ARG_F], n, f_cos, f_sin);
+    
+    const int zero = LUNAR_MAX_MULTIPLE;
+    
+    for (int i = 0; i < lr_terms; i++) {
+        const double* dc = d_cos[zero + lunar_lr_d[i]];
+        const double* ds = d_sin[zero + lunar_lr_d[i]];
+        const double* mc = m_cos[zero + lunar_lr_m[i]];
+        const double* ms = m_sin[zero + lunar_lr_m[i]];
+        const double* mpc = mp_cos[zero + lunar_lr_mp[i]];
+        const double* mps = mp_sin[zero + lunar_lr_mp[i]];
+        const double* fc = f_cos[zero + lunar_lr_f[i]];
+        const double* fs = f_sin[zero + lunar_lr_f[i]];
+        const double* ef = in->e_pow[abs(lunar_lr_m[i])];
+        const double kl = lunar_lr_sin_l[i];
+        const double kr = lunar_lr_cos_r[i];
+        
+        for (int j = 0; j < n; j++) {
+            double c = dc[j] * mc[j] - ds[j] * ms[j];
+            double s = ds[j] * mc[j] + dc[j] * ms[j];
+            double c2 = c * mpc[j] - s * mps[j];
+            double s2 = s * mpc[j] + c * mps[j];
+            double c3 = c2 * fc[j] - s2 * fs[j];
+            double s3 = s2 * fc[j] + c2 * fs[j];
+            sum_l[j] += kl * ef[j] * s3;
+            sum_r[j] += kr * ef[j] * c3;
+        }
+    }
+    
+    for (int i = 0; i < b_terms; i++) {
+        const double* dc = d_cos[zero + lunar_b_d[i]];
+        const double* ds = d_sin[zero + lunar_b_d[i]];
+        const double* mc = m_cos[zero + lunar_b_m[i]];
+        const double* ms = m_sin[zero + lunar_b_m[i]];
+        const double* mpc = mp_cos[zero + lunar_b_mp[i]];
+        const double* mps = mp_sin[zero + lunar_b_mp[i]];
+        const double* fc = f_cos[zero + lunar_b_f[i]];
+        const double* fs = f_sin[zero + lunar_b_f[i]];
+        const double* ef = in->e_pow[abs(lunar_b_m[i])];
+        const double kb = lunar_b_sin_b[i];
+        
+        for (int j = 0; j < n; j++) {
+            double c = dc[j] * mc[j] - ds[j] * ms[j];
+            double s = ds[j] * mc[j] + dc[j] * ms[j];
+            double c2 = c * mpc[j] - s * mps[j];
+            double s2 = s * mpc[j] + c * mps[j];
+            double s3 = s2 * fc[j] + c2 * fs[j];
+            sum_b[j] += kb * ef[j] * s3;
+        }
+    }
+    
+    for (int j = 0; j < n; j++) {
+        out[j].julian_day = in->julian_day[j];
+        out[j].longitude = lunar_normalize_degrees(in->Lp[j] + sum_l[j] / 1000000.0);
+        out[j].latitude = sum_b[j] / 1000000.0;
+        out[j].distance_km = 385000.56 + sum_r[j] / 1000.0;
+    }
+}
+
+static void lunar_position_block(const double* julian_days, int n, int lr_terms, int b_terms,
+                                 LunarPosition* out) {
+    LunarSeriesInput in;
+    lunar_series_input_direct(julian_days, n, b_terms > 0, &in);
+    lunar_series_evaluate(&in, n, lr_terms, b_terms, out);
+}
+
+// Geometric solar longitude (degrees) and Earth-Sun distance (AU), Meeus ch. 25
+static void lunar_sun_geometry(double julian_day, double* longitude, double* distance_au) {
+    double t = (julian_day - 2451545.0) / 36525.0;
+    
+    // Mean longitude of sun
+    double L0 = 280.4664567 + 36000.76982779 * t + 0.0003032 * t * t;
+    
+    // Mean anomaly of sun
+    double M = 357.5291092 + 35999.0502909 * t - 0.0001536 * t * t;
+    M *= M_PI / 180.0;
+    
+    // Equation of center
+    double C = (1.9146 - 0.004817 * t - 0.000014 * t * t) * sin(M) +
+               (0.019993 - 0.000101 * t) * sin(2.0 * M) +
+               0.000289 * sin(3.0 * M);
+    
+    // True longitude and radius vector
+    *longitude = lunar_normalize_degrees(L0 + C);
+    
+    double e = 0.016708634 - 0.000042037 * t - 0.0000001267 * t * t;
+    double v = M + C * LUNAR_DEG_TO_RAD;
+    *distance_au = 1.000001018 * (1.0 - e * e) / (1.0 + e * cos(v));
+}
+
+static double lunar_elongation_event(double julian_day, void* context) {
+    (void)context;
+    return lunar_elongation(julian_day);
+}
+
+// FAST tier: mean elements plus the five largest periodic terms of the
+// elongation. Arguments are reduced in double, the series runs in float.
+static double lunar_fast_elongation(double julian_day, double* distance_km) {
+    double t = (julian_day - 2451545.0) / 36525.0;
+    float D = (float)(lunar_normalize_degrees(297.8501921 + 445267.1114034 * t) * LUNAR_DEG_TO_RAD);
+    float M = (float)(lunar_normalize_degrees(357.5291092 + 35999.0502909 * t) * LUNAR_DEG_TO_RAD);
+    float Mp = (float)(lunar_normalize_degrees(134.9633964 + 477198.8675055 * t) * LUNAR_DEG_TO_RAD);
+    
+    // Equation of centre, evection and variation of the moon; equation of centre
+    // of the sun together with the moon's annual equation
+    float periodic = 6.2888f * sinf(Mp) + 1.2740f * sinf(2.0f * D - Mp) + 0.6583f * sinf(2.0f * D) +
+                     0.2136f * sinf(2.0f * Mp) - 2.1001f * sinf(M);
+    if (distance_km) {
+        *distance_km = 385000.56 - 20905.355 * cos(Mp) - 3699.111 * cos(2.0f * D - Mp) -
+                       2955.968 * cos(2.0f * D);
+    }
+    return lunar_normalize_degrees(D / LUNAR_DEG_TO_RAD + periodic + LUNAR_SOLAR_ABERRATION);
+}
+
+// STANDARD tier: the leading terms of table 47.A through the blocked kernel;
+// the instant is used as TT directly (Delta-T moves the moon ~0.01 deg)
+static void lunar_standard_elongation_block(const double* julian_days, int n,
+                                            double* angles, double* distance_km) {
+    LunarPosition moon[LUNAR_BATCH_BLOCK];
+    lunar_position_block(julian_days, n, LUNAR_STANDARD_TERMS, 0, moon);
+    for (int j = 0; j < n; j++) {
+        angles[j] = lunar_normalize_degrees(moon[j].longitude - lunar_solar_longitude(julian_days[j]) +
+                                            LUNAR_SOLAR_ABERRATION);
+        if (distance_km) distance_km[j] = moon[j].distance_km;
+    }
+}
+
+static double lunar_standard_elongation(double julian_day, double* distance_km) {
+    double angle;
+    lunar_standard_elongation_block(&julian_day, 1, &angle, distance_km);
+    return angle;
+}
+
+// Phase class from the elongation, centred on the principal phases
+static LunarPhase lunar_phase_from_angle(double D) {
+    if (D < 11.25 || D >= 348.75) {
+        return LUNAR_NEW_MOON;
+    } else if (D < 56.25) {
+        return LUNAR_WAXING_CRESCENT;
+    } else if (D < 123.75) {
+        return LUNAR_FIRST_QUARTER;
+    } else if (D < 146.25) {
+        return LUNAR_WAXING_GIBBOUS;
+    } else if (D < 213.75) {
+        return LUNAR_FULL_MOON;
+    } else if (D < 236.25) {
+        return LUNAR_WANING_GIBBOUS;
+    } else if (D < 303.75) {
+        return LUNAR_LAST_QUARTER;
+    } else {
+        return LUNAR_WANING_CRESCENT;
+    }
+}
+
+void lunar_set_default_precision(LunarPrecision precision) {
+    lunar_default_precision = precision;
+}
+
+LunarPrecision lunar_get_default_precision(void) {
+    return lunar_default_precision;
+}
+
+CalendarResult lunar_calculate_info(double julian_day, LunarPrecision precision, PreciseLunarInfo* info) {
+    if (!info) return CALENDAR_ERROR_NULL_POINTER;
+    
+    info->julian_day = julian_day;
+    
+    double D;
+    if (precision == LUNAR_PRECISION_PRECISE) {
+        double jde = time_ut_to_tt(julian_day);
+        
+        // One series evaluation feeds phase, illumination and distance
+        LunarPosition moon;
+        lunar_calculate_position(jde, &moon);
+        
+        double sun_longitude, sun_distance_au;
+        lunar_sun_geometry(jde, &sun_longitude, &sun_distance_au);
+        
+        // Apparent elongation of the moon from the sun (0 = new moon, 180 = full moon)
+        D = lunar_normalize_degrees(moon.longitude - sun_longitude + LUNAR_SOLAR_ABERRATION);
+        
+        // Phase angle at the moon (Meeus 48.2, 48.3) gives the illuminated fraction
+        double beta = moon.latitude * LUNAR_DEG_TO_RAD;
+        double cos_psi = cos(beta) * cos(D * LUNAR_DEG_TO_RAD);
+        double psi = acos(cos_psi);
+        double sun_distance_km = sun_distance_au * LUNAR_AU_KM;
+        double i = atan2(sun_distance_km * sin(psi),
+                         moon.distance_km - sun_distance_km * cos_psi);
+        info->moon_illumination = (1.0 + cos(i)) / 2.0;
+        info->moon_distance_km = moon.distance_km;
+    } else {
+        D = precision == LUNAR_PRECISION_FAST
+            ? lunar_fast_elongation(julian_day, &info->moon_distance_km)
+            : lunar_standard_elongation(julian_day, &info->moon_distance_km);
+        info->moon_illumination = (1.0 - cos(D * LUNAR_DEG_TO_RAD)) / 2.0;
+    }
+    
+    info->moon_phase_angle = D;
+    info->moon_age_precise = D / 360.0 * LUNAR_MONTH_PRECISE;
+    info->phase = lunar_phase_from_angle(D);
+    return CALENDAR_SUCCESS;
+}
+
+double lunar_phase_angle(double julian_day, LunarPrecision precision) {
+    switch (precision) {
+        case LUNAR_PRECISION_FAST:
+            return lunar_fast_elongation(julian_day, NULL);
+        case LUNAR_PRECISION_STANDARD:
+            return lunar_standard_elongation(julian_day, NULL);
+        default:
+            return lunar_elongation(time_ut_to_tt(julian_day));
+    }
+}
+
+CalendarResult lunar_phase_angle_batch(const double* julian_days, int count,
+                                       LunarPrecision precision, double* angles) {
+    if (!julian_days || !angles) return CALENDAR_ERROR_NULL_POINTER;
+    if (count < 0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    if (precision == LUNAR_PRECISION_FAST) {
+        for (int i = 0; i < count; i++) {
+            angles[i] = lunar_fast_elongation(julian_days[i], NULL);
+        }
+        return CALENDAR_SUCCESS;
+    }
+    
+    // The series tiers go through the blocked kernel
+    double jde[LUNAR_BATCH_BLOCK];
+    LunarPosition moon[LUNAR_BATCH_BLOCK];
+    for (int start = 0; start < count; start += LUNAR_BATCH_BLOCK) {
+        int n = count - start < LUNAR_BATCH_BLOCK ? count - start : LUNAR_BATCH_BLOCK;
+        if (precision == LUNAR_PRECISION_STANDARD) {
+            lunar_standard_elongation_block(julian_days + start, n, angles + start, NULL);
+            continue;
+        }
+        for (int j = 0; j < n; j++) jde[j] = time_ut_to_tt(julian_days[start + j]);
+        lunar_position_block(jde, n, LUNAR_LR_TERMS, LUNAR_B_TERMS, moon);
+        for (int j = 0; j < n; j++) {
+            angles[start + j] = lunar_normalize_degrees(moon[j].longitude - lunar_solar_longitude(jde[j]) +
+                                                        LUNAR_SOLAR_ABERRATION);
+        }
+    }
+    return CALENDAR_SUCCESS;
+}
+
+// Unit phasor of a linearly advancing angle, advanced by a fixed rotation
+typedef struct {
+    double c, s;
+    double step_c, step_s;
+} LunarRotor;
+
+// Range mode: every series term's argument is a fixed combination of angles
+// linear in time, so k*sin(arg) at equal steps obeys the second-order
+// recurrence x[n+1] = 2 cos(step) x[n] - x[n-1]: one multiply-add per term and
+// step. Terms are grouped by the power of E they carry (|m| = 0, 1, 2), so the
+// slowly varying eccentricity factor is applied per step to each group sum.
+#define LUNAR_RANGE_LR_TERMS (LUNAR_LR_TERMS + 3)
+#define LUNAR_RANGE_B_TERMS (LUNAR_B_TERMS + 6)
+
+typedef struct {
+    double sin_now[LUNAR_RANGE_B_TERMS];    // k_sin * sin(arg) at the current step
+    double sin_prev[LUNAR_RANGE_B_TERMS];
+    double cos_now[LUNAR_RANGE_B_TERMS];    // k_cos * cos(arg), longitude table only
+    double cos_prev[LUNAR_RANGE_B_TERMS];
+    double twice_cos_step[LUNAR_RANGE_B_TERMS];
+    int group_end[3];                       // End of the terms with |m| = 0, 1, 2
+    int count;
+} LunarTermSeries;
+
+// Angles advanced in range mode besides D, M, M', F (index matches LUNAR_ARG_*)
+enum { LUNAR_ANGLE_LP = 4, LUNAR_ANGLE_A1, LUNAR_ANGLE_A2, LUNAR_ANGLE_A3, LUNAR_ANGLE_L0, LUNAR_ANGLES };
+
+static void lunar_range_angles(double t, double* angles) {
+    lunar_fundamental_arguments(t, &angles[LUNAR_ANGLE_LP], &angles[LUNAR_ARG_D], &angles[LUNAR_ARG_M],
+                                &angles[LUNAR_ARG_MP], &angles[LUNAR_ARG_F]);
+    angles[LUNAR_ANGLE_A1] = 119.75 + 131.849 * t;
+    angles[LUNAR_ANGLE_A2] = 53.09 + 479264.290 * t;
+    angles[LUNAR_ANGLE_A3] = 313.45 + 481266.484 * t;
+    angles[LUNAR_ANGLE_L0] = 280.4664567 + 36000.76982779 * t + 0.0003032 * t * t;
+}
+
+static void lunar_rotor_start(LunarRotor* rotor, double angle_deg, double step_deg) {
+    double angle = lunar_normalize_degrees(angle_deg) * LUNAR_DEG_TO_RAD;
+    rotor->c = cos(angle);
+    rotor->s = sin(angle);
+    rotor->step_c = cos(step_deg * LUNAR_DEG_TO_RAD);
+    rotor->step_s = sin(step_deg * LUNAR_DEG_TO_RAD);
+}
+
+static void lunar_rotor_advance(LunarRotor* rotor) {
+    double c = rotor->c * rotor->step_c - rotor->s * rotor->step_s;
+    rotor->s = rotor->s * rotor->step_c + rotor->c * rotor->step_s;
+    rotor->c = c;
+}
+
+// Append a term given its phasor at the block start and its step phasor
+static void lunar_term_append(LunarTermSeries* terms, double c, double s, double step_c, double step_s,
+                              double k_sin, double k_cos) {
+    int i = terms->count++;
+    terms->sin_now[i] = k_sin * s;
+    terms->sin_prev[i] = k_sin * (s * step_c - c * step_s);
+    terms->cos_now[i] = k_cos * c;
+    terms->cos_prev[i] = k_cos * (c * step_c + s * step_s);
+    terms->twice_cos_step[i] = 2.0 * step_c;
+}
+
+static void lunar_term_append_angle(LunarTermSeries* terms, double angle_deg, double step_deg, double k_sin) {
+    LunarRotor rotor;
+    lunar_rotor_start(&rotor, angle_deg, step_deg);
+    lunar_term_append(terms, rotor.c, rotor.s, rotor.step_c, rotor.step_s, k_sin, 0.0);
+}
+
+// Table rows from the harmonics of D, M, M' and F (column 0: block start,
+// column 1: step), appended group by group after any additive terms
+static void lunar_term_append_table(LunarTermSeries* terms, int rows,
+                                    const signed char* td, const signed char* tm,
+                                    const signed char* tmp, const signed char* tf,
+                                    const double* k_sin, const double* k_cos,
+                                    double cos_rows[4][LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK],
+                                    double sin_rows[4][LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK]) {
+    const int zero = LUNAR_MAX_MULTIPLE;
+    for (int group = 0; group < 3; group++) {
+        for (int i = 0; i < rows; i++) {
+            if (abs(tm[i]) != group) continue;
+            
+            const int row[4] = { zero + td[i], zero + tm[i], zero + tmp[i], zero + tf[i] };
+            double c[2], s[2];
+            for (int j = 0; j < 2; j++) {
+                c[j] = 1.0;
+                s[j] = 0.0;
+                for (int a = 0; a < 4; a++) {
+                    double ca = cos_rows[a][row[a]][j], sa = sin_rows[a][row[a]][j];
+                    double next = c[j] * ca - s[j] * sa;
+                    s[j] = s[j] * ca + c[j] * sa;
+                    c[j] = next;
+                }
+            }
+            lunar_term_append(terms, c[0], s[0], c[1], s[1], k_sin[i], k_cos ? k_cos[i] : 0.0);
+        }
+        terms->group_end[group] = terms->count;
     }
-    return days_since_new_moon;
+}
+
+// sin and cos of a small angle (|x| < 0.2 rad) from the Taylor series
+static void lunar_small_sincos(double x, double* s, double* c) {
+    double x2 = x * x;
+    *s = x * (1.0 - x2 / 6.0 * (1.0 - x2 / 20.0 * (1.0 - x2 / 42.0 * (1.0 - x2 / 72.0))));
+    *c = 1.0 - x2 / 2.0 * (1.0 - x2 / 12.0 * (1.0 - x2 / 30.0 * (1.0 - x2 / 56.0 * (1.0 - x2 / 90.0))));
+}
+
+// Re-evaluate every term exactly at the start of a block
+static void lunar_range_start_block(double t0, double step_t, LunarTermSeries* lr, LunarTermSeries* b,
+                                    LunarRotor* sun_anomaly, LunarRotor* mean_elongation) {
+    double angles[LUNAR_ANGLES], next[LUNAR_ANGLES], step[LUNAR_ANGLES];
+    lunar_range_angles(t0, angles);
+    lunar_range_angles(t0 + step_t, next);
+    for (int a = 0; a < LUNAR_ANGLES; a++) step[a] = next[a] - angles[a];
+    
+    double cos1[4][LUNAR_BATCH_BLOCK], sin1[4][LUNAR_BATCH_BLOCK];
+    double cos_rows[4][LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK];
+    double sin_rows[4][LUNAR_HARMONIC_ROWS][LUNAR_BATCH_BLOCK];
+    for (int a = 0; a < 4; a++) {
+        double start = lunar_normalize_degrees(angles[a]) * LUNAR_DEG_TO_RAD;
+        cos1[a][0] = cos(start);
+        sin1[a][0] = sin(start);
+        cos1[a][1] = cos(step[a] * LUNAR_DEG_TO_RAD);
+        sin1[a][1] = sin(step[a] * LUNAR_DEG_TO_RAD);
+        lunar_fill_harmonics(cos1[a], sin1[a], 2, cos_rows[a], sin_rows[a]);
+    }
+    
+    // Additive terms (|m| = 0): Venus (A1), Jupiter (A2) and flattening of the Earth
+    double A1 = angles[LUNAR_ANGLE_A1], A2 = angles[LUNAR_ANGLE_A2], A3 = angles[LUNAR_ANGLE_A3];
+    double Lp = angles[LUNAR_ANGLE_LP], Mp = angles[LUNAR_ARG_MP], F = angles[LUNAR_ARG_F];
+    double dA1 = step[LUNAR_ANGLE_A1], dLp = step[LUNAR_ANGLE_LP];
+    double dMp = step[LUNAR_ARG_MP], dF = step[LUNAR_ARG_F];
+    
+    lr->count = 0;
+    lunar_term_append_angle(lr, A1, dA1, 3958.0);
+    lunar_term_append_angle(lr, Lp - F, dLp - dF, 1962.0);
+    lunar_term_append_angle(lr, A2, step[LUNAR_ANGLE_A2], 318.0);
+    lunar_term_append_table(lr, LUNAR_LR_TERMS, lunar_lr_d, lunar_lr_m, lunar_lr_mp, lunar_lr_f,
+                            lunar_lr_sin_l, lunar_lr_cos_r, cos_rows, sin_rows);
+    
+    b->count = 0;
+    lunar_term_append_angle(b, Lp, dLp, -2235.0);
+    lunar_term_append_angle(b, A3, step[LUNAR_ANGLE_A3], 382.0);
+    lunar_term_append_angle(b, A1 - F, dA1 - dF, 175.0);
+    lunar_term_append_angle(b, A1 + F, dA1 + dF, 175.0);
+    lunar_term_append_angle(b, Lp - Mp, dLp - dMp, 127.0);
+    lunar_term_append_angle(b, Lp + Mp, dLp + dMp, -115.0);
+    lunar_term_append_table(b, LUNAR_B_TERMS, lunar_b_d, lunar_b_m, lunar_b_mp, lunar_b_f,
+                            lunar_b_sin_b, NULL, cos_rows, sin_rows);
+    
+    lunar_rotor_start(sun_anomaly, angles[LUNAR_ARG_M], step[LUNAR_ARG_M]);
+    lunar_rotor_start(mean_elongation, Lp - angles[LUNAR_ANGLE_L0], dLp - step[LUNAR_ANGLE_L0]);
+}
+
+// Sums of one group of terms for the next LUNAR_RANGE_UNROLL steps; each term is
+// loaded and stored once per pass rather than once per step
+static void lunar_range_group_steps(double* now, double* prev, const double* twice_cos_step,
+                                    int begin, int end, double* sums) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    
+    #pragma omp simd reduction(+:s0, s1, s2, s3)
+    for (int i = begin; i < end; i++) {
+        double k = twice_cos_step[i];
+        double x0 = now[i];
+        double x1 = k * x0 - prev[i];
+        double x2 = k * x1 - x0;
+        double x3 = k * x2 - x1;
+        s0 += x0;
+        s1 += x1;
+        s2 += x2;
+        s3 += x3;
+        now[i] = k * x3 - x2;
+        prev[i] = x3;
+    }
+    sums[0] = s0;
+    sums[1] = s1;
+    sums[2] = s2;
+    sums[3] = s3;
+}
+
+// Series sums for the next LUNAR_RANGE_UNROLL steps, with E applied per group
+static void lunar_range_series_steps(LunarTermSeries* terms, int with_cos, const double* E,
+                                     double* sum_sin, double* sum_cos) {
+    double factor[LUNAR_RANGE_UNROLL], sums[LUNAR_RANGE_UNROLL];
+    int begin = 0;
+    for (int q = 0; q < LUNAR_RANGE_UNROLL; q++) {
+        factor[q] = 1.0;
+        sum_sin[q] = 0.0;
+        sum_cos[q] = 0.0;
+    }
+    for (int group = 0; group < 3; group++) {
+        int end = terms->group_end[group];
+        lunar_range_group_steps(terms->sin_now, terms->sin_prev, terms->twice_cos_step, begin, end, sums);
+        for (int q = 0; q < LUNAR_RANGE_UNROLL; q++) sum_sin[q] += factor[q] * sums[q];
+        if (with_cos) {
+            lunar_range_group_steps(terms->cos_now, terms->cos_prev, terms->twice_cos_step, begin, end, sums);
+            for (int q = 0; q < LUNAR_RANGE_UNROLL; q++) sum_cos[q] += factor[q] * sums[q];
+        }
+        for (int q = 0; q < LUNAR_RANGE_UNROLL; q++) factor[q] *= E[q];
+        begin = end;
+    }
+}
+
+CalendarResult lunar_calculate_info_range(double start_jd, double step_days, int count,
+                                          PreciseLunarInfo* infos) {
+    if (!infos) return CALENDAR_ERROR_NULL_POINTER;
+    if (count < 0 || !(step_days > 0.0)) return CALENDAR_ERROR_INVALID_DATE;
+    
+    LunarTermSeries lr, b;
+    LunarRotor sun_anomaly, mean_elongation;
+    int block = LUNAR_RANGE_MAX_STEPS;
+    if (block * step_days > LUNAR_RANGE_MAX_DAYS) block = (int)(LUNAR_RANGE_MAX_DAYS / step_days);
+    if (block < 1) block = 1;
+    
+    for (int start = 0; start < count; start += block) {
+        int n = count - start < block ? count - start : block;
+        
+        // The series advance at a constant TT step; the small departure of
+        // Delta-T from a straight line across the block is applied per step below
+        double jde0 = time_ut_to_tt(start_jd + start * step_days);
+        double step_tt = step_days;
+        if (n > 1) {
+            step_tt = (time_ut_to_tt(start_jd + (start + n - 1) * step_days) - jde0) / (n - 1);
+        }
+        double t0 = (jde0 - 2451545.0) / 36525.0;
+        double step_t = step_tt / 36525.0;
+        lunar_range_start_block(t0, step_t, &lr, &b, &sun_anomaly, &mean_elongation);
+        
+        double sum_l[LUNAR_RANGE_UNROLL], sum_r[LUNAR_RANGE_UNROLL];
+        double sum_b[LUNAR_RANGE_UNROLL], unused[LUNAR_RANGE_UNROLL];
+        for (int j = 0; j < n; j++) {
+            PreciseLunarInfo* info = &infos[start + j];
+            double t = t0 + j * step_t;
+            double t2 = t * t;
+            int q = j % LUNAR_RANGE_UNROLL;
+            
+            if (q == 0) {
+                double E[LUNAR_RANGE_UNROLL];
+                for (int u = 0; u < LUNAR_RANGE_UNROLL; u++) {
+                    double tu = t + u * step_t;
+                    E[u] = 1.0 - 0.002516 * tu - 0.0000074 * tu * tu;
+                }
+                lunar_range_series_steps(&lr, 1, E, sum_l, sum_r);
+                lunar_range_series_steps(&b, 0, E, sum_b, unused);
+            }
+            
+            // Moon: only the mean longitude needs its polynomial
+            double Lp = 218.3164477 + 481267.88123421 * t - 0.0015786 * t2 +
+                        t2 * t * (1.0 / 538841.0) - t2 * t2 * (1.0 / 65194000.0);
+            double ut = start_jd + (start + j) * step_days;
+            double tt_offset = time_ut_to_tt(ut) - (jde0 + j * step_tt);
+            double moon_longitude = Lp + sum_l[q] / 1000000.0 + LUNAR_MOON_MEAN_RATE * tt_offset;
+            double moon_distance = 385000.56 + sum_r[q] / 1000.0;
+            
+            // Sun as in lunar_sun_geometry, with sin kM from the rotated phasor
+            double s1 = sun_anomaly.s, c1 = sun_anomaly.c;
+            double s2 = 2.0 * s1 * c1;
+            double s3 = s1 * (3.0 - 4.0 * s1 * s1);
+            double C = (1.9146 - 0.004817 * t - 0.000014 * t2) * s1 +
+                       (0.019993 - 0.000101 * t) * s2 + 0.000289 * s3;
+            double L0 = 280.4664567 + 36000.76982779 * t + 0.0003032 * t2;
+            double e = 0.016708634 - 0.000042037 * t - 0.0000001267 * t2;
+            double sin_c, cos_c;
+            lunar_small_sincos(C * LUNAR_DEG_TO_RAD, &sin_c, &cos_c);
+            double cos_v = c1 * cos_c - s1 * sin_c;
+            double sun_distance_km = 1.000001018 * (1.0 - e * e) / (1.0 + e * cos_v) * LUNAR_AU_KM;
+            
+            double D = moon_longitude - L0 - C + LUNAR_SOLAR_ABERRATION - LUNAR_SUN_MEAN_RATE * tt_offset;
+            D -= 360.0 * floor(D / 360.0);
+            
+            // cos D: the mean elongation phasor turned by the small periodic part
+            double delta = (sum_l[q] / 1000000.0 - C + LUNAR_SOLAR_ABERRATION +
+                            (LUNAR_MOON_MEAN_RATE - LUNAR_SUN_MEAN_RATE) * tt_offset) * LUNAR_DEG_TO_RAD;
+            double sin_delta, cos_delta;
+            lunar_small_sincos(delta, &sin_delta, &cos_delta);
+            double cos_d = mean_elongation.c * cos_delta - mean_elongation.s * sin_delta;
+            
+            // Illuminated fraction as in lunar_calculate_info, without inverse trigonometry
+            double beta = sum_b[q] / 1000000.0 * LUNAR_DEG_TO_RAD, beta2 = beta * beta;
+            double cos_beta = 1.0 - beta2 / 2.0 * (1.0 - beta2 / 12.0 * (1.0 - beta2 / 30.0 * (1.0 - beta2 / 56.0)));
+            double cos_psi = cos_beta * cos_d;
+            double sin_psi = sqrt(fmax(0.0, 1.0 - cos_psi * cos_psi));
+            double x = moon_distance - sun_distance_km * cos_psi;
+            double y = sun_distance_km * sin_psi;
+            
+            info->julian_day = ut;
+            info->moon_phase_angle = D;
+            info->moon_age_precise = D / 360.0 * LUNAR_MONTH_PRECISE;
+            info->moon_illumination = (1.0 + x / sqrt(x * x + y * y)) / 2.0;
+            info->moon_distance_km = moon_distance;
+            info->phase = lunar_phase_from_angle(D);
+            
+            lunar_rotor_advance(&sun_anomaly);
+            lunar_rotor_advance(&mean_elongation);
+        }
+    }
+    return CALENDAR_SUCCESS;
+}
+
+double lunar_moon_age(double julian_day, LunarPrecision precision) {
+    return lunar_phase_angle(julian_day, precision) / 360.0 * LUNAR_MONTH_PRECISE;
+}
+
+double lunar_calculate_moon_age(long julian_day) {
+    return lunar_moon_age((double)julian_day, lunar_default_precision);
 }
 
 LunarPhase lunar_get_phase(double moon_age) {
@@ -57,92 +823,7 @@ PreciseLunarInfo* lunar_calculate_precise(double julian_day) {
     PreciseLunarInfo* info = malloc(sizeof(PreciseLunarInfo));
     if (!info) return NULL;
     
-    info->julian_day = julian_day;
-    
-    // Julian centuries since J2000.0
-    double t = (julian_day - 2451545.0) / 36525.0;
-    
-    // Moon's mean longitude (degrees)
-    double L = 218.3164591 + 481267.88134236 * t - 0.0013268 * t * t + 
-               t * t * t / 538841.0 - t * t * t * t / 65194000.0;
-    
-    // Sun's mean longitude (degrees)
-    double L_sun = 280.4664567 + 36000.76982779 * t + 0.0003032 * t * t;
-    
-    // Moon's mean elongation from sun (degrees)
-    double D = L - L_sun;
-    D = fmod(D, 360.0);
-    if (D < 0) D += 360.0;
-    
-    // Moon's mean anomaly (degrees)
-    double M = 134.9634114 + 477198.8676313 * t + 0.008997 * t * t + 
-               t * t * t / 69699.0 - t * t * t * t / 14712000.0;
-    M = fmod(M, 360.0);
-    
-    // Sun's mean anomaly (degrees)
-    double M_sun = 357.5291092 + 35999.0502909 * t - 0.0001536 * t * t + 
-                   t * t * t / 24490000.0;
-    M_sun = fmod(M_sun, 360.0);
-    
-    // Moon's argument of latitude (degrees)
-    double F = 93.2720993 + 483202.0175273 * t - 0.0034029 * t * t - 
-               t * t * t / 3526000.0 + t * t * t * t / 863310000.0;
-    F = fmod(F, 360.0);
-    
-    // Convert to radians
-    double D_rad = D * M_PI / 180.0;
-    double M_rad = M * M_PI / 180.0;
-    double M_sun_rad = M_sun * M_PI / 180.0;
-    double F_rad = F * M_PI / 180.0;
-    
-    // Calculate corrections for more precise moon phase
-    double correction = 0.0;
-    correction += -0.40720 * sin(M_sun_rad);
-    correction += 0.17241 * sin(M_rad);
-    correction += 0.01608 * sin(2.0 * M_sun_rad);
-    correction += 0.01039 * sin(2.0 * F_rad);
-    correction += 0.00739 * sin(M_rad - M_sun_rad);
-    correction += -0.00514 * sin(M_rad + M_sun_rad);
-    correction += 0.00208 * sin(2.0 * M_rad);
-    
-    D += correction;
-    if (D < 0) D += 360.0;
-    if (D >= 360.0) D -= 360.0;
-    
-    info->moon_phase_angle = D;
-    info->moon_age_precise = D / 360.0 * LUNAR_MONTH_PRECISE;
-    
-    // Calculate precise illumination
-    info->moon_illumination = (1.0 - cos(D * M_PI / 180.0)) / 2.0;
-    
-    // Calculate moon distance (simplified Meeus algorithm)
-    double lunar_distance_correction = 0.0;
-    lunar_distance_correction += -20905.0 * cos(M_rad);
-    lunar_distance_correction += -3699.0 * cos(2.0 * D_rad - M_rad);
-    lunar_distance_correction += -2956.0 * cos(2.0 * D_rad);
-    lunar_distance_correction += -570.0 * cos(2.0 * M_rad);
-    
-    info->moon_distance_km = 385000.56 + lunar_distance_correction / 1000.0;
-    
-    // Determine precise phase with better boundaries
-    if (D < 11.25 || D >= 348.75) {
-        info->phase = LUNAR_NEW_MOON;
-    } else if (D < 56.25) {
-        info->phase = LUNAR_WAXING_CRESCENT;
-    } else if (D < 123.75) {
-        info->phase = LUNAR_FIRST_QUARTER;
-    } else if (D < 146.25) {
-        info->phase = LUNAR_WAXING_GIBBOUS;
-    } else if (D < 213.75) {
-        info->phase = LUNAR_FULL_MOON;
-    } else if (D < 236.25) {
-        info->phase = LUNAR_WANING_GIBBOUS;
-    } else if (D < 303.75) {
-        info->phase = LUNAR_LAST_QUARTER;
-    } else {
-        info->phase = LUNAR_WANING_CRESCENT;
-    }
-    
+    lunar_calculate_info(julian_day, LUNAR_PRECISION_PRECISE, info);
     return info;
 }
 
@@ -181,41 +862,25 @@ double lunar_calculate_new_moon_precise(double julian_day) {
     correction += 0.00739 * sin(M - M_sun);
     correction += -0.00514 * sin(M + M_sun);
     
-    return JDE + correction;
+    // Refine the series estimate to the instant the elongation crosses zero
+    EventSearchSpec spec = {0};
+    spec.function = lunar_elongation_event;
+    spec.kind = EVENT_VALUE_ANGLE;
+    spec.target = 0.0;
+    spec.tolerance_days = LUNAR_EVENT_TOLERANCE_DAYS;
+    return time_tt_to_ut(event_refine_root(&spec, JDE + correction - 1.5, JDE + correction + 1.5, NULL));
 }
 
 double lunar_solar_longitude(double julian_day) {
-    double t = (julian_day - 2451545.0) / 36525.0;
-    
-    // Mean longitude of sun
-    double L0 = 280.4664567 + 36000.76982779 * t + 0.0003032 * t * t;
-    
-    // Mean anomaly of sun
-    double M = 357.5291092 + 35999.0502909 * t - 0.0001536 * t * t;
-    M *= M_PI / 180.0;
-    
-    // Equation of center
-    double C = (1.9146 - 0.004817 * t - 0.000014 * t * t) * sin(M) +
-               (0.019993 - 0.000101 * t) * sin(2.0 * M) +
-               0.000289 * sin(3.0 * M);
-    
-    // True longitude
-    double longitude = L0 + C;
-    longitude = fmod(longitude, 360.0);
-    if (longitude < 0) longitude += 360.0;
-    
+    double longitude, distance_au;
+    lunar_sun_geometry(julian_day, &longitude, &distance_au);
     return longitude;
 }
 
 double lunar_moon_longitude(double julian_day) {
-    double t = (julian_day - 2451545.0) / 36525.0;
-    
-    // Moon's mean longitude
-    double L = 218.3164591 + 481267.88134236 * t - 0.0013268 * t * t;
-    L = fmod(L, 360.0);
-    if (L < 0) L += 360.0;
-    
-    return L;
+    LunarPosition position;
+    lunar_calculate_position(julian_day, &position);
+    return position.longitude;
 }
 
 double lunar_equation_of_time(double julian_day) {
@@ -231,13 +896,85 @@ double lunar_equation_of_time(double julian_day) {
     return equation; // in minutes
 }
 
+double lunar_elongation(double julian_day) {
+    LunarPosition moon;
+    lunar_calculate_position(julian_day, &moon);
+    
+    double sun_longitude, sun_distance_au;
+    lunar_sun_geometry(julian_day, &sun_longitude, &sun_distance_au);
+    
+    // Apparent elongation; nutation is common to both bodies and cancels
+    return lunar_normalize_degrees(moon.longitude - sun_longitude + LUNAR_SOLAR_ABERRATION);
+}
+
+double lunar_find_next_phase(double julian_day, double phase_angle) {
+    EventSearchSpec spec = {0};
+    spec.function = lunar_elongation_event;
+    spec.kind = EVENT_VALUE_ANGLE;
+    spec.target = lunar_normalize_degrees(phase_angle);
+    spec.tolerance_days = LUNAR_EVENT_TOLERANCE_DAYS;
+    spec.min_rate = LUNAR_ELONGATION_MIN_RATE;
+    spec.max_rate = LUNAR_ELONGATION_MAX_RATE;
+    
+    double jde = time_ut_to_tt(julian_day);
+    EventCrossing crossing;
+    if (event_find_next(&spec, jde, jde + 2.0 * LUNAR_MONTH_PRECISE, &crossing) != CALENDAR_SUCCESS) {
+        return 0.0;
+    }
+    return time_tt_to_ut(crossing.julian_day);
+}
+
+CalendarResult lunar_calculate_position(double julian_day, LunarPosition* position) {
+    if (!position) return CALENDAR_ERROR_NULL_POINTER;
+    
+    lunar_position_block(&julian_day, 1, LUNAR_LR_TERMS, LUNAR_B_TERMS, position);
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult lunar_calculate_position_batch(const double* julian_days, int count,
+                                              LunarPosition* positions) {
+    if (!julian_days || !positions) return CALENDAR_ERROR_NULL_POINTER;
+    if (count < 0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    for (int start = 0; start < count; start += LUNAR_BATCH_BLOCK) {
+        int n = count - start < LUNAR_BATCH_BLOCK ? count - start : LUNAR_BATCH_BLOCK;
+        lunar_position_block(julian_days + start, n, LUNAR_LR_TERMS, LUNAR_B_TERMS, positions + start);
+    }
+    
+    return CALENDAR_SUCCESS;
+}
+
 CalendarResult islamic_from_gregorian_precise(const GregorianDate* greg_date, 
                                              IslamicDate* islamic_date,
                                              double longitude, double latitude) {
-    (void)longitude; // For future astronomical calculations
-    (void)latitude;  // For future astronomical calculations
+    if (!greg_date || !islamic_date) return CALENDAR_ERROR_NULL_POINTER;
+    
+    long jdn = julian_day_from_date(greg_date->base.day, greg_date->base.month, greg_date->base.year);
+    
+    // Month start at this location for the latest conjunction before the date
+    double conjunction = lunar_find_next_phase(jdn - 31.0, 0.0);
+    if (conjunction == 0.0) return CALENDAR_ERROR_CONVERSION_FAILED;
+    double next = lunar_find_next_phase(conjunction + 1.0, 0.0);
+    if (next == 0.0) return CALENDAR_ERROR_CONVERSION_FAILED;
+    if (next < jdn - 0.5) conjunction = next;
+    
+    long month_start = crescent_month_start(conjunction, latitude, longitude,
+                                            CRESCENT_DEFAULT_CRITERION, CRESCENT_DEFAULT_THRESHOLD);
+    if (month_start > jdn) {
+        conjunction = lunar_find_next_phase(conjunction - 31.0, 0.0);
+        if (conjunction == 0.0) return CALENDAR_ERROR_CONVERSION_FAILED;
+        month_start = crescent_month_start(conjunction, latitude, longitude,
+                                           CRESCENT_DEFAULT_CRITERION, CRESCENT_DEFAULT_THRESHOLD);
+    }
+    if (month_start <= 0 || month_start > jdn) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    // The tabular calendar is never off by half a month: it names the month
+    GregorianDate mid_month;
+    mid_month.julian_day = month_start + 14;
+    julian_day_to_date(mid_month.julian_day, &mid_month.base.day, &mid_month.base.month, &mid_month.base.year);
+    CalendarResult result = islamic_from_gregorian(&mid_month, islamic_date);
+    if (result != CALENDAR_SUCCESS) return result;
     
-    // For now, use the existing conversion
-    // Future enhancement: Use lunar visibility calculations
-    return islamic_from_gregorian(greg_date, islamic_date);
-}
\ No newline at end of file
+    islamic_date->base.day = (int)(jdn - month_start) + 1;
+    return CALENDAR_SUCCESS;
+}
@@ -19,19 +19,69 @@ typedef struct {
     double moon_distance_km;     // Distance to moon in kilometers
 } PreciseLunarInfo;
 
-// Basic lunar calculations
+// Geocentric lunar position (Meeus ch. 47, ELP-2000/82 truncated series)
+typedef struct {
+    double julian_day;
+    double longitude;            // Geometric ecliptic longitude in degrees (0-360)
+    double latitude;             // Ecliptic latitude in degrees
+    double distance_km;          // Earth-Moon distance in kilometers
+} LunarPosition;
+
+// Precision tiers. Bounds are the largest phase-angle error against PRECISE over
+// 1900-2100; one degree of phase angle is about two hours of moon age.
+typedef enum {
+    LUNAR_PRECISION_FAST,       // Mean elements + five periodic terms, single precision
+    LUNAR_PRECISION_STANDARD,   // Largest 14 terms of table 47.A, UT taken as TT
+    LUNAR_PRECISION_PRECISE     // Full ELP-2000/82 truncation (Meeus ch. 47) with Delta-T
+} LunarPrecision;
+
+#define LUNAR_FAST_MAX_ERROR_DEG 0.5
+#define LUNAR_STANDARD_MAX_ERROR_DEG 0.12
+
+// Tier used by the functions without a precision argument (per thread, STANDARD by default)
+void lunar_set_default_precision(LunarPrecision precision);
+LunarPrecision lunar_get_default_precision(void);
+
+// Phase information at a UT instant in the given tier
+CalendarResult lunar_calculate_info(double julian_day, LunarPrecision precision, PreciseLunarInfo* info);
+double lunar_phase_angle(double julian_day, LunarPrecision precision);
+double lunar_moon_age(double julian_day, LunarPrecision precision);
+CalendarResult lunar_phase_angle_batch(const double* julian_days, int count,
+                                       LunarPrecision precision, double* angles);
+
+// PRECISE-tier information for start_jd + i * step_days (UT), i < count. The
+// arguments advance by rotation instead of trigonometric calls; results match
+// lunar_calculate_info() to LUNAR_RANGE_MAX_ERROR_DEG in phase angle, 1e-6 in
+// illumination and 0.05 km in distance.
+#define LUNAR_RANGE_MAX_ERROR_DEG 1e-5
+CalendarResult lunar_calculate_info_range(double start_jd, double step_days, int count,
+                                          PreciseLunarInfo* infos);
+
+// Basic lunar calculations (default tier, noon UT of the Julian Day Number)
 double lunar_calculate_moon_age(long julian_day);
 LunarPhase lunar_get_phase(double moon_age);
 const char* lunar_phase_name(LunarPhase phase);
 double lunar_calculate_illumination(double moon_age);
 
-// Enhanced astronomical calculations
+// Enhanced astronomical calculations (civil instants in UT); PRECISE tier
 PreciseLunarInfo* lunar_calculate_precise(double julian_day);
 double lunar_calculate_new_moon_precise(double julian_day);
+
+// Series values; the argument is in dynamical time (TT)
 double lunar_solar_longitude(double julian_day);
 double lunar_moon_longitude(double julian_day);
 double lunar_equation_of_time(double julian_day);
 
+// Lunar phase search in UT (phase_angle: 0 = new, 90 = first quarter, 180 = full, 270 = last quarter);
+// 0.0 when the search fails
+double lunar_elongation(double julian_day);  // TT
+double lunar_find_next_phase(double julian_day, double phase_angle);
+
+// Lunar position series (longitude, latitude, distance in one evaluation), TT
+CalendarResult lunar_calculate_position(double julian_day, LunarPosition* position);
+CalendarResult lunar_calculate_position_batch(const double* julian_days, int count,
+                                              LunarPosition* positions);
+
 // Enhanced Islamic calendar functions
 CalendarResult islamic_from_gregorian_precise(const GregorianDate* greg_date, 
                                              IslamicDate* islamic_date,
@@ -0,0 +1,252 @@
+// src/astronomy/lunar_rise_set.c
+#include "lunar_rise_set.h"
+#include "lunar_calc.h"
+#include "solar_calc.h"
+#include "time_scale.h"
+#include <string.h>
+
+#define RISE_SET_DEG_TO_RAD (M_PI / 180.0)
+#define RISE_SET_RAD_TO_DEG (180.0 / M_PI)
+#define RISE_SET_EARTH_RADIUS_KM 6378.14
+#define RISE_SET_MOON_RADIUS_KM 1737.4
+#define RISE_SET_FLATTENING (1.0 / 298.257)
+#define RISE_SET_REFRACTION 0.5667          // Horizon refraction, degrees
+#define RISE_SET_HOUR_RATE 347.81           // Mean rate of the moon's hour angle, degrees/day
+#define RISE_SET_MEAN_PASS 1.0350           // Mean interval between transits, days
+#define RISE_SET_MAX_ITERATIONS 8
+#define RISE_SET_TOLERANCE (1.0 / 86400.0)
+
+typedef struct {
+    double latitude;
+    double longitude;
+    double rho_cos_phi;         // Geocentric observer position, Earth radii (Meeus ch. 11)
+    double rho_sin_phi;
+} RiseSetObserver;
+
+// Topocentric moon at one instant
+typedef struct {
+    double hour_angle;          // Degrees, [-180, 180)
+    double declination;         // Degrees
+    double semidiameter;        // Degrees
+    double altitude;            // Degrees, without refraction
+    double azimuth;             // Degrees from north
+} RiseSetState;
+
+static void rise_set_observer_init(RiseSetObserver* observer, double latitude, double longitude) {
+    double u = atan((1.0 - RISE_SET_FLATTENING) * tan(latitude * RISE_SET_DEG_TO_RAD));
+    
+    observer->latitude = latitude;
+    observer->longitude = longitude;
+    observer->rho_cos_phi = cos(u);
+    observer->rho_sin_phi = (1.0 - RISE_SET_FLATTENING) * sin(u);
+}
+
+static double rise_set_wrap180(double angle) {
+    angle = fmod(angle, 360.0);
+    if (angle >= 180.0) angle -= 360.0;
+    if (angle < -180.0) angle += 360.0;
+    return angle;
+}
+
+// Topocentric equatorial and horizontal coordinates of the moon at a UT instant
+static void rise_set_moon(const RiseSetObserver* observer, double julian_day, RiseSetState* state) {
+    LunarPosition pos;
+    lunar_calculate_position(time_ut_to_tt(julian_day), &pos);
+    
+    double ra, dec;
+    solar_ecliptic_to_equatorial(pos.longitude, pos.latitude, &ra, &dec);
+    
+    // Shift the geocentric vector to the observer: parallax in both coordinates
+    double r = pos.distance_km / RISE_SET_EARTH_RADIUS_KM;
+    double alpha = ra * 15.0 * RISE_SET_DEG_TO_RAD;
+    double delta = dec * RISE_SET_DEG_TO_RAD;
+    double lst = solar_greenwich_sidereal_time(julian_day) * 15.0 + observer->longitude;
+    double theta = lst * RISE_SET_DEG_TO_RAD;
+    
+    double x = r * cos(delta) * cos(alpha) - observer->rho_cos_phi * cos(theta);
+    double y = r * cos(delta) * sin(alpha) - observer->rho_cos_phi * sin(theta);
+    double z = r * sin(delta) - observer->rho_sin_phi;
+    double distance = sqrt(x * x + y * y + z * z);
+    
+    double topo_ra = atan2(y, x) * RISE_SET_RAD_TO_DEG;
+    state->declination = asin(z / distance) * RISE_SET_RAD_TO_DEG;
+    state->hour_angle = rise_set_wrap180(lst - topo_ra);
+    state->semidiameter = asin(RISE_SET_MOON_RADIUS_KM / (distance * RISE_SET_EARTH_RADIUS_KM)) * RISE_SET_RAD_TO_DEG;
+    solar_equatorial_to_horizontal(topo_ra / 15.0, state->declination, observer->latitude, lst / 15.0,
+                                   &state->azimuth, &state->altitude);
+}
+
+// Hour angle at which the upper limb touches the refracted horizon; 0 when the
+// moon stays above or below the horizon all day at this declination
+static int rise_set_horizon_angle(const RiseSetObserver* observer, const RiseSetState* state, double* angle) {
+    double h0 = (-RISE_SET_REFRACTION - state->semidiameter) * RISE_SET_DEG_TO_RAD;
+    double phi = observer->latitude * RISE_SET_DEG_TO_RAD;
+    double delta = state->declination * RISE_SET_DEG_TO_RAD;
+    double cos_h0 = (sin(h0) - sin(phi) * sin(delta)) / (cos(phi) * cos(delta));
+    
+    if (cos_h0 < -1.0 || cos_h0 > 1.0) return 0;
+    *angle = acos(cos_h0) * RISE_SET_RAD_TO_DEG;
+    return 1;
+}
+
+static double rise_set_refine_transit(const RiseSetObserver* observer, double t, RiseSetState* state) {
+    for (int iter = 0; iter < RISE_SET_MAX_ITERATIONS; iter++) {
+        rise_set_moon(observer, t, state);
+        double dt = -state->hour_angle / RISE_SET_HOUR_RATE;
+        t += dt;
+        if (fabs(dt) < RISE_SET_TOLERANCE) break;
+    }
+    return t;
+}
+
+// Height of the upper limb above the refracted horizon, degrees
+static double rise_set_limb_height(const RiseSetState* state) {
+    return state->altitude + state->semidiameter + RISE_SET_REFRACTION;
+}
+
+// Rise (sign -1) or set (sign +1) nearest the guess, by hour-angle steps
+static int rise_set_refine_horizon(const RiseSetObserver* observer, double t, int sign,
+                                   RiseSetState* state, double* result) {
+    for (int iter = 0; iter < RISE_SET_MAX_ITERATIONS; iter++) {
+        rise_set_moon(observer, t, state);
+        
+        double h0;
+        if (!rise_set_horizon_angle(observer, state, &h0)) return 0;
+        
+        double dt = rise_set_wrap180(sign * h0 - state->hour_angle) / RISE_SET_HOUR_RATE;
+        t += dt;
+        if (fabs(dt) < RISE_SET_TOLERANCE) {
+            *result = t;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Horizon crossing inside [a, b] where the limb height changes sign. The
+// hour-angle iteration from the guess settles almost every case in two or three
+// evaluations; near the polar circles, where the declination moves faster than
+// the horizon angle can follow, fall back to the Illinois method on the bracket.
+static double rise_set_find_crossing(const RiseSetObserver* observer, int sign, double guess,
+                                     double a, double fa, double b, double fb,
+                                     RiseSetState* state) {
+    double t;
+    if (rise_set_refine_horizon(observer, guess, sign, state, &t) && t >= a && t <= b) {
+        return t;
+    }
+    
+    t = a;
+    for (int iter = 0; iter < 4 * RISE_SET_MAX_ITERATIONS && fabs(b - a) > RISE_SET_TOLERANCE; iter++) {
+        t = b - fb * (b - a) / (fb - fa);
+        rise_set_moon(observer, t, state);
+        double ft = rise_set_limb_height(state);
+        
+        if ((ft < 0.0) != (fb < 0.0)) {
+            a = b;
+            fa = fb;
+        } else {
+            fa *= 0.5;
+        }
+        b = t;
+        fb = ft;
+    }
+    return t;
+}
+
+// Day slot of an instant, or -1 outside the requested range
+static int rise_set_day_index(double t, double window_start, int days) {
+    double offset = floor(t - window_start);
+    return offset >= 0.0 && offset < days ? (int)offset : -1;
+}
+
+CalendarResult lunar_calculate_rise_set_range(double start_jd, int days,
+                                              double latitude, double longitude,
+                                              double utc_offset_hours, LunarRiseSet* results) {
+    if (!results) return CALENDAR_ERROR_NULL_POINTER;
+    if (days <= 0 || latitude < -90.0 || latitude > 90.0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    long first_jdn = (long)floor(start_jd + 0.5);
+    double window_start = first_jdn - 0.5 - utc_offset_hours / 24.0;   // Local midnight, UT
+    double window_end = window_start + days;
+    
+    memset(results, 0, sizeof(LunarRiseSet) * days);
+    for (int i = 0; i < days; i++) {
+        results[i].julian_day_number = first_jdn + i;
+    }
+    
+    RiseSetObserver observer;
+    rise_set_observer_init(&observer, latitude, longitude);
+    RiseSetState state;
+    
+    // Start a pass early so a moonset just after midnight on day 0 is found
+    double half = RISE_SET_MEAN_PASS / 2.0;
+    double transit = rise_set_refine_transit(&observer, window_start - 1.0, &state);
+    double lower_jd = transit - half;
+    RiseSetState lower;
+    rise_set_moon(&observer, lower_jd, &lower);
+    double lower_height = rise_set_limb_height(&lower);
+    
+    double interval = RISE_SET_MEAN_PASS;
+    double rise_offset = 0.0, set_offset = 0.0;
+    int have_rise = 0, have_set = 0;
+    
+    while (transit - half < window_end) {
+        double upper_height = rise_set_limb_height(&state);
+        int day = rise_set_day_index(transit, window_start, days);
+        if (day >= 0 && results[day].transit_jd == 0.0) {
+            results[day].transit_jd = transit;
+            results[day].transit_altitude = state.altitude;
+        }
+        
+        // Seed rise and set from the previous pass, else from the horizon angle at transit
+        double h0 = 90.0;
+        rise_set_horizon_angle(&observer, &state, &h0);
+        double rise_guess = have_rise ? transit + rise_offset : transit - h0 / RISE_SET_HOUR_RATE;
+        double set_guess = have_set ? transit + set_offset : transit + h0 / RISE_SET_HOUR_RATE;
+        
+        // Limb height at the next lower culmination brackets this pass's moonset
+        double next_lower_jd = transit + half;
+        rise_set_moon(&observer, next_lower_jd, &lower);
+        double next_lower_height = rise_set_limb_height(&lower);
+        
+        have_rise = lower_height < 0.0 && upper_height >= 0.0;
+        have_set = upper_height >= 0.0 && next_lower_height < 0.0;
+        
+        if (have_rise) {
+            double event = rise_set_find_crossing(&observer, -1, rise_guess, lower_jd, lower_height,
+                                                  transit, upper_height, &state);
+            rise_offset = event - transit;
+            day = rise_set_day_index(event, window_start, days);
+            if (day >= 0 && results[day].moonrise_jd == 0.0) {
+                results[day].moonrise_jd = event;
+                results[day].rise_azimuth = state.azimuth;
+            }
+        }
+        if (have_set) {
+            double event = rise_set_find_crossing(&observer, 1, set_guess, transit, upper_height,
+                                                  next_lower_jd, next_lower_height, &state);
+            set_offset = event - transit;
+            day = rise_set_day_index(event, window_start, days);
+            if (day >= 0 && results[day].moonset_jd == 0.0) {
+                results[day].moonset_jd = event;
+                results[day].set_azimuth = state.azimuth;
+            }
+        }
+        
+        // The next transit follows after about the same interval as this one
+        double previous = transit;
+        transit = rise_set_refine_transit(&observer, transit + interval, &state);
+        interval = transit - previous;
+        if (interval < 0.9 || interval > 1.2) interval = RISE_SET_MEAN_PASS;
+        
+        lower_jd = next_lower_jd;
+        lower_height = next_lower_height;
+    }
+    
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult lunar_calculate_rise_set(double julian_day, double latitude, double longitude,
+                                        double utc_offset_hours, LunarRiseSet* result) {
+    return lunar_calculate_rise_set_range(julian_day, 1, latitude, longitude, utc_offset_hours, result);
+}
@@ -0,0 +1,30 @@
+// src/astronomy/lunar_rise_set.h
+#ifndef LUNAR_RISE_SET_H
+#define LUNAR_RISE_SET_H
+
+#include "../../include/calendar_types.h"
+
+// Moon events of one local civil day (UT Julian days; 0 when the event does not occur
+// that day, the first one when it occurs twice)
+typedef struct {
+    long julian_day_number;     // Civil date
+    double moonrise_jd;
+    double moonset_jd;
+    double transit_jd;          // Upper culmination
+    double transit_altitude;    // Topocentric, degrees
+    double rise_azimuth;        // Degrees from north
+    double set_azimuth;
+} LunarRiseSet;
+
+// Events for the civil date containing julian_day at a location (longitude east positive,
+// utc_offset_hours defines the local day)
+CalendarResult lunar_calculate_rise_set(double julian_day, double latitude, double longitude,
+                                        double utc_offset_hours, LunarRiseSet* result);
+
+// Consecutive days starting with the civil date containing start_jd; each day's
+// solution seeds the next, so a year costs a few series evaluations per day
+CalendarResult lunar_calculate_rise_set_range(double start_jd, int days,
+                                              double latitude, double longitude,
+                                              double utc_offset_hours, LunarRiseSet* results);
+
+#endif // LUNAR_RISE_SET_H
@@ -0,0 +1,449 @@
+// src/astronomy/planetary_calc.c
+#include "planetary_calc.h"
+#include "coordinates.h"
+#include "event_finder.h"
+#include "time_scale.h"
+#include "../utils/date_utils.h"
+
+#define PLANETARY_DEG_TO_RAD (M_PI / 180.0)
+#define PLANETARY_RAD_TO_DEG (180.0 / M_PI)
+#define PLANETARY_J2000 2451545.0
+#define PLANETARY_LIGHT_TIME 0.0057755183  // Days per au
+#define PLANETARY_KEPLER_ITERATIONS 8       // Newton step cap; e = 0.21 converges in four
+#define PLANETARY_EPOCH_REUSE_DAYS 1.0      // Batch frame rotation is refreshed at this interval
+#define PLANETARY_EVENT_TOLERANCE_DAYS (1.0 / 1440.0)
+#define PLANETARY_PAIR_STEP_DAYS 2.0        // Bracketing step for planet pair conjunctions
+#define PLANETARY_BATCH_RUN 256             // Positions converted per equatorial batch call
+
+// Keplerian elements at J2000 and their rates per Julian century (Standish,
+// "Keplerian Elements for Approximate Positions of the Major Planets", table 1)
+typedef struct {
+    double a, e, inclination, mean_longitude, perihelion, node;
+    double a_rate, e_rate, inclination_rate, mean_longitude_rate, perihelion_rate, node_rate;
+} PlanetElements;
+
+static const PlanetElements planetary_elements[PLANET_COUNT] = {
+    { 0.38709927, 0.20563593, 7.00497902, 252.25032350, 77.45779628, 48.33076593,
+      0.00000037, 0.00001906, -0.00594749, 149472.67411175, 0.16047689, -0.12534081 },
+    { 0.72333566, 0.00677672, 3.39467605, 181.97909950, 131.60246718, 76.67984255,
+      0.00000390, -0.00004107, -0.00078890, 58517.81538729, 0.00268329, -0.27769418 },
+    { 1.00000261, 0.01671123, -0.00001531, 100.46457166, 102.93768193, 0.0,
+      0.00000562, -0.00004392, -0.01294668, 35999.37244981, 0.32327364, 0.0 },
+    { 1.52371034, 0.09339410, 1.84969142, -4.55343205, -23.94362959, 49.55953891,
+      0.00001847, 0.00007882, -0.00813131, 19140.30268499, 0.44441088, -0.29257343 },
+    { 5.20288700, 0.04838624, 1.30439695, 34.39644051, 14.72847983, 100.47390909,
+      -0.00011607, -0.00013253, -0.00183714, 3034.74612775, 0.21252668, 0.20469106 },
+    { 9.53667594, 0.05386179, 2.48599187, 49.95424423, 92.59887831, 113.66242448,
+      -0.00125060, -0.00050991, 0.00193609, 1222.49362201, -0.41897216, -0.28867794 },
+    { 19.18916464, 0.04725744, 0.77263783, 313.23810451, 170.95427630, 74.01692503,
+      -0.00196176, -0.00004397, -0.00242939, 428.48202785, 0.40805281, 0.04240589 },
+    { 30.06992276, 0.00859048, 1.77004347, -55.12002969, 44.96476227, 131.78422574,
+      0.00026291, 0.00005105, 0.00035372, 218.45945325, -0.32241464, -0.00508664 }
+};
+
+static const char* planetary_names[PLANET_COUNT] = {
+    "Mercury", "Venus", "Earth", "Mars", "Jupiter", "Saturn", "Uranus", "Neptune"
+};
+
+// Bounds on the rate of (sun - planet) geocentric longitude, degrees/day, for the
+// outer planets: the sun's motion less the planet's fastest direct and
+// retrograde motion. Mercury and Venus swing both ways and use fixed steps.
+static const double planetary_synodic_rate[PLANET_COUNT][2] = {
+    { 0.0, 0.0 }, { 0.0, 0.0 }, { 0.0, 0.0 },
+    { 0.10, 1.50 }, { 0.65, 1.20 }, { 0.78, 1.15 }, { 0.85, 1.10 }, { 0.88, 1.08 }
+};
+static const double planetary_inner_step[PLANET_COUNT] = { 4.0, 10.0 };
+
+const char* planetary_name(Planet planet) {
+    return planet >= 0 && planet < PLANET_COUNT ? planetary_names[planet] : "Unknown";
+}
+
+static double planetary_wrap180(double angle) {
+    angle = fmod(angle, 360.0);
+    if (angle >= 180.0) angle -= 360.0;
+    if (angle < -180.0) angle += 360.0;
+    return angle;
+}
+
+// Orbit orientation and shape at one instant. The slowly varying elements
+// change by under 0.05" a day, so a batch reuses one orbit across a day.
+typedef struct {
+    const PlanetElements* elements;
+    double a, e, b;             // Semi-axes (au) and eccentricity
+    double p[3], q[3];          // Unit vectors to perihelion and 90 degrees ahead, J2000 ecliptic
+} PlanetOrbit;
+
+static void planetary_orbit_init(const PlanetElements* el, double t, PlanetOrbit* orbit) {
+    double I = (el->inclination + el->inclination_rate * t) * PLANETARY_DEG_TO_RAD;
+    double varpi = el->perihelion + el->perihelion_rate * t;
+    double node = el->node + el->node_rate * t;
+    double omega = (varpi - node) * PLANETARY_DEG_TO_RAD;
+    double Omega = node * PLANETARY_DEG_TO_RAD;
+    
+    orbit->elements = el;
+    orbit->a = el->a + el->a_rate * t;
+    orbit->e = el->e + el->e_rate * t;
+    orbit->b = orbit->a * sqrt(1.0 - orbit->e * orbit->e);
+    
+    double cw = cos(omega), sw = sin(omega), cO = cos(Omega), sO = sin(Omega), ci = cos(I), si = sin(I);
+    orbit->p[0] = cw * cO - sw * sO * ci;
+    orbit->p[1] = cw * sO + sw * cO * ci;
+    orbit->p[2] = sw * si;
+    orbit->q[0] = -sw * cO - cw * sO * ci;
+    orbit->q[1] = -sw * sO + cw * cO * ci;
+    orbit->q[2] = cw * si;
+}
+
+// Heliocentric J2000 ecliptic position at t centuries on a prepared orbit
+static void planetary_orbit_solve(const PlanetOrbit* orbit, double t, double xyz[3]) {
+    const PlanetElements* el = orbit->elements;
+    double L = el->mean_longitude + el->mean_longitude_rate * t;
+    double varpi = el->perihelion + el->perihelion_rate * t;
+    double M = planetary_wrap180(L - varpi) * PLANETARY_DEG_TO_RAD;
+    double e = orbit->e;
+    
+    // Kepler's equation by Newton's method from E = M + e sin M
+    double E = M + e * sin(M);
+    for (int i = 0; i < PLANETARY_KEPLER_ITERATIONS; i++) {
+        double delta = (E - e * sin(E) - M) / (1.0 - e * cos(E));
+        E -= delta;
+        if (fabs(delta) < 1e-12) break;
+    }
+    
+    double xp = orbit->a * (cos(E) - e);
+    double yp = orbit->b * sin(E);
+    for (int k = 0; k < 3; k++) xyz[k] = orbit->p[k] * xp + orbit->q[k] * yp;
+}
+
+static void planetary_orbit_position(const PlanetElements* el, double t, double xyz[3]) {
+    PlanetOrbit orbit;
+    planetary_orbit_init(el, t, &orbit);
+    planetary_orbit_solve(&orbit, t, xyz);
+}
+
+CalendarResult planetary_heliocentric(Planet planet, double julian_day, double xyz[3]) {
+    if (!xyz) return CALENDAR_ERROR_NULL_POINTER;
+    if (planet < 0 || planet >= PLANET_COUNT) return CALENDAR_ERROR_INVALID_DATE;
+    
+    planetary_orbit_position(&planetary_elements[planet], (julian_day - PLANETARY_J2000) / 36525.0, xyz);
+    return CALENDAR_SUCCESS;
+}
+
+static void planetary_spherical(const double v[3], double* longitude, double* latitude, double* distance) {
+    *distance = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    *longitude = atan2(v[1], v[0]) * PLANETARY_RAD_TO_DEG;
+    if (*longitude < 0.0) *longitude += 360.0;
+    *latitude = asin(v[2] / *distance) * PLANETARY_RAD_TO_DEG;
+}
+
+// Geocentric vector of the planet as seen at t (light-time corrected). One
+// pass suffices: the geometric distance misstates the light time by well under 0.1 s.
+static void planetary_orbit_geocentric(const PlanetOrbit* orbit, double t, const double earth[3],
+                                       double helio[3], double geo[3]) {
+    planetary_orbit_solve(orbit, t, helio);
+    for (int k = 0; k < 3; k++) geo[k] = helio[k] - earth[k];
+    double distance = sqrt(geo[0] * geo[0] + geo[1] * geo[1] + geo[2] * geo[2]);
+    planetary_orbit_solve(orbit, t - PLANETARY_LIGHT_TIME * distance / 36525.0, helio);
+    for (int k = 0; k < 3; k++) geo[k] = helio[k] - earth[k];
+}
+
+static void planetary_geocentric(Planet planet, double julian_day, const double earth[3],
+                                 double helio[3], double geo[3]) {
+    double t = (julian_day - PLANETARY_J2000) / 36525.0;
+    PlanetOrbit orbit;
+    planetary_orbit_init(&planetary_elements[planet], t, &orbit);
+    planetary_orbit_geocentric(&orbit, t, earth, helio, geo);
+}
+
+// Everything but the equatorial coordinates, which the batch converts in runs
+static void planetary_fill_position(const PlanetOrbit* orbit, const PlanetOrbit* earth_orbit,
+                                    double julian_day, PlanetPosition* position) {
+    double t = (julian_day - PLANETARY_J2000) / 36525.0;
+    double earth[3], helio[3], geo[3];
+    
+    planetary_orbit_solve(earth_orbit, t, earth);
+    memset(position, 0, sizeof(*position));
+    position->julian_day = julian_day;
+    if (orbit == earth_orbit) {
+        planetary_spherical(earth, &position->helio_longitude, &position->helio_latitude, &position->helio_distance);
+        return;
+    }
+    
+    planetary_orbit_geocentric(orbit, t, earth, helio, geo);
+    planetary_spherical(helio, &position->helio_longitude, &position->helio_latitude, &position->helio_distance);
+    planetary_spherical(geo, &position->longitude, &position->latitude, &position->distance);
+    
+    // Sun direction is -earth
+    double dot = -(geo[0] * earth[0] + geo[1] * earth[1] + geo[2] * earth[2]);
+    double earth_distance = sqrt(earth[0] * earth[0] + earth[1] * earth[1] + earth[2] * earth[2]);
+    position->elongation = acos(fmax(-1.0, fmin(1.0, dot / (position->distance * earth_distance)))) *
+                           PLANETARY_RAD_TO_DEG;
+}
+
+CalendarResult planetary_calculate_position(Planet planet, double julian_day, PlanetPosition* position) {
+    return planetary_calculate_positions_batch(planet, &julian_day, 1, position);
+}
+
+// Converts positions[first, last) to right ascension and declination in one call
+static void planetary_equatorial_run(const CoordEpoch* epoch, PlanetPosition* positions, int first, int last) {
+    double lon[PLANETARY_BATCH_RUN], lat[PLANETARY_BATCH_RUN], ra[PLANETARY_BATCH_RUN], dec[PLANETARY_BATCH_RUN];
+    int n = last - first;
+    if (n <= 0) return;
+    for (int i = 0; i < n; i++) {
+        lon[i] = positions[first + i].longitude;
+        lat[i] = positions[first + i].latitude;
+    }
+    coord_ecliptic_to_equatorial_batch(epoch, COORD_ECLIPTIC_J2000, lon, lat, n, ra, dec);
+    for (int i = 0; i < n; i++) {
+        positions[first + i].right_ascension = ra[i];
+        positions[first + i].declination = dec[i];
+    }
+}
+
+CalendarResult planetary_calculate_positions_batch(Planet planet, const double* julian_days, int count,
+                                                   PlanetPosition* positions) {
+    if (!julian_days || !positions) return CALENDAR_ERROR_NULL_POINTER;
+    if (planet < 0 || planet >= PLANET_COUNT || count < 0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    // Precession and nutation move by under 0.2" a day and the orbits far
+    // less: the frame rotation and both orbits are refreshed once per day of series
+    CoordEpoch epoch;
+    PlanetOrbit orbit, earth_orbit;
+    int run_start = 0;
+    for (int i = 0; i < count; i++) {
+        double jd = julian_days[i];
+        int refresh = i == 0 || fabs(jd - epoch.julian_day) > PLANETARY_EPOCH_REUSE_DAYS / 2.0;
+        if (i > run_start && (refresh || i - run_start == PLANETARY_BATCH_RUN)) {
+            if (planet != PLANET_EARTH) planetary_equatorial_run(&epoch, positions, run_start, i);
+            run_start = i;
+        }
+        if (refresh) {
+            double t = (jd - PLANETARY_J2000) / 36525.0;
+            coord_epoch_init(jd, &epoch);
+            planetary_orbit_init(&planetary_elements[PLANET_EARTH], t, &earth_orbit);
+            planetary_orbit_init(&planetary_elements[planet], t, &orbit);
+        }
+        planetary_fill_position(planet == PLANET_EARTH ? &earth_orbit : &orbit, &earth_orbit, jd, &positions[i]);
+    }
+    if (count > run_start && planet != PLANET_EARTH) planetary_equatorial_run(&epoch, positions, run_start, count);
+    return CALENDAR_SUCCESS;
+}
+
+// Event search state: one planet against the sun or another planet
+typedef struct {
+    Planet planet;
+    Planet other;
+    int against_sun;
+} PlanetEventContext;
+
+// Geocentric ecliptic longitude and latitude of a planet, or of the sun for PLANET_EARTH
+static void planetary_apparent(Planet planet, double julian_day, const double earth[3],
+                               double* longitude, double* latitude, double* distance) {
+    double helio[3], geo[3];
+    if (planet == PLANET_EARTH) {
+        for (int k = 0; k < 3; k++) geo[k] = -earth[k];
+    } else {
+        planetary_geocentric(planet, julian_day, earth, helio, geo);
+    }
+    planetary_spherical(geo, longitude, latitude, distance);
+}
+
+// Sun minus planet (increasing for the outer planets), or planet minus other
+static double planetary_event_value(double julian_day, void* context) {
+    const PlanetEventContext* ctx = context;
+    double earth[3], lon_a, lon_b, lat, distance;
+    planetary_orbit_position(&planetary_elements[PLANET_EARTH], (julian_day - PLANETARY_J2000) / 36525.0, earth);
+    
+    planetary_apparent(ctx->planet, julian_day, earth, &lon_a, &lat, &distance);
+    planetary_apparent(ctx->against_sun ? PLANET_EARTH : ctx->other, julian_day, earth, &lon_b, &lat, &distance);
+    return ctx->against_sun ? lon_b - lon_a : lon_a - lon_b;
+}
+
+static int planetary_event_spec(Planet planet, Planet other, PlanetEventType type,
+                                PlanetEventContext* context, EventSearchSpec* spec) {
+    if (planet < 0 || planet >= PLANET_COUNT || planet == PLANET_EARTH) return 0;
+    
+    int inner = planet < PLANET_EARTH;
+    context->planet = planet;
+    context->other = other;
+    context->against_sun = type != PLANET_EVENT_PAIR_CONJUNCTION;
+    
+    memset(spec, 0, sizeof(*spec));
+    spec->function = planetary_event_value;
+    spec->context = context;
+    spec->kind = EVENT_VALUE_ANGLE;
+    spec->tolerance_days = PLANETARY_EVENT_TOLERANCE_DAYS;
+    
+    switch (type) {
+        case PLANET_EVENT_CONJUNCTION:
+        case PLANET_EVENT_INFERIOR_CONJUNCTION:
+            if (type == PLANET_EVENT_INFERIOR_CONJUNCTION && !inner) return 0;
+            spec->target = 0.0;
+            break;
+        case PLANET_EVENT_OPPOSITION:
+            if (inner) return 0;
+            spec->target = 180.0;
+            break;
+        case PLANET_EVENT_PAIR_CONJUNCTION:
+            if (other < 0 || other >= PLANET_COUNT || other == PLANET_EARTH || other == planet) return 0;
+            spec->target = 0.0;
+            spec->step_days = PLANETARY_PAIR_STEP_DAYS;
+            return 1;
+    }
+    
+    if (inner) {
+        spec->step_days = planetary_inner_step[planet];
+    } else {
+        spec->min_rate = planetary_synodic_rate[planet][0];
+        spec->max_rate = planetary_synodic_rate[planet][1];
+    }
+    return 1;
+}
+
+// Type and separation of a crossing found by the search
+static PlanetEventType planetary_classify(const PlanetEventContext* ctx, PlanetEventType requested,
+                                          double julian_day, double* separation) {
+    double earth[3], lon, lat_a, lat_b, dist_a, dist_b;
+    planetary_orbit_position(&planetary_elements[PLANET_EARTH], (julian_day - PLANETARY_J2000) / 36525.0, earth);
+    planetary_apparent(ctx->planet, julian_day, earth, &lon, &lat_a, &dist_a);
+    planetary_apparent(ctx->against_sun ? PLANET_EARTH : ctx->other, julian_day, earth, &lon, &lat_b, &dist_b);
+    *separation = lat_a - lat_b;
+    
+    if (ctx->against_sun && ctx->planet < PLANET_EARTH && requested != PLANET_EVENT_OPPOSITION) {
+        return dist_a < dist_b ? PLANET_EVENT_INFERIOR_CONJUNCTION : PLANET_EVENT_CONJUNCTION;
+    }
+    return requested;
+}
+
+CalendarResult planetary_find_next_event(Planet planet, Planet other, PlanetEventType type,
+                                         double julian_day, PlanetEvent* event) {
+    if (!event) return CALENDAR_ERROR_NULL_POINTER;
+    
+    PlanetEventContext context;
+    EventSearchSpec spec;
+    if (!planetary_event_spec(planet, other, type, &context, &spec)) return CALENDAR_ERROR_INVALID_DATE;
+    
+    // Synodic periods: at most 780 days for the sun events, decades for slow pairs
+    double horizon = type == PLANET_EVENT_PAIR_CONJUNCTION ? 365.25 * 25.0 : 800.0;
+    EventSearch search;
+    EventCrossing crossing;
+    event_search_init(&search, &spec, julian_day, julian_day + horizon);
+    while (event_search_next(&search, &crossing)) {
+        double separation;
+        PlanetEventType found = planetary_classify(&context, type, crossing.julian_day, &separation);
+        if (found != type) continue;
+        
+        event->type = found;
+        event->planet = planet;
+        event->other = type == PLANET_EVENT_PAIR_CONJUNCTION ? other : PLANET_EARTH;
+        event->julian_day = crossing.julian_day;
+        event->separation = separation;
+        return CALENDAR_SUCCESS;
+    }
+    return CALENDAR_ERROR_CONVERSION_FAILED;
+}
+
+static void planetary_to_astronomical_event(const PlanetEvent* event, AstronomicalEvent* out) {
+    double ut = time_tt_to_ut(event->julian_day);
+    long jdn = (long)floor(ut + 0.5);
+    int minutes = (int)floor((ut + 0.5 - jdn) * 1440.0);
+    int day, month, year;
+    julian_day_to_date(jdn, &day, &month, &year);
+    
+    memset(out, 0, sizeof(*out));
+    out->type = event->type == PLANET_EVENT_OPPOSITION ? ASTRO_EVENT_PLANET_OPPOSITION : ASTRO_EVENT_PLANET_CONJUNCTION;
+    out->julian_day = event->julian_day;
+    switch (event->type) {
+        case PLANET_EVENT_CONJUNCTION:
+            snprintf(out->name, sizeof(out->name), "%s %s", planetary_name(event->planet),
+                     event->planet < PLANET_EARTH ? "Superior Conjunction" : "Conjunction with the Sun");
+            break;
+        case PLANET_EVENT_INFERIOR_CONJUNCTION:
+            snprintf(out->name, sizeof(out->name), "%s Inferior Conjunction", planetary_name(event->planet));
+            break;
+        case PLANET_EVENT_OPPOSITION:
+            snprintf(out->name, sizeof(out->name), "%s Opposition", planetary_name(event->planet));
+            break;
+        case PLANET_EVENT_PAIR_CONJUNCTION:
+            snprintf(out->name, sizeof(out->name), "%s-%s Conjunction",
+                     planetary_name(event->planet), planetary_name(event->other));
+            break;
+    }
+    snprintf(out->description, sizeof(out->description),
+             "%04d-%02d-%02d %02d:%02d UT, latitude difference %.2f degrees",
+             year, month, day, minutes / 60, minutes % 60, event->separation);
+    out->magnitude = fabs(event->separation);
+    out->visibility_global = 1;
+}
+
+static int planetary_compare_events(const void* a, const void* b) {
+    double ja = ((const AstronomicalEvent*)a)->julian_day;
+    double jb = ((const AstronomicalEvent*)b)->julian_day;
+    return (ja > jb) - (ja < jb);
+}
+
+// Append every crossing of one search; returns 0 when out of memory
+static int planetary_collect(Planet planet, Planet other, PlanetEventType type, double start_jd, double end_jd,
+                             AstronomicalEvent** events, int* count, int* capacity) {
+    PlanetEventContext context;
+    EventSearchSpec spec;
+    if (!planetary_event_spec(planet, other, type, &context, &spec)) return 1;
+    
+    EventSearch search;
+    EventCrossing crossing;
+    event_search_init(&search, &spec, start_jd, end_jd);
+    while (event_search_next(&search, &crossing)) {
+        PlanetEvent event;
+        event.type = planetary_classify(&context, type, crossing.julian_day, &event.separation);
+        event.planet = planet;
+        event.other = other;
+        event.julian_day = crossing.julian_day;
+        
+        if (*count >= *capacity) {
+            int grown = *capacity * 2;
+            AstronomicalEvent* larger = realloc(*events, sizeof(AstronomicalEvent) * grown);
+            if (!larger) return 0;
+            *events = larger;
+            *capacity = grown;
+        }
+        planetary_to_astronomical_event(&event, &(*events)[(*count)++]);
+    }
+    return 1;
+}
+
+AstronomicalEvent* planetary_generate_catalog(double start_jd, double end_jd, int* count) {
+    if (!count) return NULL;
+    *count = 0;
+    if (end_jd < start_jd) return NULL;
+    
+    int capacity = 64;
+    AstronomicalEvent* events = malloc(sizeof(AstronomicalEvent) * capacity);
+    if (!events) return NULL;
+    
+    int ok = 1;
+    for (int p = 0; p < PLANET_COUNT && ok; p++) {
+        if (p == PLANET_EARTH) continue;
+        
+        // One search per planet finds both conjunctions of Mercury and Venus
+        ok = planetary_collect(p, PLANET_EARTH, PLANET_EVENT_CONJUNCTION, start_jd, end_jd, &events, count, &capacity);
+        if (ok && p > PLANET_EARTH) {
+            ok = planetary_collect(p, PLANET_EARTH, PLANET_EVENT_OPPOSITION, start_jd, end_jd, &events, count, &capacity);
+        }
+        for (int q = p + 1; q < PLANET_COUNT && ok; q++) {
+            if (q == PLANET_EARTH) continue;
+            ok = planetary_collect(p, q, PLANET_EVENT_PAIR_CONJUNCTION, start_jd, end_jd, &events, count, &capacity);
+        }
+    }
+    if (!ok) {
+        free(events);
+        *count = 0;
+        return NULL;
+    }
+    
+    qsort(events, *count, sizeof(AstronomicalEvent), planetary_compare_events);
+    return events;
+}
+
+void planetary_destroy_catalog(AstronomicalEvent* events) {
+    if (events) free(events);
+}
@@ -0,0 +1,77 @@
+// src/astronomy/planetary_calc.h
+#ifndef PLANETARY_CALC_H
+#define PLANETARY_CALC_H
+
+#include "../../include/calendar_types.h"
+#include "../../include/calendar_types_extended.h"
+
+typedef enum {
+    PLANET_MERCURY,
+    PLANET_VENUS,
+    PLANET_EARTH,               // Earth-Moon barycenter
+    PLANET_MARS,
+    PLANET_JUPITER,
+    PLANET_SATURN,
+    PLANET_URANUS,
+    PLANET_NEPTUNE,
+    PLANET_COUNT
+} Planet;
+
+// Position at a TT instant. Ecliptic coordinates refer to the mean ecliptic
+// and equinox of J2000; the geocentric ones are corrected for light time.
+typedef struct {
+    double julian_day;
+    double helio_longitude;     // Degrees
+    double helio_latitude;
+    double helio_distance;      // au
+    double longitude;           // Geocentric, degrees
+    double latitude;
+    double distance;            // au
+    double right_ascension;     // Hours, true equator and equinox of date
+    double declination;         // Degrees
+    double elongation;          // Angular distance from the sun, degrees
+} PlanetPosition;
+
+typedef enum {
+    PLANET_EVENT_CONJUNCTION,           // With the sun; superior for Mercury and Venus
+    PLANET_EVENT_INFERIOR_CONJUNCTION,  // Mercury and Venus between the Earth and the sun
+    PLANET_EVENT_OPPOSITION,            // Mars to Neptune
+    PLANET_EVENT_PAIR_CONJUNCTION       // Two planets at the same geocentric longitude
+} PlanetEventType;
+
+typedef struct {
+    PlanetEventType type;
+    Planet planet;
+    Planet other;               // Pair conjunctions only
+    double julian_day;          // TT
+    double separation;          // Latitude difference at the event, degrees
+} PlanetEvent;
+
+// Largest position error of the element model against DE405, 1800-2050 (Standish):
+// about 1' for Mercury to Mars, Uranus and Neptune, 10' for Jupiter and Saturn
+#define PLANETARY_VALID_FROM_JD 2378496.5   // 1800 January 1
+#define PLANETARY_VALID_TO_JD 2470172.5     // 2050 December 31
+
+const char* planetary_name(Planet planet);
+
+// Heliocentric rectangular coordinates, J2000 ecliptic, au (TT)
+CalendarResult planetary_heliocentric(Planet planet, double julian_day, double xyz[3]);
+
+CalendarResult planetary_calculate_position(Planet planet, double julian_day, PlanetPosition* position);
+
+// Series over an array of instants (TT); the Earth's orbit and the frame
+// rotation are shared across the batch
+CalendarResult planetary_calculate_positions_batch(Planet planet, const double* julian_days, int count,
+                                                   PlanetPosition* positions);
+
+// Next event of the given type after julian_day (TT); for pair conjunctions
+// "other" names the second planet
+CalendarResult planetary_find_next_event(Planet planet, Planet other, PlanetEventType type,
+                                         double julian_day, PlanetEvent* event);
+
+// Conjunctions with the sun, oppositions and planet pair conjunctions in
+// [start_jd, end_jd] (TT), in time order
+AstronomicalEvent* planetary_generate_catalog(double start_jd, double end_jd, int* count);
+void planetary_destroy_catalog(AstronomicalEvent* events);
+
+#endif // PLANETARY_CALC_H
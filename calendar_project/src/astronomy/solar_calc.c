@@ -0,0 +1,409 @@
+// src/astronomy/solar_calc.c
+#include "solar_calc.h"
+#include "eclipse.h"
+#include "time_scale.h"
+#include "lunar_calc.h"
+
+#define SOLAR_DEG_TO_RAD (M_PI / 180.0)
+#define SOLAR_RAD_TO_DEG (180.0 / M_PI)
+
+#define SOLAR_SEASON_TERMS 24
+
+#define SOLAR_AU_KM 149597870.7
+#define SOLAR_EARTH_RADIUS_KM 6378.14
+#define SOLAR_SUN_RADIUS_KM 696000.0
+#define SOLAR_MOON_RADIUS_KM 1737.4
+
+#define SOLAR_STANDARD_ALTITUDE -0.8333  // Sunrise/sunset: refraction plus semidiameter
+#define SOLAR_HOUR_ANGLE_RATE 360.0      // Degrees of solar hour angle per day
+
+// Reduce an angle in degrees to [0, 360)
+static double solar_normalize_degrees(double angle) {
+    angle = fmod(angle, 360.0);
+    return angle < 0 ? angle + 360.0 : angle;
+}
+
+// Geometric mean longitude of the sun in degrees (Meeus 25.2)
+static double solar_mean_longitude(double t) {
+    return solar_normalize_degrees(280.46646 + 36000.76983 * t + 0.0003032 * t * t);
+}
+
+// Eccentricity of Earth's orbit (Meeus 25.4)
+static double solar_eccentricity(double t) {
+    return EARTH_ORBITAL_ECCENTRICITY - 0.000042037 * t - 0.0000001267 * t * t;
+}
+
+// Equation of center in degrees
+static double solar_equation_of_center(double t, double mean_anomaly_deg) {
+    double M = mean_anomaly_deg * SOLAR_DEG_TO_RAD;
+    return (1.914602 - 0.004817 * t - 0.000014 * t * t) * sin(M) +
+           (0.019993 - 0.000101 * t) * sin(2.0 * M) +
+           0.000289 * sin(3.0 * M);
+}
+
+// Longitude of the ascending node of the moon's orbit, used for nutation
+static double solar_omega(double t) {
+    return 125.04 - 1934.136 * t;
+}
+
+// Apparent obliquity of the ecliptic in degrees (Meeus 22.2 + 25.8)
+static double solar_obliquity(double t) {
+    double seconds = 21.448 - t * (46.8150 + t * (0.00059 - t * 0.001813));
+    double mean = 23.0 + (26.0 + seconds / 60.0) / 60.0;
+    return mean + 0.00256 * cos(solar_omega(t) * SOLAR_DEG_TO_RAD);
+}
+
+double solar_julian_centuries_since_j2000(double julian_day) {
+    return (julian_day - SOLAR_EPOCH_2000) / 36525.0;
+}
+
+double solar_mean_anomaly(double julian_day) {
+    double t = solar_julian_centuries_since_j2000(julian_day);
+    return solar_normalize_degrees(357.52911 + 35999.05029 * t - 0.0001537 * t * t);
+}
+
+double solar_true_anomaly(double julian_day) {
+    double t = solar_julian_centuries_since_j2000(julian_day);
+    double M = solar_mean_anomaly(julian_day);
+    return solar_normalize_degrees(M + solar_equation_of_center(t, M));
+}
+
+double solar_greenwich_sidereal_time(double julian_day) {
+    // Mean sidereal time at Greenwich in hours (Meeus 12.4)
+    double t = solar_julian_centuries_since_j2000(julian_day);
+    double theta = 280.46061837 + 360.98564736629 * (julian_day - SOLAR_EPOCH_2000) +
+                   t * t * (0.000387933 - t / 38710000.0);
+    return solar_normalize_degrees(theta) / 15.0;
+}
+
+double solar_calculate_longitude(double julian_day) {
+    double t = solar_julian_centuries_since_j2000(julian_day);
+    double M = solar_mean_anomaly(julian_day);
+    double true_longitude = solar_mean_longitude(t) + solar_equation_of_center(t, M);
+    
+    // Apparent longitude: correct for nutation and aberration
+    double omega = solar_omega(t) * SOLAR_DEG_TO_RAD;
+    return solar_normalize_degrees(true_longitude - 0.00569 - 0.00478 * sin(omega));
+}
+
+double solar_calculate_distance(double julian_day) {
+    double t = solar_julian_centuries_since_j2000(julian_day);
+    double e = solar_eccentricity(t);
+    double v = solar_true_anomaly(julian_day) * SOLAR_DEG_TO_RAD;
+    return 1.000001018 * (1.0 - e * e) / (1.0 + e * cos(v));
+}
+
+double solar_calculate_declination(double julian_day) {
+    double t = solar_julian_centuries_since_j2000(julian_day);
+    double epsilon = solar_obliquity(t) * SOLAR_DEG_TO_RAD;
+    double lambda = solar_calculate_longitude(julian_day) * SOLAR_DEG_TO_RAD;
+    return asin(sin(epsilon) * sin(lambda)) * SOLAR_RAD_TO_DEG;
+}
+
+double solar_calculate_equation_of_time(double julian_day) {
+    double t = solar_julian_centuries_since_j2000(julian_day);
+    double L0 = solar_mean_longitude(t) * SOLAR_DEG_TO_RAD;
+    double M = solar_mean_anomaly(julian_day) * SOLAR_DEG_TO_RAD;
+    double e = solar_eccentricity(t);
+    double y = tan(solar_obliquity(t) * SOLAR_DEG_TO_RAD / 2.0);
+    y *= y;
+    
+    // Meeus 28.3, result in radians of hour angle
+    double E = y * sin(2.0 * L0) - 2.0 * e * sin(M) +
+               4.0 * e * y * sin(M) * cos(2.0 * L0) -
+               0.5 * y * y * sin(4.0 * L0) - 1.25 * e * e * sin(2.0 * M);
+    
+    return 4.0 * E * SOLAR_RAD_TO_DEG; // minutes
+}
+
+SolarPosition* solar_calculate_position(double julian_day) {
+    SolarPosition* pos = malloc(sizeof(SolarPosition));
+    if (!pos) return NULL;
+    
+    // Civil instant in UT; the series run on dynamical time
+    double jde = time_ut_to_tt(julian_day);
+    double t = solar_julian_centuries_since_j2000(jde);
+    double epsilon = solar_obliquity(t) * SOLAR_DEG_TO_RAD;
+    
+    pos->julian_day = julian_day;
+    pos->solar_longitude = solar_calculate_longitude(jde);
+    pos->solar_latitude = 0.0;
+    
+    double lambda = pos->solar_longitude * SOLAR_DEG_TO_RAD;
+    double ra = atan2(cos(epsilon) * sin(lambda), cos(lambda)) * SOLAR_RAD_TO_DEG;
+    pos->right_ascension = solar_normalize_degrees(ra) / 15.0;
+    pos->declination = asin(sin(epsilon) * sin(lambda)) * SOLAR_RAD_TO_DEG;
+    pos->equation_of_time = solar_calculate_equation_of_time(jde);
+    pos->solar_distance = solar_calculate_distance(jde);
+    
+    return pos;
+}
+
+// Apparent right ascension (hours) and declination of the sun at a UT instant
+void solar_calculate_equatorial(double julian_day, double* ra, double* dec) {
+    double jde = time_ut_to_tt(julian_day);
+    double epsilon = solar_obliquity(solar_julian_centuries_since_j2000(jde)) * SOLAR_DEG_TO_RAD;
+    double lambda = solar_calculate_longitude(jde) * SOLAR_DEG_TO_RAD;
+    
+    *ra = solar_normalize_degrees(atan2(cos(epsilon) * sin(lambda), cos(lambda)) * SOLAR_RAD_TO_DEG) / 15.0;
+    *dec = asin(sin(epsilon) * sin(lambda)) * SOLAR_RAD_TO_DEG;
+}
+
+// Local hour angle in degrees, reduced to [-180, 180)
+static double solar_hour_angle(double julian_day, double longitude, double ra) {
+    double H = solar_normalize_degrees((solar_greenwich_sidereal_time(julian_day) - ra) * 15.0 + longitude);
+    return H >= 180.0 ? H - 360.0 : H;
+}
+
+// Upper transit nearest the estimate
+static double solar_transit(double estimate, double longitude) {
+    double t = estimate, ra, dec;
+    for (int iter = 0; iter < 3; iter++) {
+        solar_calculate_equatorial(t, &ra, &dec);
+        t -= solar_hour_angle(t, longitude, ra) / SOLAR_HOUR_ANGLE_RATE;
+    }
+    return t;
+}
+
+// Morning (sign -1) or evening (sign +1) instant the sun's center reaches
+// the given altitude; 0 when it does not reach it that day
+static double solar_altitude_crossing(double noon, double latitude, double longitude,
+                                      double altitude, int sign) {
+    double phi = latitude * SOLAR_DEG_TO_RAD;
+    double t = noon, ra, dec;
+    
+    for (int iter = 0; iter < 4; iter++) {
+        solar_calculate_equatorial(t, &ra, &dec);
+        double delta = dec * SOLAR_DEG_TO_RAD;
+        double cos_h0 = (sin(altitude * SOLAR_DEG_TO_RAD) - sin(phi) * sin(delta)) / (cos(phi) * cos(delta));
+        if (cos_h0 < -1.0 || cos_h0 > 1.0) return 0.0;
+        
+        double target = sign * acos(cos_h0) * SOLAR_RAD_TO_DEG;
+        t += (target - solar_hour_angle(t, longitude, ra)) / SOLAR_HOUR_ANGLE_RATE;
+    }
+    return t;
+}
+
+// Local noon estimate for the civil date containing julian_day
+static double solar_local_noon_estimate(double julian_day, double longitude) {
+    return floor(julian_day - 0.5) + 1.0 - longitude / 360.0;
+}
+
+double solar_calculate_solar_noon(double julian_day, double longitude) {
+    return solar_transit(solar_local_noon_estimate(julian_day, longitude), longitude);
+}
+
+double solar_calculate_altitude_time(double julian_day, double latitude, double longitude,
+                                     double altitude, int is_evening) {
+    double noon = solar_calculate_solar_noon(julian_day, longitude);
+    return solar_altitude_crossing(noon, latitude, longitude, altitude, is_evening ? 1 : -1);
+}
+
+double solar_calculate_sunrise(double julian_day, double latitude, double longitude) {
+    return solar_calculate_altitude_time(julian_day, latitude, longitude, SOLAR_STANDARD_ALTITUDE, 0);
+}
+
+double solar_calculate_sunset(double julian_day, double latitude, double longitude) {
+    return solar_calculate_altitude_time(julian_day, latitude, longitude, SOLAR_STANDARD_ALTITUDE, 1);
+}
+
+SunriseSunset* solar_calculate_sunrise_sunset(double julian_day, double latitude, double longitude) {
+    SunriseSunset* ss = malloc(sizeof(SunriseSunset));
+    if (!ss) return NULL;
+    
+    ss->solar_noon_jd = solar_calculate_solar_noon(julian_day, longitude);
+    ss->sunrise_jd = solar_altitude_crossing(ss->solar_noon_jd, latitude, longitude, SOLAR_STANDARD_ALTITUDE, -1);
+    ss->sunset_jd = solar_altitude_crossing(ss->solar_noon_jd, latitude, longitude, SOLAR_STANDARD_ALTITUDE, 1);
+    ss->sunrise_azimuth = 0.0;
+    ss->sunset_azimuth = 0.0;
+    
+    double ra, dec, altitude;
+    if (ss->sunrise_jd == 0.0 || ss->sunset_jd == 0.0) {
+        // Polar day or night: decide by the altitude at noon
+        solar_calculate_equatorial(ss->solar_noon_jd, &ra, &dec);
+        ss->day_length = 90.0 - fabs(latitude - dec) > SOLAR_STANDARD_ALTITUDE ? 24.0 : 0.0;
+        return ss;
+    }
+    
+    ss->day_length = (ss->sunset_jd - ss->sunrise_jd) * 24.0;
+    
+    double lst = solar_greenwich_sidereal_time(ss->sunrise_jd) + longitude / 15.0;
+    solar_calculate_equatorial(ss->sunrise_jd, &ra, &dec);
+    solar_equatorial_to_horizontal(ra, dec, latitude, lst, &ss->sunrise_azimuth, &altitude);
+    
+    lst = solar_greenwich_sidereal_time(ss->sunset_jd) + longitude / 15.0;
+    solar_calculate_equatorial(ss->sunset_jd, &ra, &dec);
+    solar_equatorial_to_horizontal(ra, dec, latitude, lst, &ss->sunset_azimuth, &altitude);
+    
+    return ss;
+}
+
+// Mean equinoxes and solstices (Meeus tables 27.A and 27.B): March, June,
+// September and December, polynomials in millennia
+static const double solar_season_mean_early[4][5] = {
+    {1721139.29189, 365242.13740, 0.06134, 0.00111, -0.00071},
+    {1721233.25401, 365241.72562, -0.05323, 0.00907, 0.00025},
+    {1721325.70455, 365242.49558, -0.11677, -0.00297, 0.00074},
+    {1721414.39987, 365242.88257, -0.00769, -0.00933, -0.00006}
+};
+static const double solar_season_mean_late[4][5] = {
+    {2451623.80984, 365242.37404, 0.05169, -0.00411, -0.00057},
+    {2451716.56767, 365241.62603, 0.00325, 0.00888, -0.00030},
+    {2451810.21715, 365242.01767, -0.11575, 0.00337, 0.00078},
+    {2451900.05952, 365242.74049, -0.06223, -0.00823, 0.00032}
+};
+
+// Periodic terms A cos(B + C T) (Meeus table 27.C)
+static const double solar_season_terms[SOLAR_SEASON_TERMS][3] = {
+    {485, 324.96, 1934.136}, {203, 337.23, 32964.467}, {199, 342.08, 20.186}, {182, 27.85, 445267.112},
+    {156, 73.14, 45036.886}, {136, 171.52, 22518.443}, {77, 222.54, 65928.934}, {74, 296.72, 3034.906},
+    {70, 243.58, 9037.513}, {58, 119.81, 33718.147}, {52, 297.17, 150.678}, {50, 21.02, 2281.226},
+    {45, 247.54, 29929.562}, {44, 325.15, 31555.956}, {29, 60.93, 4443.417}, {18, 155.12, 67555.328},
+    {17, 288.79, 4562.452}, {16, 198.04, 62894.029}, {14, 199.76, 31436.921}, {12, 95.39, 14577.848},
+    {12, 287.11, 31931.756}, {12, 320.81, 34777.259}, {9, 227.73, 1222.114}, {8, 15.45, 16859.074}
+};
+
+// Instant (UT) the apparent solar longitude reaches season * 90 degrees
+// (Meeus ch. 27): within a minute for 1951-2050, where the low-precision
+// longitude would put it up to ten minutes out
+static double solar_season_instant(int year, int season) {
+    const double* mean = year < 1000 ? solar_season_mean_early[season] : solar_season_mean_late[season];
+    double y = year < 1000 ? year / 1000.0 : (year - 2000) / 1000.0;
+    double jde0 = mean[0] + y * (mean[1] + y * (mean[2] + y * (mean[3] + y * mean[4])));
+    
+    double t = (jde0 - SOLAR_EPOCH_2000) / 36525.0;
+    double w = (35999.373 * t - 2.47) * SOLAR_DEG_TO_RAD;
+    double delta_lambda = 1.0 + 0.0334 * cos(w) + 0.0007 * cos(2.0 * w);
+    double s = 0.0;
+    for (int i = 0; i < SOLAR_SEASON_TERMS; i++) {
+        const double* term = solar_season_terms[i];
+        s += term[0] * cos((term[1] + term[2] * t) * SOLAR_DEG_TO_RAD);
+    }
+    return time_tt_to_ut(jde0 + 0.00001 * s / delta_lambda);
+}
+
+double solar_calculate_equinox(int year, int is_autumn) {
+    return solar_season_instant(year, is_autumn ? 2 : 0);
+}
+
+double solar_calculate_solstice(int year, int is_winter) {
+    return solar_season_instant(year, is_winter ? 3 : 1);
+}
+
+SeasonalEvents* solar_calculate_seasons(int year) {
+    SeasonalEvents* seasons = malloc(sizeof(SeasonalEvents));
+    if (!seasons) return NULL;
+    
+    seasons->spring_equinox_jd = solar_calculate_equinox(year, 0);
+    seasons->summer_solstice_jd = solar_calculate_solstice(year, 0);
+    seasons->autumn_equinox_jd = solar_calculate_equinox(year, 1);
+    seasons->winter_solstice_jd = solar_calculate_solstice(year, 1);
+    
+    return seasons;
+}
+
+SolarEclipse* solar_predict_next_eclipse(double julian_day) {
+    EclipseInfo info;
+    if (eclipse_find_next(ECLIPSE_SOLAR, time_ut_to_tt(julian_day), &info) != CALENDAR_SUCCESS) return NULL;
+    
+    SolarEclipse* eclipse = malloc(sizeof(SolarEclipse));
+    if (!eclipse) return NULL;
+    
+    eclipse->eclipse_jd = time_tt_to_ut(info.greatest_jd);
+    eclipse->max_eclipse_jd = eclipse->eclipse_jd;
+    eclipse->magnitude = info.magnitude;
+    eclipse->duration_minutes = info.duration_minutes;
+    eclipse->eclipse_type = info.type;
+    
+    return eclipse;
+}
+
+// Topocentric direction and distance (Earth radii) of a body at ecliptic coordinates
+static double solar_topocentric(double longitude, double latitude, double distance,
+                                const double observer[3], double direction[3]) {
+    double ra, dec;
+    solar_ecliptic_to_equatorial(longitude, latitude, &ra, &dec);
+    
+    double alpha = ra * 15.0 * SOLAR_DEG_TO_RAD;
+    double delta = dec * SOLAR_DEG_TO_RAD;
+    direction[0] = distance * cos(delta) * cos(alpha) - observer[0];
+    direction[1] = distance * cos(delta) * sin(alpha) - observer[1];
+    direction[2] = distance * sin(delta) - observer[2];
+    
+    double r = sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+    for (int i = 0; i < 3; i++) direction[i] /= r;
+    return r;
+}
+
+int solar_is_eclipse_visible(double julian_day, double latitude, double longitude) {
+    // Observer on a spherical Earth; longitude east positive
+    double phi = latitude * SOLAR_DEG_TO_RAD;
+    double theta = (solar_greenwich_sidereal_time(julian_day) * 15.0 + longitude) * SOLAR_DEG_TO_RAD;
+    double observer[3] = {cos(phi) * cos(theta), cos(phi) * sin(theta), sin(phi)};
+    
+    double jde = time_ut_to_tt(julian_day);
+    LunarPosition moon;
+    if (lunar_calculate_position(jde, &moon) != CALENDAR_SUCCESS) return 0;
+    
+    double moon_dir[3], sun_dir[3];
+    double moon_r = solar_topocentric(moon.longitude, moon.latitude,
+                                      moon.distance_km / SOLAR_EARTH_RADIUS_KM, observer, moon_dir);
+    double sun_r = solar_topocentric(solar_calculate_longitude(jde), 0.0,
+                                     solar_calculate_distance(jde) * SOLAR_AU_KM / SOLAR_EARTH_RADIUS_KM,
+                                     observer, sun_dir);
+    
+    // Sun must be above the horizon
+    if (sun_dir[0] * observer[0] + sun_dir[1] * observer[1] + sun_dir[2] * observer[2] <= 0.0) return 0;
+    
+    double cos_sep = moon_dir[0] * sun_dir[0] + moon_dir[1] * sun_dir[1] + moon_dir[2] * sun_dir[2];
+    double separation = acos(fmin(1.0, fmax(-1.0, cos_sep)));
+    double moon_radius = asin(SOLAR_MOON_RADIUS_KM / (moon_r * SOLAR_EARTH_RADIUS_KM));
+    double sun_radius = asin(SOLAR_SUN_RADIUS_KM / (sun_r * SOLAR_EARTH_RADIUS_KM));
+    
+    return separation < moon_radius + sun_radius;
+}
+
+void solar_destroy_position(SolarPosition* pos) {
+    if (pos) free(pos);
+}
+
+void solar_destroy_sunrise_sunset(SunriseSunset* ss) {
+    if (ss) free(ss);
+}
+
+void solar_destroy_eclipse(SolarEclipse* eclipse) {
+    if (eclipse) free(eclipse);
+}
+
+void solar_destroy_seasons(SeasonalEvents* seasons) {
+    if (seasons) free(seasons);
+}
+
+void solar_ecliptic_to_equatorial(double longitude, double latitude, double* ra, double* dec) {
+    if (!ra || !dec) return;
+    
+    // Mean obliquity at J2000.0; ra in hours, dec in degrees
+    double epsilon = EARTH_AXIAL_TILT * SOLAR_DEG_TO_RAD;
+    double lambda = longitude * SOLAR_DEG_TO_RAD;
+    double beta = latitude * SOLAR_DEG_TO_RAD;
+    
+    double alpha = atan2(sin(lambda) * cos(epsilon) - tan(beta) * sin(epsilon), cos(lambda));
+    *ra = solar_normalize_degrees(alpha * SOLAR_RAD_TO_DEG) / 15.0;
+    *dec = asin(sin(beta) * cos(epsilon) + cos(beta) * sin(epsilon) * sin(lambda)) * SOLAR_RAD_TO_DEG;
+}
+
+void solar_equatorial_to_horizontal(double ra, double dec, double latitude, double lst,
+                                    double* azimuth, double* altitude) {
+    if (!azimuth || !altitude) return;
+    
+    // ra and lst in hours; azimuth measured from north through east
+    double H = (lst - ra) * 15.0 * SOLAR_DEG_TO_RAD;
+    double delta = dec * SOLAR_DEG_TO_RAD;
+    double phi = latitude * SOLAR_DEG_TO_RAD;
+    
+    double sin_alt = sin(phi) * sin(delta) + cos(phi) * cos(delta) * cos(H);
+    *altitude = asin(sin_alt) * SOLAR_RAD_TO_DEG;
+    
+    double az = atan2(-sin(H) * cos(delta), cos(phi) * sin(delta) - sin(phi) * cos(delta) * cos(H));
+    *azimuth = solar_normalize_degrees(az * SOLAR_RAD_TO_DEG);
+}
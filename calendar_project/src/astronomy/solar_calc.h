@@ -37,7 +37,7 @@ typedef struct {
     double magnitude;           // Eclipse magnitude (0-1 for partial, >1 for total)
     double duration_minutes;    // Duration in minutes
     double max_eclipse_jd;      // Julian day of maximum eclipse
-    int eclipse_type;           // 0=partial, 1=total, 2=annular
+    int eclipse_type;           // 0=partial, 1=total, 2=annular, 3=hybrid
 } SolarEclipse;
 
 // Seasonal information
@@ -48,25 +48,33 @@ typedef struct {
     double winter_solstice_jd;  // Winter solstice
 } SeasonalEvents;
 
-// Core solar calculations
+// Core solar calculations; solar_calculate_position takes UT, the
+// individual series functions take dynamical time (TT)
 SolarPosition* solar_calculate_position(double julian_day);
 double solar_calculate_longitude(double julian_day);
 double solar_calculate_declination(double julian_day);
 double solar_calculate_equation_of_time(double julian_day);
 double solar_calculate_distance(double julian_day);
 
-// Sunrise/sunset calculations
+// Apparent right ascension (hours) and declination of the sun at a UT instant
+void solar_calculate_equatorial(double julian_day, double* ra, double* dec);
+
+// Sunrise/sunset calculations for the civil date containing julian_day (results in UT;
+// longitude east positive; 0 when the sun does not rise or set)
 SunriseSunset* solar_calculate_sunrise_sunset(double julian_day, double latitude, double longitude);
 double solar_calculate_sunrise(double julian_day, double latitude, double longitude);
 double solar_calculate_sunset(double julian_day, double latitude, double longitude);
 double solar_calculate_solar_noon(double julian_day, double longitude);
+double solar_calculate_altitude_time(double julian_day, double latitude, double longitude,
+                                     double altitude, int is_evening);
 
-// Seasonal calculations
+// Seasonal calculations (results in UT): equinoxes and solstices from Meeus
+// ch. 27, good to about a minute for 1951-2050
 SeasonalEvents* solar_calculate_seasons(int year);
 double solar_calculate_equinox(int year, int is_autumn);
 double solar_calculate_solstice(int year, int is_winter);
 
-// Eclipse calculations
+// Eclipse calculations (UT)
 SolarEclipse* solar_predict_next_eclipse(double julian_day);
 int solar_is_eclipse_visible(double julian_day, double latitude, double longitude);
 
@@ -74,6 +82,7 @@ int solar_is_eclipse_visible(double julian_day, double latitude, double longitud
 double solar_julian_centuries_since_j2000(double julian_day);
 double solar_mean_anomaly(double julian_day);
 double solar_true_anomaly(double julian_day);
+double solar_greenwich_sidereal_time(double julian_day);
 void solar_destroy_position(SolarPosition* pos);
 void solar_destroy_sunrise_sunset(SunriseSunset* ss);
 void solar_destroy_eclipse(SolarEclipse* eclipse);
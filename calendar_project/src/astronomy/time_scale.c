@@ -0,0 +1,202 @@
+// src/astronomy/time_scale.c
+#include "time_scale.h"
+#include "../utils/date_utils.h"
+#include <pthread.h>
+
+// Yearly Delta-T table built from the Espenak-Meeus fits to the historical
+// record; outside it the long-term parabola is evaluated directly
+#define TIME_TABLE_FIRST_YEAR -500
+#define TIME_TABLE_LAST_YEAR 2150
+#define TIME_TABLE_SIZE (TIME_TABLE_LAST_YEAR - TIME_TABLE_FIRST_YEAR + 1)
+
+#define TIME_J2000_YEAR_START 2451544.5   // 2000 January 1, 0h
+#define TIME_DAYS_PER_YEAR 365.2425
+
+#if defined(__GNUC__)
+#define TIME_THREAD_LOCAL __thread
+#else
+#define TIME_THREAD_LOCAL
+#endif
+
+// Observed Delta-T on January 1 of 2000-2025 (IERS), seconds
+static const double time_observed_delta_t[] = {
+    63.83, 64.09, 64.30, 64.47, 64.57, 64.69, 64.85, 65.15, 65.46, 65.78,
+    66.07, 66.32, 66.60, 66.91, 67.28, 67.64, 68.10, 68.59, 68.97, 69.22,
+    69.36, 69.36, 69.29, 69.20, 69.18, 69.10
+};
+#define TIME_OBSERVED_FIRST_YEAR 2000
+#define TIME_OBSERVED_COUNT ((int)(sizeof(time_observed_delta_t) / sizeof(time_observed_delta_t[0])))
+#define TIME_BLEND_END_YEAR 2050
+
+// Leap seconds: TAI - UTC from the first of the given month
+static const struct { int year; int month; int tai_minus_utc; } time_leap_seconds[] = {
+    {1972, 1, 10}, {1972, 7, 11}, {1973, 1, 12}, {1974, 1, 13}, {1975, 1, 14},
+    {1976, 1, 15}, {1977, 1, 16}, {1978, 1, 17}, {1979, 1, 18}, {1980, 1, 19},
+    {1981, 7, 20}, {1982, 7, 21}, {1983, 7, 22}, {1985, 7, 23}, {1988, 1, 24},
+    {1990, 1, 25}, {1991, 1, 26}, {1992, 7, 27}, {1993, 7, 28}, {1994, 7, 29},
+    {1996, 1, 30}, {1997, 7, 31}, {1999, 1, 32}, {2006, 1, 33}, {2009, 1, 34},
+    {2012, 7, 35}, {2015, 7, 36}, {2017, 1, 37}
+};
+#define TIME_LEAP_COUNT ((int)(sizeof(time_leap_seconds) / sizeof(time_leap_seconds[0])))
+
+static double time_table[TIME_TABLE_SIZE];
+static double time_leap_jd[TIME_LEAP_COUNT];
+static pthread_once_t time_init_once = PTHREAD_ONCE_INIT;
+
+// Per-day cache: Delta-T changes by milliseconds per day at most
+static TIME_THREAD_LOCAL double time_cached_day = -1e300;
+static TIME_THREAD_LOCAL double time_cached_delta_t = 0.0;
+
+// Morrison & Stephenson long-term parabola
+static double time_long_term(double year) {
+    double u = (year - 1820.0) / 100.0;
+    return -20.0 + 32.0 * u * u;
+}
+
+// Espenak & Meeus piecewise polynomials (NASA Five Millennium Canon)
+static double time_polynomial(double y) {
+    double u, t;
+    
+    if (y < -500.0) return time_long_term(y);
+    if (y < 500.0) {
+        u = y / 100.0;
+        return 10583.6 + u * (-1014.41 + u * (33.78311 + u * (-5.952053 +
+               u * (-0.1798452 + u * (0.022174192 + u * 0.0090316521)))));
+    }
+    if (y < 1600.0) {
+        u = (y - 1000.0) / 100.0;
+        return 1574.2 + u * (-556.01 + u * (71.23472 + u * (0.319781 +
+               u * (-0.8503463 + u * (-0.005050998 + u * 0.0083572073)))));
+    }
+    if (y < 1700.0) {
+        t = y - 1600.0;
+        return 120.0 + t * (-0.9808 + t * (-0.01532 + t / 7129.0));
+    }
+    if (y < 1800.0) {
+        t = y - 1700.0;
+        return 8.83 + t * (0.1603 + t * (-0.0059285 + t * (0.00013336 - t / 1174000.0)));
+    }
+    if (y < 1860.0) {
+        t = y - 1800.0;
+        return 13.72 + t * (-0.332447 + t * (0.0068612 + t * (0.0041116 + t * (-0.00037436 +
+               t * (0.0000121272 + t * (-0.0000001699 + t * 0.000000000875))))));
+    }
+    if (y < 1900.0) {
+        t = y - 1860.0;
+        return 7.62 + t * (0.5737 + t * (-0.251754 + t * (0.01680668 +
+               t * (-0.0004473624 + t / 233174.0))));
+    }
+    if (y < 1920.0) {
+        t = y - 1900.0;
+        return -2.79 + t * (1.494119 + t * (-0.0598939 + t * (0.0061966 - t * 0.000197)));
+    }
+    if (y < 1941.0) {
+        t = y - 1920.0;
+        return 21.20 + t * (0.84493 + t * (-0.076100 + t * 0.0020936));
+    }
+    if (y < 1961.0) {
+        t = y - 1950.0;
+        return 29.07 + t * (0.407 + t * (-1.0 / 233.0 + t / 2547.0));
+    }
+    if (y < 1986.0) {
+        t = y - 1975.0;
+        return 45.45 + t * (1.067 + t * (-1.0 / 260.0 - t / 718.0));
+    }
+    if (y < TIME_OBSERVED_FIRST_YEAR) {
+        t = y - 2000.0;
+        return 63.86 + t * (0.3345 + t * (-0.060374 + t * (0.0017275 +
+               t * (0.000651814 + t * 0.00002373599))));
+    }
+    
+    int last_observed = TIME_OBSERVED_FIRST_YEAR + TIME_OBSERVED_COUNT - 1;
+    if (y <= last_observed) {
+        double index = y - TIME_OBSERVED_FIRST_YEAR;
+        int i = (int)index;
+        if (i >= TIME_OBSERVED_COUNT - 1) return time_observed_delta_t[TIME_OBSERVED_COUNT - 1];
+        double f = index - i;
+        return time_observed_delta_t[i] + f * (time_observed_delta_t[i + 1] - time_observed_delta_t[i]);
+    }
+    
+    // Extrapolation joins the last observation to the long-term trend
+    if (y < TIME_BLEND_END_YEAR) {
+        double last = time_observed_delta_t[TIME_OBSERVED_COUNT - 1];
+        double end = time_long_term(TIME_BLEND_END_YEAR) - 0.5628 * (TIME_TABLE_LAST_YEAR - TIME_BLEND_END_YEAR);
+        return last + (y - last_observed) / (TIME_BLEND_END_YEAR - last_observed) * (end - last);
+    }
+    if (y < TIME_TABLE_LAST_YEAR) return time_long_term(y) - 0.5628 * (TIME_TABLE_LAST_YEAR - y);
+    return time_long_term(y);
+}
+
+static void time_build_tables(void) {
+    for (int i = 0; i < TIME_TABLE_SIZE; i++) {
+        time_table[i] = time_polynomial((double)(TIME_TABLE_FIRST_YEAR + i));
+    }
+    for (int i = 0; i < TIME_LEAP_COUNT; i++) {
+        time_leap_jd[i] = julian_day_from_date(1, time_leap_seconds[i].month, time_leap_seconds[i].year) - 0.5;
+    }
+}
+
+// Parallel loops can reach Delta-T on their first call, so the build runs once
+// whichever thread gets there first
+void time_scale_init(void) {
+    pthread_once(&time_init_once, time_build_tables);
+}
+
+double time_delta_t_for_year(double decimal_year) {
+    double index = decimal_year - TIME_TABLE_FIRST_YEAR;
+    if (index < 0.0 || index >= TIME_TABLE_SIZE - 1) return time_long_term(decimal_year);
+    
+    time_scale_init();
+    int i = (int)index;
+    double f = index - i;
+    return time_table[i] + f * (time_table[i + 1] - time_table[i]);
+}
+
+double time_delta_t(double julian_day) {
+    double day = floor(julian_day);
+    if (day == time_cached_day) return time_cached_delta_t;
+    
+    time_cached_delta_t = time_delta_t_for_year(2000.0 + (day - TIME_J2000_YEAR_START) / TIME_DAYS_PER_YEAR);
+    time_cached_day = day;
+    return time_cached_delta_t;
+}
+
+double time_ut_to_tt(double julian_day_ut) {
+    return julian_day_ut + time_delta_t(julian_day_ut) / TIME_SCALE_SECONDS_PER_DAY;
+}
+
+double time_tt_to_ut(double julian_day_tt) {
+    // Delta-T varies slowly enough that one evaluation at TT suffices
+    return julian_day_tt - time_delta_t(julian_day_tt) / TIME_SCALE_SECONDS_PER_DAY;
+}
+
+double time_tai_minus_utc(double julian_day_utc) {
+    time_scale_init();
+    
+    if (julian_day_utc < time_leap_jd[0]) {
+        // Before 1972 UTC is taken to follow UT1
+        return time_delta_t(julian_day_utc) - TIME_SCALE_TT_MINUS_TAI;
+    }
+    
+    int i = TIME_LEAP_COUNT - 1;
+    while (julian_day_utc < time_leap_jd[i]) i--;
+    return time_leap_seconds[i].tai_minus_utc;
+}
+
+// Offset of a time scale from TT in seconds at the given instant
+static double time_offset_from_tt(double julian_day, TimeScale scale) {
+    switch (scale) {
+        case TIME_SCALE_TT:  return 0.0;
+        case TIME_SCALE_TAI: return -TIME_SCALE_TT_MINUS_TAI;
+        case TIME_SCALE_UT1: return -time_delta_t(julian_day);
+        case TIME_SCALE_UTC: return -TIME_SCALE_TT_MINUS_TAI - time_tai_minus_utc(julian_day);
+        default:             return 0.0;
+    }
+}
+
+double time_scale_convert(double julian_day, TimeScale from, TimeScale to) {
+    if (from == to) return julian_day;
+    
+    double tt = julian_day - time_offset_from_tt(julian_day, from) / TIME_SCALE_SECONDS_PER_DAY;
+    return tt + time_offset_from_tt(tt, to) / TIME_SCALE_SECONDS_PER_DAY;
+}
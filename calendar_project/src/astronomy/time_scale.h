@@ -0,0 +1,37 @@
+// src/astronomy/time_scale.h
+#ifndef TIME_SCALE_H
+#define TIME_SCALE_H
+
+#include "../../include/calendar_types.h"
+
+// Astronomical series are evaluated in Terrestrial Time (TT, "JDE");
+// civil dates and clocks are in UTC / UT1.
+typedef enum {
+    TIME_SCALE_UTC,             // Coordinated Universal Time (atomic, leap seconds)
+    TIME_SCALE_UT1,             // Earth rotation angle time
+    TIME_SCALE_TAI,             // International Atomic Time
+    TIME_SCALE_TT               // Terrestrial (dynamical) Time, TT = TAI + 32.184 s
+} TimeScale;
+
+#define TIME_SCALE_TT_MINUS_TAI 32.184   // seconds
+#define TIME_SCALE_SECONDS_PER_DAY 86400.0
+
+// Delta-T = TT - UT1 in seconds
+double time_delta_t(double julian_day);
+double time_delta_t_for_year(double decimal_year);
+
+// Conversions between UT and TT (Julian days)
+double time_ut_to_tt(double julian_day_ut);
+double time_tt_to_ut(double julian_day_tt);
+
+// TAI - UTC in seconds (leap seconds since 1972; UTC follows UT1 before that)
+double time_tai_minus_utc(double julian_day_utc);
+
+// General conversion between any two time scales
+double time_scale_convert(double julian_day, TimeScale from, TimeScale to);
+
+// Builds the interpolation table; called lazily and safe from any thread.
+// Calling it up front keeps the build out of a timed or parallel section.
+void time_scale_init(void);
+
+#endif // TIME_SCALE_H
@@ -1,5 +1,9 @@
 #include "chinese.h"
 #include "../utils/date_utils.h"
+#ifdef BUILD_ASTRONOMY
+#include "../astronomy/lunar_calc.h"
+#include "../astronomy/solar_calc.h"
+#endif
 
 // Chinese zodiac animals
 const char* chinese_zodiac[CHINESE_ZODIAC_COUNT] = {
@@ -93,4 +97,104 @@ CalendarResult chinese_from_gregorian(const GregorianDate* greg_date, ChineseDat
     chinese_date->cycle_year = chinese_get_cycle_year(greg_date->base.year);
     
     return CALENDAR_SUCCESS;
-}
\ No newline at end of file
+}
+
+#ifdef BUILD_ASTRONOMY
+#define CHINESE_UTC_OFFSET (8.0 / 24.0)     // Beijing time, in days
+
+// UT instant of the midnight that begins a Beijing civil day
+static double chinese_midnight(long jdn) {
+    return jdn - 0.5 - CHINESE_UTC_OFFSET;
+}
+
+// Beijing civil day containing a UT instant
+static long chinese_civil_day(double jd_ut) {
+    return (long)floor(jd_ut + 0.5 + CHINESE_UTC_OFFSET);
+}
+
+// Day of the first new moon on or after a day
+static long chinese_new_moon_on_or_after(long jdn) {
+    return chinese_civil_day(lunar_find_next_phase(chinese_midnight(jdn), 0.0));
+}
+
+// Day of the last new moon on or before a day
+static long chinese_new_moon_on_or_before(long jdn) {
+    long month = chinese_new_moon_on_or_after(jdn - 30);
+    long next = chinese_new_moon_on_or_after(month + 1);
+    while (next <= jdn) {
+        month = next;
+        next = chinese_new_moon_on_or_after(month + 1);
+    }
+    return month;
+}
+
+// Day of the December solstice (solar longitude 270 degrees)
+static long chinese_winter_solstice(int year) {
+    double jd = julian_day_from_date(21, 12, year);
+    for (int i = 0; i < 4; i++) {
+        double delta = fmod(270.0 - solar_calculate_longitude(jd) + 540.0, 360.0) - 180.0;
+        jd += delta / 0.9856;
+    }
+    return chinese_civil_day(jd);
+}
+
+// Whether a principal term (solar longitude a multiple of 30 degrees) falls
+// in the days [start, end)
+static int chinese_has_principal_term(long start, long end) {
+    int first = (int)(solar_calculate_longitude(chinese_midnight(start)) / 30.0);
+    int last = (int)(solar_calculate_longitude(chinese_midnight(end)) / 30.0);
+    return first != last;
+}
+
+// Months from the one holding the December solstice of year - 1 up to the
+// next such month. With 13 of them, the first without a principal term is leap.
+static int chinese_sui_months(int year, ChineseMonth* months) {
+    long first = chinese_new_moon_on_or_before(chinese_winter_solstice(year - 1));
+    long next_first = chinese_new_moon_on_or_before(chinese_winter_solstice(year));
+    
+    long starts[CHINESE_MAX_MONTHS + 2];
+    int count = 0;
+    for (long start = first; start < next_first && count <= CHINESE_MAX_MONTHS; start = chinese_new_moon_on_or_after(start + 1)) {
+        starts[count++] = start;
+    }
+    starts[count] = next_first;
+    
+    int leap_sui = count == CHINESE_MAX_MONTHS;
+    int leap_found = 0;
+    int number = 11;
+    for (int i = 0; i < count && i < CHINESE_MAX_MONTHS; i++) {
+        int is_leap = 0;
+        if (i > 0) {
+            if (leap_sui && !leap_found && !chinese_has_principal_term(starts[i], starts[i + 1])) {
+                is_leap = leap_found = 1;
+            } else {
+                number = number % 12 + 1;
+            }
+        }
+        months[i].start_jdn = starts[i];
+        months[i].number = number;
+        months[i].is_leap = is_leap;
+        months[i].length = (int)(starts[i + 1] - starts[i]);
+    }
+    return count < CHINESE_MAX_MONTHS ? count : CHINESE_MAX_MONTHS;
+}
+
+CalendarResult chinese_year_months(int year, ChineseMonth* months, int* count) {
+    if (!months || !count) return CALENDAR_ERROR_NULL_POINTER;
+    *count = 0;
+    
+    // The year runs from month 1 of one sui to month 1 of the next
+    ChineseMonth suis[2 * CHINESE_MAX_MONTHS];
+    int total = chinese_sui_months(year, suis);
+    total += chinese_sui_months(year + 1, suis + total);
+    
+    int begin = 0;
+    while (begin < total && (suis[begin].number != 1 || suis[begin].is_leap)) begin++;
+    for (int i = begin; i < total; i++) {
+        if (i > begin && suis[i].number == 1 && !suis[i].is_leap) break;
+        if (*count == CHINESE_MAX_MONTHS) return CALENDAR_ERROR_CONVERSION_FAILED;
+        months[(*count)++] = suis[i];
+    }
+    return *count >= 12 ? CALENDAR_SUCCESS : CALENDAR_ERROR_CONVERSION_FAILED;
+}
+#endif
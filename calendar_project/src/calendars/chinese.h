@@ -28,4 +28,20 @@ void chinese_print_date(const ChineseDate* date);
 // Conversion functions (simplified)
 CalendarResult chinese_from_gregorian(const GregorianDate* greg_date, ChineseDate* chinese_date);
 
+#ifdef BUILD_ASTRONOMY
+#define CHINESE_MAX_MONTHS 13
+
+// One month of a Chinese year
+typedef struct {
+    long start_jdn;             // Day of the new moon, Beijing time
+    int number;                 // 1-12
+    int is_leap;                // Repeats the number before it
+    int length;                 // 29 or 30 days
+} ChineseMonth;
+
+// Months of the Chinese year that begins in Gregorian year `year`, from the
+// new moons and principal solar terms at Beijing time (UTC+8)
+CalendarResult chinese_year_months(int year, ChineseMonth* months, int* count);
+#endif
+
 #endif // CHINESE_H
\ No newline at end of file
@@ -14,38 +14,54 @@ const char* hebrew_months_hebrew[HEBREW_MONTHS_COUNT] = {
 };
 
 int hebrew_is_leap_year(int year) {
-    // Hebrew leap year: 7 out of every 19 years (Metonic cycle)
-    return ((year * 7) % 19) < 7;
+    // Years 3, 6, 8, 11, 14, 17 and 19 of the 19-year Metonic cycle
+    return ((7L * year + 1) % 19) < 7;
 }
 
 int hebrew_months_in_year(int year) {
     return hebrew_is_leap_year(year) ? 13 : 12;
 }
 
+// Days in the year: 353-355 in common years, 383-385 in leap years
+static int hebrew_days_in_year(int year) {
+    return (int)(hebrew_elapsed_days_accurate(year + 1) - hebrew_elapsed_days_accurate(year));
+}
+
 int hebrew_days_in_month(int month, int year) {
-    // Standard month lengths (simplified but more accurate)
-    int days_per_month[] = {30, 29, 29, 29, 30, 29, 30, 29, 30, 29, 30, 29, 29};
+    // Tishrei ... Elul, then Adar II
+    int days_per_month[] = {30, 29, 30, 29, 30, 29, 30, 29, 30, 29, 30, 29, 29};
     
     if (month < 1 || month > hebrew_months_in_year(year)) {
         return -1;
     }
     
-    if (month > 12) {
-        // Adar II in leap year
-        return 29;
+    // Cheshvan and Kislev absorb the year-length postponements
+    if (month == 2) { // Cheshvan: long in complete years
+        return hebrew_days_in_year(year) % 10 == 5 ? 30 : 29;
     }
-    
-    // Apply variable month lengths for Cheshvan and Kislev
-    if (month == 2) { // Cheshvan
-        return 29 + (year % 3); // Simplified variable length
+    if (month == 3) { // Kislev: short in deficient years
+        return hebrew_days_in_year(year) % 10 == 3 ? 29 : 30;
     }
-    if (month == 3) { // Kislev
-        return 29 + ((year + 1) % 2); // Simplified variable length
+    if (month == 6) { // Adar (Adar I in leap years)
+        return hebrew_is_leap_year(year) ? 30 : 29;
     }
     
     return days_per_month[month - 1];
 }
 
+// Days from the start of the year to the month; Adar II (13) falls between
+// Adar and Nisan
+static long hebrew_days_before_month(int month, int year) {
+    long days = 0;
+    for (int m = 1; m < (month == 13 ? 7 : month); m++) {
+        days += hebrew_days_in_month(m, year);
+    }
+    if (month >= 7 && month <= 12 && hebrew_is_leap_year(year)) {
+        days += hebrew_days_in_month(13, year);
+    }
+    return days;
+}
+
 long hebrew_elapsed_days(int year) {
     // Basic calculation for compatibility
     long days = (year - 1) * 354;  // Base year length
@@ -53,29 +69,34 @@ long hebrew_elapsed_days(int year) {
     return days;
 }
 
+// Day of the molad of Tishrei, postponed a day when Rosh Hashanah would
+// fall on Sunday, Wednesday or Friday
+static long hebrew_molad_day(int year) {
+    long months = (235L * year - 234) / 19;     // Months before the year
+    long parts = 12084 + 13753 * months;        // 1080 parts per hour
+    long day = 29 * months + parts / 25920;
+    if ((3 * (day + 1)) % 7 < 3) {
+        day++;
+    }
+    return day;
+}
+
 long hebrew_elapsed_days_accurate(int year) {
-    // More accurate calculation using the 19-year Metonic cycle
-    if (year <= 1) return 0;
-    
-    long complete_cycles = (year - 1) / 19;
-    int years_in_cycle = (year - 1) % 19;
+    // Days from the epoch to 1 Tishrei, by the molad and the postponements
+    // that keep the year 353-355 or 383-385 days long
+    if (year < 1) return 0;
     
-    // Days in complete 19-year cycles (6939.6896 days per cycle, rounded to 6939)
-    long days = complete_cycles * 6939;
+    long previous = hebrew_molad_day(year - 1);
+    long current = hebrew_molad_day(year);
+    long next = hebrew_molad_day(year + 1);
     
-    // Add days for partial cycle with more accurate year lengths
-    for (int y = 1; y <= years_in_cycle; y++) {
-        if (hebrew_is_leap_year(y)) {
-            days += 383;  // Leap year length
-        } else {
-            days += 354;  // Regular year length
-        }
-        
-        // Add variable adjustments for deficient/complete/abundant years
-        days += (y % 3);  // Simplified adjustment
+    if (next - current == 356) {
+        return current + 2;
     }
-    
-    return days;
+    if (current - previous == 382) {
+        return current + 1;
+    }
+    return current;
 }
 
 HebrewDate* hebrew_create_date(int day, int month, int year) {
@@ -148,18 +169,14 @@ CalendarResult hebrew_from_gregorian_enhanced(const GregorianDate* greg_date, He
         return CALENDAR_ERROR_NULL_POINTER;
     }
     
-    double julian_day = (double)greg_date->julian_day;
-    double n = julian_day - HEBREW_EPOCH_JD;
+    long n = greg_date->julian_day - (long)HEBREW_EPOCH_JD;
     
     if (n < 0) {
         return CALENDAR_ERROR_CONVERSION_FAILED;
     }
     
-    // Calculate Hebrew year more accurately
-    double hebrew_year_approx = n / 365.2468 + 1;
-    int hebrew_year = (int)hebrew_year_approx;
-    
-    // Adjust for the complex Hebrew calendar rules
+    // Estimate the year from the mean year length, then settle it
+    int hebrew_year = (int)(n / 365.2468) + 1;
     while (hebrew_year > 1 && hebrew_elapsed_days_accurate(hebrew_year) > n) {
         hebrew_year--;
     }
@@ -167,28 +184,19 @@ CalendarResult hebrew_from_gregorian_enhanced(const GregorianDate* greg_date, He
         hebrew_year++;
     }
     
-    // Calculate month and day
-    double days_in_year = n - hebrew_elapsed_days_accurate(hebrew_year);
+    // Walk the months in calendar order, Adar II after Adar
+    static const int month_order[HEBREW_MONTHS_COUNT] = {1, 2, 3, 4, 5, 6, 13, 7, 8, 9, 10, 11, 12};
+    long days_in_year = n - hebrew_elapsed_days_accurate(hebrew_year);
     int month = 1;
-    
-    while (month <= hebrew_months_in_year(hebrew_year) && 
-           days_in_year >= hebrew_days_in_month(month, hebrew_year)) {
+    for (int i = 0; i < HEBREW_MONTHS_COUNT; i++) {
+        month = month_order[i];
+        if (month == 13 && !hebrew_is_leap_year(hebrew_year)) continue;
+        if (days_in_year < hebrew_days_in_month(month, hebrew_year)) break;
         days_in_year -= hebrew_days_in_month(month, hebrew_year);
-        month++;
     }
     
     int day = (int)days_in_year + 1;
     
-    // Validate and create Hebrew date
-    if (month > hebrew_months_in_year(hebrew_year)) {
-        month = hebrew_months_in_year(hebrew_year);
-        day = hebrew_days_in_month(month, hebrew_year);
-    }
-    
-    if (day < 1) {
-        day = 1;
-    }
-    
     hebrew_date->base.day = day;
     hebrew_date->base.month = month;
     hebrew_date->base.year = hebrew_year;
@@ -210,9 +218,7 @@ CalendarResult hebrew_to_gregorian(const HebrewDate* hebrew_date, GregorianDate*
     long days_since_epoch = hebrew_elapsed_days_accurate(hebrew_date->base.year);
     
     // Add days for months in current year
-    for (int month = 1; month < hebrew_date->base.month; month++) {
-        days_since_epoch += hebrew_days_in_month(month, hebrew_date->base.year);
-    }
+    days_since_epoch += hebrew_days_before_month(hebrew_date->base.month, hebrew_date->base.year);
     
     // Add days in current month
     days_since_epoch += hebrew_date->base.day - 1;
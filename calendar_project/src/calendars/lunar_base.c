@@ -1,6 +1,7 @@
 // src/calendars/lunar_base.c (Updated with consistent signatures)
 #include "lunar_base.h"
 #include "../utils/date_utils.h"
+#include "../astronomy/lunar_calc.h"
 
 LunarDate* lunar_create_date(int day, int month, int year) {
     LunarDate* date = malloc(sizeof(LunarDate));
@@ -40,9 +41,8 @@ LunarPhase lunar_calculate_phase(long julian_day) {
 }
 
 double lunar_calculate_age(long julian_day) {
-    // Simplified lunar age calculation
-    double days_since_epoch = julian_day - 2451550.1; // J2000 new moon reference
-    return fmod(days_since_epoch, LUNAR_MONTH_DAYS);
+    // Same model as lunar_calculate_moon_age (default precision tier)
+    return lunar_calculate_moon_age(julian_day);
 }
 
 double lunar_next_new_moon(long julian_day) {
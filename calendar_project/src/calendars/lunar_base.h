@@ -4,6 +4,8 @@
 #include "../../include/calendar_types.h"
 
 // Lunar phase enumeration
+#ifndef LUNAR_PHASE_DEFINED
+#define LUNAR_PHASE_DEFINED
 typedef enum {
     LUNAR_NEW_MOON,
     LUNAR_WAXING_CRESCENT,
@@ -14,6 +16,7 @@ typedef enum {
     LUNAR_LAST_QUARTER,
     LUNAR_WANING_CRESCENT
 } LunarPhase;
+#endif
 
 // Lunar calendar constants (use precise astronomical value)
 #define LUNAR_MONTH_DAYS 29.530588531  // Precise synodic month length
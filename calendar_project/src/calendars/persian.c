@@ -62,9 +62,13 @@ long persian_to_julian_day(int day, int month, int year) {
     // Calculate total days from epoch
     long total_days = 0;
     
-    // Add days for complete years
-    for (int y = 1; y < year; y++) {
-        total_days += persian_is_leap_year(y) ? 366 : 365;
+    // Add days for complete years: whole 33-year cycles, then the rest
+    if (year > 1) {
+        long cycles = (year - 1) / 33;
+        total_days += cycles * (33 * 365 + 8);
+        for (int y = (int)(cycles * 33) + 1; y < year; y++) {
+            total_days += persian_is_leap_year(y) ? 366 : 365;
+        }
     }
     
     // Add days for complete months in current year
@@ -9,6 +9,8 @@
 #define PERSIAN_DAYS_PER_WEEK 7
 
 // Persian date structure
+#ifndef PERSIAN_DATE_DEFINED
+#define PERSIAN_DATE_DEFINED
 typedef struct {
     Date base;
     int day_of_week;
@@ -16,6 +18,7 @@ typedef struct {
     int is_leap_year;
     char season[20];  // Spring, Summer, Autumn, Winter
 } PersianDate;
+#endif
 
 // External arrays
 extern const char* persian_months[PERSIAN_MONTHS_COUNT];
@@ -7,6 +7,19 @@
 #include "../holidays/holiday_db.h"
 #include "../astronomy/lunar_calc.h"
 
+#define EXPORT_MAX_HOLIDAYS_PER_DAY 32
+
+// Holidays on a Gregorian date, capped at the buffer size
+static int export_find_holidays(HolidayDatabase* db, const Date* date, const char* country_code,
+                                const Holiday** matches) {
+    int count = 0;
+    if (!db || holiday_db_find_holidays(db, date, CALENDAR_GREGORIAN, country_code, matches,
+                                        EXPORT_MAX_HOLIDAYS_PER_DAY, &count) != CALENDAR_SUCCESS) {
+        return 0;
+    }
+    return count < EXPORT_MAX_HOLIDAYS_PER_DAY ? count : EXPORT_MAX_HOLIDAYS_PER_DAY;
+}
+
 CalendarResult export_calendar_month(const ExportOptions* options, int month, int year) {
     // Suppress unused parameter warnings
     (void)month;
@@ -95,7 +108,24 @@ CalendarResult export_to_csv_enhanced(const ExportOptions* options, FILE* file)
     if (options->include_holidays) {
         holiday_db = holiday_db_create();
         if (holiday_db) {
-            holiday_db_load_from_file(holiday_db, "data/holidays.csv");
+            holiday_db_load_from_file(holiday_db, HOLIDAY_DB_DEFAULT_FILE);
+            // Every calendar's holidays as Gregorian days, in one pass
+            holiday_db_materialize_range(holiday_db, options->start_year, options->end_year);
+        }
+    }
+    
+    // Moon phases for the whole span in one incremental series pass; the fast
+    // tier per day if the buffer cannot be allocated
+    long first_jdn = gregorian_to_julian_day(1, 1, options->start_year);
+    PreciseLunarInfo* moon_days = NULL;
+    int moon_day_count = 0;
+    if (options->include_moon_phases && options->end_year >= options->start_year) {
+        moon_day_count = (int)(gregorian_to_julian_day(31, 12, options->end_year) - first_jdn + 1);
+        moon_days = malloc(sizeof(PreciseLunarInfo) * moon_day_count);
+        if (moon_days &&
+            lunar_calculate_info_range((double)first_jdn, 1.0, moon_day_count, moon_days) != CALENDAR_SUCCESS) {
+            free(moon_days);
+            moon_days = NULL;
         }
     }
     
@@ -148,32 +178,41 @@ CalendarResult export_to_csv_enhanced(const ExportOptions* options, FILE* file)
                 
                 // Moon phase information
                 if (options->include_moon_phases) {
-                    double moon_age = lunar_calculate_moon_age(greg_date->julian_day);
+                    PreciseLunarInfo lunar_info;
+                    long index = greg_date->julian_day - first_jdn;
+                    if (moon_days && index >= 0 && index < moon_day_count) {
+                        lunar_info = moon_days[index];
+                    } else {
+                        lunar_calculate_info(greg_date->julian_day, LUNAR_PRECISION_FAST, &lunar_info);
+                    }
+                    double moon_age = lunar_info.moon_age_precise;
                     LunarPhase phase = lunar_get_phase(moon_age);
-                    
-                    PreciseLunarInfo* lunar_info = lunar_calculate_precise(greg_date->julian_day);
-                    double illumination = lunar_info ? lunar_info->moon_illumination * 100 : 0;
+                    double illumination = lunar_info.moon_illumination * 100;
                     
                     fprintf(file, "%s,%.1f,%.1f,", 
                            lunar_phase_name(phase), moon_age, illumination);
-                    
-                    if (lunar_info) free(lunar_info);
                 } else {
                     fprintf(file, "N/A,N/A,N/A,");
                 }
                 
                 // Holiday information
+                // Several holidays on one day share the columns, separated by semicolons
                 if (options->include_holidays && holiday_db) {
-                    Holiday* holiday = holiday_db_get_holidays_for_date(
-                        holiday_db, &greg_date->base, CALENDAR_GREGORIAN, options->country_code);
+                    const Holiday* holidays[EXPORT_MAX_HOLIDAYS_PER_DAY];
+                    int holiday_count = export_find_holidays(holiday_db, &greg_date->base,
+                                                             options->country_code, holidays);
                     
-                    if (holiday) {
-                        fprintf(file, "%s,%s,%s", 
-                               holiday->name, 
-                               holiday->is_public_holiday ? "Public" : "Cultural",
-                               holiday->country_code);
-                    } else {
-                        fprintf(file, ",,");
+                    for (int h = 0; h < holiday_count; h++) {
+                        fprintf(file, "%s%s", h > 0 ? ";" : "", holidays[h]->name);
+                    }
+                    fprintf(file, ",");
+                    for (int h = 0; h < holiday_count; h++) {
+                        fprintf(file, "%s%s", h > 0 ? ";" : "",
+                               holidays[h]->is_public_holiday ? "Public" : "Cultural");
+                    }
+                    fprintf(file, ",");
+                    for (int h = 0; h < holiday_count; h++) {
+                        fprintf(file, "%s%s", h > 0 ? ";" : "", holidays[h]->country_code);
                     }
                 }
                 
@@ -183,6 +222,7 @@ CalendarResult export_to_csv_enhanced(const ExportOptions* options, FILE* file)
         }
     }
     
+    free(moon_days);
     if (holiday_db) holiday_db_destroy(holiday_db);
     return CALENDAR_SUCCESS;
 }
@@ -208,7 +248,9 @@ CalendarResult export_to_ical_enhanced(const ExportOptions* options, FILE* file)
     if (options->include_holidays) {
         holiday_db = holiday_db_create();
         if (holiday_db) {
-            holiday_db_load_from_file(holiday_db, "data/holidays.csv");
+            holiday_db_load_from_file(holiday_db, HOLIDAY_DB_DEFAULT_FILE);
+            // Every calendar's holidays as Gregorian days, in one pass
+            holiday_db_materialize_range(holiday_db, options->start_year, options->end_year);
         }
     }
     
@@ -221,14 +263,12 @@ CalendarResult export_to_ical_enhanced(const ExportOptions* options, FILE* file)
                 if (!greg_date) continue;
                 
                 // Check for holidays
-                Holiday* holiday = NULL;
-                if (holiday_db) {
-                    holiday = holiday_db_get_holidays_for_date(
-                        holiday_db, &greg_date->base, CALENDAR_GREGORIAN, options->country_code);
-                }
+                const Holiday* holidays[EXPORT_MAX_HOLIDAYS_PER_DAY];
+                int holiday_count = export_find_holidays(holiday_db, &greg_date->base,
+                                                         options->country_code, holidays);
                 
                 // Only create events for holidays or special dates
-                if (holiday || options->include_moon_phases) {
+                if (holiday_count > 0 || options->include_moon_phases) {
                     fprintf(file, "BEGIN:VEVENT\n");
                     fprintf(file, "UID:multicalendar-%04d%02d%02d@multicalendar.system\n", year, month, day);
                     fprintf(file, "DTSTART;VALUE=DATE:%04d%02d%02d\n", year, month, day);
@@ -236,8 +276,12 @@ CalendarResult export_to_ical_enhanced(const ExportOptions* options, FILE* file)
                     
                     // Create summary
                     char summary[500] = {0};
-                    if (holiday) {
-                        snprintf(summary, sizeof(summary), "%s", holiday->name);
+                    if (holiday_count > 0) {
+                        for (int h = 0; h < holiday_count; h++) {
+                            size_t used = strlen(summary);
+                            snprintf(summary + used, sizeof(summary) - used, "%s%s",
+                                    h > 0 ? ", " : "", holidays[h]->name);
+                        }
                     } else {
                         snprintf(summary, sizeof(summary), "%s, %s %d, %d", 
                                 gregorian_days[greg_date->day_of_week],
@@ -279,7 +323,7 @@ CalendarResult export_to_ical_enhanced(const ExportOptions* options, FILE* file)
                     
                     // Add moon phase
                     if (options->include_moon_phases) {
-                        double moon_age = lunar_calculate_moon_age(greg_date->julian_day);
+                        double moon_age = lunar_moon_age(greg_date->julian_day, LUNAR_PRECISION_FAST);
                         LunarPhase phase = lunar_get_phase(moon_age);
                         char moon_str[100];
                         snprintf(moon_str, sizeof(moon_str), "%s | Moon: %s (%.1f days)",
@@ -376,7 +420,7 @@ CalendarResult export_to_json(const ExportOptions* options, FILE* file) {
                 
                 // Add moon phase if requested
                 if (options->include_moon_phases) {
-                    double moon_age = lunar_calculate_moon_age(greg_date->julian_day);
+                    double moon_age = lunar_moon_age(greg_date->julian_day, LUNAR_PRECISION_FAST);
                     LunarPhase phase = lunar_get_phase(moon_age);
                     
                     fprintf(file, ",\n        \"astronomy\": {\n");
@@ -0,0 +1,227 @@
+// src/holidays/business_calendar.c
+#include "business_calendar.h"
+#include "holiday_rules.h"
+#include "../utils/date_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUSINESS_CALENDAR_OBSERVE_MARGIN 14     // Days an observed holiday can move
+
+// Countries whose weekend is not Saturday and Sunday
+static const struct {
+    const char* country_code;
+    int weekend_mask;
+} business_calendar_weekends[] = {
+    { "SA", BUSINESS_WEEKEND_FRI_SAT }, { "IL", BUSINESS_WEEKEND_FRI_SAT }, { "EG", BUSINESS_WEEKEND_FRI_SAT },
+    { "KW", BUSINESS_WEEKEND_FRI_SAT }, { "QA", BUSINESS_WEEKEND_FRI_SAT }, { "BH", BUSINESS_WEEKEND_FRI_SAT },
+    { "OM", BUSINESS_WEEKEND_FRI_SAT }, { "JO", BUSINESS_WEEKEND_FRI_SAT }, { "IQ", BUSINESS_WEEKEND_FRI_SAT },
+    { "DZ", BUSINESS_WEEKEND_FRI_SAT }, { "LY", BUSINESS_WEEKEND_FRI_SAT }, { "SY", BUSINESS_WEEKEND_FRI_SAT },
+    { "YE", BUSINESS_WEEKEND_FRI_SAT }, { "SD", BUSINESS_WEEKEND_FRI_SAT }, { "BD", BUSINESS_WEEKEND_FRI_SAT },
+    { "IR", BUSINESS_WEEKEND_FRI }, { "NP", BUSINESS_WEEKEND_SAT }
+};
+
+int business_calendar_weekend_mask(const char* country_code) {
+    if (country_code) {
+        for (size_t i = 0; i < sizeof(business_calendar_weekends) / sizeof(business_calendar_weekends[0]); i++) {
+            if (strcmp(business_calendar_weekends[i].country_code, country_code) == 0) {
+                return business_calendar_weekends[i].weekend_mask;
+            }
+        }
+    }
+    return BUSINESS_WEEKEND_SAT_SUN;
+}
+
+// Whether a holiday closes business under a plane
+static int business_calendar_closes(const Holiday* holiday, HolidayPlane plane) {
+    switch (plane) {
+        case HOLIDAY_PLANE_PUBLIC: return holiday->is_public_holiday;
+        case HOLIDAY_PLANE_BANK: return holiday->is_bank_holiday;
+        case HOLIDAY_PLANE_SCHOOL: return holiday->is_school_holiday;
+        case HOLIDAY_PLANE_OBSERVED: return holiday->is_public_holiday;
+        default: return 1;
+    }
+}
+
+BusinessCalendar* business_calendar_create(HolidayDatabase* db, const char* country_code, int weekend_mask,
+                                           HolidayPlane plane, int start_year, int end_year) {
+    if (!db || !country_code || end_year < start_year) return NULL;
+    
+    BusinessCalendar* calendar = calloc(1, sizeof(BusinessCalendar));
+    if (!calendar) return NULL;
+    snprintf(calendar->country_code, sizeof(calendar->country_code), "%s", country_code);
+    calendar->weekend_mask = weekend_mask & 0x7F;
+    calendar->first_jdn = julian_day_from_date(1, 1, start_year);
+    calendar->day_count = (int)(julian_day_from_date(1, 1, end_year + 1) - calendar->first_jdn);
+    calendar->word_count = (calendar->day_count + 63) / 64;
+    calendar->open = calloc((size_t)calendar->word_count, sizeof(uint64_t));
+    calendar->rank = malloc(sizeof(uint32_t) * (size_t)(calendar->word_count + 1));
+    if (!calendar->open || !calendar->rank) {
+        business_calendar_destroy(calendar);
+        return NULL;
+    }
+    
+    // Weekend days stay closed; (jdn + 1) % 7 is 0 on Sundays
+    int weekday = (int)((calendar->first_jdn + 1) % 7);
+    for (int day = 0; day < calendar->day_count; day++) {
+        if (!(calendar->weekend_mask >> weekday & 1)) calendar->open[day >> 6] |= (uint64_t)1 << (day & 63);
+        weekday = weekday == 6 ? 0 : weekday + 1;
+    }
+    
+    // Holidays, periods from the previous year included, and the days they
+    // are observed on; those can lie a few days outside the range
+    long last_jdn = calendar->first_jdn + calendar->day_count - 1;
+    long search_start = calendar->first_jdn - BUSINESS_CALENDAR_OBSERVE_MARGIN;
+    long search_end = last_jdn + BUSINESS_CALENDAR_OBSERVE_MARGIN;
+    
+    // A frozen database only has the years next to the range it was frozen over
+    int margin_first = start_year - 1, margin_last = end_year + 1;
+    holiday_db_clamp_years(db, &margin_first, &margin_last);
+    long cached_start = julian_day_from_date(1, 1, margin_first);
+    long cached_end = julian_day_from_date(1, 1, margin_last + 1) - 1;
+    if (search_start < cached_start) search_start = cached_start;
+    if (search_end > cached_end) search_end = cached_end;
+    
+    int found = 0;
+    CalendarResult result = holiday_db_find_periods(db, search_start, search_end, calendar->country_code, NULL, 0,
+                                                    &found);
+    HolidayOccurrence* periods = malloc(sizeof(HolidayOccurrence) * (size_t)(found > 0 ? found : 1));
+    if (result == CALENDAR_SUCCESS && periods) {
+        result = holiday_db_find_periods(db, search_start, search_end, calendar->country_code, periods, found, &found);
+    }
+    if (result != CALENDAR_SUCCESS || !periods) {
+        free(periods);
+        business_calendar_destroy(calendar);
+        return NULL;
+    }
+    for (int i = 0; i < found; i++) {
+        if (!business_calendar_closes(&db->holidays[periods[i].holiday], plane)) continue;
+        long observed = periods[i].observed_jdn;
+        if (observed != periods[i].jdn && observed >= calendar->first_jdn && observed <= last_jdn) {
+            long day = observed - calendar->first_jdn;
+            calendar->open[day >> 6] &= ~((uint64_t)1 << (day & 63));
+        }
+        long first = periods[i].jdn > calendar->first_jdn ? periods[i].jdn : calendar->first_jdn;
+        long last = periods[i].end_jdn < last_jdn ? periods[i].end_jdn : last_jdn;
+        for (long jdn = first; jdn <= last; jdn++) {
+            long day = jdn - calendar->first_jdn;
+            calendar->open[day >> 6] &= ~((uint64_t)1 << (day & 63));
+        }
+    }
+    free(periods);
+    
+    calendar->rank[0] = 0;
+    for (int w = 0; w < calendar->word_count; w++) {
+        calendar->rank[w + 1] = calendar->rank[w] + (uint32_t)holiday_bitmap_popcount(calendar->open[w]);
+    }
+    return calendar;
+}
+
+void business_calendar_destroy(BusinessCalendar* calendar) {
+    if (!calendar) return;
+    free(calendar->open);
+    free(calendar->rank);
+    free(calendar);
+}
+
+static int business_calendar_in_range(const BusinessCalendar* calendar, long jdn) {
+    return calendar && jdn >= calendar->first_jdn && jdn < calendar->first_jdn + calendar->day_count;
+}
+
+int business_calendar_is_business_day(const BusinessCalendar* calendar, long jdn) {
+    if (!business_calendar_in_range(calendar, jdn)) return 0;
+    long day = jdn - calendar->first_jdn;
+    return (int)(calendar->open[day >> 6] >> (day & 63) & 1);
+}
+
+// Working days before a day of the range (day_count for the end)
+static long business_calendar_rank(const BusinessCalendar* calendar, long day) {
+    long word = day >> 6;
+    if (word == calendar->word_count) return calendar->rank[word];
+    uint64_t below = ((uint64_t)1 << (day & 63)) - 1;
+    return calendar->rank[word] + holiday_bitmap_popcount(calendar->open[word] & below);
+}
+
+// Day of the working day with the given rank (from 0); -1 outside. Steps
+// land near where they start, so the word is found by galloping out from a
+// hint word and then binary-searching the bracket: O(log distance).
+static long business_calendar_select(const BusinessCalendar* calendar, long rank, int hint) {
+    if (rank < 0 || rank >= (long)calendar->rank[calendar->word_count]) return -1;
+    
+    // Bracket [lo, hi] holds the last word whose prefix count is at most rank
+    int lo, hi;
+    if ((long)calendar->rank[hint] <= rank) {
+        lo = hint;
+        hi = calendar->word_count - 1;
+        for (int step = 1; hint + step < calendar->word_count; step *= 2) {
+            if ((long)calendar->rank[hint + step] > rank) {
+                hi = hint + step - 1;
+                break;
+            }
+            lo = hint + step;
+        }
+    } else {
+        lo = 0;
+        hi = hint - 1;
+        for (int step = 1; hint - step > 0; step *= 2) {
+            if ((long)calendar->rank[hint - step] <= rank) {
+                lo = hint - step;
+                break;
+            }
+            hi = hint - step - 1;
+        }
+    }
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if ((long)calendar->rank[mid] <= rank) lo = mid; else hi = mid - 1;
+    }
+    
+    // Drop the lower set bits; the lowest one left is the day
+    uint64_t word = calendar->open[lo];
+    for (long skip = rank - calendar->rank[lo]; skip > 0; skip--) {
+        word &= word - 1;
+    }
+    return (long)lo * 64 + holiday_bitmap_popcount((word & (~word + 1)) - 1);
+}
+
+CalendarResult business_calendar_count(const BusinessCalendar* calendar, long start_jdn, long end_jdn, long* count) {
+    if (!calendar || !count) return CALENDAR_ERROR_NULL_POINTER;
+    long limit_jdn = calendar->first_jdn + calendar->day_count;
+    if (start_jdn < calendar->first_jdn || start_jdn > limit_jdn || end_jdn < calendar->first_jdn ||
+        end_jdn > limit_jdn) {
+        return CALENDAR_ERROR_INVALID_DATE;
+    }
+    *count = business_calendar_rank(calendar, end_jdn - calendar->first_jdn) -
+             business_calendar_rank(calendar, start_jdn - calendar->first_jdn);
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult business_calendar_add(const BusinessCalendar* calendar, long jdn, long n, long* result) {
+    if (!calendar || !result) return CALENDAR_ERROR_NULL_POINTER;
+    if (!business_calendar_in_range(calendar, jdn)) return CALENDAR_ERROR_INVALID_DATE;
+    
+    long day = jdn - calendar->first_jdn;
+    long rank;
+    if (n > 0) {
+        rank = business_calendar_rank(calendar, day + 1) + n - 1;
+    } else {
+        rank = business_calendar_rank(calendar, day) + n;
+    }
+    long found = business_calendar_select(calendar, rank, (int)(day >> 6));
+    if (found < 0) return CALENDAR_ERROR_INVALID_DATE;
+    *result = calendar->first_jdn + found;
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult business_calendar_next(const BusinessCalendar* calendar, long jdn, long* result) {
+    return business_calendar_add(calendar, jdn, 0, result);
+}
+
+CalendarResult business_calendar_previous(const BusinessCalendar* calendar, long jdn, long* result) {
+    if (!calendar || !result) return CALENDAR_ERROR_NULL_POINTER;
+    if (business_calendar_is_business_day(calendar, jdn)) {
+        *result = jdn;
+        return CALENDAR_SUCCESS;
+    }
+    return business_calendar_add(calendar, jdn, -1, result);
+}
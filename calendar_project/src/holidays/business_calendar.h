@@ -0,0 +1,58 @@
+// src/holidays/business_calendar.h
+#ifndef BUSINESS_CALENDAR_H
+#define BUSINESS_CALENDAR_H
+
+#include "holiday_db.h"
+#include "holiday_bitmap.h"
+#include <stdint.h>
+
+// Weekend masks: bit d set when weekday d (0 = Sunday ... 6 = Saturday) is off
+#define BUSINESS_WEEKEND_DAY(weekday) (1 << (weekday))
+#define BUSINESS_WEEKEND_SAT_SUN (BUSINESS_WEEKEND_DAY(6) | BUSINESS_WEEKEND_DAY(0))
+#define BUSINESS_WEEKEND_FRI_SAT (BUSINESS_WEEKEND_DAY(5) | BUSINESS_WEEKEND_DAY(6))
+#define BUSINESS_WEEKEND_FRI (BUSINESS_WEEKEND_DAY(5))
+#define BUSINESS_WEEKEND_SAT (BUSINESS_WEEKEND_DAY(6))
+
+// One country's working days over a range of years: a bit per day, and the
+// number of working days before each 64-day word. Counting is two popcounts;
+// stepping N working days binary-searches the prefix counts, then selects a
+// bit within one word.
+typedef struct {
+    char country_code[4];
+    int weekend_mask;
+    long first_jdn;
+    int day_count;
+    int word_count;
+    uint64_t* open;             // Bit set on working days
+    uint32_t* rank;             // word_count + 1 prefix counts
+} BusinessCalendar;
+
+// Usual weekend of a country: Friday and Saturday across much of the Middle
+// East, Saturday and Sunday elsewhere
+int business_calendar_weekend_mask(const char* country_code);
+
+// Working days of years [start_year, end_year]: every day outside the weekend
+// mask that no holiday of the plane covers or is observed on
+// (HOLIDAY_PLANE_PUBLIC for public holidays, HOLIDAY_PLANE_BANK for
+// settlement). NULL if out of memory.
+BusinessCalendar* business_calendar_create(HolidayDatabase* db, const char* country_code, int weekend_mask,
+                                           HolidayPlane plane, int start_year, int end_year);
+void business_calendar_destroy(BusinessCalendar* calendar);
+
+// 0 for days outside the calendar's range
+int business_calendar_is_business_day(const BusinessCalendar* calendar, long jdn);
+
+// Working days in [start_jdn, end_jdn); negative when end is before start.
+// This and the steps below fail with CALENDAR_ERROR_INVALID_DATE outside the
+// range, or when a step runs past either end of it.
+CalendarResult business_calendar_count(const BusinessCalendar* calendar, long start_jdn, long end_jdn, long* count);
+
+// The working day n working days after jdn (before it for negative n); for
+// n = 0, jdn itself or the next working day
+CalendarResult business_calendar_add(const BusinessCalendar* calendar, long jdn, long n, long* result);
+
+// First working day on or after, or on or before, jdn
+CalendarResult business_calendar_next(const BusinessCalendar* calendar, long jdn, long* result);
+CalendarResult business_calendar_previous(const BusinessCalendar* calendar, long jdn, long* result);
+
+#endif // BUSINESS_CALENDAR_H
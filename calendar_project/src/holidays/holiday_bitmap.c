@@ -0,0 +1,210 @@
+// src/holidays/holiday_bitmap.c
+#include "holiday_bitmap.h"
+#include "holiday_rules.h"
+#include "../utils/date_utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+int holiday_bitmap_popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word -= (word >> 1) & 0x5555555555555555ULL;
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static int holiday_bitmap_compare_keys(const void* a, const void* b) {
+    uint32_t ka = *(const uint32_t*)a;
+    uint32_t kb = *(const uint32_t*)b;
+    return ka < kb ? -1 : (ka > kb);
+}
+
+static int holiday_bitmap_key_column(const HolidayBitmap* bitmap, uint32_t key) {
+    int lo = 0, hi = bitmap->country_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (bitmap->country_keys[mid] < key) lo = mid + 1; else hi = mid;
+    }
+    return key != 0 && lo < bitmap->country_count && bitmap->country_keys[lo] == key ? lo : -1;
+}
+
+// One column per distinct country code in the database
+static int holiday_bitmap_collect_countries(HolidayBitmap* bitmap, const HolidayDatabase* db) {
+    bitmap->country_keys = malloc(sizeof(uint32_t) * (size_t)(db->count > 0 ? db->count : 1));
+    if (!bitmap->country_keys) return 0;
+    
+    int count = 0;
+    for (int i = 0; i < db->count; i++) {
+        uint32_t key = holiday_index_country_key(db->holidays[i].country_code);
+        if (key != 0) bitmap->country_keys[count++] = key;
+    }
+    qsort(bitmap->country_keys, (size_t)count, sizeof(uint32_t), holiday_bitmap_compare_keys);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || bitmap->country_keys[unique - 1] != bitmap->country_keys[i]) {
+            bitmap->country_keys[unique++] = bitmap->country_keys[i];
+        }
+    }
+    bitmap->country_count = unique;
+    
+    bitmap->country_codes = calloc((size_t)(unique > 0 ? unique : 1), 4);
+    if (!bitmap->country_codes) return 0;
+    for (int i = 0; i < unique; i++) {
+        for (int j = 0; j < 3; j++) {
+            bitmap->country_codes[i * 4 + j] = (char)(bitmap->country_keys[i] >> (8 * j));
+        }
+    }
+    return 1;
+}
+
+// Sets a column's bit over days [first, last] of the rows
+static void holiday_bitmap_fill(const HolidayBitmap* bitmap, uint64_t* plane, int column, long first, long last) {
+    uint64_t bit = (uint64_t)1 << (column & 63);
+    uint64_t* word = plane + (size_t)(first - bitmap->first_jdn) * (size_t)bitmap->words_per_day + (column >> 6);
+    for (long day = first; day <= last; day++) {
+        *word |= bit;
+        word += bitmap->words_per_day;
+    }
+}
+
+HolidayBitmap* holiday_bitmap_build(HolidayDatabase* db, int start_year, int end_year) {
+    if (!db || end_year < start_year) return NULL;
+    
+    // Periods from the year before can run into the range, and observed days
+    // can move across New Year; a frozen database has what it has of those
+    int first_year = start_year - 1, last_year = end_year + 1;
+    holiday_db_clamp_years(db, &first_year, &last_year);
+    if (first_year > start_year || last_year < end_year) return NULL;
+    if (holiday_db_materialize_range(db, first_year, last_year) != CALENDAR_SUCCESS) return NULL;
+    
+    HolidayBitmap* bitmap = calloc(1, sizeof(HolidayBitmap));
+    if (!bitmap) return NULL;
+    if (!holiday_bitmap_collect_countries(bitmap, db)) {
+        holiday_bitmap_destroy(bitmap);
+        return NULL;
+    }
+    bitmap->first_jdn = julian_day_from_date(1, 1, start_year);
+    bitmap->day_count = (int)(julian_day_from_date(1, 1, end_year + 1) - bitmap->first_jdn);
+    bitmap->words_per_day = (bitmap->country_count + 63) / 64;
+    size_t words = (size_t)bitmap->day_count * (size_t)(bitmap->words_per_day > 0 ? bitmap->words_per_day : 1);
+    for (int p = 0; p < HOLIDAY_PLANE_COUNT; p++) {
+        bitmap->planes[p] = calloc(words, sizeof(uint64_t));
+        if (!bitmap->planes[p]) {
+            holiday_bitmap_destroy(bitmap);
+            return NULL;
+        }
+    }
+    
+    long last_jdn = bitmap->first_jdn + bitmap->day_count - 1;
+    for (int year = first_year; year <= last_year; year++) {
+        const HolidayYear* occurrences = db->years[year - db->first_year];
+        for (uint32_t c = 0; c < occurrences->country_count; c++) {
+            const HolidayCountryRun* run = &occurrences->countries[c];
+            int column = holiday_bitmap_key_column(bitmap, run->country);
+            if (column < 0) continue;
+            for (uint32_t i = run->start; i < run->start + run->count; i++) {
+                const HolidayOccurrence* occurrence = &occurrences->by_country[i];
+                const Holiday* holiday = &db->holidays[occurrence->holiday];
+                if (holiday->is_public_holiday && occurrence->observed_jdn != occurrence->jdn &&
+                    occurrence->observed_jdn >= bitmap->first_jdn && occurrence->observed_jdn <= last_jdn) {
+                    holiday_bitmap_fill(bitmap, bitmap->planes[HOLIDAY_PLANE_OBSERVED], column,
+                                        occurrence->observed_jdn, occurrence->observed_jdn);
+                }
+                long first = occurrence->jdn > bitmap->first_jdn ? occurrence->jdn : bitmap->first_jdn;
+                long last = occurrence->end_jdn < last_jdn ? occurrence->end_jdn : last_jdn;
+                if (first > last) continue;
+                
+                if (holiday->is_public_holiday && occurrence->observed_jdn == occurrence->jdn) {
+                    holiday_bitmap_fill(bitmap, bitmap->planes[HOLIDAY_PLANE_OBSERVED], column, first, last);
+                }
+                holiday_bitmap_fill(bitmap, bitmap->planes[HOLIDAY_PLANE_ANY], column, first, last);
+                if (holiday->is_public_holiday) {
+                    holiday_bitmap_fill(bitmap, bitmap->planes[HOLIDAY_PLANE_PUBLIC], column, first, last);
+                }
+                if (holiday->is_bank_holiday) {
+                    holiday_bitmap_fill(bitmap, bitmap->planes[HOLIDAY_PLANE_BANK], column, first, last);
+                }
+                if (holiday->is_school_holiday) {
+                    holiday_bitmap_fill(bitmap, bitmap->planes[HOLIDAY_PLANE_SCHOOL], column, first, last);
+                }
+            }
+        }
+    }
+    return bitmap;
+}
+
+void holiday_bitmap_destroy(HolidayBitmap* bitmap) {
+    if (!bitmap) return;
+    for (int p = 0; p < HOLIDAY_PLANE_COUNT; p++) {
+        free(bitmap->planes[p]);
+    }
+    free(bitmap->country_keys);
+    free(bitmap->country_codes);
+    free(bitmap);
+}
+
+int holiday_bitmap_column(const HolidayBitmap* bitmap, const char* country_code) {
+    if (!bitmap) return -1;
+    return holiday_bitmap_key_column(bitmap, holiday_index_country_key(country_code));
+}
+
+const uint64_t* holiday_bitmap_row(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn) {
+    if (!bitmap || plane < 0 || plane >= HOLIDAY_PLANE_COUNT) return NULL;
+    if (jdn < bitmap->first_jdn || jdn >= bitmap->first_jdn + bitmap->day_count) return NULL;
+    return bitmap->planes[plane] + (size_t)(jdn - bitmap->first_jdn) * (size_t)bitmap->words_per_day;
+}
+
+void holiday_bitmap_set_add(const HolidayBitmap* bitmap, uint64_t* set, const char* country_code) {
+    int column = holiday_bitmap_column(bitmap, country_code);
+    if (column < 0 || !set) return;
+    set[column >> 6] |= (uint64_t)1 << (column & 63);
+}
+
+int holiday_bitmap_test(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, int column) {
+    const uint64_t* row = holiday_bitmap_row(bitmap, plane, jdn);
+    if (!row || column < 0 || column >= bitmap->country_count) return 0;
+    return (int)(row[column >> 6] >> (column & 63) & 1);
+}
+
+int holiday_bitmap_count(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, const uint64_t* set) {
+    const uint64_t* row = holiday_bitmap_row(bitmap, plane, jdn);
+    if (!row) return 0;
+    
+    int count = 0;
+    for (int w = 0; w < bitmap->words_per_day; w++) {
+        count += holiday_bitmap_popcount(set ? row[w] & set[w] : row[w]);
+    }
+    return count;
+}
+
+int holiday_bitmap_any(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, const uint64_t* set) {
+    const uint64_t* row = holiday_bitmap_row(bitmap, plane, jdn);
+    if (!row) return 0;
+    
+    uint64_t any = 0;
+    for (int w = 0; w < bitmap->words_per_day; w++) {
+        any |= set ? row[w] & set[w] : row[w];
+    }
+    return any != 0;
+}
+
+int holiday_bitmap_list(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, const uint64_t* set,
+                        int* columns, int capacity) {
+    const uint64_t* row = holiday_bitmap_row(bitmap, plane, jdn);
+    if (!row) return 0;
+    
+    int count = 0;
+    for (int w = 0; w < bitmap->words_per_day; w++) {
+        uint64_t word = set ? row[w] & set[w] : row[w];
+        while (word) {
+            int bit = holiday_bitmap_popcount((word & -word) - 1);     // Index of the lowest set bit
+            if (count < capacity && columns) columns[count] = w * 64 + bit;
+            count++;
+            word &= word - 1;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,61 @@
+// src/holidays/holiday_bitmap.h
+#ifndef HOLIDAY_BITMAP_H
+#define HOLIDAY_BITMAP_H
+
+#include "holiday_db.h"
+#include <stdint.h>
+
+// Materialized day x country matrix: one bit per (day, country) per plane,
+// each day a row of 64-bit words with one column per country. Questions about
+// many countries at once ("which countries", "any of these") become a few
+// word-wide ANDs, ORs and popcounts over one row.
+typedef enum {
+    HOLIDAY_PLANE_ANY,          // Any holiday observed
+    HOLIDAY_PLANE_PUBLIC,
+    HOLIDAY_PLANE_BANK,
+    HOLIDAY_PLANE_SCHOOL,
+    HOLIDAY_PLANE_OBSERVED,     // Public holidays on the days they are observed
+    HOLIDAY_PLANE_COUNT
+} HolidayPlane;
+
+typedef struct {
+    long first_jdn;
+    int day_count;
+    int country_count;
+    int words_per_day;          // Words in a row
+    uint32_t* country_keys;     // Column keys (holiday_index_country_key), ascending
+    char* country_codes;        // 4 bytes per column, NUL-terminated
+    uint64_t* planes[HOLIDAY_PLANE_COUNT];  // day_count * words_per_day words each
+} HolidayBitmap;
+
+// Set bits in a word: the compiler's popcount where there is one
+int holiday_bitmap_popcount(uint64_t word);
+
+// Every observance day of years [start_year, end_year], periods included;
+// NULL if out of memory
+HolidayBitmap* holiday_bitmap_build(HolidayDatabase* db, int start_year, int end_year);
+void holiday_bitmap_destroy(HolidayBitmap* bitmap);
+
+// Column of a country; -1 when it has no holidays
+int holiday_bitmap_column(const HolidayBitmap* bitmap, const char* country_code);
+
+// A plane's row for a day; NULL outside the materialized range
+const uint64_t* holiday_bitmap_row(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn);
+
+// Country sets are rows too: words_per_day words, cleared by the caller.
+// Adding a country without holidays leaves the set unchanged.
+void holiday_bitmap_set_add(const HolidayBitmap* bitmap, uint64_t* set, const char* country_code);
+
+// Whether a country has a holiday on a day
+int holiday_bitmap_test(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, int column);
+
+// Countries with a holiday on a day, all (set NULL) or within a set
+int holiday_bitmap_count(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, const uint64_t* set);
+int holiday_bitmap_any(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, const uint64_t* set);
+
+// Columns with a holiday on a day, in column order: up to capacity of them,
+// and the total as the result
+int holiday_bitmap_list(const HolidayBitmap* bitmap, HolidayPlane plane, long jdn, const uint64_t* set,
+                        int* columns, int capacity);
+
+#endif // HOLIDAY_BITMAP_H
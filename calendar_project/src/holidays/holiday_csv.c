@@ -0,0 +1,197 @@
+// src/holidays/holiday_csv.c
+#include "holiday_csv.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    HOLIDAY_CSV_FIELD_START,
+    HOLIDAY_CSV_UNQUOTED,
+    HOLIDAY_CSV_QUOTED,
+    HOLIDAY_CSV_QUOTE,              // A quote inside a quoted field: escape or close
+    HOLIDAY_CSV_CLOSED              // After the closing quote
+} HolidayCsvState;
+
+// Where the record being read stands in the buffer; all move when it does
+typedef struct {
+    size_t start;                   // First byte of the record
+    size_t read;
+    size_t write;                   // Unescaped text is written back from here
+    size_t field_begin;
+} HolidayCsvCursor;
+
+// Bytes that end a run of unquoted text
+static const unsigned char holiday_csv_special[256] = {
+    ['\n'] = 1, ['\r'] = 1, ['"'] = 1, [','] = 1
+};
+
+HolidayCsvReader* holiday_csv_open(const char* filename) {
+    if (!filename) return NULL;
+    
+    HolidayCsvReader* reader = calloc(1, sizeof(HolidayCsvReader));
+    if (!reader) return NULL;
+    reader->file = fopen(filename, "rb");
+    reader->buffer = malloc(HOLIDAY_CSV_BUFFER_SIZE + 1);
+    if (!reader->file || !reader->buffer) {
+        holiday_csv_close(reader);
+        return NULL;
+    }
+    reader->capacity = HOLIDAY_CSV_BUFFER_SIZE;
+    reader->next_line = 1;
+    return reader;
+}
+
+void holiday_csv_close(HolidayCsvReader* reader) {
+    if (!reader) return;
+    if (reader->file) fclose(reader->file);
+    free(reader->buffer);
+    free(reader);
+}
+
+// Moves the unfinished record to the front of the buffer (or doubles the
+// buffer when the record fills it) and reads more; 0 at end of file, -1 when
+// out of memory
+static int holiday_csv_refill(HolidayCsvReader* reader, HolidayCsvCursor* cursor) {
+    size_t kept = reader->length - cursor->start;
+    if (kept == reader->capacity) {
+        char* buffer = realloc(reader->buffer, reader->capacity * 2 + 1);
+        if (!buffer) return -1;
+        reader->buffer = buffer;
+        reader->capacity *= 2;
+    } else if (cursor->start > 0) {
+        memmove(reader->buffer, reader->buffer + cursor->start, kept);
+        int stored = reader->field_count < HOLIDAY_CSV_MAX_FIELDS ? reader->field_count : HOLIDAY_CSV_MAX_FIELDS;
+        for (int i = 0; i < stored; i++) {
+            reader->field_offsets[i] -= cursor->start;
+        }
+        cursor->read -= cursor->start;
+        cursor->write -= cursor->start;
+        cursor->field_begin -= cursor->start;
+        cursor->start = 0;
+    }
+    
+    size_t added = fread(reader->buffer + kept, 1, reader->capacity - kept, reader->file);
+    reader->length = kept + added;
+    return added > 0;
+}
+
+// Terminates the field written so far; the write position is always behind
+// the read position, so there is room
+static void holiday_csv_end_field(HolidayCsvReader* reader, HolidayCsvCursor* cursor) {
+    if (reader->field_count < HOLIDAY_CSV_MAX_FIELDS) {
+        reader->field_offsets[reader->field_count] = cursor->field_begin;
+        reader->field_lengths[reader->field_count] = cursor->write - cursor->field_begin;
+    }
+    reader->buffer[cursor->write++] = '\0';
+    reader->field_count++;
+    cursor->field_begin = cursor->write;
+}
+
+static void holiday_csv_fail(HolidayCsvReader* reader, const char* error) {
+    if (!reader->error) reader->error = error;
+}
+
+// Moves length bytes at the read position back to the write position
+static void holiday_csv_keep(HolidayCsvReader* reader, HolidayCsvCursor* cursor, size_t length) {
+    if (cursor->write != cursor->read) {
+        memmove(reader->buffer + cursor->write, reader->buffer + cursor->read, length);
+    }
+    cursor->write += length;
+    cursor->read += length;
+}
+
+HolidayCsvStatus holiday_csv_next(HolidayCsvReader* reader) {
+    if (!reader) return HOLIDAY_CSV_FAILED;
+    
+    reader->field_count = 0;
+    reader->error = NULL;
+    reader->line = reader->next_line;
+    HolidayCsvCursor cursor = { reader->position, reader->position, reader->position, reader->position };
+    HolidayCsvState state = HOLIDAY_CSV_FIELD_START;
+    int started = 0;                // Anything but line-end bytes seen
+    int at_end = 0;
+    
+    for (;;) {
+        if (cursor.read == reader->length) {
+            int filled = holiday_csv_refill(reader, &cursor);
+            if (filled < 0) return HOLIDAY_CSV_FAILED;
+            if (filled == 0) {
+                at_end = 1;
+                break;
+            }
+        }
+        char* buffer = reader->buffer;
+        
+        if (state == HOLIDAY_CSV_QUOTED) {
+            // Keep everything up to the next quote, counting the line breaks
+            const char* start = buffer + cursor.read;
+            size_t available = reader->length - cursor.read;
+            const char* quote = memchr(start, '"', available);
+            size_t span = quote ? (size_t)(quote - start) : available;
+            for (const char* c = memchr(start, '\n', span); c; c = memchr(c + 1, '\n', start + span - c - 1)) {
+                reader->next_line++;
+            }
+            holiday_csv_keep(reader, &cursor, span);
+            if (quote) {
+                cursor.read++;
+                state = HOLIDAY_CSV_QUOTE;
+            }
+            continue;
+        }
+        
+        if (state == HOLIDAY_CSV_QUOTE) {
+            if (buffer[cursor.read] == '"') {
+                buffer[cursor.write++] = '"';
+                cursor.read++;
+                state = HOLIDAY_CSV_QUOTED;
+            } else {
+                state = HOLIDAY_CSV_CLOSED;
+            }
+            continue;
+        }
+        
+        // Unquoted text: keep the run up to the next special byte
+        size_t end = cursor.read;
+        while (end < reader->length && !holiday_csv_special[(unsigned char)buffer[end]]) end++;
+        if (end > cursor.read) {
+            if (state == HOLIDAY_CSV_CLOSED) holiday_csv_fail(reader, "text after a closing quote");
+            holiday_csv_keep(reader, &cursor, end - cursor.read);
+            state = HOLIDAY_CSV_UNQUOTED;
+            started = 1;
+            if (end == reader->length) continue;
+        }
+        
+        char c = buffer[cursor.read++];
+        if (c == '\r') continue;
+        if (c == '\n') {
+            reader->next_line++;
+            if (started) break;
+            
+            // Blank line
+            cursor.start = cursor.write = cursor.field_begin = cursor.read;
+            reader->line = reader->next_line;
+            continue;
+        }
+        started = 1;
+        if (c == ',') {
+            holiday_csv_end_field(reader, &cursor);
+            state = HOLIDAY_CSV_FIELD_START;
+        } else if (state == HOLIDAY_CSV_FIELD_START) {
+            state = HOLIDAY_CSV_QUOTED;
+        } else {
+            // A quote inside unquoted text is kept, but flagged
+            holiday_csv_fail(reader, "quote inside an unquoted field");
+            buffer[cursor.write++] = '"';
+        }
+    }
+    
+    reader->position = cursor.read;
+    if (at_end && !started) return HOLIDAY_CSV_END;
+    if (state == HOLIDAY_CSV_QUOTED) holiday_csv_fail(reader, "unterminated quoted field");
+    holiday_csv_end_field(reader, &cursor);
+    
+    int stored = reader->field_count < HOLIDAY_CSV_MAX_FIELDS ? reader->field_count : HOLIDAY_CSV_MAX_FIELDS;
+    for (int i = 0; i < stored; i++) {
+        reader->fields[i] = reader->buffer + reader->field_offsets[i];
+    }
+    return reader->error ? HOLIDAY_CSV_MALFORMED : HOLIDAY_CSV_RECORD;
+}
@@ -0,0 +1,43 @@
+// src/holidays/holiday_csv.h
+#ifndef HOLIDAY_CSV_H
+#define HOLIDAY_CSV_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// Streaming RFC 4180 reader: quoted fields with "" escapes and line breaks,
+// LF or CRLF records. Fields are unescaped in place in one read buffer, which
+// grows only for a record longer than itself.
+#define HOLIDAY_CSV_BUFFER_SIZE (1 << 20)
+#define HOLIDAY_CSV_MAX_FIELDS 16
+
+typedef enum {
+    HOLIDAY_CSV_FAILED = -2,        // Out of memory
+    HOLIDAY_CSV_MALFORMED = -1,     // Record read, but not well-formed; see error
+    HOLIDAY_CSV_END = 0,
+    HOLIDAY_CSV_RECORD = 1
+} HolidayCsvStatus;
+
+typedef struct {
+    FILE* file;
+    char* buffer;                   // capacity + 1 bytes, for a final terminator
+    size_t capacity;
+    size_t length;                  // Bytes in buffer
+    size_t position;
+    size_t field_offsets[HOLIDAY_CSV_MAX_FIELDS];
+    const char* fields[HOLIDAY_CSV_MAX_FIELDS];   // NUL-terminated; valid until the next record
+    size_t field_lengths[HOLIDAY_CSV_MAX_FIELDS];
+    int field_count;                // All fields in the record, even past the maximum
+    long line;                      // Line the record starts on, from 1
+    long next_line;
+    const char* error;              // Why the record is malformed
+} HolidayCsvReader;
+
+HolidayCsvReader* holiday_csv_open(const char* filename);
+void holiday_csv_close(HolidayCsvReader* reader);
+
+// Next record, skipping blank lines. A malformed record is still read to its
+// end, so reading resumes cleanly at the record after it.
+HolidayCsvStatus holiday_csv_next(HolidayCsvReader* reader);
+
+#endif // HOLIDAY_CSV_H
@@ -1,158 +1,503 @@
 // src/holidays/holiday_db.c (Fixed with proper includes)
 #include "holiday_db.h"
+#include "holiday_rules.h"
+#include "holiday_csv.h"
 #include "../utils/string_utils.h"
+#include "../utils/date_utils.h"
+#include "../calendars/gregorian.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define HOLIDAY_DB_TABLE_PADDING 4     // Gregorian years added to each side of a month table
+#define HOLIDAY_DB_INITIAL_CAPACITY 64
+#define HOLIDAY_DB_MIN_FIELDS 8        // Weekday, Offset, Duration, IsBank and IsSchool are optional
+#define HOLIDAY_DB_MAX_FIELDS 13
+
 HolidayDatabase* holiday_db_create(void) {
     HolidayDatabase* db = malloc(sizeof(HolidayDatabase));
     if (!db) return NULL;
     
-    db->holidays = malloc(sizeof(Holiday) * MAX_HOLIDAYS);
-    if (!db->holidays) {
+    db->holidays = malloc(sizeof(Holiday) * HOLIDAY_DB_INITIAL_CAPACITY);
+    db->strings = string_pool_create();
+    if (!db->holidays || !db->strings) {
+        free(db->holidays);
+        string_pool_destroy(db->strings);
         free(db);
         return NULL;
     }
     
     db->count = 0;
+    db->capacity = HOLIDAY_DB_INITIAL_CAPACITY;
+    db->index = NULL;
+    db->years = NULL;
+    db->first_year = 0;
+    db->year_count = 0;
+    for (int i = 0; i < HOLIDAY_INDEX_CALENDARS; i++) {
+        db->month_tables[i] = NULL;
+    }
+    db->observance_rules = NULL;
+    db->observance_rule_count = 0;
+    db->frozen = 0;
     return db;
 }
 
+CalendarResult holiday_db_freeze(HolidayDatabase* db, int start_year, int end_year) {
+    if (!db) return CALENDAR_ERROR_NULL_POINTER;
+    if (db->frozen) return CALENDAR_SUCCESS;
+    
+    CalendarResult result = holiday_db_build_index(db);
+    if (result == CALENDAR_SUCCESS) result = holiday_db_materialize_range(db, start_year - 1, end_year + 1);
+    if (result == CALENDAR_SUCCESS) db->frozen = 1;
+    return result;
+}
+
+// Drop everything derived from the holiday list
+static void holiday_db_invalidate(HolidayDatabase* db) {
+    holiday_index_destroy(db->index);
+    db->index = NULL;
+    for (int i = 0; i < db->year_count; i++) {
+        holiday_year_destroy(db->years[i]);
+    }
+    free(db->years);
+    db->years = NULL;
+    db->year_count = 0;
+}
+
 void holiday_db_destroy(HolidayDatabase* db) {
     if (db) {
         if (db->holidays) {
             free(db->holidays);
         }
+        holiday_db_invalidate(db);
+        for (int i = 0; i < HOLIDAY_INDEX_CALENDARS; i++) {
+            holiday_month_table_destroy(db->month_tables[i]);
+        }
+        free(db->observance_rules);
+        string_pool_destroy(db->strings);
         free(db);
     }
 }
 
-CalendarResult holiday_db_load_from_file(HolidayDatabase* db, const char* filename) {
-    if (!db || !filename) return CALENDAR_ERROR_NULL_POINTER;
+// Room for at least needed holidays
+static CalendarResult holiday_db_reserve(HolidayDatabase* db, int needed) {
+    if (needed <= db->capacity) return CALENDAR_SUCCESS;
     
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        printf("Warning: Holiday database file not found: %s\n", filename);
-        printf("Creating sample holiday database...\n");
-        
-        // Create directory if it doesn't exist
-        char dir_command[256];
-        snprintf(dir_command, sizeof(dir_command), "mkdir -p %s", 
-                strstr(filename, "/") ? "data" : ".");
-        system(dir_command);
-        
-        // Create sample data if file doesn't exist
-        file = fopen(filename, "w");
-        if (file) {
-            fprintf(file, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic\n");
-            fprintf(file, "New Year's Day,Beginning of the year,0,0,1,1,US,1\n");
-            fprintf(file, "Martin Luther King Jr Day,Civil Rights Leader Birthday,0,4,1,15,US,1\n");
-            fprintf(file, "Independence Day,US Independence Day,0,0,7,4,US,1\n");
-            fprintf(file, "Christmas Day,Christian celebration,0,0,12,25,US,1\n");
-            fprintf(file, "Chinese New Year,Lunar New Year,2,0,1,1,CN,1\n");
-            fprintf(file, "Eid al-Fitr,End of Ramadan,1,0,10,1,SA,1\n");
-            fprintf(file, "Rosh Hashanah,Jewish New Year,3,0,1,1,IL,1\n");
-            fprintf(file, "Yom Kippur,Day of Atonement,3,0,1,10,IL,1\n");
-            fclose(file);
-            
-            // Reopen for reading
-            file = fopen(filename, "r");
-        }
-        
-        if (!file) return CALENDAR_ERROR_CONVERSION_FAILED;
+    int capacity = db->capacity * 2;
+    while (capacity < needed) capacity *= 2;
+    Holiday* holidays = realloc(db->holidays, sizeof(Holiday) * (size_t)capacity);
+    if (!holidays) return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    db->holidays = holidays;
+    db->capacity = capacity;
+    return CALENDAR_SUCCESS;
+}
+
+static void holiday_db_report_error(HolidayLoadReport* report, long line, const char* message) {
+    if (!report) return;
+    if (report->malformed < HOLIDAY_LOAD_MAX_ERRORS) {
+        HolidayLoadError* error = &report->errors[report->malformed];
+        error->line = line;
+        snprintf(error->message, sizeof(error->message), "%s", message);
     }
+    report->malformed++;
+}
+
+// Whole-field decimal integer in [min, max]; fields are short, so this is
+// a plain digit loop rather than strtol
+static int holiday_db_parse_int(const char* text, int min, int max, int* value) {
+    int negative = *text == '-';
+    const char* c = text + negative;
+    if (*c == '\0') return 0;
     
-    char line[512];
-    // int line_count = 0; // Unused variable
+    long parsed = 0;
+    for (; *c; c++) {
+        if (*c < '0' || *c > '9' || parsed > max - min) return 0;
+        parsed = parsed * 10 + (*c - '0');
+    }
+    if (negative) parsed = -parsed;
+    if (parsed < min || parsed > max) return 0;
+    *value = (int)parsed;
+    return 1;
+}
+
+// Row fields into a holiday; the reason when they do not make one
+// (name and description are left to the caller, to intern)
+static const char* holiday_db_parse_row(const char* const* fields, int field_count, Holiday* holiday) {
+    if (field_count < HOLIDAY_DB_MIN_FIELDS || field_count > HOLIDAY_DB_MAX_FIELDS) {
+        return "expected 8 to 13 fields";
+    }
+    if (fields[0][0] == '\0') return "empty name";
+    if (strlen(fields[6]) >= sizeof(holiday->country_code)) return "country code longer than 3 letters";
     
-    // Skip header line
-    if (fgets(line, sizeof(line), file)) {
-        // Header line processed
+    int calendar_type;
+    if (!holiday_db_parse_int(fields[2], 0, HOLIDAY_INDEX_CALENDARS - 1, &calendar_type)) return "bad CalendarType";
+    if (!holiday_db_parse_int(fields[3], HOLIDAY_FIXED, HOLIDAY_WEEKDAY, &holiday->holiday_type)) {
+        return "bad HolidayType";
+    }
+    if (!holiday_db_parse_int(fields[4], 0, HOLIDAY_MONTH_SLOTS, &holiday->date.month)) return "bad Month";
+    if (!holiday_db_parse_int(fields[5], 0, 31, &holiday->date.day)) return "bad Day";
+    if (!holiday_db_parse_int(fields[7], 0, 1, &holiday->is_public_holiday)) return "bad IsPublic";
+    holiday->weekday = -1;
+    holiday->offset_days = 0;
+    holiday->duration_days = 1;
+    holiday->is_bank_holiday = 0;
+    holiday->is_school_holiday = 0;
+    if (field_count > 8 && fields[8][0] != '\0' && !holiday_db_parse_int(fields[8], -1, 6, &holiday->weekday)) {
+        return "bad Weekday";
+    }
+    if (field_count > 9 && fields[9][0] != '\0' &&
+        !holiday_db_parse_int(fields[9], -366, 366, &holiday->offset_days)) {
+        return "bad Offset";
+    }
+    if (field_count > 10 && fields[10][0] != '\0' &&
+        !holiday_db_parse_int(fields[10], 0, HOLIDAY_MAX_DURATION_DAYS, &holiday->duration_days)) {
+        return "bad Duration";
+    }
+    if (field_count > 11 && fields[11][0] != '\0' &&
+        !holiday_db_parse_int(fields[11], 0, 1, &holiday->is_bank_holiday)) {
+        return "bad IsBank";
+    }
+    if (field_count > 12 && fields[12][0] != '\0' &&
+        !holiday_db_parse_int(fields[12], 0, 1, &holiday->is_school_holiday)) {
+        return "bad IsSchool";
     }
     
-    while (fgets(line, sizeof(line), file) && db->count < MAX_HOLIDAYS) {
-        // Process data line
-        
-        // Remove newline
-        line[strcspn(line, "\n")] = 0;
-        
-        // Parse CSV line
-        char* tokens[8];
-        int token_count = 0;
-        char* line_copy = strdup(line);
-        char* token = strtok(line_copy, ",");
-        
-        while (token && token_count < 8) {
-            tokens[token_count++] = token;
-            token = strtok(NULL, ",");
+    holiday->calendar_type = (CalendarType)calendar_type;
+    holiday->date.year = 0; // Default for recurring holidays
+    memcpy(holiday->country_code, fields[6], strlen(fields[6]) + 1);
+    return NULL;
+}
+
+CalendarResult holiday_db_load_csv(HolidayDatabase* db, const char* filename, HolidayLoadReport* report) {
+    if (!db || !filename) return CALENDAR_ERROR_NULL_POINTER;
+    if (report) memset(report, 0, sizeof(*report));
+    
+    if (db->frozen) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    HolidayCsvReader* reader = holiday_csv_open(filename);
+    if (!reader) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    holiday_db_invalidate(db);
+    
+    CalendarResult result = CALENDAR_SUCCESS;
+    int first_row = 1;
+    for (;;) {
+        HolidayCsvStatus status = holiday_csv_next(reader);
+        if (status == HOLIDAY_CSV_END) break;
+        if (status == HOLIDAY_CSV_FAILED) {
+            result = CALENDAR_ERROR_MEMORY_ALLOCATION;
+            break;
         }
         
-        if (token_count >= 8) {
-            Holiday* holiday = &db->holidays[db->count];
-            
-            strncpy(holiday->name, tokens[0], sizeof(holiday->name) - 1);
-            holiday->name[sizeof(holiday->name) - 1] = '\0';
-            
-            strncpy(holiday->description, tokens[1], sizeof(holiday->description) - 1);
-            holiday->description[sizeof(holiday->description) - 1] = '\0';
-            
-            holiday->calendar_type = (CalendarType)atoi(tokens[2]);
-            holiday->holiday_type = atoi(tokens[3]);
-            holiday->date.month = atoi(tokens[4]);
-            holiday->date.day = atoi(tokens[5]);
-            holiday->date.year = 0; // Default for recurring holidays
-            
-            strncpy(holiday->country_code, tokens[6], sizeof(holiday->country_code) - 1);
-            holiday->country_code[sizeof(holiday->country_code) - 1] = '\0';
-            
-            holiday->is_public_holiday = atoi(tokens[7]);
-            
-            db->count++;
+        // Skip comments and the header line
+        if (reader->fields[0][0] == '#') continue;
+        if (first_row) {
+            first_row = 0;
+            if (strcmp(reader->fields[0], "Name") == 0) continue;
+        }
+        if (status == HOLIDAY_CSV_MALFORMED) {
+            holiday_db_report_error(report, reader->line, reader->error);
+            continue;
         }
         
-        free(line_copy);
+        if (holiday_db_reserve(db, db->count + 1) != CALENDAR_SUCCESS) {
+            result = CALENDAR_ERROR_MEMORY_ALLOCATION;
+            break;
+        }
+        Holiday* holiday = &db->holidays[db->count];
+        const char* error = holiday_db_parse_row(reader->fields, reader->field_count, holiday);
+        if (error) {
+            holiday_db_report_error(report, reader->line, error);
+            continue;
+        }
+        holiday->name = string_pool_intern_length(db->strings, reader->fields[0], reader->field_lengths[0]);
+        holiday->description = string_pool_intern_length(db->strings, reader->fields[1],
+                                                             reader->field_lengths[1]);
+        if (!holiday->name || !holiday->description) {
+            result = CALENDAR_ERROR_MEMORY_ALLOCATION;
+            break;
+        }
+        db->count++;
+        if (report) report->loaded++;
     }
     
-    fclose(file);
+    holiday_csv_close(reader);
+    return result;
+}
+
+CalendarResult holiday_db_load_from_file(HolidayDatabase* db, const char* filename) {
+    if (!db || !filename) return CALENDAR_ERROR_NULL_POINTER;
     
-    printf("Loaded %d holidays from %s\n", db->count, filename);
+    HolidayLoadReport report;
+    CalendarResult result = holiday_db_load_csv(db, filename, &report);
+    if (result != CALENDAR_SUCCESS) return result;
+    
+    for (int i = 0; i < report.malformed && i < HOLIDAY_LOAD_MAX_ERRORS; i++) {
+        fprintf(stderr, "%s:%ld: %s\n", filename, report.errors[i].line, report.errors[i].message);
+    }
+    if (report.malformed > HOLIDAY_LOAD_MAX_ERRORS) {
+        fprintf(stderr, "%s: %d more malformed rows\n", filename, report.malformed - HOLIDAY_LOAD_MAX_ERRORS);
+    }
     return CALENDAR_SUCCESS;
 }
 
 CalendarResult holiday_db_add_holiday(HolidayDatabase* db, const Holiday* holiday) {
-    if (!db || !holiday || db->count >= MAX_HOLIDAYS) {
+    if (!db || !holiday) {
         return CALENDAR_ERROR_NULL_POINTER;
     }
+    if (db->frozen) return CALENDAR_ERROR_CONVERSION_FAILED;
+    if (holiday_db_reserve(db, db->count + 1) != CALENDAR_SUCCESS) {
+        return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    }
     
-    db->holidays[db->count] = *holiday;
+    Holiday* added = &db->holidays[db->count];
+    *added = *holiday;
+    added->name = string_pool_intern(db->strings, holiday->name ? holiday->name : "");
+    added->description = string_pool_intern(db->strings, holiday->description ? holiday->description : "");
+    if (!added->name || !added->description) return CALENDAR_ERROR_MEMORY_ALLOCATION;
     db->count++;
     
+    holiday_db_invalidate(db);
+    
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult holiday_db_build_index(HolidayDatabase* db) {
+    if (!db) return CALENDAR_ERROR_NULL_POINTER;
+    if (db->index) return CALENDAR_SUCCESS;
+    if (db->frozen) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    int32_t* slots = malloc(sizeof(int32_t) * (db->count > 0 ? db->count : 1));
+    if (!slots) return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    for (int i = 0; i < db->count; i++) {
+        const Holiday* holiday = &db->holidays[i];
+        slots[i] = holiday_index_slot(holiday->calendar_type, holiday->date.month, holiday->date.day);
+    }
+    
+    db->index = holiday_index_build(slots, db->holidays[0].country_code, sizeof(Holiday), (uint32_t)db->count);
+    free(slots);
+    return db->index ? CALENDAR_SUCCESS : CALENDAR_ERROR_MEMORY_ALLOCATION;
+}
+
+CalendarResult holiday_db_find_holidays(HolidayDatabase* db, const Date* date, CalendarType calendar_type,
+                                        const char* country_code, const Holiday** matches, int capacity,
+                                        int* count) {
+    if (!db || !date || !count || (!matches && capacity > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    *count = 0;
+    
+    // A dated Gregorian day sees every calendar's holidays
+    if (calendar_type == CALENDAR_GREGORIAN && date->year != 0) {
+        if (gregorian_validate_date(date->day, date->month, date->year) != CALENDAR_SUCCESS) return CALENDAR_SUCCESS;
+        return holiday_db_find_occurrences(db, julian_day_from_date(date->day, date->month, date->year),
+                                           country_code, matches, capacity, count);
+    }
+    
+    CalendarResult result = holiday_db_build_index(db);
+    if (result != CALENDAR_SUCCESS) return result;
+    
+    uint32_t first, found;
+    int slot = holiday_index_slot(calendar_type, date->month, date->day);
+    if (slot == HOLIDAY_INDEX_NO_SLOT) return CALENDAR_SUCCESS;
+    holiday_index_lookup(db->index, slot, country_code, &first, &found);
+    
+    for (uint32_t i = 0; i < found && (int)i < capacity; i++) {
+        matches[i] = &db->holidays[db->index->order[first + i]];
+    }
+    *count = (int)found;
     return CALENDAR_SUCCESS;
 }
 
+// First holiday on the date; holiday_db_find_holidays() returns them all
 Holiday* holiday_db_get_holidays_for_date(HolidayDatabase* db, const Date* date, 
                                           CalendarType calendar_type, const char* country_code) {
-    if (!db || !date) return NULL;
+    const Holiday* match = NULL;
+    int count = 0;
+    if (holiday_db_find_holidays(db, date, calendar_type, country_code, &match, 1, &count) != CALENDAR_SUCCESS) {
+        return NULL;
+    }
+    return count > 0 ? (Holiday*)match : NULL;
+}
+
+// Grow the cache so that it covers [start_year, end_year]
+static CalendarResult holiday_db_reserve_years(HolidayDatabase* db, int start_year, int end_year) {
+    int first = db->year_count > 0 && db->first_year < start_year ? db->first_year : start_year;
+    int last = db->year_count > 0 && db->first_year + db->year_count - 1 > end_year
+        ? db->first_year + db->year_count - 1 : end_year;
+    if (db->year_count > 0 && first == db->first_year && last - first + 1 == db->year_count) {
+        return CALENDAR_SUCCESS;
+    }
     
+    struct HolidayYear** years = calloc((size_t)(last - first + 1), sizeof(struct HolidayYear*));
+    if (!years) return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    for (int i = 0; i < db->year_count; i++) {
+        years[db->first_year - first + i] = db->years[i];
+    }
+    free(db->years);
+    db->years = years;
+    db->first_year = first;
+    db->year_count = last - first + 1;
+    return CALENDAR_SUCCESS;
+}
+
+// Month tables for every non-Gregorian calendar in use, covering the Gregorian
+// years [start_year, end_year]; a table is rebuilt over the union when it
+// falls short
+static CalendarResult holiday_db_build_month_tables(HolidayDatabase* db, int start_year, int end_year) {
+    int used[HOLIDAY_INDEX_CALENDARS] = {0};
     for (int i = 0; i < db->count; i++) {
-        Holiday* holiday = &db->holidays[i];
-        
-        // Check calendar type
-        if (holiday->calendar_type != calendar_type) continue;
+        unsigned calendar = (unsigned)db->holidays[i].calendar_type;
+        if (calendar < HOLIDAY_INDEX_CALENDARS) used[calendar] = 1;
+    }
+    
+    // Padding covers offsets that reach into the neighbouring years, and
+    // spares a rebuild for each of a run of single-year lookups
+    for (int calendar = 0; calendar < HOLIDAY_INDEX_CALENDARS; calendar++) {
+        if (!used[calendar] || calendar == CALENDAR_GREGORIAN) continue;
         
-        // Check country code if specified
-        if (country_code && strlen(country_code) > 0) {
-            if (strcmp(holiday->country_code, country_code) != 0) continue;
+        int first, last;
+        holiday_calendar_year_span(calendar, start_year - HOLIDAY_DB_TABLE_PADDING, end_year + HOLIDAY_DB_TABLE_PADDING,
+                                   &first, &last);
+        HolidayMonthTable* table = db->month_tables[calendar];
+        if (table && table->first_year <= first && table->first_year + table->year_count - 1 >= last) continue;
+        if (table) {
+            first = table->first_year < first ? table->first_year : first;
+            last = table->first_year + table->year_count - 1 > last ? table->first_year + table->year_count - 1 : last;
         }
         
-        // Check date match
-        if (holiday->date.month == date->month && holiday->date.day == date->day) {
-            return holiday;
+        HolidayMonthTable* built = holiday_month_table_build(calendar, first, last);
+        if (!built) continue;   // The engine stays the fallback (or Chinese without astronomy)
+        holiday_month_table_destroy(table);
+        db->month_tables[calendar] = built;
+    }
+    return CALENDAR_SUCCESS;
+}
+
+const struct HolidayYear* holiday_db_materialize_year(HolidayDatabase* db, int year) {
+    if (!db) return NULL;
+    if (year >= db->first_year && year < db->first_year + db->year_count && db->years[year - db->first_year]) {
+        return db->years[year - db->first_year];
+    }
+    if (holiday_db_materialize_range(db, year, year) != CALENDAR_SUCCESS) return NULL;
+    return db->years[year - db->first_year];
+}
+
+CalendarResult holiday_db_materialize_range(HolidayDatabase* db, int start_year, int end_year) {
+    if (!db) return CALENDAR_ERROR_NULL_POINTER;
+    if (end_year < start_year) return CALENDAR_ERROR_INVALID_YEAR;
+    if (db->frozen) {
+        // Readers share the cache: it may only be read
+        if (start_year < db->first_year || end_year >= db->first_year + db->year_count) {
+            return CALENDAR_ERROR_INVALID_YEAR;
+        }
+        for (int year = start_year; year <= end_year; year++) {
+            if (!db->years[year - db->first_year]) return CALENDAR_ERROR_INVALID_YEAR;
         }
+        return CALENDAR_SUCCESS;
     }
     
-    return NULL;
+    CalendarResult result = holiday_db_reserve_years(db, start_year, end_year);
+    if (result != CALENDAR_SUCCESS) return result;
+    result = holiday_db_build_month_tables(db, start_year, end_year);
+    if (result != CALENDAR_SUCCESS) return result;
+    
+    // Years are independent; build the missing ones in parallel
+    struct HolidayYear** years = db->years + (start_year - db->first_year);
+    int count = end_year - start_year + 1;
+    int failed = 0;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(|:failed)
+#endif
+    for (int i = 0; i < count; i++) {
+        if (!years[i]) {
+            years[i] = holiday_year_build(db, start_year + i);
+            failed |= years[i] == NULL;
+        }
+    }
+    return failed ? CALENDAR_ERROR_MEMORY_ALLOCATION : CALENDAR_SUCCESS;
+}
+
+CalendarResult holiday_db_find_occurrences(HolidayDatabase* db, long jdn, const char* country_code,
+                                           const Holiday** matches, int capacity, int* count) {
+    if (!db || !count || (!matches && capacity > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    *count = 0;
+    
+    int day, month, year;
+    julian_day_to_date(jdn, &day, &month, &year);
+    const HolidayYear* occurrences = holiday_db_materialize_year(db, year);
+    if (!occurrences) return db->frozen ? CALENDAR_ERROR_INVALID_YEAR : CALENDAR_ERROR_MEMORY_ALLOCATION;
+    
+    const HolidayOccurrence* first;
+    int found;
+    holiday_year_find(occurrences, jdn, jdn, country_code, &first, &found);
+    for (int i = 0; i < found && i < capacity; i++) {
+        matches[i] = &db->holidays[first[i].holiday];
+    }
+    *count = found;
+    return CALENDAR_SUCCESS;
+}
+
+void holiday_db_clamp_years(const HolidayDatabase* db, int* start_year, int* end_year) {
+    if (!db || !start_year || !end_year || !db->frozen) return;
+    if (*start_year < db->first_year) *start_year = db->first_year;
+    if (*end_year > db->first_year + db->year_count - 1) *end_year = db->first_year + db->year_count - 1;
+}
+
+CalendarResult holiday_db_set_observance_rule(HolidayDatabase* db, const HolidayObservanceRule* rule) {
+    if (!db || !rule) return CALENDAR_ERROR_NULL_POINTER;
+    if (db->frozen || holiday_index_country_key(rule->country_code) == 0) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    int slot = 0;
+    while (slot < db->observance_rule_count &&
+           strcmp(db->observance_rules[slot].country_code, rule->country_code) != 0) {
+        slot++;
+    }
+    if (slot == db->observance_rule_count) {
+        HolidayObservanceRule* rules = realloc(db->observance_rules,
+                                               sizeof(HolidayObservanceRule) * (size_t)(slot + 1));
+        if (!rules) return CALENDAR_ERROR_MEMORY_ALLOCATION;
+        db->observance_rules = rules;
+        db->observance_rule_count++;
+    }
+    db->observance_rules[slot] = *rule;
+    
+    // Only the observed days change: rerun the pass, not the rules
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < db->year_count; i++) {
+        if (db->years[i]) holiday_year_observe(db->years[i], db);
+    }
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult holiday_db_find_periods(HolidayDatabase* db, long start_jdn, long end_jdn, const char* country_code,
+                                       HolidayOccurrence* matches, int capacity, int* count) {
+    if (!db || !count || (!matches && capacity > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    *count = 0;
+    if (end_jdn < start_jdn) return CALENDAR_SUCCESS;
+    
+    // Periods last at most a year, so the one before the range is the
+    // earliest that can reach into it
+    int day, month, first_year, last_year;
+    julian_day_to_date(start_jdn, &day, &month, &first_year);
+    julian_day_to_date(end_jdn, &day, &month, &last_year);
+    int padded_year = first_year - 1;
+    int end_year = last_year;
+    holiday_db_clamp_years(db, &padded_year, &end_year);
+    if (padded_year > first_year || end_year < last_year) return CALENDAR_ERROR_INVALID_YEAR;
+    CalendarResult result = holiday_db_materialize_range(db, padded_year, last_year);
+    if (result != CALENDAR_SUCCESS) return result;
+    
+    int total = 0;
+    for (int year = padded_year; year <= last_year; year++) {
+        int room = capacity > total ? capacity - total : 0;
+        int found;
+        holiday_year_find_overlapping(db->years[year - db->first_year], start_jdn, end_jdn, country_code,
+                                      room > 0 ? matches + total : NULL, room, &found);
+        total += found;
+    }
+    *count = total;
+    return CALENDAR_SUCCESS;
 }
 
 void holiday_db_print_holidays(const HolidayDatabase* db) {
@@ -208,6 +553,20 @@ void holiday_db_print_holidays_for_month(const HolidayDatabase* db, int month,
     printf("\n");
 }
 
+// Text field, quoted when it holds a comma, quote or line break
+static void holiday_db_write_field(FILE* file, const char* text) {
+    if (!strpbrk(text, ",\"\r\n")) {
+        fputs(text, file);
+        return;
+    }
+    fputc('"', file);
+    for (const char* c = text; *c; c++) {
+        if (*c == '"') fputc('"', file);
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
 CalendarResult holiday_db_save_to_file(const HolidayDatabase* db, const char* filename) {
     if (!db || !filename) return CALENDAR_ERROR_NULL_POINTER;
     
@@ -215,19 +574,21 @@ CalendarResult holiday_db_save_to_file(const HolidayDatabase* db, const char* fi
     if (!file) return CALENDAR_ERROR_CONVERSION_FAILED;
     
     // Write header
-    fprintf(file, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic\n");
+    fprintf(file, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic,Weekday,Offset,Duration,IsBank,IsSchool\n");
     
     // Write holidays
     for (int i = 0; i < db->count; i++) {
         const Holiday* holiday = &db->holidays[i];
-        fprintf(file, "%s,%s,%d,%d,%d,%d,%s,%d\n",
-                holiday->name, holiday->description,
+        holiday_db_write_field(file, holiday->name);
+        fputc(',', file);
+        holiday_db_write_field(file, holiday->description);
+        fprintf(file, ",%d,%d,%d,%d,%s,%d,%d,%d,%d,%d,%d\n",
                 holiday->calendar_type, holiday->holiday_type,
                 holiday->date.month, holiday->date.day,
-                holiday->country_code, holiday->is_public_holiday);
+                holiday->country_code, holiday->is_public_holiday,
+                holiday->weekday, holiday->offset_days, holiday->duration_days,
+                holiday->is_bank_holiday, holiday->is_school_holiday);
     }
     
-    fclose(file);
-    printf("Saved %d holidays to %s\n", db->count, filename);
-    return CALENDAR_SUCCESS;
+    return fclose(file) == 0 ? CALENDAR_SUCCESS : CALENDAR_ERROR_CONVERSION_FAILED;
 }
\ No newline at end of file
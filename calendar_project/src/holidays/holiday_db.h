@@ -3,8 +3,14 @@
 #define HOLIDAY_DB_H
 
 #include "../../include/calendar_types.h"
+#include "holiday_index.h"
+#include "../utils/string_pool.h"
 
-#define MAX_HOLIDAYS 1000
+#define HOLIDAY_LOAD_MAX_ERRORS 16
+#define HOLIDAY_MAX_DURATION_DAYS 366
+#define HOLIDAY_DB_DEFAULT_FILE "data/holidays.csv"     // Read by the exporters
+
+struct HolidayOccurrence;       // holiday_rules.h
 
 // Holiday types
 typedef enum {
@@ -15,36 +21,129 @@ typedef enum {
     HOLIDAY_WEEKDAY      // Nth weekday of month
 } HolidayType;
 
-// Holiday structure
+// Holiday structure. In a database, name and description point into its
+// string pool, and a holiday read from a snapshot points into the mapping.
 typedef struct {
-    char name[64];
-    char description[128];
+    const char* name;
+    const char* description;
     CalendarType calendar_type;
     int holiday_type;
     Date date;
     char country_code[4];
     int is_public_holiday;
+    int is_bank_holiday;        // As in ExtendedHoliday
+    int is_school_holiday;
+    int weekday;                // HOLIDAY_WEEKDAY: 0 = Sunday ... 6 = Saturday; -1 = use the date as is
+    int offset_days;            // Added to the day the rule gives (Easter: days from Easter Sunday)
+    int duration_days;          // Days the observance lasts from that day; 0 or 1 = a single day
 } Holiday;
 
+// How a country moves a public holiday that falls on its weekend
+typedef enum {
+    HOLIDAY_OBSERVE_ACTUAL,     // Not moved
+    HOLIDAY_OBSERVE_NEAREST,    // To the nearest weekday, later on a tie (US: Saturday to Friday, Sunday to Monday)
+    HOLIDAY_OBSERVE_FOLLOWING   // To the next weekday (UK)
+} HolidayObserveShift;
+
+// A country's substitution rule. Multi-day periods are never moved.
+typedef struct {
+    char country_code[4];
+    int weekend_mask;           // Bit d set when weekday d (0 = Sunday) is off, as in business_calendar.h
+    HolidayObserveShift shift;
+    int cascade;                // Move on again past days other holidays already take (UK Christmas and Boxing Day)
+} HolidayObservanceRule;
+
 // Holiday database structure
 typedef struct {
     Holiday* holidays;
     int count;
+    int capacity;               // Grows by doubling
+    StringPool* strings;        // Names and descriptions, each stored once
+    HolidayIndex* index;        // Built on first lookup, dropped on every change
+    struct HolidayYear** years; // Materialized occurrences, years[y - first_year]; likewise
+    int first_year;
+    int year_count;
+    struct HolidayMonthTable* month_tables[HOLIDAY_INDEX_CALENDARS];  // Per calendar; kept across changes
+    HolidayObservanceRule* observance_rules;    // One per country; likewise
+    int observance_rule_count;
+    int frozen;                 // Shared with readers (holiday_handle.h): changes and lazy builds fail
 } HolidayDatabase;
 
 // Database management functions
 HolidayDatabase* holiday_db_create(void);
 void holiday_db_destroy(HolidayDatabase* db);
 
-// Loading and saving
+// Builds the index and the years [start_year - 1, end_year + 1], then makes
+// the database read-only, so that threads can query it at once: changes fail
+// with CALENDAR_ERROR_CONVERSION_FAILED, and years outside the range with
+// CALENDAR_ERROR_INVALID_YEAR. The year on each side holds the periods and
+// observed days that reach into the range.
+CalendarResult holiday_db_freeze(HolidayDatabase* db, int start_year, int end_year);
+
+// A CSV row the loader rejected
+typedef struct {
+    long line;                  // Line the row starts on, from 1
+    char message[64];
+} HolidayLoadError;
+
+// Outcome of loading a CSV file: every malformed row is counted, and the
+// first HOLIDAY_LOAD_MAX_ERRORS are kept
+typedef struct {
+    int loaded;
+    int malformed;
+    HolidayLoadError errors[HOLIDAY_LOAD_MAX_ERRORS];
+} HolidayLoadReport;
+
+// Loading and saving. Files are RFC 4180 CSV: an optional header row starting
+// with "Name", '#' comment lines, and fields quoted where they hold commas,
+// quotes or line breaks. Rows are appended; malformed ones are skipped and
+// reported. load_from_file prints the malformed rows to stderr; neither
+// writes to stdout, and a missing file is CALENDAR_ERROR_CONVERSION_FAILED.
+CalendarResult holiday_db_load_csv(HolidayDatabase* db, const char* filename, HolidayLoadReport* report);
 CalendarResult holiday_db_load_from_file(HolidayDatabase* db, const char* filename);
 CalendarResult holiday_db_save_to_file(const HolidayDatabase* db, const char* filename);
 
-// Holiday management
+// Holiday management; the names are copied into the database
 CalendarResult holiday_db_add_holiday(HolidayDatabase* db, const Holiday* holiday);
 Holiday* holiday_db_get_holidays_for_date(HolidayDatabase* db, const Date* date, 
                                           CalendarType calendar_type, const char* country_code);
 
+// Date lookups through the (calendar, month, day) index with per-country buckets
+CalendarResult holiday_db_build_index(HolidayDatabase* db);
+
+// Every holiday on a date (country_code NULL or "" for all countries): up to
+// capacity pointers into the database, and the total number in *count.
+// Gregorian dates with a year match every rule through the materialized
+// occurrences, whatever the holiday's calendar; other calendars match the
+// stored month and day.
+CalendarResult holiday_db_find_holidays(HolidayDatabase* db, const Date* date, CalendarType calendar_type,
+                                        const char* country_code, const Holiday** matches, int capacity,
+                                        int* count);
+
+// Rules expanded into Gregorian day numbers, one cached HolidayYear per year
+// (see holiday_rules.h); lookups binary-search the occurrences. A range first
+// builds month tables for the other calendars it needs, so that converting a
+// date is a table read.
+const struct HolidayYear* holiday_db_materialize_year(HolidayDatabase* db, int year);
+CalendarResult holiday_db_materialize_range(HolidayDatabase* db, int start_year, int end_year);
+CalendarResult holiday_db_find_occurrences(HolidayDatabase* db, long jdn, const char* country_code,
+                                           const Holiday** matches, int capacity, int* count);
+
+// Narrows [*start_year, *end_year] to the years a frozen database has cached,
+// for lookups that pad the years they need; left alone while it can build
+void holiday_db_clamp_years(const HolidayDatabase* db, int* start_year, int* end_year);
+
+// Sets a country's observance rule, replacing any earlier one. Years already
+// materialized get their observed days recomputed in place.
+CalendarResult holiday_db_set_observance_rule(HolidayDatabase* db, const HolidayObservanceRule* rule);
+
+// Observance periods overlapping [start_jdn, end_jdn], through each year's
+// interval tree: up to capacity occurrences (holiday index, first and last
+// day), in date order, and the total in *count. A period that starts in the
+// previous year is included; find_periods(d, d) lists what is active on d.
+CalendarResult holiday_db_find_periods(HolidayDatabase* db, long start_jdn, long end_jdn, const char* country_code,
+                                       struct HolidayOccurrence* matches, int capacity, int* count);
+
 // Display functions
 void holiday_db_print_holidays(const HolidayDatabase* db);
 void holiday_db_print_holidays_for_month(const HolidayDatabase* db, int month, 
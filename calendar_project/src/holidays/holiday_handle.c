@@ -0,0 +1,205 @@
+// src/holidays/holiday_handle.c
+#include "holiday_handle.h"
+#include "holiday_snapshot.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+typedef struct HolidayHandleVersion {
+    HolidayDatabase* db;
+    uint64_t number;
+    uint64_t retired_epoch;             // Readers that started before it may still hold the version
+    struct HolidayHandleVersion* next;  // Retired list
+} HolidayHandleVersion;
+
+// One reader, on a cache line of its own so that announcing stays local
+typedef struct {
+    _Atomic uint64_t epoch;             // Epoch the current read started in; 0 outside reads
+    atomic_int in_use;
+    char padding[64 - sizeof(_Atomic uint64_t) - sizeof(atomic_int)];
+} HolidayHandleReader;
+
+struct HolidayHandle {
+    _Atomic(HolidayHandleVersion*) current;
+    _Atomic uint64_t epoch;             // From 1
+    _Atomic uint64_t version;
+    atomic_flag publishing;
+    HolidayHandleVersion* retired;      // Only touched while publishing is set
+    int start_year;
+    int end_year;
+    HolidayHandleReader readers[HOLIDAY_HANDLE_MAX_READERS];
+};
+
+static HolidayHandleVersion* holiday_handle_version_create(HolidayDatabase* db, uint64_t number) {
+    HolidayHandleVersion* version = malloc(sizeof(HolidayHandleVersion));
+    if (!version) return NULL;
+    version->db = db;
+    version->number = number;
+    version->retired_epoch = 0;
+    version->next = NULL;
+    return version;
+}
+
+static void holiday_handle_lock(HolidayHandle* handle) {
+    while (atomic_flag_test_and_set_explicit(&handle->publishing, memory_order_acquire)) {
+        // Publishers only swap pointers while holding it, so waits are short
+    }
+}
+
+static void holiday_handle_unlock(HolidayHandle* handle) {
+    atomic_flag_clear_explicit(&handle->publishing, memory_order_release);
+}
+
+HolidayHandle* holiday_handle_create(HolidayDatabase* db, int start_year, int end_year) {
+    if (!db || end_year < start_year) return NULL;
+    if (holiday_db_freeze(db, start_year, end_year) != CALENDAR_SUCCESS) return NULL;
+    
+    HolidayHandle* handle = malloc(sizeof(HolidayHandle));
+    HolidayHandleVersion* version = holiday_handle_version_create(db, 1);
+    if (!handle || !version) {
+        free(handle);
+        free(version);
+        return NULL;
+    }
+    atomic_init(&handle->current, version);
+    atomic_init(&handle->epoch, 1);
+    atomic_init(&handle->version, 1);
+    atomic_flag_clear(&handle->publishing);
+    handle->retired = NULL;
+    handle->start_year = start_year;
+    handle->end_year = end_year;
+    for (int i = 0; i < HOLIDAY_HANDLE_MAX_READERS; i++) {
+        atomic_init(&handle->readers[i].epoch, 0);
+        atomic_init(&handle->readers[i].in_use, 0);
+    }
+    return handle;
+}
+
+void holiday_handle_destroy(HolidayHandle* handle) {
+    if (!handle) return;
+    
+    HolidayHandleVersion* version = atomic_load(&handle->current);
+    version->next = handle->retired;
+    while (version) {
+        HolidayHandleVersion* next = version->next;
+        holiday_db_destroy(version->db);
+        free(version);
+        version = next;
+    }
+    free(handle);
+}
+
+int holiday_handle_register_reader(HolidayHandle* handle) {
+    if (!handle) return -1;
+    for (int i = 0; i < HOLIDAY_HANDLE_MAX_READERS; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&handle->readers[i].in_use, &expected, 1)) return i;
+    }
+    return -1;
+}
+
+void holiday_handle_unregister_reader(HolidayHandle* handle, int reader) {
+    if (!handle || reader < 0 || reader >= HOLIDAY_HANDLE_MAX_READERS) return;
+    atomic_store(&handle->readers[reader].epoch, 0);
+    atomic_store(&handle->readers[reader].in_use, 0);
+}
+
+HolidayDatabase* holiday_handle_read_begin(HolidayHandle* handle, int reader, uint64_t* version) {
+    if (!handle || reader < 0 || reader >= HOLIDAY_HANDLE_MAX_READERS) return NULL;
+    
+    // Announce the epoch before loading the pointer: a publisher that has
+    // not seen the announcement swapped the pointer first, so the load finds
+    // the newer version
+    atomic_store(&handle->readers[reader].epoch, atomic_load(&handle->epoch));
+    HolidayHandleVersion* current = atomic_load(&handle->current);
+    if (version) *version = current->number;
+    return current->db;
+}
+
+void holiday_handle_read_end(HolidayHandle* handle, int reader) {
+    if (!handle || reader < 0 || reader >= HOLIDAY_HANDLE_MAX_READERS) return;
+    atomic_store_explicit(&handle->readers[reader].epoch, 0, memory_order_release);
+}
+
+uint64_t holiday_handle_version(const HolidayHandle* handle) {
+    return handle ? atomic_load(&((HolidayHandle*)handle)->version) : 0;
+}
+
+// Frees what every reader has moved past; the caller holds the lock
+static size_t holiday_handle_reclaim_locked(HolidayHandle* handle) {
+    uint64_t oldest = UINT64_MAX;
+    for (int i = 0; i < HOLIDAY_HANDLE_MAX_READERS; i++) {
+        uint64_t epoch = atomic_load(&handle->readers[i].epoch);
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+    
+    size_t left = 0;
+    HolidayHandleVersion** link = &handle->retired;
+    while (*link) {
+        HolidayHandleVersion* version = *link;
+        if (version->retired_epoch <= oldest) {
+            *link = version->next;
+            holiday_db_destroy(version->db);
+            free(version);
+        } else {
+            link = &version->next;
+            left++;
+        }
+    }
+    return left;
+}
+
+CalendarResult holiday_handle_publish(HolidayHandle* handle, HolidayDatabase* db) {
+    if (!handle || !db) return CALENDAR_ERROR_NULL_POINTER;
+    
+    // All building happens here, before any reader can see the database
+    CalendarResult result = holiday_db_freeze(db, handle->start_year, handle->end_year);
+    if (result != CALENDAR_SUCCESS) return result;
+    HolidayHandleVersion* version = holiday_handle_version_create(db, 0);
+    if (!version) return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    
+    holiday_handle_lock(handle);
+    version->number = atomic_load(&handle->version) + 1;
+    HolidayHandleVersion* old = atomic_exchange(&handle->current, version);
+    atomic_store(&handle->version, version->number);
+    
+    // Readers announcing the new epoch load the pointer after the swap
+    old->retired_epoch = atomic_fetch_add(&handle->epoch, 1) + 1;
+    old->next = handle->retired;
+    handle->retired = old;
+    holiday_handle_reclaim_locked(handle);
+    holiday_handle_unlock(handle);
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult holiday_handle_reload(HolidayHandle* handle, const char* const* sources, int source_count) {
+    if (!handle || (!sources && source_count > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    
+    HolidayDatabase* db = holiday_db_create();
+    if (!db) return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    CalendarResult result = CALENDAR_SUCCESS;
+    for (int i = 0; i < source_count && result == CALENDAR_SUCCESS; i++) {
+        result = sources[i] ? holiday_snapshot_load_source(db, sources[i]) : CALENDAR_ERROR_NULL_POINTER;
+    }
+    
+    // Rules are configuration rather than data; the lock keeps the current
+    // version from being retired and freed while they are copied
+    if (result == CALENDAR_SUCCESS) {
+        holiday_handle_lock(handle);
+        const HolidayDatabase* current = atomic_load(&handle->current)->db;
+        for (int i = 0; i < current->observance_rule_count && result == CALENDAR_SUCCESS; i++) {
+            result = holiday_db_set_observance_rule(db, &current->observance_rules[i]);
+        }
+        holiday_handle_unlock(handle);
+    }
+    if (result == CALENDAR_SUCCESS) result = holiday_handle_publish(handle, db);
+    if (result != CALENDAR_SUCCESS) holiday_db_destroy(db);
+    return result;
+}
+
+size_t holiday_handle_reclaim(HolidayHandle* handle) {
+    if (!handle) return 0;
+    holiday_handle_lock(handle);
+    size_t left = holiday_handle_reclaim_locked(handle);
+    holiday_handle_unlock(handle);
+    return left;
+}
@@ -0,0 +1,50 @@
+// src/holidays/holiday_handle.h
+#ifndef HOLIDAY_HANDLE_H
+#define HOLIDAY_HANDLE_H
+
+#include "holiday_db.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Hot-reloadable database for long-running services, read-copy-update style.
+// Readers take the current version with an atomic load, without locks, and
+// query it while a reloader builds the next one beside it (index and years
+// included) and publishes it with an atomic swap. A version replaced is
+// freed once no reader that could have seen it is still reading: each
+// reader announces the epoch it started in, and each publish starts a new one.
+#define HOLIDAY_HANDLE_MAX_READERS 64
+
+typedef struct HolidayHandle HolidayHandle;
+
+// Takes ownership of db, frozen over years [start_year, end_year] as every
+// later version will be; NULL when it cannot be prepared
+HolidayHandle* holiday_handle_create(HolidayDatabase* db, int start_year, int end_year);
+
+// Frees every version; no reader may be inside a read
+void holiday_handle_destroy(HolidayHandle* handle);
+
+// Each reading thread takes a slot once; -1 when all are taken
+int holiday_handle_register_reader(HolidayHandle* handle);
+void holiday_handle_unregister_reader(HolidayHandle* handle, int reader);
+
+// The current version, frozen (holiday_db_freeze) and valid until
+// read_end; version numbers start at 1. Reads do not nest.
+HolidayDatabase* holiday_handle_read_begin(HolidayHandle* handle, int reader, uint64_t* version);
+void holiday_handle_read_end(HolidayHandle* handle, int reader);
+
+// Latest version number published
+uint64_t holiday_handle_version(const HolidayHandle* handle);
+
+// Freezes db, takes ownership and makes it the current version; on failure
+// db stays the caller's. Publishers are serialized with each other only.
+CalendarResult holiday_handle_publish(HolidayHandle* handle, HolidayDatabase* db);
+
+// Loads a new version from sources (snapshots or CSV files, as in
+// holiday_snapshot_compile), carries the observance rules over and publishes it
+CalendarResult holiday_handle_reload(HolidayHandle* handle, const char* const* sources, int source_count);
+
+// Frees the replaced versions no reader can still see; returns how many are
+// left waiting. Publishing reclaims too.
+size_t holiday_handle_reclaim(HolidayHandle* handle);
+
+#endif // HOLIDAY_HANDLE_H
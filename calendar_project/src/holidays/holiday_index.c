@@ -0,0 +1,144 @@
+// src/holidays/holiday_index.c
+#include "holiday_index.h"
+
+#define HOLIDAY_INDEX_MIN_BUCKETS 16
+#define HOLIDAY_INDEX_HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL   // Fibonacci hashing
+
+typedef struct {
+    uint64_t key;
+    uint32_t entry;
+} HolidayIndexSortItem;
+
+int holiday_index_slot(int calendar_type, int month, int day) {
+    if (calendar_type < 0 || calendar_type >= HOLIDAY_INDEX_CALENDARS) return HOLIDAY_INDEX_NO_SLOT;
+    if (month < 1 || month >= HOLIDAY_INDEX_MONTHS) return HOLIDAY_INDEX_NO_SLOT;
+    if (day < 1 || day >= HOLIDAY_INDEX_DAYS) return HOLIDAY_INDEX_NO_SLOT;
+    return (calendar_type * HOLIDAY_INDEX_MONTHS + month) * HOLIDAY_INDEX_DAYS + day;
+}
+
+uint32_t holiday_index_country_key(const char* country_code) {
+    if (!country_code) return 0;
+    
+    uint32_t key = 0;
+    for (int i = 0; country_code[i]; i++) {
+        if (i == 3) return 0;
+        key |= (uint32_t)(unsigned char)country_code[i] << (8 * i);
+    }
+    return key;
+}
+
+static uint32_t holiday_index_hash(uint64_t key, uint32_t mask) {
+    return (uint32_t)((key * HOLIDAY_INDEX_HASH_MULTIPLIER) >> 32) & mask;
+}
+
+static int holiday_index_compare_items(const void* a, const void* b) {
+    const HolidayIndexSortItem* ia = a;
+    const HolidayIndexSortItem* ib = b;
+    if (ia->key != ib->key) return ia->key < ib->key ? -1 : 1;
+    return ia->entry < ib->entry ? -1 : (ia->entry > ib->entry);
+}
+
+HolidayIndex* holiday_index_build(const int32_t* slots, const char* countries, size_t country_stride,
+                                  uint32_t count) {
+    if ((!slots || !countries) && count > 0) return NULL;
+    
+    HolidayIndex* index = calloc(1, sizeof(HolidayIndex));
+    HolidayIndexSortItem* items = malloc(sizeof(HolidayIndexSortItem) * (count > 0 ? count : 1));
+    if (!index || !items) {
+        free(index);
+        free(items);
+        return NULL;
+    }
+    
+    // One sort orders entries by slot, country and insertion at once
+    uint32_t indexed = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (slots[i] <= 0 || slots[i] >= HOLIDAY_INDEX_SLOTS) continue;
+        items[indexed].key = (uint64_t)slots[i] << 32 |
+                             holiday_index_country_key(countries + (size_t)i * country_stride);
+        items[indexed].entry = i;
+        indexed++;
+    }
+    qsort(items, indexed, sizeof(HolidayIndexSortItem), holiday_index_compare_items);
+    
+    uint32_t distinct = 0;
+    for (uint32_t i = 0; i < indexed; i++) {
+        if (i == 0 || items[i].key != items[i - 1].key) distinct++;
+    }
+    uint32_t bucket_count = HOLIDAY_INDEX_MIN_BUCKETS;
+    while (bucket_count < 2 * distinct) bucket_count *= 2;
+    
+    index->order = malloc(sizeof(uint32_t) * (indexed > 0 ? indexed : 1));
+    index->slot_start = calloc(HOLIDAY_INDEX_SLOTS + 1, sizeof(uint32_t));
+    index->buckets = calloc(bucket_count, sizeof(HolidayIndexBucket));
+    if (!index->order || !index->slot_start || !index->buckets) {
+        free(items);
+        holiday_index_destroy(index);
+        return NULL;
+    }
+    index->bucket_mask = bucket_count - 1;
+    index->count = indexed;
+    
+    // Slot offsets: counts, then a running sum
+    for (uint32_t i = 0; i < indexed; i++) {
+        index->order[i] = items[i].entry;
+        index->slot_start[(items[i].key >> 32) + 1]++;
+    }
+    for (int s = 0; s < HOLIDAY_INDEX_SLOTS; s++) index->slot_start[s + 1] += index->slot_start[s];
+    
+    // One bucket per run of equal keys, by linear probing
+    for (uint32_t i = 0; i < indexed; ) {
+        uint32_t end = i + 1;
+        while (end < indexed && items[end].key == items[i].key) end++;
+        
+        uint32_t b = holiday_index_hash(items[i].key, index->bucket_mask);
+        while (index->buckets[b].key != 0) b = (b + 1) & index->bucket_mask;
+        index->buckets[b].key = items[i].key;
+        index->buckets[b].start = i;
+        index->buckets[b].count = end - i;
+        i = end;
+    }
+    
+    free(items);
+    return index;
+}
+
+void holiday_index_destroy(HolidayIndex* index) {
+    if (!index) return;
+    free(index->order);
+    free(index->slot_start);
+    free(index->buckets);
+    free(index);
+}
+
+CalendarResult holiday_index_lookup(const HolidayIndex* index, int slot, const char* country_code,
+                                    uint32_t* first, uint32_t* count) {
+    if (!index || !first || !count) return CALENDAR_ERROR_NULL_POINTER;
+    
+    *first = 0;
+    *count = 0;
+    if (slot <= 0 || slot >= HOLIDAY_INDEX_SLOTS) return CALENDAR_ERROR_INVALID_DATE;
+    
+    if (!country_code || country_code[0] == '\0') {
+        *first = index->slot_start[slot];
+        *count = index->slot_start[slot + 1] - index->slot_start[slot];
+        return CALENDAR_SUCCESS;
+    }
+    
+    // Codes longer than any stored one match nothing
+    uint32_t country = holiday_index_country_key(country_code);
+    if (country == 0) return CALENDAR_SUCCESS;
+    
+    // The probe count bounds the loop even on a mapped table with no empty bucket
+    uint64_t key = (uint64_t)slot << 32 | country;
+    uint32_t b = holiday_index_hash(key, index->bucket_mask);
+    for (uint64_t probe = 0; probe <= index->bucket_mask && index->buckets[b].key != 0;
+         probe++, b = (b + 1) & index->bucket_mask) {
+        if (index->buckets[b].key == key) {
+            *first = index->buckets[b].start;
+            *count = index->buckets[b].count;
+            break;
+        }
+    }
+    return CALENDAR_SUCCESS;
+}
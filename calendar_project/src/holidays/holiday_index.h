@@ -0,0 +1,50 @@
+// src/holidays/holiday_index.h
+#ifndef HOLIDAY_INDEX_H
+#define HOLIDAY_INDEX_H
+
+#include "../../include/calendar_types.h"
+#include <stdint.h>
+
+// Direct-addressed slot per (calendar, month, day); 13 months for Hebrew leap years
+#define HOLIDAY_INDEX_CALENDARS 16
+#define HOLIDAY_INDEX_MONTHS 14
+#define HOLIDAY_INDEX_DAYS 32
+#define HOLIDAY_INDEX_SLOTS (HOLIDAY_INDEX_CALENDARS * HOLIDAY_INDEX_MONTHS * HOLIDAY_INDEX_DAYS)
+#define HOLIDAY_INDEX_NO_SLOT -1
+
+// Country sub-bucket: the run of one slot's entries that belong to one country
+typedef struct {
+    uint64_t key;               // Slot << 32 | packed country code; 0 = empty
+    uint32_t start;             // Position in order[]
+    uint32_t count;
+} HolidayIndexBucket;
+
+// Entries grouped by slot, then by country, then in insertion order. A date
+// maps to its slot's run of order[]; a date and country hash to a bucket.
+typedef struct {
+    uint32_t* order;            // Entry indices
+    uint32_t* slot_start;       // HOLIDAY_INDEX_SLOTS + 1 offsets into order[]
+    HolidayIndexBucket* buckets;
+    uint32_t bucket_mask;       // Bucket count - 1 (a power of two)
+    uint32_t count;             // Entries indexed
+} HolidayIndex;
+
+// Entry i is filed under slots[i] (HOLIDAY_INDEX_NO_SLOT to leave it out)
+// and the country code countries[i * country_stride]
+HolidayIndex* holiday_index_build(const int32_t* slots, const char* countries, size_t country_stride,
+                                  uint32_t count);
+void holiday_index_destroy(HolidayIndex* index);
+
+// Slot of a date; HOLIDAY_INDEX_NO_SLOT when out of range
+int holiday_index_slot(int calendar_type, int month, int day);
+
+// Country codes of up to three characters packed into one word; 0 when empty
+// or too long to be stored
+uint32_t holiday_index_country_key(const char* country_code);
+
+// Run of order[] holding the entries on a date, optionally for one country
+// (NULL or "" for all countries)
+CalendarResult holiday_index_lookup(const HolidayIndex* index, int slot, const char* country_code,
+                                    uint32_t* first, uint32_t* count);
+
+#endif // HOLIDAY_INDEX_H
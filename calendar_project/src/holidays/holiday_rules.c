@@ -0,0 +1,663 @@
+// src/holidays/holiday_rules.c
+#include "holiday_rules.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/calendar_types_extended.h"
+#include "../calendars/gregorian.h"
+#include "../calendars/islamic.h"
+#include "../calendars/hebrew.h"
+#include "../calendars/persian.h"
+#include "../calendars/chinese.h"
+#ifdef BUILD_ASTRONOMY
+#include "../astronomy/time_scale.h"
+#endif
+#include "../utils/date_utils.h"
+
+#define HOLIDAY_RULE_MAX_BASES 4        // Calendar years tried per Gregorian year
+#define HOLIDAY_OBSERVE_WINDOW_WORDS 8  // Days tracked for cascading: 512 from a month before the year
+
+// Weekday of a JDN, 0 = Sunday
+static int holiday_jdn_weekday(long jdn) {
+    return (int)((jdn + 1) % 7);
+}
+
+long holiday_weekday_on_or_after(long jdn, int weekday) {
+    return jdn + (weekday - holiday_jdn_weekday(jdn) + 7) % 7;
+}
+
+long holiday_nth_weekday_jdn(int year, int month, int weekday, int nth) {
+    if (nth == 0 || weekday < 0 || weekday > 6 || month < 1 || month > 12) return 0;
+    
+    long first = julian_day_from_date(1, month, year);
+    long last = first + gregorian_days_in_month(month, year) - 1;
+    long jdn = nth > 0 ? holiday_weekday_on_or_after(first, weekday) + 7L * (nth - 1)
+                       : holiday_weekday_on_or_after(last - 6, weekday) + 7L * (nth + 1);
+    return jdn >= first && jdn <= last ? jdn : 0;
+}
+
+// Julian calendar date to JDN
+static long holiday_julian_calendar_jdn(int day, int month, int year) {
+    int a = (14 - month) / 12;
+    long y = year + 4800 - a;
+    int m = month + 12 * a - 3;
+    return day + (153 * m + 2) / 5 + 365 * y + y / 4 - 32083;
+}
+
+// Meeus, Astronomical Algorithms ch. 8
+long holiday_easter_jdn(int year, int orthodox) {
+    if (orthodox) {
+        int a = year % 4, b = year % 7, c = year % 19;
+        int d = (19 * c + 15) % 30;
+        int e = (2 * a + 4 * b - d + 34) % 7;
+        return holiday_julian_calendar_jdn((d + e + 114) % 31 + 1, (d + e + 114) / 31, year);
+    }
+    
+    int a = year % 19, b = year / 100, c = year % 100;
+    int d = b / 4, e = b % 4;
+    int f = (b + 8) / 25;
+    int g = (b - f + 1) / 3;
+    int h = (19 * a + b - d - g + 15) % 30;
+    int i = c / 4, k = c % 4;
+    int l = (32 + 2 * e + 2 * i - h - k) % 7;
+    int m = (a + 11 * h + 22 * l) / 451;
+    return julian_day_from_date((h + l - 7 * m + 114) % 31 + 1, (h + l - 7 * m + 114) / 31, year);
+}
+
+#ifdef BUILD_ASTRONOMY
+// Start and length of a (non-leap) month of the Chinese year beginning in
+// Gregorian year `year`; 0 if not found
+static int holiday_chinese_month(int month, int year, long* start) {
+    ChineseMonth months[CHINESE_MAX_MONTHS];
+    int count = 0;
+    if (chinese_year_months(year, months, &count) != CALENDAR_SUCCESS) return 0;
+    for (int i = 0; i < count; i++) {
+        if (months[i].number == month && !months[i].is_leap) {
+            *start = months[i].start_jdn;
+            return months[i].length;
+        }
+    }
+    return 0;
+}
+#endif
+
+// Whether dates of a calendar can be converted
+static int holiday_calendar_supported(int calendar_type) {
+#ifdef BUILD_ASTRONOMY
+    (void)calendar_type;
+    return 1;
+#else
+    return calendar_type != CALENDAR_CHINESE;
+#endif
+}
+
+// Length of a month in the holiday's own calendar; 0 if the year lacks it
+static int holiday_calendar_month_length(int calendar_type, int month, int year) {
+    switch (calendar_type) {
+#ifdef BUILD_ASTRONOMY
+        case CALENDAR_CHINESE: {
+            long start;
+            return holiday_chinese_month(month, year, &start);
+        }
+#endif
+        case CALENDAR_ISLAMIC:
+            return month >= 1 && month <= 12 ? islamic_days_in_month(month, year) : 0;
+        case CALENDAR_HEBREW:
+            return month >= 1 && month <= hebrew_months_in_year(year) ? hebrew_days_in_month(month, year) : 0;
+        case CALENDAR_PERSIAN:
+            return persian_days_in_month(month, year);
+        default:
+            return month >= 1 && month <= 12 ? gregorian_days_in_month(month, year) : 0;
+    }
+}
+
+// JDN of a date in the holiday's own calendar through its engine; 0 if it
+// does not exist that year
+static long holiday_calendar_date_jdn(int calendar_type, int day, int month, int year) {
+    if (day < 1 || day > holiday_calendar_month_length(calendar_type, month, year)) return 0;
+    
+    switch (calendar_type) {
+        case CALENDAR_ISLAMIC: {
+            IslamicDate islamic;
+            GregorianDate gregorian;
+            memset(&islamic, 0, sizeof(islamic));
+            islamic.base.day = day;
+            islamic.base.month = month;
+            islamic.base.year = year;
+            return islamic_to_gregorian(&islamic, &gregorian) == CALENDAR_SUCCESS ? gregorian.julian_day : 0;
+        }
+        case CALENDAR_HEBREW: {
+            HebrewDate hebrew;
+            GregorianDate gregorian;
+            memset(&hebrew, 0, sizeof(hebrew));
+            hebrew.base.day = day;
+            hebrew.base.month = month;
+            hebrew.base.year = year;
+            return hebrew_to_gregorian(&hebrew, &gregorian) == CALENDAR_SUCCESS ? gregorian.julian_day : 0;
+        }
+        case CALENDAR_PERSIAN:
+            return persian_to_julian_day(day, month, year);
+#ifdef BUILD_ASTRONOMY
+        case CALENDAR_CHINESE: {
+            long start = 0;
+            holiday_chinese_month(month, year, &start);
+            return start > 0 ? start + day - 1 : 0;
+        }
+#endif
+        default:
+            return julian_day_from_date(day, month, year);
+    }
+}
+
+void holiday_calendar_year_span(int calendar, int start_year, int end_year, int* first_year, int* last_year) {
+    switch (calendar) {
+        case CALENDAR_ISLAMIC:
+            // 33 lunar years to 32 solar ones
+            *first_year = (start_year - 622) * 33 / 32 - 1;
+            *last_year = (end_year - 622) * 33 / 32 + 2;
+            break;
+        case CALENDAR_HEBREW:
+            *first_year = start_year + 3760;
+            *last_year = end_year + 3761;
+            break;
+        case CALENDAR_PERSIAN:
+            *first_year = start_year - 622;
+            *last_year = end_year - 621;
+            break;
+        case CALENDAR_CHINESE:
+            // Years are numbered by the Gregorian year they begin in
+            *first_year = start_year - 1;
+            *last_year = end_year;
+            break;
+        default:
+            *first_year = start_year;
+            *last_year = end_year;
+            break;
+    }
+}
+
+HolidayMonthTable* holiday_month_table_build(int calendar, int first_year, int last_year) {
+    if (!holiday_calendar_supported(calendar) || last_year < first_year) return NULL;
+    
+    HolidayMonthTable* table = calloc(1, sizeof(HolidayMonthTable));
+    if (!table) return NULL;
+    table->calendar = calendar;
+    table->first_year = first_year;
+    table->year_count = last_year - first_year + 1;
+    size_t slots = (size_t)table->year_count * HOLIDAY_MONTH_SLOTS;
+    table->starts = malloc(sizeof(int32_t) * slots);
+    table->lengths = malloc(sizeof(uint8_t) * slots);
+    if (!table->starts || !table->lengths) {
+        holiday_month_table_destroy(table);
+        return NULL;
+    }
+    
+    // One engine conversion per month instead of one per holiday and year
+#ifdef BUILD_ASTRONOMY
+    time_scale_init();          // Builds the Delta-T table before the threads start
+#endif
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for (int y = 0; y < table->year_count; y++) {
+#ifdef BUILD_ASTRONOMY
+        // A Chinese year is computed whole; a leap month has no slot, as
+        // holiday dates name the regular month
+        if (calendar == CALENDAR_CHINESE) {
+            ChineseMonth months[CHINESE_MAX_MONTHS];
+            int count = 0;
+            size_t base = (size_t)y * HOLIDAY_MONTH_SLOTS;
+            memset(&table->lengths[base], 0, HOLIDAY_MONTH_SLOTS);
+            memset(&table->starts[base], 0, sizeof(int32_t) * HOLIDAY_MONTH_SLOTS);
+            if (chinese_year_months(first_year + y, months, &count) != CALENDAR_SUCCESS) continue;
+            for (int i = 0; i < count; i++) {
+                if (months[i].is_leap) continue;
+                size_t slot = base + months[i].number - 1;
+                table->starts[slot] = (int32_t)months[i].start_jdn;
+                table->lengths[slot] = (uint8_t)months[i].length;
+            }
+            continue;
+        }
+#endif
+        for (int m = 1; m <= HOLIDAY_MONTH_SLOTS; m++) {
+            size_t slot = (size_t)y * HOLIDAY_MONTH_SLOTS + m - 1;
+            int length = holiday_calendar_month_length(calendar, m, first_year + y);
+            table->lengths[slot] = (uint8_t)(length > 0 ? length : 0);
+            table->starts[slot] = length > 0 ? (int32_t)holiday_calendar_date_jdn(calendar, 1, m, first_year + y) : 0;
+        }
+    }
+    return table;
+}
+
+void holiday_month_table_destroy(HolidayMonthTable* table) {
+    if (!table) return;
+    free(table->starts);
+    free(table->lengths);
+    free(table);
+}
+
+long holiday_month_table_jdn(const HolidayMonthTable* table, int day, int month, int year) {
+    if (!table || year < table->first_year || year >= table->first_year + table->year_count) return 0;
+    if (month < 1 || month > HOLIDAY_MONTH_SLOTS) return 0;
+    
+    size_t slot = (size_t)(year - table->first_year) * HOLIDAY_MONTH_SLOTS + month - 1;
+    if (day < 1 || day > table->lengths[slot]) return 0;
+    return table->starts[slot] + day - 1;
+}
+
+// Dates the rule gives for the calendar years overlapping a Gregorian year,
+// before the offset; a lunar year can begin twice in one Gregorian year
+static int holiday_rule_bases(const Holiday* holiday, int year, const HolidayMonthTable* table, long* bases) {
+    int count = 0;
+    const Date* date = &holiday->date;
+    
+    switch (holiday->holiday_type) {
+        case HOLIDAY_EASTER:
+            bases[count++] = holiday_easter_jdn(year, (int)holiday->calendar_type == CALENDAR_JULIAN);
+            return count;
+        
+        case HOLIDAY_WEEKDAY:
+            if (holiday->weekday >= 0 && holiday->weekday <= 6 && date->month >= 1 && date->month <= 12) {
+                long anchor = date->day > 0
+                    ? julian_day_from_date(date->day, date->month, year)
+                    : julian_day_from_date(1, date->month, year) + gregorian_days_in_month(date->month, year) - 1 +
+                      date->day - 6;
+                if (date->day <= gregorian_days_in_month(date->month, year)) {
+                    bases[count++] = holiday_weekday_on_or_after(anchor, holiday->weekday);
+                }
+                return count;
+            }
+            break;  // No weekday given: the stored date as is
+        
+        default:
+            break;
+    }
+    
+    int calendar = (int)holiday->calendar_type;
+    int first_year, last_year;
+    holiday_calendar_year_span(calendar, year, year, &first_year, &last_year);
+    if (table && table->calendar != calendar) table = NULL;
+    
+    for (int y = first_year; y <= last_year && count < HOLIDAY_RULE_MAX_BASES; y++) {
+        long jdn = 0;
+        if (table && y >= table->first_year && y < table->first_year + table->year_count) {
+            jdn = holiday_month_table_jdn(table, date->day, date->month, y);
+        } else {
+            jdn = holiday_calendar_date_jdn(calendar, date->day, date->month, y);
+        }
+        if (jdn > 0) bases[count++] = jdn;
+    }
+    return count;
+}
+
+CalendarResult holiday_rule_evaluate(const Holiday* holiday, int year, long* jdns, int capacity, int* count) {
+    return holiday_rule_evaluate_with(holiday, year, NULL, jdns, capacity, count);
+}
+
+CalendarResult holiday_rule_evaluate_with(const Holiday* holiday, int year, const HolidayMonthTable* table,
+                                          long* jdns, int capacity, int* count) {
+    if (!holiday || !count || (!jdns && capacity > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    *count = 0;
+    if (!holiday_calendar_supported(holiday->calendar_type)) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    // The offset can move a date across the year boundary, so the window of
+    // base dates is the year shifted back by it
+    long first = julian_day_from_date(1, 1, year) - holiday->offset_days;
+    long last = julian_day_from_date(31, 12, year) - holiday->offset_days;
+    int first_year, last_year, unused_day, unused_month;
+    julian_day_to_date(first, &unused_day, &unused_month, &first_year);
+    julian_day_to_date(last, &unused_day, &unused_month, &last_year);
+    
+    for (int y = first_year; y <= last_year; y++) {
+        long bases[HOLIDAY_RULE_MAX_BASES];
+        int base_count = holiday_rule_bases(holiday, y, table, bases);
+        
+        for (int b = 0; b < base_count; b++) {
+            if (bases[b] < first || bases[b] > last) continue;
+            
+            long jdn = bases[b] + holiday->offset_days;
+            int seen = 0;
+            for (int i = 0; i < *count; i++) seen |= jdns[i] == jdn;
+            if (!seen && *count < capacity) jdns[(*count)++] = jdn;
+        }
+    }
+    return CALENDAR_SUCCESS;
+}
+
+typedef struct {
+    uint32_t country;
+    int32_t jdn;
+    int32_t end_jdn;
+    uint32_t holiday;
+} HolidayCountrySortItem;
+
+#define HOLIDAY_TREE_SCAN_LEVEL 3      // Subtrees this low are scanned, not descended
+#define HOLIDAY_TREE_MAX_DEPTH 64
+
+// Interval tree over n date-sorted occurrences, laid out in place (as in
+// cgranges): leaves are the even positions, and the level-k nodes sit at
+// 2^k - 1 + j * 2^(k+1). A node past the end stands for the partial subtree
+// at the right edge, whose latest end is carried in `last`.
+static void holiday_interval_tree_build(const HolidayOccurrence* a, int32_t* max_end, size_t n) {
+    if (n == 0) return;
+    
+    size_t last_i = 0;
+    int32_t last = 0;
+    for (size_t i = 0; i < n; i += 2) {
+        last_i = i;
+        last = max_end[i] = a[i].end_jdn;
+    }
+    for (int k = 1; ((size_t)1 << k) <= n; k++) {
+        size_t x = (size_t)1 << (k - 1), step = x << 2;
+        for (size_t i = (x << 1) - 1; i < n; i += step) {
+            int32_t e = a[i].end_jdn;
+            int32_t left = max_end[i - x];
+            int32_t right = i + x < n ? max_end[i + x] : last;
+            if (left > e) e = left;
+            if (right > e) e = right;
+            max_end[i] = e;
+        }
+        last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+        if (last_i < n && max_end[last_i] > last) last = max_end[last_i];
+    }
+}
+
+typedef struct {
+    int level;
+    size_t node;
+    int left_done;
+} HolidayTreeFrame;
+
+// Occurrences overlapping [start, end] in date order; the first capacity are
+// copied to matches, and the return value counts them all
+static int holiday_interval_tree_query(const HolidayOccurrence* a, const int32_t* max_end, size_t n,
+                                       long start, long end, HolidayOccurrence* matches, int capacity) {
+    if (n == 0) return 0;
+    
+    int root = 0;
+    while (((size_t)1 << (root + 1)) <= n) root++;
+    
+    HolidayTreeFrame stack[HOLIDAY_TREE_MAX_DEPTH];
+    int top = 0, found = 0;
+    stack[top++] = (HolidayTreeFrame){ root, ((size_t)1 << root) - 1, 0 };
+    while (top > 0) {
+        HolidayTreeFrame z = stack[--top];
+        if (z.level <= HOLIDAY_TREE_SCAN_LEVEL) {
+            // Small subtree: scan it in order
+            size_t i0 = z.node >> z.level << z.level;
+            size_t i1 = i0 + ((size_t)1 << (z.level + 1)) - 1;
+            if (i1 > n) i1 = n;
+            for (size_t i = i0; i < i1 && a[i].jdn <= end; i++) {
+                if (a[i].end_jdn < start) continue;
+                if (found < capacity) matches[found] = a[i];
+                found++;
+            }
+        } else if (!z.left_done) {
+            // Revisit the node after its left subtree, which is skipped when
+            // everything in it ends before the query starts
+            size_t left = z.node - ((size_t)1 << (z.level - 1));
+            stack[top++] = (HolidayTreeFrame){ z.level, z.node, 1 };
+            if (left >= n || max_end[left] >= start) stack[top++] = (HolidayTreeFrame){ z.level - 1, left, 0 };
+        } else if (z.node < n && a[z.node].jdn <= end) {
+            // Right subtrees start no earlier than the node
+            if (a[z.node].end_jdn >= start) {
+                if (found < capacity) matches[found] = a[z.node];
+                found++;
+            }
+            stack[top++] = (HolidayTreeFrame){ z.level - 1, z.node + ((size_t)1 << (z.level - 1)), 0 };
+        }
+    }
+    return found;
+}
+
+static int holiday_compare_date_items(const void* a, const void* b) {
+    const HolidayCountrySortItem* ia = a;
+    const HolidayCountrySortItem* ib = b;
+    if (ia->jdn != ib->jdn) return ia->jdn < ib->jdn ? -1 : 1;
+    return ia->holiday < ib->holiday ? -1 : (ia->holiday > ib->holiday);
+}
+
+static int holiday_compare_country_items(const void* a, const void* b) {
+    const HolidayCountrySortItem* ia = a;
+    const HolidayCountrySortItem* ib = b;
+    if (ia->country != ib->country) return ia->country < ib->country ? -1 : 1;
+    if (ia->jdn != ib->jdn) return ia->jdn < ib->jdn ? -1 : 1;
+    return ia->holiday < ib->holiday ? -1 : (ia->holiday > ib->holiday);
+}
+
+HolidayYear* holiday_year_build(const HolidayDatabase* db, int year) {
+    if (!db) return NULL;
+    
+    size_t capacity = (size_t)db->count * HOLIDAY_RULE_MAX_OCCURRENCES;
+    HolidayYear* result = calloc(1, sizeof(HolidayYear));
+    HolidayCountrySortItem* items = malloc(sizeof(HolidayCountrySortItem) * (capacity > 0 ? capacity : 1));
+    if (!result || !items) {
+        free(result);
+        free(items);
+        return NULL;
+    }
+    result->year = year;
+    
+    uint32_t count = 0;
+    for (int i = 0; i < db->count; i++) {
+        const Holiday* holiday = &db->holidays[i];
+        const HolidayMonthTable* table = (unsigned)holiday->calendar_type < HOLIDAY_INDEX_CALENDARS
+            ? db->month_tables[holiday->calendar_type] : NULL;
+        long jdns[HOLIDAY_RULE_MAX_OCCURRENCES];
+        int found = 0;
+        holiday_rule_evaluate_with(holiday, year, table, jdns, HOLIDAY_RULE_MAX_OCCURRENCES, &found);
+        int duration = holiday->duration_days > 1 ? holiday->duration_days : 1;
+        for (int j = 0; j < found; j++) {
+            items[count].country = holiday_index_country_key(holiday->country_code);
+            items[count].jdn = (int32_t)jdns[j];
+            items[count].end_jdn = (int32_t)(jdns[j] + duration - 1);
+            items[count].holiday = (uint32_t)i;
+            count++;
+        }
+    }
+    
+    size_t bytes = sizeof(HolidayOccurrence) * (count > 0 ? count : 1);
+    result->count = count;
+    result->occurrences = malloc(bytes);
+    result->by_country = malloc(bytes);
+    result->countries = malloc(sizeof(HolidayCountryRun) * (count > 0 ? count : 1));
+    result->max_end = malloc(sizeof(int32_t) * (count > 0 ? count : 1));
+    result->country_max_end = malloc(sizeof(int32_t) * (count > 0 ? count : 1));
+    result->date_position = malloc(sizeof(uint32_t) * (count > 0 ? count : 1));
+    if (!result->occurrences || !result->by_country || !result->countries || !result->max_end ||
+        !result->country_max_end || !result->date_position) {
+        free(items);
+        holiday_year_destroy(result);
+        return NULL;
+    }
+    
+    // Country order first, with the runs, then date order
+    qsort(items, count, sizeof(HolidayCountrySortItem), holiday_compare_country_items);
+    for (uint32_t i = 0; i < count; i++) {
+        result->by_country[i].jdn = items[i].jdn;
+        result->by_country[i].end_jdn = items[i].end_jdn;
+        result->by_country[i].observed_jdn = items[i].jdn;
+        result->by_country[i].holiday = items[i].holiday;
+        if (i == 0 || items[i].country != items[i - 1].country) {
+            HolidayCountryRun* run = &result->countries[result->country_count++];
+            run->country = items[i].country;
+            run->start = i;
+            run->count = 0;
+        }
+        result->countries[result->country_count - 1].count++;
+    }
+    
+    // Date order, remembering where each country-order entry went; items
+    // are reused with the country field holding the country-order position
+    for (uint32_t i = 0; i < count; i++) {
+        items[i].country = i;
+    }
+    qsort(items, count, sizeof(HolidayCountrySortItem), holiday_compare_date_items);
+    for (uint32_t i = 0; i < count; i++) {
+        result->occurrences[i] = result->by_country[items[i].country];
+        result->date_position[items[i].country] = i;
+    }
+    holiday_year_observe(result, db);
+    
+    holiday_interval_tree_build(result->occurrences, result->max_end, count);
+    for (uint32_t c = 0; c < result->country_count; c++) {
+        const HolidayCountryRun* run = &result->countries[c];
+        holiday_interval_tree_build(result->by_country + run->start, result->country_max_end + run->start, run->count);
+    }
+    
+    free(items);
+    return result;
+}
+
+static const HolidayObservanceRule* holiday_observance_rule(const HolidayDatabase* db, uint32_t country) {
+    for (int i = 0; i < db->observance_rule_count; i++) {
+        if (holiday_index_country_key(db->observance_rules[i].country_code) == country) {
+            return &db->observance_rules[i];
+        }
+    }
+    return NULL;
+}
+
+// Days a rule moves a holiday falling on each weekday
+static void holiday_observe_deltas(const HolidayObservanceRule* rule, int deltas[7]) {
+    int weekend = rule->weekend_mask & 0x7F;
+    for (int weekday = 0; weekday < 7; weekday++) {
+        deltas[weekday] = 0;
+        if (rule->shift == HOLIDAY_OBSERVE_ACTUAL || !(weekend >> weekday & 1) || weekend == 0x7F) continue;
+        
+        int forward = 1, back = 1;
+        while (weekend >> ((weekday + forward) % 7) & 1) forward++;
+        while (weekend >> ((weekday + 7 - back) % 7) & 1) back++;
+        deltas[weekday] = rule->shift == HOLIDAY_OBSERVE_NEAREST && back < forward ? -back : forward;
+    }
+}
+
+// Moved holidays landing on a day another public holiday takes move on to
+// the next free weekday, in date order, so that each gets its own day off
+static void holiday_observe_cascade(HolidayOccurrence* run, uint32_t count, const HolidayDatabase* db,
+                                    int weekend_mask, long window_start) {
+    uint64_t taken[HOLIDAY_OBSERVE_WINDOW_WORDS] = { 0 };
+    long window_end = window_start + HOLIDAY_OBSERVE_WINDOW_WORDS * 64;
+    for (uint32_t i = 0; i < count; i++) {
+        if (run[i].observed_jdn != run[i].jdn || !db->holidays[run[i].holiday].is_public_holiday) continue;
+        for (long jdn = run[i].jdn > window_start ? run[i].jdn : window_start;
+             jdn <= run[i].end_jdn && jdn < window_end; jdn++) {
+            taken[(jdn - window_start) >> 6] |= (uint64_t)1 << ((jdn - window_start) & 63);
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        long jdn = run[i].observed_jdn;
+        if (jdn == run[i].jdn || jdn < window_start) continue;
+        while (jdn < window_end && ((taken[(jdn - window_start) >> 6] >> ((jdn - window_start) & 63) & 1) ||
+                                    (weekend_mask >> holiday_jdn_weekday(jdn) & 1))) {
+            jdn++;
+        }
+        if (jdn >= window_end) continue;
+        taken[(jdn - window_start) >> 6] |= (uint64_t)1 << ((jdn - window_start) & 63);
+        run[i].observed_jdn = (int32_t)jdn;
+    }
+}
+
+void holiday_year_observe(HolidayYear* year, const HolidayDatabase* db) {
+    if (!year || !db) return;
+    
+    for (uint32_t c = 0; c < year->country_count; c++) {
+        HolidayOccurrence* run = year->by_country + year->countries[c].start;
+        uint32_t count = year->countries[c].count;
+        const HolidayObservanceRule* rule = holiday_observance_rule(db, year->countries[c].country);
+        int deltas[7] = { 0 };
+        if (rule) holiday_observe_deltas(rule, deltas);
+        
+        // Public single-day holidays move by their weekday's delta
+        const Holiday* holidays = db->holidays;
+        #pragma omp simd
+        for (uint32_t i = 0; i < count; i++) {
+            int movable = holidays[run[i].holiday].is_public_holiday && run[i].end_jdn == run[i].jdn;
+            run[i].observed_jdn = run[i].jdn + (movable ? deltas[(run[i].jdn + 1) % 7] : 0);
+        }
+        if (rule && rule->cascade && rule->shift != HOLIDAY_OBSERVE_ACTUAL) {
+            holiday_observe_cascade(run, count, db, rule->weekend_mask, julian_day_from_date(1, 12, year->year - 1));
+        }
+    }
+    
+    // Date order holds the same occurrences
+    for (uint32_t i = 0; i < year->count; i++) {
+        year->occurrences[year->date_position[i]].observed_jdn = year->by_country[i].observed_jdn;
+    }
+}
+
+void holiday_year_destroy(HolidayYear* year) {
+    if (!year) return;
+    free(year->occurrences);
+    free(year->by_country);
+    free(year->countries);
+    free(year->max_end);
+    free(year->country_max_end);
+    free(year->date_position);
+    free(year);
+}
+
+// First position in a date-sorted run whose date is >= jdn
+static uint32_t holiday_lower_bound(const HolidayOccurrence* occurrences, uint32_t count, long jdn) {
+    uint32_t lo = 0, hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (occurrences[mid].jdn < jdn) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+// A country's run of by_country[]; NULL when it has no occurrences
+static const HolidayCountryRun* holiday_year_country(const HolidayYear* year, const char* country_code) {
+    uint32_t key = holiday_index_country_key(country_code);
+    uint32_t lo = 0, hi = year->country_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (year->countries[mid].country < key) lo = mid + 1; else hi = mid;
+    }
+    if (key == 0 || lo == year->country_count || year->countries[lo].country != key) return NULL;
+    return &year->countries[lo];
+}
+
+CalendarResult holiday_year_find(const HolidayYear* year, long start_jdn, long end_jdn, const char* country_code,
+                                 const HolidayOccurrence** first, int* count) {
+    if (!year || !first || !count) return CALENDAR_ERROR_NULL_POINTER;
+    
+    const HolidayOccurrence* run = year->occurrences;
+    uint32_t run_count = year->count;
+    *first = run;
+    *count = 0;
+    
+    if (country_code && country_code[0] != '\0') {
+        const HolidayCountryRun* country = holiday_year_country(year, country_code);
+        if (!country) return CALENDAR_SUCCESS;
+        run = year->by_country + country->start;
+        run_count = country->count;
+    }
+    
+    uint32_t begin = holiday_lower_bound(run, run_count, start_jdn);
+    uint32_t end = holiday_lower_bound(run, run_count, end_jdn + 1);
+    *first = run + begin;
+    *count = (int)(end - begin);
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult holiday_year_find_overlapping(const HolidayYear* year, long start_jdn, long end_jdn,
+                                             const char* country_code, HolidayOccurrence* matches, int capacity,
+                                             int* count) {
+    if (!year || !count || (!matches && capacity > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    
+    *count = 0;
+    if (end_jdn < start_jdn) return CALENDAR_SUCCESS;
+    if (country_code && country_code[0] != '\0') {
+        const HolidayCountryRun* country = holiday_year_country(year, country_code);
+        if (country) {
+            *count = holiday_interval_tree_query(year->by_country + country->start,
+                                                 year->country_max_end + country->start, country->count,
+                                                 start_jdn, end_jdn, matches, capacity);
+        }
+        return CALENDAR_SUCCESS;
+    }
+    *count = holiday_interval_tree_query(year->occurrences, year->max_end, year->count, start_jdn, end_jdn,
+                                         matches, capacity);
+    return CALENDAR_SUCCESS;
+}
@@ -0,0 +1,106 @@
+// src/holidays/holiday_rules.h
+#ifndef HOLIDAY_RULES_H
+#define HOLIDAY_RULES_H
+
+#include "holiday_db.h"
+
+#define HOLIDAY_RULE_MAX_OCCURRENCES 2  // A lunar-year date can fall twice in one Gregorian year
+
+// One day a holiday falls on, the last day of its period, and the day it is
+// observed on under its country's rule
+typedef struct HolidayOccurrence {
+    int32_t jdn;
+    int32_t end_jdn;            // jdn + duration_days - 1
+    int32_t observed_jdn;       // jdn unless the holiday is moved off a weekend
+    uint32_t holiday;           // Index into the database
+} HolidayOccurrence;
+
+// Run of one country's occurrences in by_country[]
+typedef struct {
+    uint32_t country;           // holiday_index_country_key()
+    uint32_t start;
+    uint32_t count;
+} HolidayCountryRun;
+
+// Every rule of a database expanded over one Gregorian year. Periods are
+// indexed by implicit interval trees over the date-sorted arrays: node i
+// (at level k when its lowest k bits are set and bit k is clear) stores the
+// latest end_jdn in its subtree, so overlap queries skip every subtree that
+// ends too early.
+struct HolidayYear {
+    int year;
+    uint32_t count;
+    HolidayOccurrence* occurrences;     // By date, then holiday
+    HolidayOccurrence* by_country;      // By country, then date, then holiday
+    HolidayCountryRun* countries;       // By country key
+    uint32_t country_count;
+    int32_t* max_end;                   // Tree over occurrences[]
+    int32_t* country_max_end;           // One tree per country run of by_country[]
+    uint32_t* date_position;            // by_country[i] is occurrences[date_position[i]]
+};
+typedef struct HolidayYear HolidayYear;
+
+#define HOLIDAY_MONTH_SLOTS 13          // Months per calendar year, Hebrew Adar II last
+
+// Day-1 JDN and length of every month of one calendar over a span of its years
+struct HolidayMonthTable {
+    int calendar;
+    int first_year;
+    int year_count;
+    int32_t* starts;            // [(year - first_year) * HOLIDAY_MONTH_SLOTS + month - 1]
+    uint8_t* lengths;           // Likewise; 0 for months the year does not have
+};
+typedef struct HolidayMonthTable HolidayMonthTable;
+
+// Rule helpers (Gregorian JDNs)
+long holiday_easter_jdn(int year, int orthodox);
+long holiday_weekday_on_or_after(long jdn, int weekday);
+long holiday_nth_weekday_jdn(int year, int month, int weekday, int nth);    // nth < 0 counts from the end
+
+// Days on which a holiday falls in a Gregorian year:
+//   HOLIDAY_FIXED, HOLIDAY_LUNAR, HOLIDAY_SOLAR: month and day in the holiday's
+//     own calendar (Gregorian, Islamic, Hebrew or Persian)
+//   HOLIDAY_WEEKDAY: the first `weekday` on or after the day of the month, or,
+//     for day <= 0, the last one on or before the month's last day + day
+//   HOLIDAY_EASTER: Easter Sunday (Julian computus for CALENDAR_JULIAN)
+// offset_days is then added to each.
+CalendarResult holiday_rule_evaluate(const Holiday* holiday, int year, long* jdns, int capacity, int* count);
+
+// The same, reading calendar dates from a month table of the holiday's
+// calendar where it covers them (NULL: the calendar engine throughout)
+CalendarResult holiday_rule_evaluate_with(const Holiday* holiday, int year, const HolidayMonthTable* table,
+                                          long* jdns, int capacity, int* count);
+
+// Calendar years (in the calendar's own numbering) whose dates can fall in
+// Gregorian years [start_year, end_year]
+void holiday_calendar_year_span(int calendar, int start_year, int end_year, int* first_year, int* last_year);
+
+// Month table of a calendar for its years [first_year, last_year], built from
+// the calendar engine; NULL for calendars without a conversion
+HolidayMonthTable* holiday_month_table_build(int calendar, int first_year, int last_year);
+void holiday_month_table_destroy(HolidayMonthTable* table);
+long holiday_month_table_jdn(const HolidayMonthTable* table, int day, int month, int year);    // 0 if not covered or invalid
+
+// Expansion of every rule in a database over one year, using the database's
+// month tables where present; destroy with holiday_year_destroy()
+HolidayYear* holiday_year_build(const HolidayDatabase* db, int year);
+void holiday_year_destroy(HolidayYear* year);
+
+// Observed days of a built year under the database's rules: a table-driven
+// shift over each country's run, then a pass in date order for rules that
+// cascade, copied to the date order through date_position. Occurrences keep
+// their order, so the interval trees stay valid.
+void holiday_year_observe(HolidayYear* year, const HolidayDatabase* db);
+
+// Contiguous run of a year's occurrences in [start_jdn, end_jdn], for one
+// country or (NULL or "") all of them
+CalendarResult holiday_year_find(const HolidayYear* year, long start_jdn, long end_jdn, const char* country_code,
+                                 const HolidayOccurrence** first, int* count);
+
+// A year's occurrences whose periods overlap [start_jdn, end_jdn], in date
+// order: up to capacity of them, and the total in *count. O(log n + matches).
+CalendarResult holiday_year_find_overlapping(const HolidayYear* year, long start_jdn, long end_jdn,
+                                             const char* country_code, HolidayOccurrence* matches, int capacity,
+                                             int* count);
+
+#endif // HOLIDAY_RULES_H
@@ -0,0 +1,406 @@
+// src/holidays/holiday_snapshot.c
+#include "holiday_snapshot.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    uint32_t country;
+    uint32_t record;
+} HolidaySnapshotCountryItem;
+
+static int holiday_snapshot_compare_countries(const void* a, const void* b) {
+    const HolidaySnapshotCountryItem* ia = a;
+    const HolidaySnapshotCountryItem* ib = b;
+    if (ia->country != ib->country) return ia->country < ib->country ? -1 : 1;
+    return ia->record < ib->record ? -1 : (ia->record > ib->record);
+}
+
+static uint64_t holiday_snapshot_align(uint64_t offset) {
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+// Section at its aligned offset, zero-padding the gap before it
+static int holiday_snapshot_write_section(FILE* file, uint64_t* position, uint64_t offset,
+                                          const void* data, size_t bytes) {
+    static const char padding[8] = {0};
+    if (offset - *position > 0 && fwrite(padding, 1, (size_t)(offset - *position), file) != offset - *position) return 0;
+    if (bytes > 0 && fwrite(data, 1, bytes, file) != bytes) return 0;
+    *position = offset + bytes;
+    return 1;
+}
+
+CalendarResult holiday_snapshot_write(const char* filename, const Holiday* holidays, size_t count) {
+    if (!filename || (!holidays && count > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    if (count >= UINT32_MAX) return CALENDAR_ERROR_CONVERSION_FAILED;
+    
+    // The string section is the pool's flat image
+    StringPool* pool = string_pool_create();
+    char* string_image = NULL;
+    size_t allocated = count > 0 ? count : 1;
+    HolidaySnapshotRecord* records = malloc(sizeof(HolidaySnapshotRecord) * allocated);
+    int32_t* slots = malloc(sizeof(int32_t) * allocated);
+    HolidaySnapshotCountryItem* items = malloc(sizeof(HolidaySnapshotCountryItem) * allocated);
+    uint32_t* country_order = malloc(sizeof(uint32_t) * allocated);
+    HolidayCountryRun* countries = malloc(sizeof(HolidayCountryRun) * allocated);
+    
+    CalendarResult result = pool && records && slots && items && country_order && countries
+        ? CALENDAR_SUCCESS : CALENDAR_ERROR_MEMORY_ALLOCATION;
+    for (size_t i = 0; i < count && result == CALENDAR_SUCCESS; i++) {
+        const Holiday* holiday = &holidays[i];
+        HolidaySnapshotRecord* record = &records[i];
+        
+        memset(record, 0, sizeof(*record));
+        record->name_offset = string_pool_offset(pool, string_pool_intern(pool, holiday->name));
+        record->description_offset = string_pool_offset(pool, string_pool_intern(pool, holiday->description));
+        record->calendar_type = (int32_t)holiday->calendar_type;
+        record->holiday_type = holiday->holiday_type;
+        record->month = holiday->date.month;
+        record->day = holiday->date.day;
+        record->weekday = holiday->weekday;
+        record->offset_days = holiday->offset_days;
+        record->duration_days = holiday->duration_days;
+        record->is_bank_holiday = (uint32_t)holiday->is_bank_holiday;
+        record->is_school_holiday = (uint32_t)holiday->is_school_holiday;
+        memcpy(record->country_code, holiday->country_code, sizeof(record->country_code));
+        record->country_code[sizeof(record->country_code) - 1] = '\0';
+        record->is_public_holiday = (uint32_t)holiday->is_public_holiday;
+        if (record->name_offset == UINT32_MAX || record->description_offset == UINT32_MAX) {
+            result = CALENDAR_ERROR_CONVERSION_FAILED;
+        }
+        
+        slots[i] = holiday_index_slot(record->calendar_type, record->month, record->day);
+        items[i].country = holiday_index_country_key(record->country_code);
+        items[i].record = (uint32_t)i;
+    }
+    
+    if (result == CALENDAR_SUCCESS) {
+        string_image = malloc(pool->bytes > 0 ? pool->bytes : 1);
+        if (string_image) string_pool_flatten(pool, string_image);
+        else result = CALENDAR_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    // Date index, as the database builds it in memory
+    HolidayIndex* index = result == CALENDAR_SUCCESS
+        ? holiday_index_build(slots, records[0].country_code, sizeof(HolidaySnapshotRecord), (uint32_t)count) : NULL;
+    if (result == CALENDAR_SUCCESS && !index) result = CALENDAR_ERROR_MEMORY_ALLOCATION;
+    
+    // Country index: records by country, and each country's run
+    size_t country_count = 0;
+    if (result == CALENDAR_SUCCESS) {
+        qsort(items, count, sizeof(HolidaySnapshotCountryItem), holiday_snapshot_compare_countries);
+        for (size_t i = 0; i < count; i++) {
+            country_order[i] = items[i].record;
+            if (i == 0 || items[i].country != items[i - 1].country) {
+                countries[country_count].country = items[i].country;
+                countries[country_count].start = (uint32_t)i;
+                countries[country_count].count = 0;
+                country_count++;
+            }
+            countries[country_count - 1].count++;
+        }
+    }
+    
+    HolidaySnapshotFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HOLIDAY_SNAPSHOT_MAGIC, sizeof(HOLIDAY_SNAPSHOT_MAGIC));
+    header.version = HOLIDAY_SNAPSHOT_FORMAT_VERSION;
+    header.record_size = sizeof(HolidaySnapshotRecord);
+    header.record_count = count;
+    if (index) {
+        header.record_offset = holiday_snapshot_align(sizeof(header));
+        header.bucket_offset = holiday_snapshot_align(header.record_offset + count * sizeof(HolidaySnapshotRecord));
+        header.bucket_count = (uint64_t)index->bucket_mask + 1;
+        header.order_offset = holiday_snapshot_align(header.bucket_offset +
+                                                     header.bucket_count * sizeof(HolidayIndexBucket));
+        header.indexed_count = index->count;
+        header.slot_offset = holiday_snapshot_align(header.order_offset + header.indexed_count * sizeof(uint32_t));
+        header.country_offset = holiday_snapshot_align(header.slot_offset +
+                                                       (HOLIDAY_INDEX_SLOTS + 1) * sizeof(uint32_t));
+        header.country_count = country_count;
+        header.country_order_offset = holiday_snapshot_align(header.country_offset +
+                                                             country_count * sizeof(HolidayCountryRun));
+        header.string_offset = holiday_snapshot_align(header.country_order_offset + count * sizeof(uint32_t));
+        header.string_bytes = pool->bytes;
+    }
+    
+    FILE* file = result == CALENDAR_SUCCESS ? fopen(filename, "wb") : NULL;
+    if (result == CALENDAR_SUCCESS && !file) result = CALENDAR_ERROR_CONVERSION_FAILED;
+    if (file) {
+        uint64_t position = 0;
+        int written = holiday_snapshot_write_section(file, &position, 0, &header, sizeof(header)) &&
+            holiday_snapshot_write_section(file, &position, header.record_offset, records,
+                                           count * sizeof(HolidaySnapshotRecord)) &&
+            holiday_snapshot_write_section(file, &position, header.bucket_offset, index->buckets,
+                                           header.bucket_count * sizeof(HolidayIndexBucket)) &&
+            holiday_snapshot_write_section(file, &position, header.order_offset, index->order,
+                                           header.indexed_count * sizeof(uint32_t)) &&
+            holiday_snapshot_write_section(file, &position, header.slot_offset, index->slot_start,
+                                           (HOLIDAY_INDEX_SLOTS + 1) * sizeof(uint32_t)) &&
+            holiday_snapshot_write_section(file, &position, header.country_offset, countries,
+                                           country_count * sizeof(HolidayCountryRun)) &&
+            holiday_snapshot_write_section(file, &position, header.country_order_offset, country_order,
+                                           count * sizeof(uint32_t)) &&
+            holiday_snapshot_write_section(file, &position, header.string_offset, string_image, pool->bytes);
+        if (!written) result = CALENDAR_ERROR_CONVERSION_FAILED;
+        if (fclose(file) != 0) result = CALENDAR_ERROR_CONVERSION_FAILED;
+    }
+    
+    holiday_index_destroy(index);
+    free(records);
+    free(slots);
+    free(items);
+    free(country_order);
+    free(countries);
+    free(string_image);
+    string_pool_destroy(pool);
+    return result;
+}
+
+// Appends a source's holidays to the database that collects them
+CalendarResult holiday_snapshot_load_source(HolidayDatabase* db, const char* source) {
+    if (!db || !source) return CALENDAR_ERROR_NULL_POINTER;
+    
+    HolidaySnapshot* snapshot = holiday_snapshot_open(source);
+    if (!snapshot) {
+        // A file with the magic is a damaged snapshot, not CSV
+        FILE* file = fopen(source, "rb");
+        if (!file) return CALENDAR_ERROR_CONVERSION_FAILED;
+        char magic[sizeof(HOLIDAY_SNAPSHOT_MAGIC)];
+        int is_snapshot = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                          memcmp(magic, HOLIDAY_SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+        fclose(file);
+        if (is_snapshot) return CALENDAR_ERROR_CONVERSION_FAILED;
+        
+        // Every row must load: a truncated or half-written file fails whole
+        HolidayLoadReport report;
+        CalendarResult result = holiday_db_load_csv(db, source, &report);
+        if (result == CALENDAR_SUCCESS && (report.malformed > 0 || report.loaded == 0)) {
+            result = CALENDAR_ERROR_CONVERSION_FAILED;
+        }
+        return result;
+    }
+    
+    CalendarResult result = CALENDAR_SUCCESS;
+    for (size_t i = 0; i < snapshot->count && result == CALENDAR_SUCCESS; i++) {
+        Holiday holiday;
+        result = holiday_snapshot_get(snapshot, i, &holiday);
+        if (result == CALENDAR_SUCCESS) result = holiday_db_add_holiday(db, &holiday);
+    }
+    holiday_snapshot_close(snapshot);
+    return result;
+}
+
+CalendarResult holiday_snapshot_compile(const char* filename, const char* const* sources, int source_count) {
+    if (!filename || (!sources && source_count > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    
+    HolidayDatabase* db = holiday_db_create();
+    if (!db) return CALENDAR_ERROR_MEMORY_ALLOCATION;
+    
+    CalendarResult result = CALENDAR_SUCCESS;
+    for (int i = 0; i < source_count && result == CALENDAR_SUCCESS; i++) {
+        result = sources[i] ? holiday_snapshot_load_source(db, sources[i]) : CALENDAR_ERROR_NULL_POINTER;
+    }
+    if (result == CALENDAR_SUCCESS) result = holiday_snapshot_write(filename, db->holidays, (size_t)db->count);
+    
+    holiday_db_destroy(db);
+    return result;
+}
+
+// Whether a section of count items lies inside the file
+static int holiday_snapshot_section_valid(uint64_t offset, uint64_t count, uint64_t item_size, uint64_t size) {
+    return offset % 8 == 0 && offset <= size && count <= (size - offset) / item_size;
+}
+
+HolidaySnapshot* holiday_snapshot_open(const char* filename) {
+    if (!filename) return NULL;
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(HolidaySnapshotFileHeader)) {
+        close(fd);
+        return NULL;
+    }
+    
+    void* mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+    
+    const HolidaySnapshotFileHeader* header = (const HolidaySnapshotFileHeader*)mapping;
+    const char* base = (const char*)mapping;
+    uint64_t size = (uint64_t)st.st_size;
+    int valid = memcmp(header->magic, HOLIDAY_SNAPSHOT_MAGIC, sizeof(HOLIDAY_SNAPSHOT_MAGIC)) == 0 &&
+                header->version == HOLIDAY_SNAPSHOT_FORMAT_VERSION &&
+                header->record_size == sizeof(HolidaySnapshotRecord) &&
+                header->record_count < UINT32_MAX && header->indexed_count <= header->record_count &&
+                header->bucket_count > 0 && (header->bucket_count & (header->bucket_count - 1)) == 0 &&
+                header->bucket_count <= UINT32_MAX && header->country_count <= header->record_count &&
+                holiday_snapshot_section_valid(header->record_offset, header->record_count,
+                                               sizeof(HolidaySnapshotRecord), size) &&
+                holiday_snapshot_section_valid(header->bucket_offset, header->bucket_count,
+                                               sizeof(HolidayIndexBucket), size) &&
+                holiday_snapshot_section_valid(header->order_offset, header->indexed_count, sizeof(uint32_t), size) &&
+                holiday_snapshot_section_valid(header->slot_offset, HOLIDAY_INDEX_SLOTS + 1, sizeof(uint32_t), size) &&
+                holiday_snapshot_section_valid(header->country_offset, header->country_count,
+                                               sizeof(HolidayCountryRun), size) &&
+                holiday_snapshot_section_valid(header->country_order_offset, header->record_count,
+                                               sizeof(uint32_t), size) &&
+                holiday_snapshot_section_valid(header->string_offset, header->string_bytes, 1, size);
+    
+    const HolidaySnapshotRecord* records = valid ? (const HolidaySnapshotRecord*)(base + header->record_offset) : NULL;
+    const char* strings = valid ? base + header->string_offset : NULL;
+    const uint32_t* order = valid ? (const uint32_t*)(base + header->order_offset) : NULL;
+    const uint32_t* slot_start = valid ? (const uint32_t*)(base + header->slot_offset) : NULL;
+    const HolidayIndexBucket* buckets = valid ? (const HolidayIndexBucket*)(base + header->bucket_offset) : NULL;
+    const HolidayCountryRun* countries = valid ? (const HolidayCountryRun*)(base + header->country_offset) : NULL;
+    const uint32_t* country_order = valid ? (const uint32_t*)(base + header->country_order_offset) : NULL;
+    
+    // Only the header is checked here, so opening touches no more than a
+    // page or two; references are checked where they are followed, and
+    // holiday_snapshot_verify() checks every one
+    if (valid && header->string_bytes > 0) {
+        valid = strings[header->string_bytes - 1] == '\0';
+    }
+    valid = valid && (header->record_count == 0 || header->string_bytes > 0);
+    
+    HolidaySnapshot* snapshot = valid ? calloc(1, sizeof(HolidaySnapshot)) : NULL;
+    if (!snapshot) {
+        munmap(mapping, (size_t)st.st_size);
+        return NULL;
+    }
+    
+    // The index reads the mapping in place; it is never written through
+    snapshot->header = header;
+    snapshot->records = records;
+    snapshot->strings = strings;
+    snapshot->count = (size_t)header->record_count;
+    snapshot->index.order = (uint32_t*)order;
+    snapshot->index.slot_start = (uint32_t*)slot_start;
+    snapshot->index.buckets = (HolidayIndexBucket*)buckets;
+    snapshot->index.bucket_mask = (uint32_t)(header->bucket_count - 1);
+    snapshot->index.count = (uint32_t)header->indexed_count;
+    snapshot->countries = countries;
+    snapshot->country_order = country_order;
+    snapshot->country_count = (size_t)header->country_count;
+    snapshot->mapping = mapping;
+    snapshot->mapping_size = (size_t)st.st_size;
+    return snapshot;
+}
+
+CalendarResult holiday_snapshot_verify(const HolidaySnapshot* snapshot) {
+    if (!snapshot) return CALENDAR_ERROR_NULL_POINTER;
+    
+    const HolidaySnapshotFileHeader* header = snapshot->header;
+    const HolidayIndex* index = &snapshot->index;
+    int valid = 1;
+    for (uint64_t i = 0; valid && i < header->record_count; i++) {
+        valid = snapshot->records[i].name_offset < header->string_bytes &&
+                snapshot->records[i].description_offset < header->string_bytes &&
+                snapshot->records[i].country_code[3] == '\0' && snapshot->country_order[i] < header->record_count;
+    }
+    for (uint64_t i = 0; valid && i < header->indexed_count; i++) {
+        valid = index->order[i] < header->record_count;
+    }
+    valid = valid && index->slot_start[0] == 0 && index->slot_start[HOLIDAY_INDEX_SLOTS] == header->indexed_count;
+    for (int s = 0; valid && s < HOLIDAY_INDEX_SLOTS; s++) {
+        valid = index->slot_start[s] <= index->slot_start[s + 1];
+    }
+    uint64_t empty_buckets = 0;
+    for (uint64_t b = 0; valid && b < header->bucket_count; b++) {
+        valid = index->buckets[b].start <= header->indexed_count &&
+                index->buckets[b].count <= header->indexed_count - index->buckets[b].start;
+        empty_buckets += index->buckets[b].key == 0;
+    }
+    valid = valid && empty_buckets > 0;     // Probes for absent keys end at an empty bucket
+    for (size_t c = 0; valid && c < snapshot->country_count; c++) {
+        valid = snapshot->countries[c].start <= header->record_count &&
+                snapshot->countries[c].count <= header->record_count - snapshot->countries[c].start;
+    }
+    return valid ? CALENDAR_SUCCESS : CALENDAR_ERROR_CONVERSION_FAILED;
+}
+
+void holiday_snapshot_close(HolidaySnapshot* snapshot) {
+    if (snapshot) {
+        munmap(snapshot->mapping, snapshot->mapping_size);
+        free(snapshot);
+    }
+}
+
+CalendarResult holiday_snapshot_find(const HolidaySnapshot* snapshot, const Date* date, CalendarType calendar_type,
+                                     const char* country_code, uint32_t* matches, int capacity, int* count) {
+    if (!snapshot || !date || !count || (!matches && capacity > 0)) return CALENDAR_ERROR_NULL_POINTER;
+    *count = 0;
+    
+    int slot = holiday_index_slot(calendar_type, date->month, date->day);
+    if (slot == HOLIDAY_INDEX_NO_SLOT) return CALENDAR_SUCCESS;
+    
+    uint32_t first, found;
+    holiday_index_lookup(&snapshot->index, slot, country_code, &first, &found);
+    if (first > snapshot->index.count || found > snapshot->index.count - first) return CALENDAR_ERROR_CONVERSION_FAILED;
+    for (uint32_t i = 0; i < found && (int)i < capacity; i++) {
+        matches[i] = snapshot->index.order[first + i];
+        if (matches[i] >= snapshot->count) return CALENDAR_ERROR_CONVERSION_FAILED;
+    }
+    *count = (int)found;
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult holiday_snapshot_country(const HolidaySnapshot* snapshot, const char* country_code,
+                                        size_t* first, size_t* count) {
+    if (!snapshot || !country_code || !first || !count) return CALENDAR_ERROR_NULL_POINTER;
+    *first = 0;
+    *count = 0;
+    
+    uint32_t key = holiday_index_country_key(country_code);
+    size_t low = 0, high = snapshot->country_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (snapshot->countries[mid].country < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (key != 0 && low < snapshot->country_count && snapshot->countries[low].country == key) {
+        const HolidayCountryRun* run = &snapshot->countries[low];
+        if (run->start > snapshot->count || run->count > snapshot->count - run->start) {
+            return CALENDAR_ERROR_CONVERSION_FAILED;
+        }
+        *first = run->start;
+        *count = run->count;
+    }
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult holiday_snapshot_get(const HolidaySnapshot* snapshot, size_t index, Holiday* holiday) {
+    if (!snapshot || !holiday) return CALENDAR_ERROR_NULL_POINTER;
+    if (index >= snapshot->count) return CALENDAR_ERROR_INVALID_DATE;
+    
+    const HolidaySnapshotRecord* record = &snapshot->records[index];
+    uint64_t string_bytes = snapshot->header->string_bytes;
+    if (record->name_offset >= string_bytes || record->description_offset >= string_bytes) {
+        return CALENDAR_ERROR_CONVERSION_FAILED;
+    }
+    memset(holiday, 0, sizeof(*holiday));
+    holiday->name = snapshot->strings + record->name_offset;
+    holiday->description = snapshot->strings + record->description_offset;
+    holiday->calendar_type = (CalendarType)record->calendar_type;
+    holiday->holiday_type = record->holiday_type;
+    holiday->date.month = record->month;
+    holiday->date.day = record->day;
+    memcpy(holiday->country_code, record->country_code, sizeof(holiday->country_code));
+    holiday->country_code[sizeof(holiday->country_code) - 1] = '\0';
+    holiday->is_public_holiday = (int)record->is_public_holiday;
+    holiday->weekday = record->weekday;
+    holiday->offset_days = record->offset_days;
+    holiday->duration_days = record->duration_days;
+    holiday->is_bank_holiday = (int)record->is_bank_holiday;
+    holiday->is_school_holiday = (int)record->is_school_holiday;
+    return CALENDAR_SUCCESS;
+}
@@ -0,0 +1,95 @@
+// src/holidays/holiday_snapshot.h
+#ifndef HOLIDAY_SNAPSHOT_H
+#define HOLIDAY_SNAPSHOT_H
+
+#include "holiday_db.h"
+#include "holiday_rules.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Compiled holiday database, mapped read-only and used in place
+#define HOLIDAY_SNAPSHOT_MAGIC "CALHOLS"
+#define HOLIDAY_SNAPSHOT_FORMAT_VERSION 3      // 2: duration_days; 3: bank and school flags
+
+// On-disk holiday; the strings live once each in the string pool
+typedef struct {
+    uint32_t name_offset;           // Byte offsets into the string pool
+    uint32_t description_offset;
+    int32_t calendar_type;
+    int32_t holiday_type;
+    int32_t month;
+    int32_t day;
+    int32_t weekday;
+    int32_t offset_days;
+    char country_code[4];
+    uint32_t is_public_holiday;
+    int32_t duration_days;
+    uint32_t is_bank_holiday;
+    uint32_t is_school_holiday;
+} HolidaySnapshotRecord;
+
+// Versioned file header. Sections follow it, each 8-byte aligned: records,
+// date index buckets, date index order, date index slot offsets, country
+// runs, country order, string pool.
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;           // sizeof(HolidaySnapshotRecord)
+    uint64_t record_count;
+    uint64_t record_offset;
+    uint64_t bucket_offset;         // HolidayIndexBucket[bucket_count]
+    uint64_t bucket_count;          // Power of two
+    uint64_t order_offset;          // uint32_t[indexed_count]
+    uint64_t indexed_count;         // Records with a valid date slot
+    uint64_t slot_offset;           // uint32_t[HOLIDAY_INDEX_SLOTS + 1]
+    uint64_t country_offset;        // HolidayCountryRun[country_count], by key
+    uint64_t country_count;
+    uint64_t country_order_offset;  // uint32_t[record_count], by country then record
+    uint64_t string_offset;
+    uint64_t string_bytes;
+} HolidaySnapshotFileHeader;
+
+// Memory-mapped snapshot handle; index points into the mapping
+typedef struct {
+    const HolidaySnapshotFileHeader* header;
+    const HolidaySnapshotRecord* records;
+    const char* strings;
+    size_t count;
+    HolidayIndex index;
+    const HolidayCountryRun* countries;
+    const uint32_t* country_order;
+    size_t country_count;
+    void* mapping;
+    size_t mapping_size;
+} HolidaySnapshot;
+
+// Building snapshot files from holidays, or from sources that are each a
+// holiday CSV file or an existing snapshot
+CalendarResult holiday_snapshot_write(const char* filename, const Holiday* holidays, size_t count);
+CalendarResult holiday_snapshot_compile(const char* filename, const char* const* sources, int source_count);
+
+// Appends one source, a snapshot or a CSV file, to a database. A damaged
+// snapshot, a CSV file with a malformed row and one with no rows all fail
+// with CALENDAR_ERROR_CONVERSION_FAILED.
+CalendarResult holiday_snapshot_load_source(HolidayDatabase* db, const char* source);
+
+// Loading: maps the file and checks its header and section bounds, with no
+// parsing or copying. Lookups check each reference they follow; verify()
+// checks them all up front, for files from untrusted sources.
+HolidaySnapshot* holiday_snapshot_open(const char* filename);
+CalendarResult holiday_snapshot_verify(const HolidaySnapshot* snapshot);
+void holiday_snapshot_close(HolidaySnapshot* snapshot);
+
+// Records on a date of a calendar (country_code NULL or "" for all countries):
+// up to capacity record indices, and the total number in *count
+CalendarResult holiday_snapshot_find(const HolidaySnapshot* snapshot, const Date* date, CalendarType calendar_type,
+                                     const char* country_code, uint32_t* matches, int capacity, int* count);
+
+// One country's records are country_order[*first .. *first + *count)
+CalendarResult holiday_snapshot_country(const HolidaySnapshot* snapshot, const char* country_code,
+                                        size_t* first, size_t* count);
+
+// Record expanded back into a holiday, whose strings point into the mapping
+CalendarResult holiday_snapshot_get(const HolidaySnapshot* snapshot, size_t index, Holiday* holiday);
+
+#endif // HOLIDAY_SNAPSHOT_H
@@ -0,0 +1,375 @@
+// src/religious/panchang.c
+#include "panchang.h"
+#include "solar_day.h"
+#include "../astronomy/lunar_calc.h"
+#include "../astronomy/event_finder.h"
+#include "../astronomy/time_scale.h"
+#include "../utils/date_utils.h"
+
+#define PANCHANG_SOLAR_ABERRATION 0.00569   // Degrees, geometric to apparent solar longitude
+#define PANCHANG_TOLERANCE_DAYS (1.0 / 86400.0)
+#define PANCHANG_WINDOW_DAYS 3.0            // Past the last sunrise; longer than any element lasts
+#define PANCHANG_NO_SUNRISE_OFFSET 0.25     // Local 6h mean time, in days before solar noon
+
+// Each limb is an increasing angle cut into equal elements. Scaling the angle
+// so one element is a full turn makes every boundary a crossing of 0 degrees,
+// so one rate-bounded search finds them all.
+typedef struct {
+    double scale;               // Elements per 360 degrees of the raw angle
+    double min_rate;            // Rate bounds of the raw angle, degrees/day
+    double max_rate;
+} PanchangLimbSpec;
+
+static const PanchangLimbSpec panchang_limb_specs[PANCHANG_LIMB_COUNT] = {
+    { PANCHANG_TITHIS, 10.0, 16.0 },        // Elongation of the moon
+    { PANCHANG_NAKSHATRAS, 11.0, 16.0 },    // Sidereal moon
+    { PANCHANG_YOGAS, 12.0, 17.0 },         // Sidereal sun plus moon
+    { PANCHANG_KARANAS, 10.0, 16.0 }        // Elongation again
+};
+
+// Ayanamsha at a defining epoch, carried to other dates by general precession
+typedef struct {
+    double epoch_jd;
+    double value;               // Degrees
+} PanchangAyanamshaSpec;
+
+static const PanchangAyanamshaSpec panchang_ayanamsha_specs[PANCHANG_AYANAMSHA_COUNT] = {
+    { 2435553.5, 23.245524743 },    // Lahiri: 1956 March 21, Indian Calendar Reform Committee
+    { 2415020.0, 21.014444 },       // Raman: 1900
+    { 2415020.0, 22.363889 },       // Krishnamurti: 1900
+    { 2433282.42346, 24.042044444 },// Fagan-Bradley: 1950
+    { 2451545.0, 0.0 }              // Tropical
+};
+
+typedef struct {
+    PanchangAyanamsha ayanamsha;
+    PanchangLimb limb;
+} PanchangSearchContext;
+
+static double panchang_normalize_degrees(double angle) {
+    angle = fmod(angle, 360.0);
+    return angle < 0.0 ? angle + 360.0 : angle;
+}
+
+// General precession in longitude since J2000, arcseconds (IAU 2006)
+static double panchang_precession(double julian_day) {
+    double t = (julian_day - 2451545.0) / 36525.0;
+    return (5028.796195 + 1.1054348 * t) * t;
+}
+
+double panchang_ayanamsha(double julian_day, PanchangAyanamsha ayanamsha) {
+    if (ayanamsha < 0 || ayanamsha >= PANCHANG_AYANAMSHA_COUNT || ayanamsha == PANCHANG_AYANAMSHA_TROPICAL) {
+        return 0.0;
+    }
+    const PanchangAyanamshaSpec* spec = &panchang_ayanamsha_specs[ayanamsha];
+    return spec->value + (panchang_precession(julian_day) - panchang_precession(spec->epoch_jd)) / 3600.0;
+}
+
+// Sidereal apparent longitudes of the sun and moon at a TT instant; the
+// ayanamsha cancels from the elongation
+static void panchang_longitudes(double julian_day, PanchangAyanamsha ayanamsha,
+                                double* sun, double* moon, double* ayanamsha_degrees) {
+    LunarPosition position;
+    lunar_calculate_position(julian_day, &position);
+    double a = panchang_ayanamsha(julian_day, ayanamsha);
+    
+    *sun = panchang_normalize_degrees(lunar_solar_longitude(julian_day) - PANCHANG_SOLAR_ABERRATION - a);
+    *moon = panchang_normalize_degrees(position.longitude - a);
+    if (ayanamsha_degrees) *ayanamsha_degrees = a;
+}
+
+static double panchang_raw_angle(PanchangLimb limb, double sun, double moon) {
+    switch (limb) {
+        case PANCHANG_NAKSHATRA: return moon;
+        case PANCHANG_YOGA:      return panchang_normalize_degrees(sun + moon);
+        default:                 return panchang_normalize_degrees(moon - sun);
+    }
+}
+
+// Element number (from 1) containing a raw angle
+static int panchang_element(PanchangLimb limb, double raw) {
+    int count = (int)panchang_limb_specs[limb].scale;
+    int number = (int)floor(raw * count / 360.0) + 1;
+    return number > count ? count : number;
+}
+
+static double panchang_limb_event(double julian_day, void* context) {
+    const PanchangSearchContext* search = context;
+    double sun, moon;
+    panchang_longitudes(julian_day, search->ayanamsha, &sun, &moon, NULL);
+    return panchang_raw_angle(search->limb, sun, moon) * panchang_limb_specs[search->limb].scale;
+}
+
+// Transitions of one limb in [start_tt, end_tt], numbered on from the element
+// in force at start_tt; times are converted to UT. Returns the count.
+static int panchang_limb_transitions(PanchangLimb limb, PanchangAyanamsha ayanamsha,
+                                     double start_tt, double end_tt, int first_number,
+                                     PanchangTransition* transitions, int capacity) {
+    const PanchangLimbSpec* limb_spec = &panchang_limb_specs[limb];
+    PanchangSearchContext context = { ayanamsha, limb };
+    
+    EventSearchSpec spec = {0};
+    spec.function = panchang_limb_event;
+    spec.context = &context;
+    spec.kind = EVENT_VALUE_ANGLE;
+    spec.target = 0.0;
+    spec.tolerance_days = PANCHANG_TOLERANCE_DAYS;
+    spec.min_rate = limb_spec->min_rate * limb_spec->scale;
+    spec.max_rate = limb_spec->max_rate * limb_spec->scale;
+    
+    EventSearch search;
+    EventCrossing crossing;
+    int count = 0, number = first_number;
+    event_search_init(&search, &spec, start_tt, end_tt);
+    while (count < capacity && event_search_next(&search, &crossing)) {
+        number = number % (int)limb_spec->scale + 1;
+        transitions[count].julian_day = time_tt_to_ut(crossing.julian_day);
+        transitions[count].limb = limb;
+        transitions[count].number = number;
+        count++;
+    }
+    return count;
+}
+
+// Upper bound on the transitions of a limb over a span
+static int panchang_capacity(PanchangLimb limb, double days) {
+    const PanchangLimbSpec* spec = &panchang_limb_specs[limb];
+    return (int)(days * spec->max_rate * spec->scale / 360.0) + 2;
+}
+
+// Transitions of every limb over [start_ut, end_ut], one list per limb. Tithis
+// end on every other karana boundary, so only three limbs are searched.
+static CalendarResult panchang_all_transitions(double start_ut, double end_ut, PanchangAyanamsha ayanamsha,
+                                               const PanchangElements* initial,
+                                               PanchangTransition* lists[PANCHANG_LIMB_COUNT],
+                                               int counts[PANCHANG_LIMB_COUNT]) {
+    double start_tt = time_ut_to_tt(start_ut);
+    double end_tt = time_ut_to_tt(end_ut);
+    int firsts[PANCHANG_LIMB_COUNT] = { initial->tithi, initial->nakshatra, initial->yoga, initial->karana };
+    
+    for (int limb = 0; limb < PANCHANG_LIMB_COUNT; limb++) {
+        lists[limb] = malloc(sizeof(PanchangTransition) * panchang_capacity(limb, end_ut - start_ut));
+        counts[limb] = 0;
+    }
+    for (int limb = 0; limb < PANCHANG_LIMB_COUNT; limb++) {
+        if (!lists[limb]) {
+            for (int i = 0; i < PANCHANG_LIMB_COUNT; i++) free(lists[i]);
+            return CALENDAR_ERROR_CONVERSION_FAILED;
+        }
+    }
+    
+    for (int limb = PANCHANG_NAKSHATRA; limb < PANCHANG_LIMB_COUNT; limb++) {
+        counts[limb] = panchang_limb_transitions(limb, ayanamsha, start_tt, end_tt, firsts[limb],
+                                                 lists[limb], panchang_capacity(limb, end_ut - start_ut));
+    }
+    
+    // Odd karanas open a tithi
+    for (int i = 0; i < counts[PANCHANG_KARANA]; i++) {
+        const PanchangTransition* karana = &lists[PANCHANG_KARANA][i];
+        if (karana->number % 2 == 0) continue;
+        PanchangTransition* tithi = &lists[PANCHANG_TITHI][counts[PANCHANG_TITHI]++];
+        tithi->julian_day = karana->julian_day;
+        tithi->limb = PANCHANG_TITHI;
+        tithi->number = (karana->number + 1) / 2;
+    }
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult panchang_calculate(double julian_day, PanchangAyanamsha ayanamsha,
+                                  PanchangElements* elements) {
+    if (!elements) return CALENDAR_ERROR_NULL_POINTER;
+    if (ayanamsha < 0 || ayanamsha >= PANCHANG_AYANAMSHA_COUNT) return CALENDAR_ERROR_INVALID_DATE;
+    
+    double sun, moon;
+    panchang_longitudes(time_ut_to_tt(julian_day), ayanamsha, &sun, &moon, &elements->ayanamsha);
+    
+    elements->julian_day = julian_day;
+    elements->sun_longitude = sun;
+    elements->moon_longitude = moon;
+    elements->tithi = panchang_element(PANCHANG_TITHI, panchang_raw_angle(PANCHANG_TITHI, sun, moon));
+    elements->nakshatra = panchang_element(PANCHANG_NAKSHATRA, panchang_raw_angle(PANCHANG_NAKSHATRA, sun, moon));
+    elements->yoga = panchang_element(PANCHANG_YOGA, panchang_raw_angle(PANCHANG_YOGA, sun, moon));
+    elements->karana = panchang_element(PANCHANG_KARANA, panchang_raw_angle(PANCHANG_KARANA, sun, moon));
+    return CALENDAR_SUCCESS;
+}
+
+static int panchang_compare_transitions(const void* a, const void* b) {
+    const PanchangTransition* ta = a;
+    const PanchangTransition* tb = b;
+    if (ta->julian_day < tb->julian_day) return -1;
+    if (ta->julian_day > tb->julian_day) return 1;
+    return (int)ta->limb - (int)tb->limb;
+}
+
+PanchangTransition* panchang_find_transitions(double start_jd, double end_jd,
+                                              PanchangAyanamsha ayanamsha, int* count) {
+    if (!count) return NULL;
+    *count = 0;
+    if (end_jd <= start_jd) return NULL;
+    
+    PanchangElements initial;
+    if (panchang_calculate(start_jd, ayanamsha, &initial) != CALENDAR_SUCCESS) return NULL;
+    
+    PanchangTransition* lists[PANCHANG_LIMB_COUNT];
+    int counts[PANCHANG_LIMB_COUNT];
+    if (panchang_all_transitions(start_jd, end_jd, ayanamsha, &initial, lists, counts) != CALENDAR_SUCCESS) {
+        return NULL;
+    }
+    
+    int total = 0;
+    for (int limb = 0; limb < PANCHANG_LIMB_COUNT; limb++) total += counts[limb];
+    PanchangTransition* transitions = malloc(sizeof(PanchangTransition) * (total > 0 ? total : 1));
+    if (transitions) {
+        for (int limb = 0; limb < PANCHANG_LIMB_COUNT; limb++) {
+            memcpy(transitions + *count, lists[limb], sizeof(PanchangTransition) * counts[limb]);
+            *count += counts[limb];
+        }
+        qsort(transitions, *count, sizeof(PanchangTransition), panchang_compare_transitions);
+    }
+    for (int limb = 0; limb < PANCHANG_LIMB_COUNT; limb++) free(lists[limb]);
+    return transitions;
+}
+
+PanchangDay* panchang_calculate_days(double first_jd, int day_count, double latitude, double longitude,
+                                     PanchangAyanamsha ayanamsha) {
+    if (day_count <= 0 || fabs(latitude) > 90.0 || fabs(longitude) > 180.0) return NULL;
+    if (ayanamsha < 0 || ayanamsha >= PANCHANG_AYANAMSHA_COUNT) return NULL;
+    
+    SolarDayTable table;
+    if (solar_day_table_init(&table, first_jd, day_count) != CALENDAR_SUCCESS) return NULL;
+    
+    PanchangDay* days = calloc(day_count, sizeof(PanchangDay));
+    if (!days) {
+        solar_day_table_free(&table);
+        return NULL;
+    }
+    
+    // Sunrises first; the day's elements are those in force at that instant
+    for (int d = 0; d < day_count; d++) {
+        SolarDay day;
+        solar_day_compute(&table, first_jd + d, latitude, longitude, &day);
+        days[d].julian_day = first_jd + d;
+        days[d].sunrise = solar_day_altitude_time(&table, &day, SOLAR_DAY_SUNRISE_ALTITUDE, 0);
+        if (days[d].sunrise == 0.0) days[d].sunrise = day.transit_jd - PANCHANG_NO_SUNRISE_OFFSET;
+        days[d].vara = (int)(((long)floor(first_jd + d + 0.5) + 1) % 7);
+    }
+    solar_day_table_free(&table);
+    
+    // One pass over each limb's transitions, which run a few days past the
+    // last sunrise so every element in force has its end
+    double start = days[0].sunrise;
+    double end = days[day_count - 1].sunrise + PANCHANG_WINDOW_DAYS;
+    PanchangElements initial;
+    PanchangTransition* lists[PANCHANG_LIMB_COUNT];
+    int counts[PANCHANG_LIMB_COUNT];
+    panchang_calculate(start, ayanamsha, &initial);
+    if (panchang_all_transitions(start, end, ayanamsha, &initial, lists, counts) != CALENDAR_SUCCESS) {
+        free(days);
+        return NULL;
+    }
+    
+    int current[PANCHANG_LIMB_COUNT] = { initial.tithi, initial.nakshatra, initial.yoga, initial.karana };
+    for (int limb = 0; limb < PANCHANG_LIMB_COUNT; limb++) {
+        int next = 0;
+        for (int d = 0; d < day_count; d++) {
+            while (next < counts[limb] && lists[limb][next].julian_day <= days[d].sunrise) {
+                current[limb] = lists[limb][next++].number;
+            }
+            days[d].ends[limb] = next < counts[limb] ? lists[limb][next].julian_day : 0.0;
+            switch (limb) {
+                case PANCHANG_TITHI:     days[d].tithi = current[limb]; break;
+                case PANCHANG_NAKSHATRA: days[d].nakshatra = current[limb]; break;
+                case PANCHANG_YOGA:      days[d].yoga = current[limb]; break;
+                default:                 days[d].karana = current[limb]; break;
+            }
+        }
+        free(lists[limb]);
+    }
+    return days;
+}
+
+PanchangDay* panchang_calculate_year(int year, double latitude, double longitude,
+                                     PanchangAyanamsha ayanamsha, int* day_count) {
+    if (!day_count) return NULL;
+    
+    long first = julian_day_from_date(1, 1, year);
+    *day_count = (int)(julian_day_from_date(1, 1, year + 1) - first);
+    return panchang_calculate_days((double)first, *day_count, latitude, longitude, ayanamsha);
+}
+
+// Names
+
+static const char* const panchang_tithi_names[15] = {
+    "Pratipada", "Dwitiya", "Tritiya", "Chaturthi", "Panchami", "Shashthi", "Saptami", "Ashtami",
+    "Navami", "Dashami", "Ekadashi", "Dwadashi", "Trayodashi", "Chaturdashi", "Purnima"
+};
+
+static const char* const panchang_nakshatra_names[PANCHANG_NAKSHATRAS] = {
+    "Ashwini", "Bharani", "Krittika", "Rohini", "Mrigashira", "Ardra", "Punarvasu", "Pushya",
+    "Ashlesha", "Magha", "Purva Phalguni", "Uttara Phalguni", "Hasta", "Chitra", "Swati",
+    "Vishakha", "Anuradha", "Jyeshtha", "Mula", "Purva Ashadha", "Uttara Ashadha", "Shravana",
+    "Dhanishta", "Shatabhisha", "Purva Bhadrapada", "Uttara Bhadrapada", "Revati"
+};
+
+static const char* const panchang_yoga_names[PANCHANG_YOGAS] = {
+    "Vishkambha", "Priti", "Ayushman", "Saubhagya", "Shobhana", "Atiganda", "Sukarma", "Dhriti",
+    "Shula", "Ganda", "Vriddhi", "Dhruva", "Vyaghata", "Harshana", "Vajra", "Siddhi", "Vyatipata",
+    "Variyana", "Parigha", "Shiva", "Siddha", "Sadhya", "Shubha", "Shukla", "Brahma", "Indra",
+    "Vaidhriti"
+};
+
+static const char* const panchang_movable_karana_names[7] = {
+    "Bava", "Balava", "Kaulava", "Taitila", "Gara", "Vanija", "Vishti"
+};
+
+static const char* const panchang_vara_names[7] = {
+    "Ravivara", "Somavara", "Mangalavara", "Budhavara", "Guruvara", "Shukravara", "Shanivara"
+};
+
+const char* panchang_tithi_name(int tithi) {
+    if (tithi < 1 || tithi > PANCHANG_TITHIS) return "Unknown";
+    if (tithi == PANCHANG_TITHIS) return "Amavasya";
+    return panchang_tithi_names[(tithi - 1) % 15];
+}
+
+const char* panchang_paksha_name(int tithi) {
+    if (tithi < 1 || tithi > PANCHANG_TITHIS) return "Unknown";
+    return tithi <= 15 ? "Shukla" : "Krishna";
+}
+
+const char* panchang_nakshatra_name(int nakshatra) {
+    if (nakshatra < 1 || nakshatra > PANCHANG_NAKSHATRAS) return "Unknown";
+    return panchang_nakshatra_names[nakshatra - 1];
+}
+
+const char* panchang_yoga_name(int yoga) {
+    if (yoga < 1 || yoga > PANCHANG_YOGAS) return "Unknown";
+    return panchang_yoga_names[yoga - 1];
+}
+
+// The first half of shukla pratipada and the last three halves of the month
+// are fixed; the seven movable karanas cycle through the other 56
+const char* panchang_karana_name(int karana) {
+    if (karana < 1 || karana > PANCHANG_KARANAS) return "Unknown";
+    if (karana == 1) return "Kimstughna";
+    if (karana == 58) return "Shakuni";
+    if (karana == 59) return "Chatushpada";
+    if (karana == 60) return "Naga";
+    return panchang_movable_karana_names[(karana - 2) % 7];
+}
+
+const char* panchang_vara_name(int vara) {
+    if (vara < 0 || vara > 6) return "Unknown";
+    return panchang_vara_names[vara];
+}
+
+const char* panchang_ayanamsha_name(PanchangAyanamsha ayanamsha) {
+    switch (ayanamsha) {
+        case PANCHANG_AYANAMSHA_LAHIRI:        return "Lahiri";
+        case PANCHANG_AYANAMSHA_RAMAN:         return "Raman";
+        case PANCHANG_AYANAMSHA_KRISHNAMURTI:  return "Krishnamurti";
+        case PANCHANG_AYANAMSHA_FAGAN_BRADLEY: return "Fagan-Bradley";
+        case PANCHANG_AYANAMSHA_TROPICAL:      return "Tropical";
+        default:                               return "Unknown";
+    }
+}
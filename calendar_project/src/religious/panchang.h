@@ -0,0 +1,91 @@
+// src/religious/panchang.h
+#ifndef PANCHANG_H
+#define PANCHANG_H
+
+#include "../../include/calendar_types.h"
+
+#define PANCHANG_TITHIS 30          // Twelve degrees of elongation each
+#define PANCHANG_NAKSHATRAS 27      // 13°20' of sidereal lunar longitude each
+#define PANCHANG_YOGAS 27           // 13°20' of summed sidereal longitudes each
+#define PANCHANG_KARANAS 60         // Half tithis
+
+// Zero point of the sidereal zodiac
+typedef enum {
+    PANCHANG_AYANAMSHA_LAHIRI,          // Chitrapaksha, Indian national ephemeris
+    PANCHANG_AYANAMSHA_RAMAN,
+    PANCHANG_AYANAMSHA_KRISHNAMURTI,
+    PANCHANG_AYANAMSHA_FAGAN_BRADLEY,
+    PANCHANG_AYANAMSHA_TROPICAL,        // No correction
+    PANCHANG_AYANAMSHA_COUNT
+} PanchangAyanamsha;
+
+// The four limbs that change at arbitrary instants (the fifth, vara, is the weekday)
+typedef enum {
+    PANCHANG_TITHI,
+    PANCHANG_NAKSHATRA,
+    PANCHANG_YOGA,
+    PANCHANG_KARANA,
+    PANCHANG_LIMB_COUNT
+} PanchangLimb;
+
+// Elements at one instant; all numbers count from 1 (tithi 1-15 shukla
+// paksha, 16-30 krishna paksha, 30 = amavasya)
+typedef struct {
+    double julian_day;          // UT
+    int tithi;
+    int nakshatra;
+    int yoga;
+    int karana;                 // Half tithi 1-60; see panchang_karana_name()
+    double ayanamsha;           // Degrees
+    double sun_longitude;       // Sidereal, degrees
+    double moon_longitude;
+} PanchangElements;
+
+// Instant an element begins
+typedef struct {
+    double julian_day;          // UT
+    PanchangLimb limb;
+    int number;                 // Element that begins, numbered as in PanchangElements
+} PanchangTransition;
+
+// Civil day at one place: the elements prevailing at sunrise and when each ends
+typedef struct {
+    double julian_day;          // Civil date
+    double sunrise;             // UT; local 6h mean time where the sun does not rise
+    int vara;                   // Weekday of the sunrise, 0 = Ravivara (Sunday)
+    int tithi;
+    int nakshatra;
+    int yoga;
+    int karana;
+    double ends[PANCHANG_LIMB_COUNT];   // UT end of each element, indexed by PanchangLimb
+} PanchangDay;
+
+// Ayanamsha in degrees at a TT instant
+double panchang_ayanamsha(double julian_day, PanchangAyanamsha ayanamsha);
+
+// Elements at a UT instant
+CalendarResult panchang_calculate(double julian_day, PanchangAyanamsha ayanamsha,
+                                  PanchangElements* elements);
+
+// Every transition of all four limbs in [start_jd, end_jd] (UT), in time
+// order; one root solve per boundary. free() the result.
+PanchangTransition* panchang_find_transitions(double start_jd, double end_jd,
+                                              PanchangAyanamsha ayanamsha, int* count);
+
+// Sunrise panchang for day_count consecutive civil dates from first_jd, and
+// for a whole Gregorian year; free() the result
+PanchangDay* panchang_calculate_days(double first_jd, int day_count, double latitude, double longitude,
+                                     PanchangAyanamsha ayanamsha);
+PanchangDay* panchang_calculate_year(int year, double latitude, double longitude,
+                                     PanchangAyanamsha ayanamsha, int* day_count);
+
+// Names (numbers from 1; vara from 0)
+const char* panchang_tithi_name(int tithi);
+const char* panchang_paksha_name(int tithi);
+const char* panchang_nakshatra_name(int nakshatra);
+const char* panchang_yoga_name(int yoga);
+const char* panchang_karana_name(int karana);
+const char* panchang_vara_name(int vara);
+const char* panchang_ayanamsha_name(PanchangAyanamsha ayanamsha);
+
+#endif // PANCHANG_H
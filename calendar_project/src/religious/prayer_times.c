@@ -0,0 +1,335 @@
+// src/religious/prayer_times.c
+#include "prayer_times.h"
+
+#define PRAYER_DEG_TO_RAD (M_PI / 180.0)
+#define PRAYER_RAD_TO_DEG (180.0 / M_PI)
+#define PRAYER_KAABA_LATITUDE 21.4225
+#define PRAYER_KAABA_LONGITUDE 39.8262
+#define PRAYER_EARTH_RADIUS_KM 6371.0
+#define PRAYER_ISHRAQ_MINUTES 15.0      // After sunrise
+
+PrayerParameters prayer_get_method_parameters(PrayerCalculationMethod method) {
+    PrayerParameters params;
+    memset(&params, 0, sizeof(params));
+    params.high_latitude_method = PRAYER_HIGH_LATITUDE_MIDDLE_OF_NIGHT;
+    
+    switch (method) {
+        case PRAYER_METHOD_ISNA:
+            params.fajr_angle = 15.0;
+            params.isha_angle = 15.0;
+            break;
+        case PRAYER_METHOD_EGYPT:
+            params.fajr_angle = 19.5;
+            params.isha_angle = 17.5;
+            break;
+        case PRAYER_METHOD_MAKKAH:
+            params.fajr_angle = 18.5;
+            params.isha_interval = 90.0;
+            break;
+        case PRAYER_METHOD_KARACHI:
+            params.fajr_angle = 18.0;
+            params.isha_angle = 18.0;
+            break;
+        case PRAYER_METHOD_TEHRAN:
+            params.fajr_angle = 17.7;
+            params.isha_angle = 14.0;
+            params.maghrib_angle = 4.5;
+            break;
+        case PRAYER_METHOD_JAFARI:
+            params.fajr_angle = 16.0;
+            params.isha_angle = 14.0;
+            params.maghrib_angle = 4.0;
+            break;
+        case PRAYER_METHOD_MWL:
+        case PRAYER_METHOD_CUSTOM:
+        default:
+            params.fajr_angle = 18.0;
+            params.isha_angle = 17.0;
+            break;
+    }
+    return params;
+}
+
+void prayer_set_custom_parameters(PrayerParameters* params, double fajr_angle,
+                                 double isha_angle, int asr_method) {
+    if (!params) return;
+    params->fajr_angle = fajr_angle;
+    params->isha_angle = isha_angle;
+    params->asr_method = asr_method;
+}
+
+// Altitude at which an object's shadow is its noon shadow plus `factor` times its length
+static double prayer_asr_altitude(double latitude, double declination, int asr_method) {
+    double factor = asr_method == 1 ? 2.0 : 1.0;
+    double noon_zenith = fabs(latitude - declination) * PRAYER_DEG_TO_RAD;
+    return atan(1.0 / (factor + tan(noon_zenith))) * PRAYER_RAD_TO_DEG;
+}
+
+static double prayer_fajr_on(const SolarDayTable* table, const SolarDay* day, const PrayerParameters* params) {
+    return solar_day_altitude_time(table, day, -params->fajr_angle, 0);
+}
+
+// Keeps Fajr and Isha within a portion of the night from sunrise and Maghrib
+static void prayer_limit_night(PrayerTimes* times, double latitude, const PrayerParameters* params, int rule) {
+    if (rule == PRAYER_HIGH_LATITUDE_NONE || fabs(latitude) < PRAYER_HIGH_LATITUDE_THRESHOLD) return;
+    if (times->sunrise_jd == 0.0 || times->maghrib_jd == 0.0) return;
+    
+    double night = times->sunrise_jd + 1.0 - times->maghrib_jd;
+    double fajr_portion = 0.5, isha_portion = 0.5;
+    if (rule == PRAYER_HIGH_LATITUDE_SEVENTH_OF_NIGHT) {
+        fajr_portion = isha_portion = 1.0 / 7.0;
+    } else if (rule == PRAYER_HIGH_LATITUDE_ANGLE_BASED) {
+        fajr_portion = params->fajr_angle / 60.0;
+        isha_portion = params->isha_angle / 60.0;
+    }
+    
+    double earliest_fajr = times->sunrise_jd - fajr_portion * night;
+    if (times->fajr_jd == 0.0 || times->fajr_jd < earliest_fajr) times->fajr_jd = earliest_fajr;
+    
+    // Interval-based Isha follows Maghrib and needs no limit
+    if (params->isha_angle > 0.0) {
+        double latest_isha = times->maghrib_jd + isha_portion * night;
+        if (times->isha_jd == 0.0 || times->isha_jd > latest_isha) times->isha_jd = latest_isha;
+    }
+}
+
+CalendarResult prayer_calculate_times_for_day(const SolarDayTable* table, const SolarDay* day,
+                                              const PrayerParameters* params, PrayerCalculationMethod method,
+                                              int timezone_offset, PrayerTimes* times) {
+    if (!table || !day || !params || !times) return CALENDAR_ERROR_NULL_POINTER;
+    
+    memset(times, 0, sizeof(*times));
+    times->method = method;
+    times->latitude = day->latitude;
+    times->longitude = day->longitude;
+    times->timezone_offset = timezone_offset;
+    
+    double sunset = solar_day_altitude_time(table, day, SOLAR_DAY_SUNRISE_ALTITUDE, 1);
+    times->fajr_jd = prayer_fajr_on(table, day, params);
+    times->sunrise_jd = solar_day_altitude_time(table, day, SOLAR_DAY_SUNRISE_ALTITUDE, 0);
+    times->dhuhr_jd = day->transit_jd;
+    
+    double ra, dec;
+    solar_day_sample(table, day->transit_jd, &ra, &dec);
+    times->asr_jd = solar_day_altitude_time(table, day, prayer_asr_altitude(day->latitude, dec, params->asr_method), 1);
+    
+    if (params->maghrib_angle > 0.0) {
+        times->maghrib_jd = solar_day_altitude_time(table, day, -params->maghrib_angle, 1);
+    } else if (sunset != 0.0) {
+        times->maghrib_jd = sunset + params->maghrib_interval / 1440.0;
+    }
+    if (params->isha_angle > 0.0) {
+        times->isha_jd = solar_day_altitude_time(table, day, -params->isha_angle, 1);
+    } else if (times->maghrib_jd != 0.0) {
+        times->isha_jd = times->maghrib_jd + params->isha_interval / 1440.0;
+    }
+    
+    prayer_limit_night(times, day->latitude, params, (int)params->high_latitude_method);
+    
+    // The night runs to the next morning's Fajr
+    SolarDay next;
+    double next_fajr = 0.0;
+    if (solar_day_compute(table, day->julian_day + 1.0, day->latitude, day->longitude, &next) == CALENDAR_SUCCESS) {
+        next_fajr = prayer_fajr_on(table, &next, params);
+    }
+    if (next_fajr == 0.0 && times->fajr_jd != 0.0) next_fajr = times->fajr_jd + 1.0;
+    if (times->maghrib_jd != 0.0 && next_fajr != 0.0) {
+        times->midnight_jd = prayer_calculate_islamic_midnight(times->maghrib_jd, next_fajr);
+        times->tahajjud_jd = prayer_calculate_last_third_night(times->maghrib_jd, next_fajr);
+    }
+    if (times->sunrise_jd != 0.0) {
+        times->ishraq_jd = times->sunrise_jd + PRAYER_ISHRAQ_MINUTES / 1440.0;
+        if (sunset != 0.0) times->duha_jd = times->sunrise_jd + (sunset - times->sunrise_jd) / 4.0;
+    }
+    return CALENDAR_SUCCESS;
+}
+
+PrayerTimes* prayer_calculate_times(double julian_day, double latitude, double longitude,
+                                   PrayerCalculationMethod method, int timezone_offset) {
+    if (!prayer_validate_coordinates(latitude, longitude) || !prayer_is_valid_method(method)) return NULL;
+    
+    // Two dates: the night ends with the next day's Fajr
+    SolarDayTable table;
+    if (solar_day_table_init(&table, julian_day, 2) != CALENDAR_SUCCESS) return NULL;
+    
+    PrayerTimes* times = malloc(sizeof(PrayerTimes));
+    PrayerParameters params = prayer_get_method_parameters(method);
+    SolarDay day;
+    if (!times || solar_day_compute(&table, julian_day, latitude, longitude, &day) != CALENDAR_SUCCESS ||
+        prayer_calculate_times_for_day(&table, &day, &params, method, timezone_offset, times) != CALENDAR_SUCCESS) {
+        free(times);
+        times = NULL;
+    }
+    
+    solar_day_table_free(&table);
+    return times;
+}
+
+// Single times share the same path through a one-day table
+static double prayer_single_time(double julian_day, double latitude, double longitude,
+                                 double altitude, int is_evening, int want_transit) {
+    SolarDayTable table;
+    SolarDay day;
+    double result = 0.0;
+    if (solar_day_table_init(&table, julian_day, 1) != CALENDAR_SUCCESS) return 0.0;
+    if (solar_day_compute(&table, julian_day, latitude, longitude, &day) == CALENDAR_SUCCESS) {
+        result = want_transit ? day.transit_jd : solar_day_altitude_time(&table, &day, altitude, is_evening);
+    }
+    solar_day_table_free(&table);
+    return result;
+}
+
+double prayer_calculate_fajr(double julian_day, double latitude, double longitude, double angle) {
+    return prayer_single_time(julian_day, latitude, longitude, -angle, 0, 0);
+}
+
+double prayer_calculate_dhuhr(double julian_day, double longitude) {
+    return prayer_single_time(julian_day, 0.0, longitude, 0.0, 0, 1);
+}
+
+double prayer_calculate_asr(double julian_day, double latitude, double longitude, int method) {
+    SolarDayTable table;
+    SolarDay day;
+    double result = 0.0;
+    if (solar_day_table_init(&table, julian_day, 1) != CALENDAR_SUCCESS) return 0.0;
+    if (solar_day_compute(&table, julian_day, latitude, longitude, &day) == CALENDAR_SUCCESS) {
+        double ra, dec;
+        solar_day_sample(&table, day.transit_jd, &ra, &dec);
+        result = solar_day_altitude_time(&table, &day, prayer_asr_altitude(latitude, dec, method), 1);
+    }
+    solar_day_table_free(&table);
+    return result;
+}
+
+double prayer_calculate_maghrib(double julian_day, double latitude, double longitude) {
+    return prayer_single_time(julian_day, latitude, longitude, SOLAR_DAY_SUNRISE_ALTITUDE, 1, 0);
+}
+
+double prayer_calculate_isha(double julian_day, double latitude, double longitude, double angle) {
+    return prayer_single_time(julian_day, latitude, longitude, -angle, 1, 0);
+}
+
+void prayer_adjust_high_latitudes(PrayerTimes* times, double latitude, int method) {
+    if (!times) return;
+    PrayerParameters params = prayer_get_method_parameters(times->method);
+    prayer_limit_night(times, latitude, &params, method);
+}
+
+double prayer_calculate_islamic_midnight(double maghrib_jd, double fajr_jd) {
+    if (fajr_jd < maghrib_jd) fajr_jd += 1.0;
+    return maghrib_jd + (fajr_jd - maghrib_jd) / 2.0;
+}
+
+double prayer_calculate_last_third_night(double maghrib_jd, double fajr_jd) {
+    if (fajr_jd < maghrib_jd) fajr_jd += 1.0;
+    return maghrib_jd + (fajr_jd - maghrib_jd) * 2.0 / 3.0;
+}
+
+QiblaDirection* prayer_calculate_qibla(double latitude, double longitude) {
+    if (!prayer_validate_coordinates(latitude, longitude)) return NULL;
+    
+    QiblaDirection* qibla = malloc(sizeof(QiblaDirection));
+    if (!qibla) return NULL;
+    
+    double phi = latitude * PRAYER_DEG_TO_RAD;
+    double phi_k = PRAYER_KAABA_LATITUDE * PRAYER_DEG_TO_RAD;
+    double dlambda = (PRAYER_KAABA_LONGITUDE - longitude) * PRAYER_DEG_TO_RAD;
+    
+    // Initial great circle bearing and haversine distance
+    double bearing = atan2(sin(dlambda), cos(phi) * tan(phi_k) - sin(phi) * cos(dlambda)) * PRAYER_RAD_TO_DEG;
+    qibla->qibla_bearing = fmod(bearing + 360.0, 360.0);
+    qibla->great_circle_bearing = qibla->qibla_bearing;
+    
+    double h = sin((phi_k - phi) / 2.0) * sin((phi_k - phi) / 2.0) +
+               cos(phi) * cos(phi_k) * sin(dlambda / 2.0) * sin(dlambda / 2.0);
+    qibla->distance_km = 2.0 * PRAYER_EARTH_RADIUS_KM * asin(fmin(1.0, sqrt(h)));
+    return qibla;
+}
+
+void prayer_julian_to_time_string(double julian_day, int timezone_offset, char* buffer, int buffer_size) {
+    if (!buffer || buffer_size <= 0) return;
+    if (julian_day == 0.0) {
+        snprintf(buffer, buffer_size, "--:--");
+        return;
+    }
+    
+    double local = julian_day + 0.5 + timezone_offset / 24.0;
+    int minutes = (int)floor((local - floor(local)) * 1440.0 + 0.5) % 1440;
+    snprintf(buffer, buffer_size, "%02d:%02d", minutes / 60, minutes % 60);
+}
+
+void prayer_julian_to_12hour_string(double julian_day, int timezone_offset, char* buffer, int buffer_size) {
+    if (!buffer || buffer_size <= 0) return;
+    if (julian_day == 0.0) {
+        snprintf(buffer, buffer_size, "--:--");
+        return;
+    }
+    
+    double local = julian_day + 0.5 + timezone_offset / 24.0;
+    int minutes = (int)floor((local - floor(local)) * 1440.0 + 0.5) % 1440;
+    int hour = minutes / 60;
+    int hour12 = hour % 12 == 0 ? 12 : hour % 12;
+    snprintf(buffer, buffer_size, "%d:%02d %s", hour12, minutes % 60, hour < 12 ? "AM" : "PM");
+}
+
+static void prayer_print_with(const PrayerTimes* times,
+                              void (*format)(double, int, char*, int)) {
+    if (!times) return;
+    
+    const char* labels[6] = { "Fajr", "Sunrise", "Dhuhr", "Asr", "Maghrib", "Isha" };
+    double values[6] = { times->fajr_jd, times->sunrise_jd, times->dhuhr_jd,
+                         times->asr_jd, times->maghrib_jd, times->isha_jd };
+    char buffer[16];
+    for (int i = 0; i < 6; i++) {
+        format(values[i], times->timezone_offset, buffer, sizeof(buffer));
+        printf("  %-8s %s\n", labels[i], buffer);
+    }
+}
+
+void prayer_print_times(const PrayerTimes* times) {
+    prayer_print_with(times, prayer_julian_to_time_string);
+}
+
+void prayer_print_times_12hour(const PrayerTimes* times) {
+    prayer_print_with(times, prayer_julian_to_12hour_string);
+}
+
+void prayer_print_qibla(const QiblaDirection* qibla) {
+    if (!qibla) return;
+    printf("  Bearing:  %.2f° from North\n", qibla->qibla_bearing);
+    printf("  Distance: %.0f km\n", qibla->distance_km);
+}
+
+const char* prayer_method_name(PrayerCalculationMethod method) {
+    switch (method) {
+        case PRAYER_METHOD_MWL: return "Muslim World League";
+        case PRAYER_METHOD_ISNA: return "Islamic Society of North America";
+        case PRAYER_METHOD_EGYPT: return "Egyptian General Authority of Survey";
+        case PRAYER_METHOD_MAKKAH: return "Umm Al-Qura University, Makkah";
+        case PRAYER_METHOD_KARACHI: return "University of Islamic Sciences, Karachi";
+        case PRAYER_METHOD_TEHRAN: return "Institute of Geophysics, University of Tehran";
+        case PRAYER_METHOD_JAFARI: return "Shia Ithna-Ashari, Leva Institute, Qum";
+        case PRAYER_METHOD_CUSTOM: return "Custom";
+        default: return "Unknown";
+    }
+}
+
+void prayer_destroy_times(PrayerTimes* times) {
+    if (times) free(times);
+}
+
+void prayer_destroy_qibla(QiblaDirection* qibla) {
+    if (qibla) free(qibla);
+}
+
+int prayer_validate_coordinates(double latitude, double longitude) {
+    return latitude >= -90.0 && latitude <= 90.0 && longitude >= -180.0 && longitude <= 180.0;
+}
+
+int prayer_is_valid_method(PrayerCalculationMethod method) {
+    return method >= PRAYER_METHOD_MWL && method <= PRAYER_METHOD_CUSTOM;
+}
+
+int prayer_is_prayer_time_valid(double prayer_jd, double latitude) {
+    return prayer_jd != 0.0 && isfinite(prayer_jd) && latitude >= -90.0 && latitude <= 90.0;
+}
@@ -3,6 +3,14 @@
 
 #include "../../include/calendar_types.h"
 #include "../astronomy/solar_calc.h"
+#include "solar_day.h"
+
+// High latitude rules for Fajr and Isha when twilight lasts all night
+#define PRAYER_HIGH_LATITUDE_NONE 0
+#define PRAYER_HIGH_LATITUDE_MIDDLE_OF_NIGHT 1     // No later/earlier than the middle of the night
+#define PRAYER_HIGH_LATITUDE_SEVENTH_OF_NIGHT 2    // Within a seventh of the night of sunset/sunrise
+#define PRAYER_HIGH_LATITUDE_ANGLE_BASED 3         // Within angle/60 of the night
+#define PRAYER_HIGH_LATITUDE_THRESHOLD 48.0        // Degrees; applied from here poleward
 
 // Prayer calculation methods
 typedef enum {
@@ -46,6 +54,7 @@ typedef struct {
     double maghrib_interval;    // Minutes after sunset for Maghrib
     int asr_method;             // 0=Shafi, 1=Hanafi
     double high_latitude_method; // Method for high latitudes
+    double maghrib_angle;       // Angle below horizon for Maghrib (0 = sunset plus the interval)
 } PrayerParameters;
 
 // Qibla direction structure
@@ -59,6 +68,11 @@ typedef struct {
 PrayerTimes* prayer_calculate_times(double julian_day, double latitude, double longitude, 
                                    PrayerCalculationMethod method, int timezone_offset);
 
+// From a shared solar table, for timetables over many days and places
+CalendarResult prayer_calculate_times_for_day(const SolarDayTable* table, const SolarDay* day,
+                                              const PrayerParameters* params, PrayerCalculationMethod method,
+                                              int timezone_offset, PrayerTimes* times);
+
 // Individual prayer calculations
 double prayer_calculate_fajr(double julian_day, double latitude, double longitude, double angle);
 double prayer_calculate_dhuhr(double julian_day, double longitude);
@@ -0,0 +1,107 @@
+// src/religious/solar_day.c
+#include "solar_day.h"
+#include "../astronomy/solar_calc.h"
+
+#define SOLAR_DAY_DEG_TO_RAD (M_PI / 180.0)
+#define SOLAR_DAY_RAD_TO_DEG (180.0 / M_PI)
+#define SOLAR_DAY_HOUR_ANGLE_RATE 360.0     // Degrees of solar hour angle per day
+#define SOLAR_DAY_ITERATIONS 3              // Each pass gains about two digits
+
+CalendarResult solar_day_table_init(SolarDayTable* table, double first_jd, int date_count) {
+    if (!table) return CALENDAR_ERROR_NULL_POINTER;
+    if (date_count <= 0) return CALENDAR_ERROR_INVALID_DATE;
+    
+    // From 0h UT of the day before the first date to 0h UT two days after
+    // the last: local noon lies within half a day of 12h UT and every time of
+    // day within half a day of local noon
+    table->start_jd = floor(first_jd - 0.5) - 0.5;
+    table->day_count = date_count + 2;
+    table->right_ascension = malloc(sizeof(double) * (table->day_count + 1));
+    table->declination = malloc(sizeof(double) * (table->day_count + 1));
+    if (!table->right_ascension || !table->declination) {
+        solar_day_table_free(table);
+        return CALENDAR_ERROR_CONVERSION_FAILED;
+    }
+    
+    double offset = 0.0;
+    for (int i = 0; i <= table->day_count; i++) {
+        double ra;
+        solar_calculate_equatorial(table->start_jd + i, &ra, &table->declination[i]);
+        if (i > 0 && ra + offset < table->right_ascension[i - 1] - 12.0) offset += 24.0;
+        table->right_ascension[i] = ra + offset;
+    }
+    return CALENDAR_SUCCESS;
+}
+
+void solar_day_table_free(SolarDayTable* table) {
+    if (!table) return;
+    free(table->right_ascension);
+    free(table->declination);
+    table->right_ascension = NULL;
+    table->declination = NULL;
+    table->day_count = 0;
+}
+
+// Linear interpolation leaves under 0.001 degrees: the sun's motion in right
+// ascension and declination curves by at most 0.007 degrees/day^2
+void solar_day_sample(const SolarDayTable* table, double julian_day, double* ra, double* dec) {
+    double x = julian_day - table->start_jd;
+    int i = (int)floor(x);
+    if (i < 0) i = 0;
+    if (i > table->day_count - 1) i = table->day_count - 1;
+    double f = x - i;
+    
+    *ra = table->right_ascension[i] + f * (table->right_ascension[i + 1] - table->right_ascension[i]);
+    *dec = table->declination[i] + f * (table->declination[i + 1] - table->declination[i]);
+}
+
+// Local hour angle in degrees, reduced to [-180, 180)
+static double solar_day_hour_angle(double julian_day, double longitude, double ra) {
+    double H = fmod((solar_greenwich_sidereal_time(julian_day) - ra) * 15.0 + longitude, 360.0);
+    if (H < -180.0) H += 360.0;
+    if (H >= 180.0) H -= 360.0;
+    return H;
+}
+
+CalendarResult solar_day_compute(const SolarDayTable* table, double julian_day,
+                                 double latitude, double longitude, SolarDay* day) {
+    if (!table || !day) return CALENDAR_ERROR_NULL_POINTER;
+    
+    day->julian_day = julian_day;
+    day->latitude = latitude;
+    day->longitude = longitude;
+    
+    // Upper transit nearest local mean noon of the civil date
+    double t = floor(julian_day - 0.5) + 1.0 - longitude / 360.0;
+    if (t - table->start_jd < 0.0 || t - table->start_jd > table->day_count) return CALENDAR_ERROR_INVALID_DATE;
+    for (int iter = 0; iter < SOLAR_DAY_ITERATIONS; iter++) {
+        double ra, dec;
+        solar_day_sample(table, t, &ra, &dec);
+        t -= solar_day_hour_angle(t, longitude, ra) / SOLAR_DAY_HOUR_ANGLE_RATE;
+    }
+    day->transit_jd = t;
+    return CALENDAR_SUCCESS;
+}
+
+double solar_day_altitude_time(const SolarDayTable* table, const SolarDay* day,
+                               double altitude, int is_evening) {
+    if (!table || !day) return 0.0;
+    
+    double sin_phi = sin(day->latitude * SOLAR_DAY_DEG_TO_RAD);
+    double cos_phi = cos(day->latitude * SOLAR_DAY_DEG_TO_RAD);
+    double sin_h = sin(altitude * SOLAR_DAY_DEG_TO_RAD);
+    double sign = is_evening ? 1.0 : -1.0;
+    double t = day->transit_jd;
+    
+    for (int iter = 0; iter <= SOLAR_DAY_ITERATIONS; iter++) {
+        double ra, dec;
+        solar_day_sample(table, t, &ra, &dec);
+        double delta = dec * SOLAR_DAY_DEG_TO_RAD;
+        double cos_h0 = (sin_h - sin_phi * sin(delta)) / (cos_phi * cos(delta));
+        if (cos_h0 < -1.0 || cos_h0 > 1.0) return 0.0;
+        
+        double target = sign * acos(cos_h0) * SOLAR_DAY_RAD_TO_DEG;
+        t += (target - solar_day_hour_angle(t, day->longitude, ra)) / SOLAR_DAY_HOUR_ANGLE_RATE;
+    }
+    return t;
+}
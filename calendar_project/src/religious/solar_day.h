@@ -0,0 +1,43 @@
+// src/religious/solar_day.h
+#ifndef SOLAR_DAY_H
+#define SOLAR_DAY_H
+
+#include "../../include/calendar_types.h"
+
+#define SOLAR_DAY_SUNRISE_ALTITUDE -0.8333  // Refraction plus semidiameter, sea level
+
+// Sun right ascension and declination at 0h UT of consecutive days. Prayer
+// times and zmanim for any number of places interpolate these samples, so
+// the solar series run once per day rather than once per time per place.
+typedef struct {
+    double start_jd;            // 0h UT of the first sample
+    int day_count;              // Samples at start_jd + i for i <= day_count
+    double* right_ascension;    // Hours, unwrapped so consecutive samples are continuous
+    double* declination;        // Degrees
+} SolarDayTable;
+
+// One place on one civil date
+typedef struct {
+    double julian_day;          // Civil date (any instant within it)
+    double latitude;            // Degrees
+    double longitude;           // Degrees, east positive
+    double transit_jd;          // Solar noon, UT
+} SolarDay;
+
+// Table covering the civil dates containing first_jd .. first_jd + date_count - 1
+// everywhere on Earth, with a day of margin on each side
+CalendarResult solar_day_table_init(SolarDayTable* table, double first_jd, int date_count);
+void solar_day_table_free(SolarDayTable* table);
+
+// Interpolated apparent right ascension (hours) and declination at a UT instant
+void solar_day_sample(const SolarDayTable* table, double julian_day, double* ra, double* dec);
+
+CalendarResult solar_day_compute(const SolarDayTable* table, double julian_day,
+                                 double latitude, double longitude, SolarDay* day);
+
+// Morning or evening instant (UT) the sun's center reaches the altitude in
+// degrees; 0 when it does not reach it that day
+double solar_day_altitude_time(const SolarDayTable* table, const SolarDay* day,
+                               double altitude, int is_evening);
+
+#endif // SOLAR_DAY_H
@@ -0,0 +1,107 @@
+// src/religious/zmanim.c
+#include "zmanim.h"
+#include "../utils/date_utils.h"
+
+#define ZMANIM_ALOT_ANGLE 16.1          // 72 minutes before sunrise at the equinox in Jerusalem
+#define ZMANIM_MISHEYAKIR_ANGLE 11.5
+#define ZMANIM_TZEIT_ANGLE 8.5
+#define ZMANIM_CANDLE_LIGHTING_MINUTES 18.0
+
+ZmanimParameters zmanim_default_parameters(void) {
+    ZmanimParameters params;
+    params.alot_angle = ZMANIM_ALOT_ANGLE;
+    params.misheyakir_angle = ZMANIM_MISHEYAKIR_ANGLE;
+    params.tzeit_angle = ZMANIM_TZEIT_ANGLE;
+    params.candle_lighting_minutes = ZMANIM_CANDLE_LIGHTING_MINUTES;
+    return params;
+}
+
+// Start plus the given number of proportional hours; 0 if either end is missing
+static double zmanim_proportional(double start, double end, double hours) {
+    if (start == 0.0 || end == 0.0) return 0.0;
+    return start + (end - start) * hours / 12.0;
+}
+
+CalendarResult zmanim_calculate_for_day(const SolarDayTable* table, const SolarDay* day,
+                                        const ZmanimParameters* params, Zmanim* zmanim) {
+    if (!table || !day || !zmanim) return CALENDAR_ERROR_NULL_POINTER;
+    
+    ZmanimParameters defaults = zmanim_default_parameters();
+    if (!params) params = &defaults;
+    
+    memset(zmanim, 0, sizeof(*zmanim));
+    zmanim->julian_day = day->julian_day;
+    zmanim->alot_hashachar = solar_day_altitude_time(table, day, -params->alot_angle, 0);
+    zmanim->misheyakir = solar_day_altitude_time(table, day, -params->misheyakir_angle, 0);
+    zmanim->sunrise = solar_day_altitude_time(table, day, SOLAR_DAY_SUNRISE_ALTITUDE, 0);
+    zmanim->sunset = solar_day_altitude_time(table, day, SOLAR_DAY_SUNRISE_ALTITUDE, 1);
+    zmanim->tzeit = solar_day_altitude_time(table, day, -params->tzeit_angle, 1);
+    zmanim->chatzot = day->transit_jd;     // Within seconds of the sunrise-sunset midpoint
+    
+    // GRA day: sunrise to sunset
+    zmanim->sof_zman_shma_gra = zmanim_proportional(zmanim->sunrise, zmanim->sunset, 3.0);
+    zmanim->sof_zman_tfila_gra = zmanim_proportional(zmanim->sunrise, zmanim->sunset, 4.0);
+    zmanim->mincha_gedola = zmanim_proportional(zmanim->sunrise, zmanim->sunset, 6.5);
+    zmanim->mincha_ketana = zmanim_proportional(zmanim->sunrise, zmanim->sunset, 9.5);
+    zmanim->plag_hamincha = zmanim_proportional(zmanim->sunrise, zmanim->sunset, 10.75);
+    
+    // Magen Avraham day: alot to nightfall at the same depression
+    double mga_end = solar_day_altitude_time(table, day, -params->alot_angle, 1);
+    zmanim->sof_zman_shma_mga = zmanim_proportional(zmanim->alot_hashachar, mga_end, 3.0);
+    zmanim->sof_zman_tfila_mga = zmanim_proportional(zmanim->alot_hashachar, mga_end, 4.0);
+    
+    if (zmanim->sunset != 0.0) {
+        zmanim->candle_lighting = zmanim->sunset - params->candle_lighting_minutes / 1440.0;
+    }
+    return CALENDAR_SUCCESS;
+}
+
+CalendarResult zmanim_calculate(double julian_day, double latitude, double longitude,
+                                const ZmanimParameters* params, Zmanim* zmanim) {
+    if (!zmanim) return CALENDAR_ERROR_NULL_POINTER;
+    
+    SolarDayTable table;
+    SolarDay day;
+    CalendarResult result = solar_day_table_init(&table, julian_day, 1);
+    if (result != CALENDAR_SUCCESS) return result;
+    
+    result = solar_day_compute(&table, julian_day, latitude, longitude, &day);
+    if (result == CALENDAR_SUCCESS) result = zmanim_calculate_for_day(&table, &day, params, zmanim);
+    solar_day_table_free(&table);
+    return result;
+}
+
+Zmanim* zmanim_calculate_timetable(int year, const double* latitudes, const double* longitudes,
+                                   int place_count, const ZmanimParameters* params, int* day_count) {
+    if (!latitudes || !longitudes || !day_count || place_count <= 0) return NULL;
+    
+    // Dates at noon UT, so the civil date is unambiguous
+    double first_jd = (double)julian_day_from_date(1, 1, year);
+    int days = (int)(julian_day_from_date(1, 1, year + 1) - julian_day_from_date(1, 1, year));
+    *day_count = days;
+    
+    SolarDayTable table;
+    if (solar_day_table_init(&table, first_jd, days) != CALENDAR_SUCCESS) return NULL;
+    
+    Zmanim* timetable = malloc(sizeof(Zmanim) * (size_t)place_count * days);
+    if (!timetable) {
+        solar_day_table_free(&table);
+        return NULL;
+    }
+    
+    // Places only read the shared table, so they are independent
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 4)
+    #endif
+    for (int p = 0; p < place_count; p++) {
+        for (int d = 0; d < days; d++) {
+            SolarDay day;
+            Zmanim* zmanim = &timetable[(size_t)p * days + d];
+            solar_day_compute(&table, first_jd + d, latitudes[p], longitudes[p], &day);
+            zmanim_calculate_for_day(&table, &day, params, zmanim);
+        }
+    }
+    
+    solar_day_table_free(&table);
+    return timetable;
+}
@@ -0,0 +1,54 @@
+// src/religious/zmanim.h
+#ifndef ZMANIM_H
+#define ZMANIM_H
+
+#include "../../include/calendar_types.h"
+#include "solar_day.h"
+
+// Depression angles and offsets. Proportional hours (sha'ot zmaniyot) are a
+// twelfth of the day: sunrise to sunset for the GRA, alot hashachar to tzeit
+// at the same depression for the Magen Avraham.
+typedef struct {
+    double alot_angle;              // Degrees below the horizon, dawn
+    double misheyakir_angle;        // Earliest tallit and tefillin
+    double tzeit_angle;             // Nightfall, three small stars
+    double candle_lighting_minutes; // Before sunset
+} ZmanimParameters;
+
+// Times for one place and civil date, as UT Julian days; 0 when the sun does
+// not reach the defining altitude (high latitudes in summer)
+typedef struct {
+    double julian_day;              // Civil date
+    double alot_hashachar;
+    double misheyakir;
+    double sunrise;
+    double sof_zman_shma_mga;
+    double sof_zman_shma_gra;
+    double sof_zman_tfila_mga;
+    double sof_zman_tfila_gra;
+    double chatzot;
+    double mincha_gedola;
+    double mincha_ketana;
+    double plag_hamincha;
+    double sunset;
+    double candle_lighting;
+    double tzeit;
+} Zmanim;
+
+// 16.1, 11.5 and 8.5 degrees; candles 18 minutes before sunset
+ZmanimParameters zmanim_default_parameters(void);
+
+// One place and date (the civil date containing julian_day)
+CalendarResult zmanim_calculate(double julian_day, double latitude, double longitude,
+                                const ZmanimParameters* params, Zmanim* zmanim);
+
+// From a shared solar table, for callers that already hold one
+CalendarResult zmanim_calculate_for_day(const SolarDayTable* table, const SolarDay* day,
+                                        const ZmanimParameters* params, Zmanim* zmanim);
+
+// Every date of a Gregorian year for each place: result[place * *day_count + day].
+// One solar table serves all places; free() the result.
+Zmanim* zmanim_calculate_timetable(int year, const double* latitudes, const double* longitudes,
+                                   int place_count, const ZmanimParameters* params, int* day_count);
+
+#endif // ZMANIM_H
@@ -0,0 +1,123 @@
+// src/tools/ephemeris_build.c - Fit the sun/moon series into a Chebyshev ephemeris file
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../astronomy/ephemeris.h"
+#include "../utils/date_utils.h"
+
+#define VERIFY_SAMPLES 200000
+
+static double elapsed_seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double angle_difference(double a, double b) {
+    double d = fmod(a - b, 360.0);
+    if (d < -180.0) d += 360.0;
+    if (d >= 180.0) d -= 360.0;
+    return fabs(d);
+}
+
+// Compare the file against the series at pseudo-random instants
+static void verify_body(const Ephemeris* eph, EphemerisBody body, const char* name,
+                        double start_jd, double end_jd) {
+    double max_lon = 0.0, max_lat = 0.0, max_dist = 0.0;
+    unsigned int seed = 12345u;
+    volatile double sink = 0.0;
+    
+    double* jds = malloc(sizeof(double) * VERIFY_SAMPLES);
+    if (!jds) return;
+    for (int i = 0; i < VERIFY_SAMPLES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        jds[i] = start_jd + (end_jd - start_jd) * ((seed >> 8) / 16777216.0);
+    }
+    
+    // Time-ordered queries, as produced by day-by-day and event-search workloads
+    qsort(jds, VERIFY_SAMPLES, sizeof(double), compare_doubles);
+    
+    // Warm pass so the timing below measures lookups, not page faults
+    for (int i = 0; i < VERIFY_SAMPLES; i++) {
+        EphemerisPosition p;
+        ephemeris_evaluate(eph, body, jds[i], &p);
+        sink += p.longitude;
+    }
+    
+    clock_t start = clock();
+    for (int i = 0; i < VERIFY_SAMPLES; i++) {
+        EphemerisPosition p;
+        ephemeris_evaluate(eph, body, jds[i], &p);
+        sink += p.longitude;
+    }
+    double file_time = elapsed_seconds(start);
+    
+    start = clock();
+    for (int i = 0; i < VERIFY_SAMPLES; i++) {
+        EphemerisPosition p;
+        ephemeris_series_position(body, jds[i], &p);
+        sink += p.longitude;
+    }
+    double series_time = elapsed_seconds(start);
+    
+    for (int i = 0; i < VERIFY_SAMPLES; i++) {
+        EphemerisPosition fitted, series;
+        ephemeris_evaluate(eph, body, jds[i], &fitted);
+        ephemeris_series_position(body, jds[i], &series);
+        double dl = angle_difference(fitted.longitude, series.longitude);
+        double db = fabs(fitted.latitude - series.latitude);
+        double dr = fabs(fitted.distance - series.distance);
+        if (dl > max_lon) max_lon = dl;
+        if (db > max_lat) max_lat = db;
+        if (dr > max_dist) max_dist = dr;
+    }
+    free(jds);
+    
+    printf("%-5s max error: longitude %.4f\", latitude %.4f\", distance %.3g %s\n",
+           name, max_lon * 3600.0, max_lat * 3600.0, max_dist,
+           body == EPHEMERIS_BODY_SUN ? "AU" : "km");
+    printf("      lookup %.1f ns, series %.1f ns (%.1fx)\n",
+           file_time / VERIFY_SAMPLES * 1e9, series_time / VERIFY_SAMPLES * 1e9,
+           file_time > 0 ? series_time / file_time : 0.0);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <output.eph> <start_year> <end_year>\n", argv[0]);
+        return 1;
+    }
+    
+    int start_year = atoi(argv[2]);
+    int end_year = atoi(argv[3]);
+    if (end_year < start_year) {
+        fprintf(stderr, "End year must not precede start year\n");
+        return 1;
+    }
+    
+    double start_jd = julian_day_from_date(1, 1, start_year) - 0.5;
+    double end_jd = julian_day_from_date(1, 1, end_year + 1) - 0.5;
+    
+    printf("Fitting %d-%d into %s...\n", start_year, end_year, argv[1]);
+    clock_t start = clock();
+    if (ephemeris_build_file(argv[1], start_jd, end_jd) != CALENDAR_SUCCESS) {
+        fprintf(stderr, "Failed to write %s\n", argv[1]);
+        return 1;
+    }
+    printf("Built in %.2f s\n", elapsed_seconds(start));
+    
+    Ephemeris* eph = ephemeris_open(argv[1]);
+    if (!eph) {
+        fprintf(stderr, "Failed to map %s\n", argv[1]);
+        return 1;
+    }
+    printf("File size: %.2f MB\n", eph->mapping_size / (1024.0 * 1024.0));
+    
+    verify_body(eph, EPHEMERIS_BODY_SUN, "Sun", start_jd, end_jd);
+    verify_body(eph, EPHEMERIS_BODY_MOON, "Moon", start_jd, end_jd);
+    
+    ephemeris_close(eph);
+    return 0;
+}
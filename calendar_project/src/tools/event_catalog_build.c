@@ -0,0 +1,67 @@
+// src/tools/event_catalog_build.c - Precompute the astronomical event catalog file
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../astronomy/event_catalog.h"
+
+#define QUERY_SAMPLES 100000
+
+// Wall time: the generator runs on several threads
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <output.evc> <start_year> <end_year>\n", argv[0]);
+        return 1;
+    }
+    
+    int start_year = atoi(argv[2]);
+    int end_year = atoi(argv[3]);
+    if (end_year < start_year) {
+        fprintf(stderr, "End year must not precede start year\n");
+        return 1;
+    }
+    
+    printf("Generating %d-%d into %s...\n", start_year, end_year, argv[1]);
+    double start = wall_seconds();
+    if (event_catalog_build_file(argv[1], start_year, end_year, EVENT_CATALOG_ALL) != CALENDAR_SUCCESS) {
+        fprintf(stderr, "Failed to write %s\n", argv[1]);
+        return 1;
+    }
+    printf("Built in %.2f s\n", wall_seconds() - start);
+    
+    start = wall_seconds();
+    EventCatalog* catalog = event_catalog_open(argv[1]);
+    if (!catalog) {
+        fprintf(stderr, "Failed to map %s\n", argv[1]);
+        return 1;
+    }
+    printf("Opened in %.1f us: %zu events, %.2f MB (strings %.1f KB)\n",
+           (wall_seconds() - start) * 1e6, catalog->count, catalog->mapping_size / (1024.0 * 1024.0),
+           catalog->header->string_bytes / 1024.0);
+    
+    // Month-long windows at pseudo-random places in the span
+    double first_jd = catalog->count ? catalog->records[0].julian_day : 0.0;
+    double span = catalog->count ? catalog->records[catalog->count - 1].julian_day - first_jd : 0.0;
+    unsigned int seed = 12345u;
+    size_t found = 0;
+    start = wall_seconds();
+    for (int i = 0; i < QUERY_SAMPLES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        double from = first_jd + span * ((seed >> 8) / 16777216.0);
+        size_t first, count;
+        event_catalog_query(catalog, from, from + 30.0, &first, &count);
+        found += count;
+    }
+    double elapsed = wall_seconds() - start;
+    printf("Month queries: %.1f ns each, %.1f events on average\n",
+           elapsed / QUERY_SAMPLES * 1e9, (double)found / QUERY_SAMPLES);
+    
+    event_catalog_close(catalog);
+    return 0;
+}
@@ -0,0 +1,63 @@
+// src/tools/holiday_snapshot_build.c - Compile holiday sources into a binary snapshot
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../holidays/holiday_snapshot.h"
+
+#define QUERY_SAMPLES 100000
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <output.hds> <source.csv|source.hds>...\n", argv[0]);
+        return 1;
+    }
+    
+    double start = wall_seconds();
+    if (holiday_snapshot_compile(argv[1], (const char* const*)(argv + 2), argc - 2) != CALENDAR_SUCCESS) {
+        fprintf(stderr, "Failed to compile %s\n", argv[1]);
+        return 1;
+    }
+    printf("Compiled in %.2f ms\n", (wall_seconds() - start) * 1e3);
+    
+    start = wall_seconds();
+    HolidaySnapshot* snapshot = holiday_snapshot_open(argv[1]);
+    if (!snapshot) {
+        fprintf(stderr, "Failed to map %s\n", argv[1]);
+        return 1;
+    }
+    double opened = wall_seconds() - start;
+    if (holiday_snapshot_verify(snapshot) != CALENDAR_SUCCESS) {
+        fprintf(stderr, "Corrupt snapshot %s\n", argv[1]);
+        holiday_snapshot_close(snapshot);
+        return 1;
+    }
+    printf("Opened in %.1f us: %zu holidays, %zu countries, %.2f MB (strings %.1f KB)\n",
+           opened * 1e6, snapshot->count, snapshot->country_count,
+           snapshot->mapping_size / (1024.0 * 1024.0), snapshot->header->string_bytes / 1024.0);
+    
+    // Gregorian days at pseudo-random places in the year
+    unsigned int seed = 12345u;
+    long found = 0;
+    start = wall_seconds();
+    for (int i = 0; i < QUERY_SAMPLES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        Date date = {1 + (int)((seed >> 8) % 28), 1 + (int)((seed >> 16) % 12), 2024};
+        uint32_t matches[16];
+        int count = 0;
+        holiday_snapshot_find(snapshot, &date, CALENDAR_GREGORIAN, NULL, matches, 16, &count);
+        found += count;
+    }
+    double elapsed = wall_seconds() - start;
+    printf("Date lookups: %.1f ns each, %.1f holidays on average\n",
+           elapsed / QUERY_SAMPLES * 1e9, (double)found / QUERY_SAMPLES);
+    
+    holiday_snapshot_close(snapshot);
+    return 0;
+}
@@ -7,6 +7,7 @@
 #include "../astronomy/lunar_calc.h"
 #include "../holidays/holiday_db.h"
 #include "../export/calendar_export.h"
+#include <sys/stat.h>
 
 static void show_gregorian_menu(void);
 static void show_islamic_menu(void);
@@ -552,6 +553,31 @@ static void show_date_calculator_menu(void) {
     }
 }
 
+// Writes a small sample holiday file for the exporters when there is none
+static void ensure_holiday_file(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (file) {
+        fclose(file);
+        return;
+    }
+    
+    printf("Holiday database file not found: %s\n", filename);
+    printf("Creating sample holiday database...\n");
+    if (strchr(filename, '/')) mkdir("data", 0755);
+    file = fopen(filename, "w");
+    if (!file) return;
+    fprintf(file, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic,Weekday,Offset\n");
+    fprintf(file, "New Year's Day,Beginning of the year,0,0,1,1,US,1,-1,0\n");
+    fprintf(file, "Martin Luther King Jr Day,Civil Rights Leader Birthday,0,4,1,15,US,1,1,0\n");
+    fprintf(file, "Independence Day,US Independence Day,0,0,7,4,US,1,-1,0\n");
+    fprintf(file, "Christmas Day,Christian celebration,0,0,12,25,US,1,-1,0\n");
+    fprintf(file, "Chinese New Year,Lunar New Year,2,0,1,1,CN,1,-1,0\n");
+    fprintf(file, "Eid al-Fitr,End of Ramadan,1,0,10,1,SA,1,-1,0\n");
+    fprintf(file, "Rosh Hashanah,Jewish New Year,3,0,1,1,IL,1,-1,0\n");
+    fprintf(file, "Yom Kippur,Day of Atonement,3,0,1,10,IL,1,-1,0\n");
+    fclose(file);
+}
+
 static void show_export_menu(void) {
     printf("\n=== EXPORT CALENDARS ===\n");
     printf("1. Export current month to CSV\n");
@@ -578,6 +604,7 @@ static void show_export_menu(void) {
             options.include_moon_phases = 1;
             strcpy(options.country_code, "US");
             strcpy(options.filename, "current_month.csv");
+            ensure_holiday_file(HOLIDAY_DB_DEFAULT_FILE);
             
             CalendarResult result = export_calendar_month(&options, 
                                                         local_time->tm_mon + 1, 
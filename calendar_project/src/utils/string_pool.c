@@ -0,0 +1,146 @@
+// src/utils/string_pool.c
+#include "string_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define STRING_POOL_INITIAL_SLOTS 256
+
+struct StringPoolChunk {
+    StringPoolChunk* next;
+    size_t capacity;
+    size_t used;
+    size_t base;                    // Offset of bytes[0] in the flat image
+    char bytes[];
+};
+
+StringPool* string_pool_create(void) {
+    StringPool* pool = calloc(1, sizeof(StringPool));
+    if (!pool) return NULL;
+    pool->slots = calloc(STRING_POOL_INITIAL_SLOTS, sizeof(StringPoolSlot));
+    if (!pool->slots) {
+        free(pool);
+        return NULL;
+    }
+    pool->slot_count = STRING_POOL_INITIAL_SLOTS;
+    return pool;
+}
+
+void string_pool_destroy(StringPool* pool) {
+    if (!pool) return;
+    while (pool->chunks) {
+        StringPoolChunk* next = pool->chunks->next;
+        free(pool->chunks);
+        pool->chunks = next;
+    }
+    free(pool->slots);
+    free(pool);
+}
+
+#define STRING_POOL_MIX 0xFF51AFD7ED558CCDULL
+
+// Word-at-a-time multiply-xorshift hash; fields are short, so this beats a
+// byte loop by several times
+static uint64_t string_pool_hash(const char* text, size_t length) {
+    uint64_t h = (uint64_t)length * 0x9E3779B97F4A7C15ULL;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, text + i, 8);
+        h = (h ^ word) * STRING_POOL_MIX;
+        h ^= h >> 32;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, text + i, length - i);
+    h = (h ^ tail) * STRING_POOL_MIX;
+    
+    // Fold the high bits down: slots come from the low ones
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    return h ^ (h >> 33);
+}
+
+static int string_pool_grow_table(StringPool* pool) {
+    size_t slot_count = pool->slot_count * 2;
+    StringPoolSlot* slots = calloc(slot_count, sizeof(StringPoolSlot));
+    if (!slots) return 0;
+    
+    for (size_t i = 0; i < pool->slot_count; i++) {
+        if (!pool->slots[i].text) continue;
+        size_t slot = (size_t)pool->slots[i].hash & (slot_count - 1);
+        while (slots[slot].text) slot = (slot + 1) & (slot_count - 1);
+        slots[slot] = pool->slots[i];
+    }
+    free(pool->slots);
+    pool->slots = slots;
+    pool->slot_count = slot_count;
+    return 1;
+}
+
+// Space for size bytes; a string too long for a chunk gets a chunk of its own
+static char* string_pool_allocate(StringPool* pool, size_t size) {
+    StringPoolChunk* chunk = pool->chunks;
+    if (!chunk || chunk->used + size > chunk->capacity) {
+        size_t capacity = size > STRING_POOL_CHUNK_SIZE ? size : STRING_POOL_CHUNK_SIZE;
+        chunk = malloc(sizeof(StringPoolChunk) + capacity);
+        if (!chunk) return NULL;
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        chunk->base = pool->bytes;
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+    }
+    char* bytes = chunk->bytes + chunk->used;
+    chunk->used += size;
+    return bytes;
+}
+
+const char* string_pool_intern(StringPool* pool, const char* text) {
+    return text ? string_pool_intern_length(pool, text, strlen(text)) : NULL;
+}
+
+const char* string_pool_intern_length(StringPool* pool, const char* text, size_t length) {
+    if (!pool || !text || length >= UINT32_MAX) return NULL;
+    
+    if ((pool->count + 1) * 2 > pool->slot_count && !string_pool_grow_table(pool)) return NULL;
+    
+    uint64_t hash = string_pool_hash(text, length);
+    size_t mask = pool->slot_count - 1;
+    size_t slot = (size_t)hash & mask;
+    while (pool->slots[slot].text) {
+        const StringPoolSlot* entry = &pool->slots[slot];
+        if (entry->hash == (uint32_t)hash && entry->length == length && memcmp(entry->text, text, length) == 0) {
+            return pool->slots[slot].text;
+        }
+        slot = (slot + 1) & mask;
+    }
+    
+    char* copy = string_pool_allocate(pool, length + 1);
+    if (!copy) return NULL;
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    pool->slots[slot].text = copy;
+    pool->slots[slot].hash = (uint32_t)hash;
+    pool->slots[slot].length = (uint32_t)length;
+    pool->count++;
+    pool->bytes += length + 1;
+    return copy;
+}
+
+uint32_t string_pool_offset(const StringPool* pool, const char* text) {
+    if (!pool || !text) return UINT32_MAX;
+    for (const StringPoolChunk* chunk = pool->chunks; chunk; chunk = chunk->next) {
+        // Chunks hold whole strings, so the bytes in use bound the search
+        if (text >= chunk->bytes && text < chunk->bytes + chunk->used) {
+            size_t offset = chunk->base + (size_t)(text - chunk->bytes);
+            return offset < UINT32_MAX ? (uint32_t)offset : UINT32_MAX;
+        }
+    }
+    return UINT32_MAX;
+}
+
+void string_pool_flatten(const StringPool* pool, char* image) {
+    if (!pool || !image) return;
+    for (const StringPoolChunk* chunk = pool->chunks; chunk; chunk = chunk->next) {
+        memcpy(image + chunk->base, chunk->bytes, chunk->used);
+    }
+}
@@ -0,0 +1,44 @@
+// src/utils/string_pool.h
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Interned strings stored in an arena of fixed-size chunks: each distinct
+// string is kept once, and its address stays valid until the pool is destroyed.
+// Chunks laid end to end form the pool's flat image, which file writers store
+// as their string section.
+#define STRING_POOL_CHUNK_SIZE (256 * 1024)
+
+typedef struct StringPoolChunk StringPoolChunk;
+
+// 16 bytes, so that large tables stay cache-friendly
+typedef struct {
+    const char* text;
+    uint32_t hash;                  // Low bits of the full hash
+    uint32_t length;
+} StringPoolSlot;
+
+typedef struct {
+    StringPoolChunk* chunks;        // Newest first
+    StringPoolSlot* slots;          // Open addressing, kept under half full
+    size_t slot_count;              // Power of two
+    size_t count;                   // Distinct strings
+    size_t bytes;                   // Bytes stored, terminators included
+} StringPool;
+
+StringPool* string_pool_create(void);
+void string_pool_destroy(StringPool* pool);
+
+// The pool's copy of text, added on first use; NULL if out of memory.
+// The _length form takes text that need not be NUL-terminated.
+const char* string_pool_intern(StringPool* pool, const char* text);
+const char* string_pool_intern_length(StringPool* pool, const char* text, size_t length);
+
+// Offset of an interned string in the flat image (pool->bytes long);
+// UINT32_MAX for text the pool does not hold
+uint32_t string_pool_offset(const StringPool* pool, const char* text);
+void string_pool_flatten(const StringPool* pool, char* image);
+
+#endif // STRING_POOL_H
@@ -0,0 +1,821 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stddef.h>
+#include "../src/astronomy/lunar_calc.h"
+#include "../src/astronomy/ephemeris.h"
+#include "../src/astronomy/event_finder.h"
+#include "../src/astronomy/eclipse.h"
+#include "../src/astronomy/time_scale.h"
+#include "../src/astronomy/crescent.h"
+#include "../src/astronomy/lunar_rise_set.h"
+#include "../src/astronomy/lunar_apsides.h"
+#include "../src/astronomy/coordinates.h"
+#include "../src/astronomy/planetary_calc.h"
+#include "../src/astronomy/event_catalog.h"
+#include "../src/calendars/islamic.h"
+#include "../src/utils/date_utils.h"
+#include "../src/astronomy/solar_calc.h"
+
+void test_lunar_position(void);
+void test_lunar_position_batch(void);
+void test_lunar_precise_info(void);
+void test_chebyshev_ephemeris(void);
+void test_event_finder(void);
+void test_seasons_and_phases(void);
+void test_eclipses(void);
+void test_time_scales(void);
+void test_sunrise_sunset(void);
+void test_crescent_visibility(void);
+void test_moon_rise_set(void);
+void test_precision_tiers(void);
+void test_lunar_info_range(void);
+void test_lunar_apsides(void);
+void test_coordinate_pipeline(void);
+void test_planetary_positions(void);
+void test_event_catalog(void);
+
+void run_astronomy_tests(void) {
+    printf("Running Astronomy Tests...\n");
+    
+    test_lunar_position();
+    test_lunar_position_batch();
+    test_lunar_precise_info();
+    test_chebyshev_ephemeris();
+    test_event_finder();
+    test_seasons_and_phases();
+    test_eclipses();
+    test_time_scales();
+    test_sunrise_sunset();
+    test_crescent_visibility();
+    test_moon_rise_set();
+    test_precision_tiers();
+    test_lunar_info_range();
+    test_lunar_apsides();
+    test_coordinate_pipeline();
+    test_planetary_positions();
+    test_event_catalog();
+    
+    printf("✅ All astronomy tests passed!\n\n");
+}
+
+void test_lunar_position(void) {
+    printf("  Testing lunar position series...\n");
+    
+    // Meeus example 47.a: 1992 April 12, 0h TD
+    LunarPosition pos;
+    assert(lunar_calculate_position(2448724.5, &pos) == CALENDAR_SUCCESS);
+    assert(fabs(pos.longitude - 133.162655) < 0.0001);
+    assert(fabs(pos.latitude - (-3.229126)) < 0.0001);
+    assert(fabs(pos.distance_km - 368409.7) < 0.5);
+    
+    assert(lunar_calculate_position(2448724.5, NULL) == CALENDAR_ERROR_NULL_POINTER);
+    assert(fabs(lunar_moon_longitude(2448724.5) - pos.longitude) < 1e-9);
+    
+    printf("    ✓ Lunar position tests passed\n");
+}
+
+void test_lunar_position_batch(void) {
+    printf("  Testing batched lunar positions...\n");
+    
+    // Batch results must match the single-instant path across block boundaries
+    enum { COUNT = 100 };
+    double jds[COUNT];
+    LunarPosition batch[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        jds[i] = 2451545.0 + i * 0.37;
+    }
+    assert(lunar_calculate_position_batch(jds, COUNT, batch) == CALENDAR_SUCCESS);
+    
+    for (int i = 0; i < COUNT; i++) {
+        LunarPosition single;
+        lunar_calculate_position(jds[i], &single);
+        assert(fabs(batch[i].longitude - single.longitude) < 1e-9);
+        assert(fabs(batch[i].latitude - single.latitude) < 1e-9);
+        assert(fabs(batch[i].distance_km - single.distance_km) < 1e-6);
+    }
+    
+    printf("    ✓ Batched lunar position tests passed\n");
+}
+
+void test_lunar_precise_info(void) {
+    printf("  Testing precise lunar info...\n");
+    
+    // Meeus example 48.a: illuminated fraction 0.6786 on 1992 April 12, 0h TD
+    PreciseLunarInfo* info = lunar_calculate_precise(time_tt_to_ut(2448724.5));
+    assert(info != NULL);
+    assert(fabs(info->moon_illumination - 0.6786) < 0.002);
+    assert(fabs(info->moon_distance_km - 368409.7) < 0.5);
+    assert(info->phase == LUNAR_FIRST_QUARTER || info->phase == LUNAR_WAXING_GIBBOUS);
+    free(info);
+    
+    // New moon of 2000 January 6, 18:14 UT
+    info = lunar_calculate_precise(2451550.26);
+    assert(info != NULL);
+    assert(info->phase == LUNAR_NEW_MOON);
+    assert(info->moon_illumination < 0.01);
+    free(info);
+    
+    printf("    ✓ Precise lunar info tests passed\n");
+}
+
+void test_chebyshev_ephemeris(void) {
+    printf("  Testing Chebyshev ephemeris files...\n");
+    
+    const char* filename = "test_ephemeris.eph";
+    double start_jd = 2451544.5;  // 2000-01-01
+    double end_jd = 2451544.5 + 366.0;
+    assert(ephemeris_build_file(filename, start_jd, end_jd) == CALENDAR_SUCCESS);
+    
+    Ephemeris* eph = ephemeris_open(filename);
+    assert(eph != NULL);
+    
+    // The fit must reproduce the series well below its own accuracy
+    for (double jd = start_jd; jd < end_jd; jd += 0.77) {
+        EphemerisPosition fitted, series;
+        
+        assert(ephemeris_evaluate(eph, EPHEMERIS_BODY_SUN, jd, &fitted) == CALENDAR_SUCCESS);
+        ephemeris_series_position(EPHEMERIS_BODY_SUN, jd, &series);
+        assert(fabs(remainder(fitted.longitude - series.longitude, 360.0)) < 1e-5);
+        assert(fabs(fitted.distance - series.distance) < 1e-8);
+        
+        assert(ephemeris_evaluate(eph, EPHEMERIS_BODY_MOON, jd, &fitted) == CALENDAR_SUCCESS);
+        ephemeris_series_position(EPHEMERIS_BODY_MOON, jd, &series);
+        assert(fabs(remainder(fitted.longitude - series.longitude, 360.0)) < 1e-5);
+        assert(fabs(fitted.latitude - series.latitude) < 1e-5);
+        assert(fabs(fitted.distance - series.distance) < 0.01);
+    }
+    
+    EphemerisPosition pos;
+    assert(ephemeris_evaluate(eph, EPHEMERIS_BODY_MOON, start_jd - 1.0, &pos) == CALENDAR_ERROR_INVALID_DATE);
+    
+    ephemeris_close(eph);
+    remove(filename);
+    
+    // Files with the wrong magic are rejected
+    FILE* bogus = fopen(filename, "wb");
+    assert(bogus != NULL);
+    for (int i = 0; i < 64; i++) fputs("junk", bogus);
+    fclose(bogus);
+    assert(ephemeris_open(filename) == NULL);
+    remove(filename);
+    
+    // So are headers with empty tables, which evaluation would index past
+    for (int field = 0; field < 3; field++) {
+        assert(ephemeris_build_file(filename, start_jd, end_jd) == CALENDAR_SUCCESS);
+        FILE* patched = fopen(filename, "r+b");
+        assert(patched != NULL);
+        size_t offsets[] = { offsetof(EphemerisBodyHeader, components), offsetof(EphemerisBodyHeader, coefficients),
+                             offsetof(EphemerisBodyHeader, segment_count) };
+        uint32_t zero = 0;
+        fseek(patched, (long)(offsetof(EphemerisFileHeader, bodies) + offsets[field]), SEEK_SET);
+        fwrite(&zero, sizeof(zero), 1, patched);
+        fclose(patched);
+        assert(ephemeris_open(filename) == NULL);
+        remove(filename);
+    }
+    
+    printf("    ✓ Chebyshev ephemeris tests passed\n");
+}
+
+static double test_sine_event(double julian_day, void* context) {
+    (void)context;
+    return sin(julian_day);
+}
+
+static double test_elongation_event(double julian_day, void* context) {
+    (void)context;
+    return lunar_elongation(julian_day);
+}
+
+void test_event_finder(void) {
+    printf("  Testing event finder...\n");
+    
+    // Scalar crossings of sin(t) = 0.5 in [0, 20]
+    EventSearchSpec spec = {0};
+    spec.function = test_sine_event;
+    spec.kind = EVENT_VALUE_SCALAR;
+    spec.target = 0.5;
+    spec.step_days = 0.5;
+    spec.tolerance_days = 1e-10;
+    
+    EventSearch search;
+    EventCrossing crossing;
+    event_search_init(&search, &spec, 0.0, 20.0);
+    int count = 0;
+    while (event_search_next(&search, &crossing)) {
+        assert(fabs(sin(crossing.julian_day) - 0.5) < 1e-9);
+        assert(crossing.direction == (cos(crossing.julian_day) > 0 ? 1 : -1));
+        count++;
+    }
+    assert(count == 7);
+    
+    // Rate-bounded angle search: a century of new moons costs evaluations
+    // per lunation, not per day
+    EventSearchSpec moon = {0};
+    moon.function = test_elongation_event;
+    moon.kind = EVENT_VALUE_ANGLE;
+    moon.target = 0.0;
+    moon.tolerance_days = 1.0 / 86400.0;
+    moon.min_rate = 10.0;
+    moon.max_rate = 16.0;
+    
+    event_search_init(&search, &moon, 2415020.5, 2415020.5 + 36525.0);
+    count = 0;
+    double previous = 0.0;
+    while (event_search_next(&search, &crossing)) {
+        if (count > 0) {
+            double gap = crossing.julian_day - previous;
+            assert(gap > 29.2 && gap < 29.9);
+        }
+        previous = crossing.julian_day;
+        count++;
+    }
+    assert(count >= 1236 && count <= 1237);
+    assert(search.evaluations < 15L * count);
+    
+    printf("    ✓ Event finder tests passed\n");
+}
+
+void test_seasons_and_phases(void) {
+    printf("  Testing seasons and lunar phases...\n");
+    
+    // 2024 seasons (UT): Mar 20 03:06, Jun 20 20:51, Sep 22 12:44, Dec 21 09:20
+    SeasonalEvents* seasons = solar_calculate_seasons(2024);
+    assert(seasons != NULL);
+    assert(fabs(seasons->spring_equinox_jd - 2460389.6292) < 0.003);
+    assert(fabs(seasons->summer_solstice_jd - 2460482.3688) < 0.003);
+    assert(fabs(seasons->autumn_equinox_jd - 2460576.0306) < 0.003);
+    assert(fabs(seasons->winter_solstice_jd - 2460665.8889) < 0.003);
+    solar_destroy_seasons(seasons);
+    
+    // Meeus example 49.a: new moon 1977 February 18, 3h37m42s TD
+    double new_moon = lunar_find_next_phase(2443180.0, 0.0);
+    assert(fabs(new_moon - 2443192.65118) < 0.002);
+    assert(fabs(lunar_calculate_new_moon_precise(2443193.0) - new_moon) < 1e-4);
+    
+    // Full moon of 2024 January 25, 17:54 UT
+    double full_moon = lunar_find_next_phase(2460320.5, 180.0);
+    assert(fabs(full_moon - 2460335.2458) < 0.003);
+    
+    printf("    ✓ Season and lunar phase tests passed\n");
+}
+
+void test_eclipses(void) {
+    printf("  Testing eclipse prediction...\n");
+    
+    // Meeus example 54.a: partial solar eclipse of 1993 May 21
+    EclipseInfo info;
+    assert(eclipse_find_next(ECLIPSE_SOLAR, 2449100.5, &info) == CALENDAR_SUCCESS);
+    assert(fabs(info.greatest_jd - 2449129.0979) < 0.001);
+    assert(info.type == ECLIPSE_TYPE_PARTIAL);
+    assert(fabs(info.gamma - 1.1348) < 0.001);
+    assert(fabs(info.magnitude - 0.740) < 0.002);
+    
+    // Meeus example 54.b: penumbral lunar eclipse of 1973 June 15
+    assert(eclipse_find_next(ECLIPSE_LUNAR, 2441830.5, &info) == CALENDAR_SUCCESS);
+    assert(info.type == ECLIPSE_TYPE_PENUMBRAL);
+    assert(fabs(info.penumbral_magnitude - 0.4625) < 0.001);
+    
+    // Total solar eclipse of 2017 August 21: greatest near Hopkinsville, Kentucky
+    SolarEclipse* eclipse = solar_predict_next_eclipse(2457980.5);
+    assert(eclipse != NULL);
+    assert(eclipse->eclipse_type == ECLIPSE_TYPE_TOTAL);
+    assert(fabs(eclipse->max_eclipse_jd - 2457987.2677) < 0.003);
+    assert(fabs(eclipse->magnitude - 1.0306) < 0.002);
+    solar_destroy_eclipse(eclipse);
+    
+    assert(eclipse_find_next(ECLIPSE_SOLAR, 2457980.5, &info) == CALENDAR_SUCCESS);
+    assert(fabs(info.latitude_center - 37.0) < 1.0);
+    assert(fabs(info.longitude_center + 87.7) < 1.0);
+    assert(solar_is_eclipse_visible(2457987.2674, 36.87, -87.49));
+    assert(!solar_is_eclipse_visible(2457987.2674, 48.85, 2.35));
+    
+    // 2023: hybrid (April 20) and annular (October 14) solar, total lunar on 2022 November 8
+    assert(eclipse_find_next(ECLIPSE_SOLAR, 2460000.5, &info) == CALENDAR_SUCCESS);
+    assert(info.type == ECLIPSE_TYPE_HYBRID);
+    assert(eclipse_find_next(ECLIPSE_SOLAR, 2460225.5, &info) == CALENDAR_SUCCESS);
+    assert(info.type == ECLIPSE_TYPE_ANNULAR && info.magnitude < 1.0);
+    assert(eclipse_find_next(ECLIPSE_LUNAR, 2459880.5, &info) == CALENDAR_SUCCESS);
+    assert(info.type == ECLIPSE_TYPE_TOTAL);
+    assert(fabs(info.magnitude - 1.359) < 0.005);
+    assert(info.total_minutes > 80.0 && info.total_minutes < 90.0);
+    
+    // Catalog: NASA's Five Millennium Canon lists 224 solar and 228 lunar
+    // eclipses for 2001-2100; Meeus ch. 54 misses grazing penumbral ones
+    int count = 0;
+    AstronomicalEvent* events = eclipse_generate_catalog(2451910.5, 2488434.5, &count);
+    assert(events != NULL);
+    int solar = 0;
+    for (int i = 0; i < count; i++) {
+        if (i > 0) assert(events[i].julian_day > events[i - 1].julian_day);
+        if (events[i].type == ASTRO_EVENT_ECLIPSE_SOLAR) solar++;
+    }
+    assert(abs(solar - 224) <= 2);
+    assert(abs(count - solar - 228) <= 2);
+    eclipse_destroy_catalog(events);
+    
+    printf("    ✓ Eclipse prediction tests passed\n");
+}
+
+void test_time_scales(void) {
+    printf("  Testing time scales...\n");
+    
+    // Delta-T: observed modern values and the historical fits
+    assert(fabs(time_delta_t_for_year(2000.0) - 63.83) < 0.05);
+    assert(fabs(time_delta_t_for_year(2020.0) - 69.36) < 0.05);
+    assert(fabs(time_delta_t_for_year(1900.0) + 2.79) < 0.05);
+    assert(fabs(time_delta_t_for_year(1000.0) - 1574.2) < 1.0);
+    assert(fabs(time_delta_t_for_year(-500.0) - 17190.0) < 50.0);
+    assert(time_delta_t_for_year(3000.0) > 4000.0);
+    
+    // Cached per-day value matches the table
+    double jd = 2460000.5;
+    assert(fabs(time_delta_t(jd + 0.3) - time_delta_t(jd)) < 1e-9);
+    assert(fabs((time_ut_to_tt(jd) - jd) * 86400.0 - time_delta_t(jd)) < 1e-3);
+    assert(fabs(time_tt_to_ut(time_ut_to_tt(jd)) - jd) < 1e-8);
+    
+    // Leap seconds: TAI - UTC = 37 s since 2017, TT - UTC = 69.184 s
+    assert(time_tai_minus_utc(2460000.5) == 37.0);
+    assert(time_tai_minus_utc(2441317.5) == 10.0);   // 1972 January 1
+    assert(time_tai_minus_utc(2441499.4) == 10.0);   // 1972 June 30
+    double tt = time_scale_convert(jd, TIME_SCALE_UTC, TIME_SCALE_TT);
+    assert(fabs((tt - jd) * 86400.0 - 69.184) < 1e-4);
+    assert(fabs(time_scale_convert(tt, TIME_SCALE_TT, TIME_SCALE_UTC) - jd) < 1e-9);
+    
+    // UT1 stays within a second of UTC while leap seconds are maintained
+    double ut1 = time_scale_convert(jd, TIME_SCALE_UTC, TIME_SCALE_UT1);
+    assert(fabs(ut1 - jd) * 86400.0 < 0.9);
+    
+    printf("    ✓ Time scale tests passed\n");
+}
+
+void test_sunrise_sunset(void) {
+    printf("  Testing sunrise and sunset...\n");
+    
+    // Boston, 2024 June 20: sunrise 09:07 UT, sunset 00:25 UT the next day
+    SunriseSunset* ss = solar_calculate_sunrise_sunset(2460481.5, 42.36, -71.06);
+    assert(ss != NULL);
+    assert(fabs(ss->sunrise_jd - 2460481.8799) < 0.001);
+    assert(fabs(ss->sunset_jd - 2460482.5174) < 0.001);
+    assert(ss->solar_noon_jd > ss->sunrise_jd && ss->solar_noon_jd < ss->sunset_jd);
+    assert(fabs(ss->day_length - 15.28) < 0.05);
+    assert(ss->sunrise_azimuth < 90.0 && ss->sunset_azimuth > 270.0);
+    solar_destroy_sunrise_sunset(ss);
+    
+    // Svalbard: midnight sun in June, polar night in December
+    ss = solar_calculate_sunrise_sunset(2460481.5, 78.0, 15.0);
+    assert(ss->sunrise_jd == 0.0 && ss->day_length == 24.0);
+    solar_destroy_sunrise_sunset(ss);
+    ss = solar_calculate_sunrise_sunset(2460300.5, 78.0, 15.0);
+    assert(ss->sunset_jd == 0.0 && ss->day_length == 0.0);
+    solar_destroy_sunrise_sunset(ss);
+    
+    printf("    ✓ Sunrise and sunset tests passed\n");
+}
+
+void test_crescent_visibility(void) {
+    printf("  Testing crescent visibility...\n");
+    
+    // Ramadan 1445: conjunction 2024 March 10, 09:00 UT
+    double conjunction = lunar_find_next_phase(2460370.5, 0.0);
+    assert(fabs(conjunction - 2460379.876) < 0.002);
+    
+    // Mecca: not visible on March 10 (moon 6.6 hours old), easily visible on March 11
+    CrescentObservation obs;
+    assert(crescent_evaluate(2460379.5, 21.4225, 39.8262, CRESCENT_CRITERION_YALLOP, &obs) == CALENDAR_SUCCESS);
+    assert(obs.visibility == CRESCENT_NOT_VISIBLE);
+    assert(obs.moon_age_hours > 6.0 && obs.moon_age_hours < 7.5);
+    assert(obs.lag_minutes > 5.0 && obs.lag_minutes < 20.0);
+    assert(crescent_evaluate(2460380.5, 21.4225, 39.8262, CRESCENT_CRITERION_ODEH, &obs) == CALENDAR_SUCCESS);
+    assert(obs.visibility == CRESCENT_EASILY_VISIBLE);
+    
+    // Los Angeles on March 10: a borderline sighting, better than Mecca
+    CrescentObservation west;
+    crescent_evaluate(2460379.5, 34.05, -118.25, CRESCENT_CRITERION_YALLOP, &west);
+    assert(west.visibility == CRESCENT_OPTICAL_AID_HELPS);
+    
+    // Grid evaluation agrees with single-location evaluation
+    CrescentMap* map = crescent_map_create(conjunction, -60.0, 60.0, -180.0, 180.0, 2.0, CRESCENT_CRITERION_YALLOP);
+    assert(map != NULL);
+    assert(map->rows == 61 && map->cols == 181);
+    crescent_evaluate(2460379.5, 34.0, -118.0, CRESCENT_CRITERION_YALLOP, &obs);
+    assert(crescent_map_visibility(map, 0, 34.0, -118.0) == obs.visibility);
+    assert(crescent_map_visibility(map, 0, 21.4225, 39.8262) >= CRESCENT_NOT_VISIBLE);
+    
+    // Month starts the day after the first sighting: March 12 in both places
+    long march_12 = julian_day_from_date(12, 3, 2024);
+    assert(crescent_map_month_start(map, 21.4225, 39.8262, CRESCENT_DEFAULT_THRESHOLD) == march_12);
+    assert(crescent_map_month_start(map, 34.05, -118.25, CRESCENT_DEFAULT_THRESHOLD) == march_12);
+    assert(crescent_map_month_start(map, 34.05, -118.25, CRESCENT_OPTICAL_AID_HELPS) == march_12 - 1);
+    crescent_map_destroy(map);
+    
+    // Location-dependent Islamic date
+    GregorianDate greg = {{12, 3, 2024}, 0, 0};
+    IslamicDate islamic;
+    assert(islamic_from_gregorian_precise(&greg, &islamic, 39.8262, 21.4225) == CALENDAR_SUCCESS);
+    assert(islamic.base.day == 1 && islamic.base.month == 9 && islamic.base.year == 1445);
+    // Sha'ban began on February 12: the conjunction was at 23h UT on February
+    // 9, too late for the crescent to reach class B at Mecca the next evening.
+    // The eve of Ramadan is therefore the 29th.
+    greg.base.day = 11;
+    assert(islamic_from_gregorian_precise(&greg, &islamic, 39.8262, 21.4225) == CALENDAR_SUCCESS);
+    assert(islamic.base.day == 29 && islamic.base.month == 8);
+    
+    printf("    ✓ Crescent visibility tests passed\n");
+}
+
+void test_moon_rise_set(void) {
+    printf("  Testing moonrise and moonset...\n");
+    
+    // Boston, 2024 January 1 (EST): waning gibbous, transit before dawn, set mid-morning, rise late evening
+    LunarRiseSet day;
+    assert(lunar_calculate_rise_set(2460310.5, 42.36, -71.06, -5.0, &day) == CALENDAR_SUCCESS);
+    assert(day.julian_day_number == 2460311);
+    assert(day.transit_jd < day.moonset_jd && day.moonset_jd < day.moonrise_jd);
+    assert(fabs(day.moonset_jd - 2460311.1523) < 0.002);
+    assert(fabs(day.moonrise_jd - 2460311.6250) < 0.002);
+    assert(day.transit_altitude > 50.0 && day.transit_altitude < 65.0);
+    assert(day.rise_azimuth < 180.0 && day.set_azimuth > 180.0);
+    
+    // A year in one pass: one rise per ~24h50m, and the same answers as day-by-day calls
+    LunarRiseSet* year = malloc(366 * sizeof(LunarRiseSet));
+    assert(year != NULL);
+    assert(lunar_calculate_rise_set_range(2460310.5, 366, 42.36, -71.06, -5.0, year) == CALENDAR_SUCCESS);
+    int rises = 0, sets = 0;
+    for (int i = 0; i < 366; i++) {
+        rises += year[i].moonrise_jd != 0.0;
+        sets += year[i].moonset_jd != 0.0;
+        assert(year[i].julian_day_number == 2460311 + i);
+    }
+    assert(rises >= 350 && rises <= 356 && sets >= 350 && sets <= 356);
+    for (int i = 0; i < 366; i += 61) {
+        lunar_calculate_rise_set(2460310.5 + i, 42.36, -71.06, -5.0, &day);
+        assert(fabs(day.moonrise_jd - year[i].moonrise_jd) < 1e-6);
+        assert(fabs(day.moonset_jd - year[i].moonset_jd) < 1e-6);
+        assert(fabs(day.transit_jd - year[i].transit_jd) < 1e-6);
+    }
+    
+    // Tromsø: the moon stays up or down for days around the lunar standstill
+    assert(lunar_calculate_rise_set_range(2460310.5, 366, 69.65, 18.96, 1.0, year) == CALENDAR_SUCCESS);
+    rises = 0;
+    for (int i = 0; i < 366; i++) rises += year[i].moonrise_jd != 0.0;
+    assert(rises > 150 && rises < 250);
+    free(year);
+    
+    printf("    ✓ Moonrise and moonset tests passed\n");
+}
+
+void test_precision_tiers(void) {
+    printf("  Testing lunar precision tiers...\n");
+    
+    // Every tier stays within its documented bound of the precise phase angle, 1900-2100
+    enum { SAMPLES = 2000 };
+    double* jds = malloc(SAMPLES * sizeof(double));
+    double* fast = malloc(SAMPLES * sizeof(double));
+    double* standard = malloc(SAMPLES * sizeof(double));
+    double* precise = malloc(SAMPLES * sizeof(double));
+    assert(jds && fast && standard && precise);
+    for (int i = 0; i < SAMPLES; i++) jds[i] = 2415020.5 + i * 36.5247;
+    assert(lunar_phase_angle_batch(jds, SAMPLES, LUNAR_PRECISION_FAST, fast) == CALENDAR_SUCCESS);
+    assert(lunar_phase_angle_batch(jds, SAMPLES, LUNAR_PRECISION_STANDARD, standard) == CALENDAR_SUCCESS);
+    assert(lunar_phase_angle_batch(jds, SAMPLES, LUNAR_PRECISION_PRECISE, precise) == CALENDAR_SUCCESS);
+    for (int i = 0; i < SAMPLES; i++) {
+        double fast_error = fabs(remainder(fast[i] - precise[i], 360.0));
+        double standard_error = fabs(remainder(standard[i] - precise[i], 360.0));
+        assert(fast_error <= LUNAR_FAST_MAX_ERROR_DEG);
+        assert(standard_error <= LUNAR_STANDARD_MAX_ERROR_DEG);
+        if (i % 97 == 0) {
+            assert(fabs(precise[i] - lunar_phase_angle(jds[i], LUNAR_PRECISION_PRECISE)) < 1e-9);
+            assert(fabs(standard[i] - lunar_phase_angle(jds[i], LUNAR_PRECISION_STANDARD)) < 1e-9);
+        }
+    }
+    free(jds);
+    free(fast);
+    free(standard);
+    free(precise);
+    
+    // New moon of 2024 January 11, 11:57 UT
+    PreciseLunarInfo info;
+    assert(lunar_calculate_info(2460320.998, LUNAR_PRECISION_FAST, &info) == CALENDAR_SUCCESS);
+    assert(info.phase == LUNAR_NEW_MOON && info.moon_illumination < 0.001);
+    PreciseLunarInfo* legacy = lunar_calculate_precise(2460320.998);
+    assert(legacy != NULL);
+    assert(lunar_calculate_info(2460320.998, LUNAR_PRECISION_PRECISE, &info) == CALENDAR_SUCCESS);
+    assert(info.moon_phase_angle == legacy->moon_phase_angle);
+    assert(fabs(remainder(info.moon_phase_angle, 360.0)) < 0.01);
+    free(legacy);
+    
+    // Legacy age functions share the default tier, which can be changed per thread
+    assert(lunar_get_default_precision() == LUNAR_PRECISION_STANDARD);
+    long jdn = 2460330;
+    assert(lunar_calculate_moon_age(jdn) == lunar_moon_age(jdn, LUNAR_PRECISION_STANDARD));
+    assert(lunar_calculate_age(jdn) == lunar_calculate_moon_age(jdn));
+    lunar_set_default_precision(LUNAR_PRECISION_FAST);
+    assert(lunar_calculate_moon_age(jdn) == lunar_moon_age(jdn, LUNAR_PRECISION_FAST));
+    lunar_set_default_precision(LUNAR_PRECISION_STANDARD);
+    
+    printf("    ✓ Lunar precision tier tests passed\n");
+}
+
+void test_lunar_info_range(void) {
+    printf("  Testing incremental lunar phase series...\n");
+    
+    // Daily and weekly runs match the per-call precise tier across several blocks
+    enum { DAYS = 1500 };
+    const double steps[] = { 1.0, 7.0 };
+    PreciseLunarInfo* range = malloc(DAYS * sizeof(PreciseLunarInfo));
+    assert(range != NULL);
+    for (int s = 0; s < 2; s++) {
+        double start = 2451179.5 + s * 3652.25;
+        assert(lunar_calculate_info_range(start, steps[s], DAYS, range) == CALENDAR_SUCCESS);
+        for (int i = 0; i < DAYS; i += 7) {
+            PreciseLunarInfo info;
+            assert(lunar_calculate_info(start + i * steps[s], LUNAR_PRECISION_PRECISE, &info) == CALENDAR_SUCCESS);
+            assert(range[i].julian_day == info.julian_day);
+            assert(fabs(remainder(range[i].moon_phase_angle - info.moon_phase_angle, 360.0)) <= LUNAR_RANGE_MAX_ERROR_DEG);
+            assert(fabs(range[i].moon_illumination - info.moon_illumination) < 1e-6);
+            assert(fabs(range[i].moon_distance_km - info.moon_distance_km) < 0.05);
+        }
+    }
+    free(range);
+    
+    PreciseLunarInfo one;
+    assert(lunar_calculate_info_range(2460320.998, 1.0, 1, &one) == CALENDAR_SUCCESS);
+    assert(one.phase == LUNAR_NEW_MOON);
+    assert(lunar_calculate_info_range(2460320.5, 1.0, 0, &one) == CALENDAR_SUCCESS);
+    assert(lunar_calculate_info_range(2460320.5, 0.0, 1, &one) == CALENDAR_ERROR_INVALID_DATE);
+    assert(lunar_calculate_info_range(2460320.5, 1.0, -1, &one) == CALENDAR_ERROR_INVALID_DATE);
+    assert(lunar_calculate_info_range(2460320.5, 1.0, 1, NULL) == CALENDAR_ERROR_NULL_POINTER);
+    
+    printf("    ✓ Incremental lunar phase series tests passed\n");
+}
+
+void test_lunar_apsides(void) {
+    printf("  Testing lunar apsides and supermoons...\n");
+    
+    // Meeus example 50.a: apogee of 1988 October 7
+    LunarApsis apsis;
+    assert(lunar_apsis_evaluate(-148.5, &apsis) == CALENDAR_SUCCESS);
+    assert(apsis.is_apogee);
+    assert(fabs(apsis.julian_day - 2447442.3543) < 0.0001);
+    assert(fabs(apsis.parallax_arcsec - 3240.679) < 0.001);
+    
+    // Apsides are extrema of the series distance to within the table's accuracy
+    assert(lunar_apsis_find_next(0, 2460300.0, &apsis) == CALENDAR_SUCCESS);
+    assert(!apsis.is_apogee && apsis.julian_day > 2460300.0 && apsis.julian_day < 2460330.0);
+    LunarPosition before, at, after;
+    lunar_calculate_position(apsis.julian_day - 0.05, &before);
+    lunar_calculate_position(apsis.julian_day, &at);
+    lunar_calculate_position(apsis.julian_day + 0.05, &after);
+    assert(fabs(at.distance_km - apsis.distance_km) < 15.0);
+    assert(at.distance_km < before.distance_km + 1.0 && at.distance_km < after.distance_km + 1.0);
+    
+    int count = 0;
+    LunarApsis* apsides = lunar_apsides_in_range(2451545.0, 2451545.0 + 365.25, &count);
+    assert(apsides != NULL && count >= 26 && count <= 28);
+    for (int i = 1; i < count; i++) {
+        assert(apsides[i].is_apogee != apsides[i - 1].is_apogee);
+        assert(apsides[i].julian_day > apsides[i - 1].julian_day);
+    }
+    free(apsides);
+    
+    // 2023: micromoons in January and February, the supermoon of 31 August is also
+    // a calendar blue moon; 19 August 2024 is a seasonal blue moon
+    LunarFullMoon* moons = lunar_full_moons_for_years(2023, 2024, &count);
+    assert(moons != NULL && count == 25);
+    int blue_calendar = 0, blue_seasonal = 0;
+    for (int i = 0; i < count; i++) {
+        int day, month, year;
+        julian_day_to_date((long)floor(time_tt_to_ut(moons[i].julian_day) + 0.5), &day, &month, &year);
+        if (year == 2023 && month == 8 && day == 31) {
+            assert(moons[i].is_supermoon && moons[i].is_blue_calendar);
+        }
+        if (year == 2024 && month == 8 && day == 19) assert(moons[i].is_blue_seasonal);
+        if (year == 2023 && month <= 2) assert(moons[i].is_micromoon);
+        assert(!(moons[i].is_supermoon && moons[i].is_micromoon));
+        blue_calendar += moons[i].is_blue_calendar;
+        blue_seasonal += moons[i].is_blue_seasonal;
+    }
+    assert(blue_calendar == 1 && blue_seasonal == 1);
+    free(moons);
+    
+    AstronomicalEvent* events = lunar_apsides_generate_catalog(2023, 2024, 1, &count);
+    assert(events != NULL && count > 50);
+    int supermoons = 0;
+    for (int i = 0; i < count; i++) {
+        if (i > 0) assert(events[i].julian_day >= events[i - 1].julian_day);
+        if (events[i].type == ASTRO_EVENT_SUPERMOON) supermoons++;
+    }
+    assert(supermoons >= 4);
+    lunar_apsides_destroy_catalog(events);
+    
+    printf("    ✓ Lunar apsides and supermoon tests passed\n");
+}
+
+void test_coordinate_pipeline(void) {
+    printf("  Testing batched coordinate transforms...\n");
+    
+    // Meeus example 21.b: theta Persei (J2000 place plus proper motion) on 2028
+    // November 13.19 TD. Meeus gives the mean place; the true place adds nutation
+    // of 16.1" in right ascension and 6.2" in declination.
+    const double d2r = M_PI / 180.0, eps0 = 23.4392911 * d2r;
+    double alpha = 41.0540615 * d2r, delta = 49.2277493 * d2r;
+    double lambda = atan2(sin(alpha) * cos(eps0) + tan(delta) * sin(eps0), cos(alpha)) / d2r;
+    double beta = asin(sin(delta) * cos(eps0) - cos(delta) * sin(eps0) * sin(alpha)) / d2r;
+    CoordEpoch epoch;
+    coord_epoch_init(2462088.69, &epoch);
+    double ra, dec;
+    assert(coord_ecliptic_to_equatorial_batch(&epoch, COORD_ECLIPTIC_J2000, &lambda, &beta, 1, &ra, &dec) == CALENDAR_SUCCESS);
+    assert(fabs((ra * 15.0 - 41.547213) * 3600.0 - 16.1) < 0.5);
+    assert(fabs((dec - 49.348483) * 3600.0 - 6.2) < 0.5);
+    
+    // The epoch cache hands back the same rotations until the instant changes
+    const CoordEpoch* cached = coord_epoch_get(2462088.69);
+    assert(cached == coord_epoch_get(2462088.69));
+    assert(memcmp(cached->from_j2000, epoch.from_j2000, sizeof(epoch.from_j2000)) == 0);
+    
+    // Batches agree with the single-point transforms (which omit nutation)
+    enum { BODIES = 300 };
+    double lon[BODIES], lat[BODIES], ras[BODIES], decs[BODIES], az[BODIES], alt[BODIES];
+    for (int i = 0; i < BODIES; i++) {
+        lon[i] = i * 1.2;
+        lat[i] = (i % 170) - 85.0;
+    }
+    coord_epoch_init(2451545.0, &epoch);
+    assert(coord_ecliptic_to_equatorial_batch(&epoch, COORD_ECLIPTIC_OF_DATE, lon, lat, BODIES, ras, decs) == CALENDAR_SUCCESS);
+    assert(coord_equatorial_to_horizontal_batch(7.25, 40.0, ras, decs, BODIES, az, alt) == CALENDAR_SUCCESS);
+    for (int i = 0; i < BODIES; i++) {
+        double ra1, dec1, az1, alt1;
+        solar_ecliptic_to_equatorial(lon[i], lat[i], &ra1, &dec1);
+        assert(fabs(dec1 - decs[i]) < 0.01);
+        solar_equatorial_to_horizontal(ras[i], decs[i], 40.0, 7.25, &az1, &alt1);
+        assert(fabs(alt1 - alt[i]) < 1e-9);
+        assert(fabs(remainder(az1 - az[i], 360.0)) < 1e-7 || fabs(alt1) > 89.999);
+    }
+    
+    // The combined ecliptic-to-horizon matrix matches the two-step pipeline
+    double az2[BODIES], alt2[BODIES];
+    assert(coord_ecliptic_to_horizontal_batch(&epoch, COORD_ECLIPTIC_OF_DATE, 7.25, 40.0, lon, lat, BODIES, az2, alt2) == CALENDAR_SUCCESS);
+    for (int i = 0; i < BODIES; i++) assert(fabs(alt2[i] - alt[i]) < 1e-9);
+    
+    // Many observers, one instant: apparent sidereal time per site
+    double lats[3] = { 40.7, -33.9, 69.6 }, lons[3] = { -74.0, 151.2, 18.9 };
+    CoordObserverSet* observers = coord_observers_create(lats, lons, 3);
+    assert(observers != NULL);
+    double jd = 2460400.3;
+    assert(coord_horizontal_for_observers(observers, jd, 5.5, 20.0, az, alt) == CALENDAR_SUCCESS);
+    const CoordEpoch* now = coord_epoch_get(time_ut_to_tt(jd));
+    double equinoxes = now->nutation_longitude * cos(now->true_obliquity * d2r) / 15.0;
+    for (int i = 0; i < 3; i++) {
+        double az1, alt1;
+        double lst = solar_greenwich_sidereal_time(jd) + equinoxes + lons[i] / 15.0;
+        solar_equatorial_to_horizontal(5.5, 20.0, lats[i], lst, &az1, &alt1);
+        assert(fabs(alt1 - alt[i]) < 1e-9 && fabs(az1 - az[i]) < 1e-9);
+    }
+    coord_observers_destroy(observers);
+    
+    assert(coord_ecliptic_to_equatorial_batch(NULL, COORD_ECLIPTIC_J2000, lon, lat, 1, ras, decs) == CALENDAR_ERROR_NULL_POINTER);
+    assert(coord_equatorial_to_horizontal_batch(0.0, 0.0, ras, decs, -1, az, alt) == CALENDAR_ERROR_INVALID_DATE);
+    assert(coord_observers_create(lats, lons, 0) == NULL);
+    
+    printf("    ✓ Coordinate transform tests passed\n");
+}
+
+void test_planetary_positions(void) {
+    printf("  Testing planetary positions and events...\n");
+    
+    // Meeus example 33.a: Venus on 1992 December 20.0 TD, alpha = 21h04m41.454s,
+    // delta = -18 53' 16.84", distance 0.910947 au. The element model and the
+    // omitted aberration leave a few arcseconds.
+    PlanetPosition venus;
+    assert(planetary_calculate_position(PLANET_VENUS, 2448976.5, &venus) == CALENDAR_SUCCESS);
+    assert(fabs(venus.right_ascension - (21.0 + 4.0 / 60.0 + 41.454 / 3600.0)) * 3600.0 < 2.0);
+    assert(fabs(venus.declination + (18.0 + 53.0 / 60.0 + 16.84 / 3600.0)) * 3600.0 < 20.0);
+    assert(fabs(venus.distance - 0.910947) < 1e-4);
+    
+    // The batch shares a day's rotation and orbits; it matches single positions to 0.1"
+    enum { STEPS = 100 };
+    double jds[STEPS];
+    PlanetPosition series[STEPS], single;
+    for (int i = 0; i < STEPS; i++) jds[i] = 2460000.5 + i * 0.3;
+    assert(planetary_calculate_positions_batch(PLANET_MARS, jds, STEPS, series) == CALENDAR_SUCCESS);
+    for (int i = 0; i < STEPS; i += 7) {
+        planetary_calculate_position(PLANET_MARS, jds[i], &single);
+        assert(fabs(series[i].longitude - single.longitude) < 1e-5);
+        assert(fabs(series[i].right_ascension - single.right_ascension) < 1e-5);
+        assert(fabs(series[i].declination - single.declination) < 1e-5);
+    }
+    
+    // Published event times (UT): Mars opposition 2020 Oct 13 23:20, Venus
+    // inferior conjunction 2023 Aug 13 11:16, Jupiter opposition 2023 Nov 3 05:03
+    // and the great conjunction of 2020 Dec 21. Jupiter and Saturn carry the
+    // largest element errors, so their events land within hours.
+    PlanetEvent event;
+    assert(planetary_find_next_event(PLANET_MARS, PLANET_EARTH, PLANET_EVENT_OPPOSITION, 2459000.5, &event) == CALENDAR_SUCCESS);
+    assert(fabs(time_tt_to_ut(event.julian_day) - (2459135.5 + 23.0 / 24.0 + 20.0 / 1440.0)) < 15.0 / 1440.0);
+    assert(planetary_find_next_event(PLANET_VENUS, PLANET_EARTH, PLANET_EVENT_INFERIOR_CONJUNCTION, 2460100.5, &event) == CALENDAR_SUCCESS);
+    assert(fabs(time_tt_to_ut(event.julian_day) - (2460169.5 + 11.0 / 24.0 + 16.0 / 1440.0)) < 15.0 / 1440.0);
+    assert(planetary_find_next_event(PLANET_JUPITER, PLANET_EARTH, PLANET_EVENT_OPPOSITION, 2460100.5, &event) == CALENDAR_SUCCESS);
+    assert(fabs(time_tt_to_ut(event.julian_day) - (2460251.5 + 5.0 / 24.0 + 3.0 / 1440.0)) < 4.0 / 24.0);
+    assert(planetary_find_next_event(PLANET_JUPITER, PLANET_SATURN, PLANET_EVENT_PAIR_CONJUNCTION, 2459000.5, &event) == CALENDAR_SUCCESS);
+    assert(fabs(event.julian_day - 2459205.3) < 1.0 && fabs(event.separation) < 0.2);
+    
+    // Mercury and Venus have no oppositions; the outer planets no inferior conjunctions
+    assert(planetary_find_next_event(PLANET_VENUS, PLANET_EARTH, PLANET_EVENT_OPPOSITION, 2460000.5, &event) == CALENDAR_ERROR_INVALID_DATE);
+    assert(planetary_find_next_event(PLANET_MARS, PLANET_EARTH, PLANET_EVENT_INFERIOR_CONJUNCTION, 2460000.5, &event) == CALENDAR_ERROR_INVALID_DATE);
+    
+    // A year of catalog: Mars to Neptune each have one or no opposition, in time order
+    int count = 0, oppositions = 0;
+    AstronomicalEvent* catalog = planetary_generate_catalog(2460310.5, 2460676.5, &count);
+    assert(catalog != NULL && count > 20);
+    for (int i = 0; i < count; i++) {
+        if (i > 0) assert(catalog[i].julian_day >= catalog[i - 1].julian_day);
+        if (catalog[i].type == ASTRO_EVENT_PLANET_OPPOSITION) oppositions++;
+    }
+    assert(oppositions >= 3 && oppositions <= 5);
+    planetary_destroy_catalog(catalog);
+    
+    printf("    ✓ Planetary position tests passed\n");
+}
+
+void test_event_catalog(void) {
+    printf("  Testing the event catalog file...\n");
+    
+    const unsigned int kinds = EVENT_CATALOG_PHASES | EVENT_CATALOG_ECLIPSES | EVENT_CATALOG_SEASONS |
+                               EVENT_CATALOG_FULL_MOONS;
+    int count = 0;
+    AstronomicalEvent* events = event_catalog_generate(2024, 2025, kinds, &count);
+    assert(events != NULL);
+    
+    // Two years: 8 seasons, about 99 phases, 8 eclipses
+    int seasons = 0, phases = 0, eclipses = 0;
+    for (int i = 0; i < count; i++) {
+        if (i > 0) assert(events[i].julian_day >= events[i - 1].julian_day);
+        if (events[i].type >= ASTRO_EVENT_EQUINOX_SPRING && events[i].type <= ASTRO_EVENT_SOLSTICE_WINTER) seasons++;
+        if (events[i].type >= ASTRO_EVENT_NEW_MOON && events[i].type <= ASTRO_EVENT_LAST_QUARTER) phases++;
+        if (events[i].type == ASTRO_EVENT_ECLIPSE_SOLAR || events[i].type == ASTRO_EVENT_ECLIPSE_LUNAR) eclipses++;
+    }
+    assert(seasons == 8 && eclipses == 8);
+    assert(phases >= 98 && phases <= 100);
+    
+    const char* filename = "test_events.evc";
+    assert(event_catalog_write(filename, events, count, 2024, 2025, kinds) == CALENDAR_SUCCESS);
+    EventCatalog* catalog = event_catalog_open(filename);
+    assert(catalog != NULL && catalog->count == (size_t)count);
+    
+    // Repeated names are stored once
+    size_t name_bytes = 0;
+    for (int i = 0; i < count; i++) name_bytes += strlen(events[i].name) + strlen(events[i].description) + 2;
+    assert(catalog->header->string_bytes < name_bytes);
+    
+    // April 2024 holds the total solar eclipse of April 8 and the new moon beside it
+    size_t first, found;
+    assert(event_catalog_query(catalog, 2460401.5, 2460431.5, &first, &found) == CALENDAR_SUCCESS);
+    int saw_eclipse = 0;
+    for (size_t i = first; i < first + found; i++) {
+        AstronomicalEvent event;
+        assert(event_catalog_get(catalog, i, &event) == CALENDAR_SUCCESS);
+        assert(event.julian_day >= 2460401.5 && event.julian_day < 2460431.5);
+        assert(strcmp(event.name, events[i].name) == 0 && strcmp(event.description, events[i].description) == 0);
+        if (event.type == ASTRO_EVENT_ECLIPSE_SOLAR && strstr(event.name, "Total")) saw_eclipse = 1;
+    }
+    assert(saw_eclipse && found >= 4);
+    assert(first == 0 || catalog->records[first - 1].julian_day < 2460401.5);
+    
+    // Empty and out-of-range windows
+    assert(event_catalog_query(catalog, 2460401.5, 2460401.5, &first, &found) == CALENDAR_SUCCESS && found == 0);
+    assert(event_catalog_query(catalog, 2400000.5, 2400100.5, &first, &found) == CALENDAR_SUCCESS && found == 0);
+    assert(event_catalog_query(catalog, 2460431.5, 2460401.5, &first, &found) == CALENDAR_ERROR_INVALID_DATE);
+    assert(event_catalog_get(catalog, catalog->count, &events[0]) == CALENDAR_ERROR_INVALID_DATE);
+    event_catalog_close(catalog);
+    
+    // A covering file is reused; a missing kind forces a rebuild
+    catalog = event_catalog_open_or_build(filename, 2025, 2025, EVENT_CATALOG_ECLIPSES);
+    assert(catalog != NULL && catalog->count == (size_t)count);
+    event_catalog_close(catalog);
+    catalog = event_catalog_open_or_build(filename, 2024, 2024, EVENT_CATALOG_PLANETS);
+    assert(catalog != NULL && catalog->header->kinds == EVENT_CATALOG_PLANETS && catalog->header->end_year == 2024);
+    event_catalog_close(catalog);
+    free(events);
+    
+    // Files with the wrong magic are rejected
+    FILE* bogus = fopen(filename, "wb");
+    assert(bogus != NULL);
+    for (int i = 0; i < 64; i++) fputs("junk", bogus);
+    fclose(bogus);
+    assert(event_catalog_open(filename) == NULL);
+    remove(filename);
+    
+    printf("    ✓ Event catalog tests passed\n");
+}
+
+// Main function for standalone testing
+#ifdef TEST_ASTRONOMY_STANDALONE
+int main(void) {
+    run_astronomy_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,1124 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../src/holidays/holiday_db.h"
+#include "../src/holidays/holiday_rules.h"
+#include "../src/holidays/holiday_snapshot.h"
+#include "../src/holidays/holiday_csv.h"
+#include "../src/holidays/holiday_bitmap.h"
+#include "../src/holidays/business_calendar.h"
+#include "../src/holidays/holiday_handle.h"
+#include "../src/calendars/islamic.h"
+#include "../src/calendars/chinese.h"
+#include "../src/utils/date_utils.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define INDEX_TEST_HOLIDAYS 1000
+#define HANDLE_TEST_VERSIONS 40
+
+void test_holiday_index(void);
+void test_holiday_rules(void);
+void test_holiday_snapshot(void);
+void test_holiday_csv(void);
+void test_holiday_periods(void);
+void test_holiday_bitmap(void);
+void test_business_calendar(void);
+void test_holiday_observance(void);
+void test_holiday_handle(void);
+
+void run_holidays_tests(void) {
+    printf("Running Holiday Database Tests...\n");
+    
+    test_holiday_index();
+    test_holiday_rules();
+    test_holiday_snapshot();
+    test_holiday_csv();
+    test_holiday_periods();
+    test_holiday_bitmap();
+    test_business_calendar();
+    test_holiday_observance();
+    test_holiday_handle();
+    
+    printf("✅ All holiday database tests passed!\n\n");
+}
+
+static Holiday make_holiday(const char* name, CalendarType calendar, int month, int day, const char* country) {
+    Holiday holiday;
+    memset(&holiday, 0, sizeof(holiday));
+    holiday.name = name;
+    holiday.description = "";
+    holiday.calendar_type = calendar;
+    holiday.holiday_type = HOLIDAY_FIXED;
+    holiday.date.month = month;
+    holiday.date.day = day;
+    snprintf(holiday.country_code, sizeof(holiday.country_code), "%s", country);
+    holiday.is_public_holiday = 1;
+    return holiday;
+}
+
+void test_holiday_index(void) {
+    printf("  Testing indexed date lookups...\n");
+    
+    HolidayDatabase* db = holiday_db_create();
+    assert(db != NULL);
+    Holiday entries[] = {
+        make_holiday("New Year's Day", CALENDAR_GREGORIAN, 1, 1, "US"),
+        make_holiday("New Year's Day", CALENDAR_GREGORIAN, 1, 1, "GB"),
+        make_holiday("Solemnity of Mary", CALENDAR_GREGORIAN, 1, 1, "VA"),
+        make_holiday("Christmas Day", CALENDAR_GREGORIAN, 12, 25, "US"),
+        make_holiday("Christmas Day", CALENDAR_GREGORIAN, 12, 25, "GB"),
+        make_holiday("Rosh Hashanah", CALENDAR_HEBREW, 1, 1, "IL"),
+        make_holiday("Chinese New Year", CALENDAR_CHINESE, 1, 1, "CN"),
+    };
+    for (size_t i = 0; i < sizeof(entries) / sizeof(entries[0]); i++) {
+        assert(holiday_db_add_holiday(db, &entries[i]) == CALENDAR_SUCCESS);
+    }
+    
+    // Every match on the date, not only the first
+    const Holiday* matches[8];
+    int count = 0;
+    Date new_year = {1, 1, 2024};
+    assert(holiday_db_find_holidays(db, &new_year, CALENDAR_GREGORIAN, NULL, matches, 8, &count) == CALENDAR_SUCCESS);
+    assert(count == 3);
+    assert(holiday_db_find_holidays(db, &new_year, CALENDAR_GREGORIAN, "GB", matches, 8, &count) == CALENDAR_SUCCESS);
+    assert(count == 1 && strcmp(matches[0]->country_code, "GB") == 0);
+    assert(holiday_db_find_holidays(db, &new_year, CALENDAR_HEBREW, "", matches, 8, &count) == CALENDAR_SUCCESS);
+    assert(count == 1 && strcmp(matches[0]->name, "Rosh Hashanah") == 0);
+    assert(holiday_db_find_holidays(db, &new_year, CALENDAR_GREGORIAN, "FR", matches, 8, &count) == CALENDAR_SUCCESS);
+    assert(count == 0);
+    assert(holiday_db_find_holidays(db, &new_year, CALENDAR_GREGORIAN, "USA", matches, 8, &count) == CALENDAR_SUCCESS);
+    assert(count == 0);
+    
+    // A short buffer still reports the total
+    assert(holiday_db_find_holidays(db, &new_year, CALENDAR_GREGORIAN, NULL, matches, 2, &count) == CALENDAR_SUCCESS);
+    assert(count == 3);
+    
+    // Additions are visible to the next lookup
+    Holiday boxing = make_holiday("Boxing Day", CALENDAR_GREGORIAN, 12, 26, "GB");
+    Holiday christmas_va = make_holiday("Christmas Day", CALENDAR_GREGORIAN, 12, 25, "VA");
+    holiday_db_add_holiday(db, &boxing);
+    holiday_db_add_holiday(db, &christmas_va);
+    Date christmas = {25, 12, 2024};
+    holiday_db_find_holidays(db, &christmas, CALENDAR_GREGORIAN, NULL, matches, 8, &count);
+    assert(count == 3);
+    Holiday* first = holiday_db_get_holidays_for_date(db, &christmas, CALENDAR_GREGORIAN, "VA");
+    assert(first != NULL && strcmp(first->country_code, "VA") == 0);
+    Date invalid = {0, 13, 2024};
+    assert(holiday_db_get_holidays_for_date(db, &invalid, CALENDAR_GREGORIAN, NULL) == NULL);
+    holiday_db_destroy(db);
+    
+    // Agrees with a scan over a full database of random entries
+    db = holiday_db_create();
+    const char* countries[] = { "US", "GB", "DE", "FR", "JP", "IN", "BR", "SA" };
+    srand(42);
+    for (int i = 0; i < INDEX_TEST_HOLIDAYS; i++) {
+        Holiday holiday = make_holiday("Holiday", (CalendarType)(rand() % 4), 1 + rand() % 12, 1 + rand() % 28,
+                                       countries[rand() % 8]);
+        holiday_db_add_holiday(db, &holiday);
+    }
+    // Gregorian days see every calendar's holidays, so they are checked
+    // against the rules; other calendars match the stored month and day
+    assert(holiday_db_materialize_year(db, 2000) != NULL);
+    long (*occurs)[HOLIDAY_RULE_MAX_OCCURRENCES] = malloc(sizeof(*occurs) * INDEX_TEST_HOLIDAYS);
+    int* occurs_count = malloc(sizeof(int) * INDEX_TEST_HOLIDAYS);
+    assert(occurs && occurs_count);
+    for (int i = 0; i < db->count; i++) {
+        const Holiday* h = &db->holidays[i];
+        holiday_rule_evaluate_with(h, 2000, db->month_tables[h->calendar_type], occurs[i],
+                                   HOLIDAY_RULE_MAX_OCCURRENCES, &occurs_count[i]);
+    }
+    for (int calendar = 0; calendar < 4; calendar++) {
+        for (int month = 1; month <= 12; month++) {
+            for (int day = 1; day <= 28; day += 3) {
+                for (int c = -1; c < 8; c++) {
+                    const char* country = c < 0 ? NULL : countries[c];
+                    Date date = {day, month, 2000};
+                    long jdn = julian_day_from_date(day, month, 2000);
+                    const Holiday* found[64];
+                    assert(holiday_db_find_holidays(db, &date, (CalendarType)calendar, country, found, 64, &count) == CALENDAR_SUCCESS);
+                    
+                    int expected = 0;
+                    for (int i = 0; i < db->count; i++) {
+                        const Holiday* h = &db->holidays[i];
+                        if (country && strcmp(h->country_code, country) != 0) continue;
+                        if (calendar == CALENDAR_GREGORIAN) {
+                            for (int j = 0; j < occurs_count[i]; j++) expected += occurs[i][j] == jdn;
+                        } else if ((int)h->calendar_type == calendar && h->date.month == month && h->date.day == day) {
+                            expected++;
+                        }
+                    }
+                    assert(count == expected);
+                    for (int i = 0; i < count; i++) {
+                        if (calendar != CALENDAR_GREGORIAN) assert(found[i]->date.month == month && found[i]->date.day == day);
+                        if (country) assert(strcmp(found[i]->country_code, country) == 0);
+                    }
+                }
+            }
+        }
+    }
+    free(occurs);
+    free(occurs_count);
+    holiday_db_destroy(db);
+    
+    printf("    ✓ Holiday index tests passed\n");
+}
+
+void test_holiday_rules(void) {
+    printf("  Testing rule evaluation and materialized occurrences...\n");
+    
+    long jdns[HOLIDAY_RULE_MAX_OCCURRENCES];
+    int count = 0;
+    
+    // Weekday rules: on or after the day, or the last one in the month
+    Holiday thanksgiving = make_holiday("Thanksgiving", CALENDAR_GREGORIAN, 11, 22, "US");
+    thanksgiving.holiday_type = HOLIDAY_WEEKDAY;
+    thanksgiving.weekday = 4;
+    assert(holiday_rule_evaluate(&thanksgiving, 2024, jdns, 2, &count) == CALENDAR_SUCCESS);
+    assert(count == 1 && jdns[0] == julian_day_from_date(28, 11, 2024));
+    Holiday memorial = make_holiday("Memorial Day", CALENDAR_GREGORIAN, 5, 0, "US");
+    memorial.holiday_type = HOLIDAY_WEEKDAY;
+    memorial.weekday = 1;
+    holiday_rule_evaluate(&memorial, 2024, jdns, 2, &count);
+    assert(count == 1 && jdns[0] == julian_day_from_date(27, 5, 2024));
+    assert(holiday_nth_weekday_jdn(2024, 5, 1, -1) == julian_day_from_date(27, 5, 2024));
+    assert(holiday_nth_weekday_jdn(2024, 9, 1, 1) == julian_day_from_date(2, 9, 2024));
+    assert(holiday_nth_weekday_jdn(2024, 2, 1, 5) == 0);
+    
+    // Easter, Western and Orthodox, with offsets
+    assert(holiday_easter_jdn(2024, 0) == julian_day_from_date(31, 3, 2024));
+    assert(holiday_easter_jdn(2025, 0) == julian_day_from_date(20, 4, 2025));
+    assert(holiday_easter_jdn(2024, 1) == julian_day_from_date(5, 5, 2024));
+    Holiday good_friday = make_holiday("Good Friday", CALENDAR_GREGORIAN, 0, 0, "GB");
+    good_friday.holiday_type = HOLIDAY_EASTER;
+    good_friday.offset_days = -2;
+    holiday_rule_evaluate(&good_friday, 2024, jdns, 2, &count);
+    assert(count == 1 && jdns[0] == julian_day_from_date(29, 3, 2024));
+    
+    // Dates that do not exist in a year are skipped
+    Holiday leap_day = make_holiday("Leap Day", CALENDAR_GREGORIAN, 2, 29, "US");
+    holiday_rule_evaluate(&leap_day, 2023, jdns, 2, &count);
+    assert(count == 0);
+    holiday_rule_evaluate(&leap_day, 2024, jdns, 2, &count);
+    assert(count == 1);
+    
+    // An Islamic date can fall twice in one Gregorian year (1 Shawwal 2033)
+    Holiday eid = make_holiday("Eid al-Fitr", CALENDAR_ISLAMIC, 10, 1, "SA");
+    holiday_rule_evaluate(&eid, 2033, jdns, 2, &count);
+    assert(count == 2);
+    for (int i = 0; i < count; i++) {
+        int day, month, year;
+        julian_day_to_date(jdns[i], &day, &month, &year);
+        assert(year == 2033);
+        IslamicDate islamic;
+        GregorianDate gregorian;
+        memset(&islamic, 0, sizeof(islamic));
+        islamic.base.day = 1;
+        islamic.base.month = 10;
+        islamic.base.year = i == 0 ? 1454 : 1455;
+        assert(islamic_to_gregorian(&islamic, &gregorian) == CALENDAR_SUCCESS);
+        assert(gregorian.julian_day == jdns[i]);
+    }
+    
+    // Hebrew dates, with Adar II between Adar and Nisan in leap years
+    Holiday rosh_hashanah = make_holiday("Rosh Hashanah", CALENDAR_HEBREW, 1, 1, "IL");
+    holiday_rule_evaluate(&rosh_hashanah, 2024, jdns, 2, &count);
+    assert(count == 1 && jdns[0] == julian_day_from_date(3, 10, 2024));
+    Holiday passover = make_holiday("Passover", CALENDAR_HEBREW, 7, 15, "IL");
+    holiday_rule_evaluate(&passover, 2024, jdns, 2, &count);
+    assert(count == 1 && jdns[0] == julian_day_from_date(23, 4, 2024));
+    Holiday purim = make_holiday("Purim", CALENDAR_HEBREW, 13, 14, "IL");
+    holiday_rule_evaluate(&purim, 2024, jdns, 2, &count);
+    assert(count == 1 && jdns[0] == julian_day_from_date(24, 3, 2024));
+    holiday_rule_evaluate(&purim, 2025, jdns, 2, &count);
+    assert(count == 0);
+    
+    // Month tables give the engines' answers
+    for (int calendar = CALENDAR_ISLAMIC; calendar <= 4; calendar++) {
+#ifndef BUILD_ASTRONOMY
+        if (calendar == CALENDAR_CHINESE) continue;
+#endif
+        int first, last;
+        holiday_calendar_year_span(calendar, 1990, 2030, &first, &last);
+        HolidayMonthTable* table = holiday_month_table_build(calendar, first, last);
+        assert(table != NULL && table->first_year == first);
+        for (int month = 1; month <= 13; month++) {
+            Holiday h = make_holiday("Holiday", (CalendarType)calendar, month, month == 1 ? 1 : 29, "XX");
+            for (int year = 1990; year <= 2030; year += 7) {
+                long with_table[2], engine[2];
+                int table_count, engine_count;
+                holiday_rule_evaluate_with(&h, year, table, with_table, 2, &table_count);
+                holiday_rule_evaluate(&h, year, engine, 2, &engine_count);
+                assert(table_count == engine_count);
+                for (int i = 0; i < table_count; i++) assert(with_table[i] == engine[i]);
+            }
+        }
+        holiday_month_table_destroy(table);
+    }
+    
+    // Chinese dates come from new moons and solar terms, so need astronomy
+    Holiday chinese = make_holiday("Chinese New Year", CALENDAR_CHINESE, 1, 1, "CN");
+#ifdef BUILD_ASTRONOMY
+    const int new_years[][3] = {
+        {25, 1, 2020}, {12, 2, 2021}, {22, 1, 2023}, {10, 2, 2024}, {29, 1, 2025}, {19, 2, 2034}
+    };
+    for (size_t i = 0; i < sizeof(new_years) / sizeof(new_years[0]); i++) {
+        assert(holiday_rule_evaluate(&chinese, new_years[i][2], jdns, 2, &count) == CALENDAR_SUCCESS);
+        assert(count == 1 && jdns[0] == julian_day_from_date(new_years[i][0], new_years[i][1], new_years[i][2]));
+    }
+    Holiday mid_autumn = make_holiday("Mid-Autumn Festival", CALENDAR_CHINESE, 8, 15, "CN");
+    holiday_rule_evaluate(&mid_autumn, 2024, jdns, 2, &count);
+    assert(count == 1 && jdns[0] == julian_day_from_date(17, 9, 2024));
+    
+    // 2020 repeats the fourth month, and 2033 the eleventh
+    ChineseMonth months[CHINESE_MAX_MONTHS];
+    assert(chinese_year_months(2020, months, &count) == CALENDAR_SUCCESS);
+    assert(count == 13 && months[4].is_leap && months[4].number == 4);
+    assert(chinese_year_months(2033, months, &count) == CALENDAR_SUCCESS);
+    assert(count == 13 && months[11].is_leap && months[11].number == 11);
+#else
+    assert(holiday_rule_evaluate(&chinese, 2024, jdns, 2, &count) == CALENDAR_ERROR_CONVERSION_FAILED);
+#endif
+    
+    // Materialized lookups agree with evaluating each rule
+    HolidayDatabase* db = holiday_db_create();
+    Holiday entries[] = {
+        thanksgiving, memorial, good_friday, leap_day, eid,
+        make_holiday("Christmas Day", CALENDAR_GREGORIAN, 12, 25, "US"),
+        make_holiday("Christmas Day", CALENDAR_GREGORIAN, 12, 25, "GB"),
+        make_holiday("Rosh Hashanah", CALENDAR_HEBREW, 1, 1, "IL"),
+        make_holiday("Nowruz", (CalendarType)4, 1, 1, "IR"),
+        chinese,
+    };
+    for (size_t i = 0; i < sizeof(entries) / sizeof(entries[0]); i++) {
+        entries[i].weekday = entries[i].holiday_type == HOLIDAY_WEEKDAY ? entries[i].weekday : -1;
+        assert(holiday_db_add_holiday(db, &entries[i]) == CALENDAR_SUCCESS);
+    }
+    assert(holiday_db_materialize_range(db, 2020, 2035) == CALENDAR_SUCCESS);
+    for (int year = 2020; year <= 2035; year++) {
+        const HolidayYear* occurrences = holiday_db_materialize_year(db, year);
+        assert(occurrences != NULL && occurrences->year == year);
+        
+        uint32_t expected = 0;
+        for (int i = 0; i < db->count; i++) {
+            holiday_rule_evaluate(&db->holidays[i], year, jdns, 2, &count);
+            expected += (uint32_t)count;
+            for (int j = 0; j < count; j++) {
+                const Holiday* found[8];
+                int found_count = 0;
+                holiday_db_find_occurrences(db, jdns[j], db->holidays[i].country_code, found, 8, &found_count);
+                int seen = 0;
+                for (int k = 0; k < found_count; k++) seen |= found[k] == &db->holidays[i];
+                assert(seen);
+            }
+        }
+        assert(occurrences->count == expected);
+        for (uint32_t i = 1; i < occurrences->count; i++) {
+            assert(occurrences->occurrences[i - 1].jdn <= occurrences->occurrences[i].jdn);
+        }
+    }
+    
+    // Range queries by country
+    const HolidayYear* year = holiday_db_materialize_year(db, 2024);
+    const HolidayOccurrence* first;
+    holiday_year_find(year, julian_day_from_date(1, 1, 2024), julian_day_from_date(31, 12, 2024), "US", &first, &count);
+    assert(count == 4);
+    holiday_year_find(year, julian_day_from_date(25, 12, 2024), julian_day_from_date(25, 12, 2024), NULL, &first, &count);
+    assert(count == 2);
+    holiday_year_find(year, julian_day_from_date(1, 1, 2024), julian_day_from_date(31, 12, 2024), "FR", &first, &count);
+    assert(count == 0);
+    
+    // Additions drop the cache
+    Holiday boxing = make_holiday("Boxing Day", CALENDAR_GREGORIAN, 12, 26, "GB");
+    boxing.weekday = -1;
+    holiday_db_add_holiday(db, &boxing);
+    assert(db->year_count == 0);
+    const Holiday* found[4];
+    holiday_db_find_occurrences(db, julian_day_from_date(26, 12, 2024), "GB", found, 4, &count);
+    assert(count == 1 && strcmp(found[0]->name, "Boxing Day") == 0);
+    holiday_db_destroy(db);
+    
+    printf("    ✓ Holiday rule tests passed\n");
+}
+
+void test_holiday_snapshot(void) {
+    printf("  Testing compiled snapshots...\n");
+    
+    const char* countries[] = { "US", "GB", "DE", "FR", "JP", "IN", "BR", "SA" };
+    const char* names[] = { "Founders Day", "Harvest Festival", "Remembrance Day", "Spring Festival" };
+    int count = 20000;
+    Holiday* holidays = malloc(sizeof(Holiday) * count);
+    assert(holidays != NULL);
+    srand(7);
+    for (int i = 0; i < count; i++) {
+        holidays[i] = make_holiday(names[rand() % 4], (CalendarType)(rand() % 4), 1 + rand() % 12,
+                                   1 + rand() % 30, countries[rand() % 8]);
+        holidays[i].weekday = -1;
+        holidays[i].offset_days = i % 3;
+        holidays[i].duration_days = 1 + i % 9;
+    }
+    assert(holiday_snapshot_write("test_holidays.hds", holidays, count) == CALENDAR_SUCCESS);
+    
+    HolidaySnapshot* snapshot = holiday_snapshot_open("test_holidays.hds");
+    assert(snapshot != NULL && snapshot->count == (size_t)count);
+    assert(holiday_snapshot_verify(snapshot) == CALENDAR_SUCCESS);
+    assert(snapshot->header->string_bytes < 100);     // Each name stored once
+    
+    // Records round-trip
+    for (int i = 0; i < count; i += 97) {
+        Holiday holiday;
+        assert(holiday_snapshot_get(snapshot, i, &holiday) == CALENDAR_SUCCESS);
+        assert(strcmp(holiday.name, holidays[i].name) == 0 && strcmp(holiday.country_code, holidays[i].country_code) == 0);
+        assert(holiday.date.month == holidays[i].date.month && holiday.date.day == holidays[i].date.day);
+        assert(holiday.offset_days == holidays[i].offset_days && holiday.weekday == -1);
+        assert(holiday.duration_days == holidays[i].duration_days);
+    }
+    
+    // Date lookups agree with a scan
+    for (int calendar = 0; calendar < 4; calendar++) {
+        for (int month = 1; month <= 12; month += 5) {
+            for (int day = 1; day <= 30; day += 7) {
+                for (int c = -1; c < 8; c++) {
+                    const char* country = c < 0 ? NULL : countries[c];
+                    Date date = {day, month, 0};
+                    uint32_t matches[64];
+                    int found = 0;
+                    holiday_snapshot_find(snapshot, &date, (CalendarType)calendar, country, matches, 64, &found);
+                    
+                    int expected = 0;
+                    for (int i = 0; i < count; i++) {
+                        if ((int)holidays[i].calendar_type != calendar || holidays[i].date.month != month ||
+                            holidays[i].date.day != day) continue;
+                        if (country && strcmp(holidays[i].country_code, country) != 0) continue;
+                        if (country) assert(expected >= 64 || (int)matches[expected] == i);  // In insertion order
+                        expected++;
+                    }
+                    assert(found == expected);
+                }
+            }
+        }
+    }
+    
+    // Country runs list each country's records in order
+    size_t total = 0;
+    for (int c = 0; c < 8; c++) {
+        size_t first, found;
+        holiday_snapshot_country(snapshot, countries[c], &first, &found);
+        for (size_t i = 0; i < found; i++) {
+            uint32_t record = snapshot->country_order[first + i];
+            assert(strcmp(holidays[record].country_code, countries[c]) == 0);
+            if (i > 0) assert(record > snapshot->country_order[first + i - 1]);
+        }
+        total += found;
+    }
+    assert(total == (size_t)count);
+    size_t first, found;
+    holiday_snapshot_country(snapshot, "XX", &first, &found);
+    assert(found == 0);
+    holiday_snapshot_close(snapshot);
+    
+    // Sources: a CSV file and an existing snapshot
+    FILE* csv = fopen("test_holidays.csv", "w");
+    assert(csv != NULL);
+    fprintf(csv, "# test_holidays.csv\n");
+    fprintf(csv, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic,Weekday,Offset\n");
+    fprintf(csv, "Thanksgiving,US Thanksgiving,0,4,11,22,US,1,4,0\n");
+    fprintf(csv, "Boxing Day,Day after Christmas,0,0,12,26,GB,1,-1,0\n");
+    fclose(csv);
+    const char* sources[] = { "test_holidays.csv", "test_holidays.hds" };
+    assert(holiday_snapshot_compile("test_holidays_merged.hds", sources, 2) == CALENDAR_SUCCESS);
+    snapshot = holiday_snapshot_open("test_holidays_merged.hds");
+    assert(snapshot != NULL && snapshot->count == (size_t)count + 2);
+    Holiday thanksgiving;
+    holiday_snapshot_get(snapshot, 0, &thanksgiving);
+    assert(strcmp(thanksgiving.name, "Thanksgiving") == 0 && thanksgiving.holiday_type == HOLIDAY_WEEKDAY);
+    assert(thanksgiving.weekday == 4);
+    holiday_snapshot_close(snapshot);
+    
+    // A bad reference still opens, but verify and the accessors refuse it
+    csv = fopen("test_holidays_merged.hds", "r+b");
+    assert(csv != NULL);
+    HolidaySnapshotFileHeader header;
+    assert(fread(&header, sizeof(header), 1, csv) == 1);
+    uint32_t bad_offset = UINT32_MAX;
+    fseek(csv, (long)header.record_offset, SEEK_SET);
+    fwrite(&bad_offset, sizeof(bad_offset), 1, csv);
+    fclose(csv);
+    snapshot = holiday_snapshot_open("test_holidays_merged.hds");
+    assert(snapshot != NULL && holiday_snapshot_verify(snapshot) != CALENDAR_SUCCESS);
+    assert(holiday_snapshot_get(snapshot, 0, &thanksgiving) != CALENDAR_SUCCESS);
+    holiday_snapshot_close(snapshot);
+    const char* missing[] = { "no_such_holidays.csv" };
+    assert(holiday_snapshot_compile("test_holidays_missing.hds", missing, 1) != CALENDAR_SUCCESS);
+    
+    // A bucket table with no empty bucket fails verify, and lookups of an
+    // absent country still end
+    csv = fopen("test_holidays.hds", "r+b");
+    assert(csv != NULL);
+    assert(fread(&header, sizeof(header), 1, csv) == 1);
+    fseek(csv, (long)header.bucket_offset, SEEK_SET);
+    for (uint64_t b = 0; b < header.bucket_count; b++) {
+        HolidayIndexBucket full = { b + 1, 0, 0 };
+        fwrite(&full, sizeof(full), 1, csv);
+    }
+    fclose(csv);
+    snapshot = holiday_snapshot_open("test_holidays.hds");
+    assert(snapshot != NULL && holiday_snapshot_verify(snapshot) != CALENDAR_SUCCESS);
+    Date christmas = {25, 12, 2024};
+    uint32_t found_records[4];
+    int found_count = -1;
+    assert(holiday_snapshot_find(snapshot, &christmas, CALENDAR_GREGORIAN, "ZZ", found_records, 4,
+                                 &found_count) == CALENDAR_SUCCESS && found_count == 0);
+    holiday_snapshot_close(snapshot);
+    
+    // Truncated or foreign files are rejected
+    csv = fopen("test_holidays.hds", "r+b");
+    assert(csv != NULL);
+    fseek(csv, 0, SEEK_END);
+    long size = ftell(csv);
+    fclose(csv);
+    assert(truncate("test_holidays.hds", size / 2) == 0);
+    assert(holiday_snapshot_open("test_holidays.hds") == NULL);
+    assert(holiday_snapshot_open("test_holidays.csv") == NULL);
+    
+    remove("test_holidays.hds");
+    remove("test_holidays_merged.hds");
+    remove("test_holidays.csv");
+    free(holidays);
+    
+    printf("    ✓ Holiday snapshot tests passed\n");
+}
+
+void test_holiday_csv(void) {
+    printf("  Testing streaming CSV loading...\n");
+    
+    // Quoted fields, escapes, line breaks, CRLF, comments, blank lines and bad rows
+    FILE* csv = fopen("test_holidays_rfc.csv", "wb");
+    assert(csv != NULL);
+    fprintf(csv, "# Holidays with awkward text\r\n");
+    fprintf(csv, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic,Weekday,Offset\r\n");
+    fprintf(csv, "\"Christmas, Day\",\"Said \"\"Merry\"\"\",0,0,12,25,US,1,-1,0\r\n");
+    fprintf(csv, "\n");
+    fprintf(csv, "Easter Monday,\"Day after\nEaster\",0,1,0,0,GB,1,-1,1\n");
+    fprintf(csv, "Too Short,Missing fields,0,0,1,1\n");                 // Line 7
+    fprintf(csv, "Bad Month,Out of range,0,0,14,1,US,1\n");             // Line 8
+    fprintf(csv, "Stray\"Quote,Unquoted quote,0,0,1,1,US,1\n");         // Line 9
+    fprintf(csv, "Boxing Day,,0,0,12,26,GB,1,,,2\n");
+    fprintf(csv, "Open,\"Never closed,0,0,1,1,US,1\n");                // Line 11, to the end
+    fclose(csv);
+    
+    HolidayDatabase* db = holiday_db_create();
+    HolidayLoadReport report;
+    assert(holiday_db_load_csv(db, "test_holidays_rfc.csv", &report) == CALENDAR_SUCCESS);
+    assert(report.loaded == 3 && db->count == 3);
+    assert(report.malformed == 4);
+    assert(report.errors[0].line == 7 && report.errors[1].line == 8);
+    assert(report.errors[2].line == 9 && report.errors[3].line == 11);
+    assert(strstr(report.errors[3].message, "unterminated") != NULL);
+    assert(strcmp(db->holidays[0].name, "Christmas, Day") == 0);
+    assert(strcmp(db->holidays[0].description, "Said \"Merry\"") == 0);
+    assert(strcmp(db->holidays[1].description, "Day after\nEaster") == 0);
+    assert(db->holidays[1].holiday_type == HOLIDAY_EASTER && db->holidays[1].offset_days == 1);
+    assert(db->holidays[2].weekday == -1 && db->holidays[2].description[0] == '\0');
+    assert(db->holidays[0].duration_days == 1 && db->holidays[2].duration_days == 2);
+    
+    // Saving quotes what needs it, so the file loads back the same
+    assert(holiday_db_save_to_file(db, "test_holidays_rfc.csv") == CALENDAR_SUCCESS);
+    HolidayDatabase* reloaded = holiday_db_create();
+    assert(holiday_db_load_csv(reloaded, "test_holidays_rfc.csv", &report) == CALENDAR_SUCCESS);
+    assert(report.malformed == 0 && reloaded->count == db->count);
+    for (int i = 0; i < db->count; i++) {
+        const Holiday* a = &db->holidays[i];
+        const Holiday* b = &reloaded->holidays[i];
+        assert(strcmp(a->name, b->name) == 0 && strcmp(a->description, b->description) == 0);
+        assert(a->date.month == b->date.month && a->date.day == b->date.day && a->offset_days == b->offset_days);
+        assert(a->duration_days == b->duration_days);
+    }
+    holiday_db_destroy(reloaded);
+    holiday_db_destroy(db);
+    
+    // No fixed cap: far more rows than the old 1000, across buffer refills
+    csv = fopen("test_holidays_rfc.csv", "w");
+    assert(csv != NULL);
+    int rows = 50000;
+    for (int i = 0; i < rows; i++) {
+        fprintf(csv, "Holiday %d,\"Row %d, padded out to cross buffer boundaries\",%d,0,%d,%d,C%d,1\n",
+                i, i, i % 4, 1 + i % 12, 1 + i % 28, i % 100);
+    }
+    // One record longer than the read buffer
+    size_t long_length = HOLIDAY_CSV_BUFFER_SIZE * 3 / 2;
+    char* long_text = malloc(long_length + 1);
+    assert(long_text != NULL);
+    for (size_t i = 0; i < long_length; i++) long_text[i] = i % 64 == 63 ? ',' : 'a' + i % 26;
+    long_text[long_length] = '\0';
+    fprintf(csv, "Long,\"%s\",0,0,1,1,US,1\n", long_text);
+    fclose(csv);
+    db = holiday_db_create();
+    assert(holiday_db_load_csv(db, "test_holidays_rfc.csv", &report) == CALENDAR_SUCCESS);
+    assert(report.malformed == 0 && db->count == rows + 1);
+    assert(strcmp(db->holidays[rows].description, long_text) == 0);
+    free(long_text);
+    for (int i = 0; i < rows; i += 997) {
+        char expected[64];
+        snprintf(expected, sizeof(expected), "Holiday %d", i);
+        assert(strcmp(db->holidays[i].name, expected) == 0 && db->holidays[i].date.day == 1 + i % 28);
+    }
+    holiday_db_destroy(db);
+    
+    db = holiday_db_create();
+    assert(holiday_db_load_csv(db, "no_such_holidays.csv", &report) != CALENDAR_SUCCESS);
+    holiday_db_destroy(db);
+    remove("test_holidays_rfc.csv");
+    
+    printf("    ✓ Streaming CSV tests passed\n");
+}
+
+void test_holiday_periods(void) {
+    printf("  Testing observance periods and interval queries...\n");
+    
+    // Random Gregorian periods, some running into the next year
+    const char* countries[] = { "US", "GB", "DE", "JP" };
+    HolidayDatabase* db = holiday_db_create();
+    assert(db != NULL);
+    srand(11);
+    for (int i = 0; i < 600; i++) {
+        Holiday holiday = make_holiday("Period", CALENDAR_GREGORIAN, 1 + rand() % 12, 1 + rand() % 28,
+                                       countries[rand() % 4]);
+        holiday.weekday = -1;
+        holiday.duration_days = rand() % 4 == 0 ? 1 : rand() % 60;
+        assert(holiday_db_add_holiday(db, &holiday) == CALENDAR_SUCCESS);
+    }
+    
+    // Every query agrees with a scan of the rules, in date order
+    HolidayOccurrence matches[1024];
+    for (int q = 0; q < 400; q++) {
+        long start = julian_day_from_date(1, 1, 2024) + rand() % 800;
+        long end = start + (q % 5 == 0 ? 0 : rand() % 90);
+        const char* country = q % 3 == 0 ? NULL : countries[q % 4];
+        int found = 0;
+        assert(holiday_db_find_periods(db, start, end, country, matches, 1024, &found) == CALENDAR_SUCCESS);
+        
+        int expected = 0;
+        int start_day, start_month, start_year, end_day, end_month, end_year;
+        julian_day_to_date(start, &start_day, &start_month, &start_year);
+        julian_day_to_date(end, &end_day, &end_month, &end_year);
+        for (int year = start_year - 1; year <= end_year; year++) {
+            for (int i = 0; i < db->count; i++) {
+                const Holiday* holiday = &db->holidays[i];
+                if (country && strcmp(holiday->country_code, country) != 0) continue;
+                long first = julian_day_from_date(holiday->date.day, holiday->date.month, year);
+                long last = first + (holiday->duration_days > 1 ? holiday->duration_days : 1) - 1;
+                if (first <= end && last >= start) expected++;
+            }
+        }
+        assert(found == expected && found <= 1024);
+        for (int i = 0; i < found; i++) {
+            const Holiday* holiday = &db->holidays[matches[i].holiday];
+            assert(matches[i].jdn <= end && matches[i].end_jdn >= start);
+            assert(matches[i].end_jdn - matches[i].jdn + 1 == (holiday->duration_days > 1 ? holiday->duration_days : 1));
+            if (country) assert(strcmp(holiday->country_code, country) == 0);
+            if (i > 0) assert(matches[i].jdn >= matches[i - 1].jdn);
+        }
+        
+        // A short buffer still gets the total
+        int total = 0;
+        holiday_db_find_periods(db, start, end, country, matches, 3, &total);
+        assert(total == found);
+    }
+    holiday_db_destroy(db);
+    
+    // Hanukkah (25 Kislev, 8 days) is still on after New Year
+    db = holiday_db_create();
+    Holiday hanukkah = make_holiday("Hanukkah", CALENDAR_HEBREW, 3, 25, "IL");
+    hanukkah.weekday = -1;
+    hanukkah.duration_days = 8;
+    holiday_db_add_holiday(db, &hanukkah);
+    long new_year = julian_day_from_date(1, 1, 2025);
+    int found = 0;
+    holiday_db_find_periods(db, new_year, new_year, "IL", matches, 4, &found);
+    assert(found == 1 && matches[0].jdn == julian_day_from_date(26, 12, 2024));
+    assert(matches[0].end_jdn == julian_day_from_date(2, 1, 2025));
+    holiday_db_find_periods(db, new_year, new_year, "US", matches, 4, &found);
+    assert(found == 0);
+    
+    // Single-day lookups keep matching the first day only
+    const Holiday* starts[4];
+    holiday_db_find_occurrences(db, new_year, "IL", starts, 4, &found);
+    assert(found == 0);
+    holiday_db_destroy(db);
+    
+    printf("    ✓ Observance period tests passed\n");
+}
+
+void test_holiday_bitmap(void) {
+    printf("  Testing the day x country bitmap...\n");
+    
+    // 200 countries, so rows span several words
+    HolidayDatabase* db = holiday_db_create();
+    assert(db != NULL);
+    char codes[200][4];
+    srand(13);
+    for (int c = 0; c < 200; c++) {
+        snprintf(codes[c], sizeof(codes[c]), "%c%c", 'A' + c / 26, 'A' + c % 26);
+        for (int i = 0; i < 4; i++) {
+            Holiday holiday = make_holiday("Day", CALENDAR_GREGORIAN, 1 + rand() % 12, 1 + rand() % 28, codes[c]);
+            holiday.weekday = -1;
+            holiday.duration_days = 1 + rand() % 10;
+            holiday.is_public_holiday = rand() % 2;
+            holiday.is_bank_holiday = rand() % 2;
+            holiday.is_school_holiday = rand() % 2;
+            assert(holiday_db_add_holiday(db, &holiday) == CALENDAR_SUCCESS);
+        }
+    }
+    HolidayBitmap* bitmap = holiday_bitmap_build(db, 2024, 2025);
+    assert(bitmap != NULL && bitmap->country_count == 200 && bitmap->words_per_day == 4);
+    assert(bitmap->day_count == 731);
+    assert(holiday_bitmap_column(bitmap, "ZZ") < 0);
+    
+    // Every bit agrees with the period query
+    uint64_t set[4] = { 0 };
+    int members[] = { 3, 64, 65, 130, 199 };
+    for (int i = 0; i < 5; i++) holiday_bitmap_set_add(bitmap, set, codes[members[i]]);
+    HolidayOccurrence matches[16];
+    for (long jdn = bitmap->first_jdn; jdn < bitmap->first_jdn + bitmap->day_count; jdn += 5) {
+        int expected[HOLIDAY_PLANE_COUNT] = { 0 };
+        int expected_in_set[HOLIDAY_PLANE_COUNT] = { 0 };
+        for (int c = 0; c < 200; c++) {
+            int column = holiday_bitmap_column(bitmap, codes[c]);
+            int found = 0;
+            holiday_db_find_periods(db, jdn, jdn, codes[c], matches, 16, &found);
+            int flags[HOLIDAY_PLANE_COUNT] = { found > 0 };
+            for (int i = 0; i < found; i++) {
+                const Holiday* holiday = &db->holidays[matches[i].holiday];
+                flags[HOLIDAY_PLANE_PUBLIC] |= holiday->is_public_holiday;
+                flags[HOLIDAY_PLANE_BANK] |= holiday->is_bank_holiday;
+                flags[HOLIDAY_PLANE_SCHOOL] |= holiday->is_school_holiday;
+            }
+            flags[HOLIDAY_PLANE_OBSERVED] = flags[HOLIDAY_PLANE_PUBLIC];   // No rules move anything
+            
+            int in_set = (set[column >> 6] >> (column & 63)) & 1;
+            for (int p = 0; p < HOLIDAY_PLANE_COUNT; p++) {
+                assert(holiday_bitmap_test(bitmap, (HolidayPlane)p, jdn, column) == flags[p]);
+                expected[p] += flags[p];
+                expected_in_set[p] += flags[p] && in_set;
+            }
+        }
+        for (int p = 0; p < HOLIDAY_PLANE_COUNT; p++) {
+            assert(holiday_bitmap_count(bitmap, (HolidayPlane)p, jdn, NULL) == expected[p]);
+            assert(holiday_bitmap_count(bitmap, (HolidayPlane)p, jdn, set) == expected_in_set[p]);
+            assert(holiday_bitmap_any(bitmap, (HolidayPlane)p, jdn, set) == (expected_in_set[p] > 0));
+        }
+        
+        int columns[200];
+        int listed = holiday_bitmap_list(bitmap, HOLIDAY_PLANE_ANY, jdn, NULL, columns, 200);
+        assert(listed == expected[HOLIDAY_PLANE_ANY]);
+        for (int i = 0; i < listed; i++) {
+            assert(holiday_bitmap_test(bitmap, HOLIDAY_PLANE_ANY, jdn, columns[i]));
+            if (i > 0) assert(columns[i] > columns[i - 1]);
+        }
+    }
+    assert(holiday_bitmap_row(bitmap, HOLIDAY_PLANE_ANY, bitmap->first_jdn - 1) == NULL);
+    assert(strcmp(bitmap->country_codes + 4 * holiday_bitmap_column(bitmap, "BC"), "BC") == 0);
+    holiday_bitmap_destroy(bitmap);
+    holiday_db_destroy(db);
+    
+    printf("    ✓ Holiday bitmap tests passed\n");
+}
+
+void test_business_calendar(void) {
+    printf("  Testing business-day arithmetic...\n");
+    
+    HolidayDatabase* db = holiday_db_create();
+    assert(db != NULL);
+    Holiday christmas = make_holiday("Christmas Day", CALENDAR_GREGORIAN, 12, 25, "US");
+    christmas.weekday = -1;
+    christmas.is_bank_holiday = 1;
+    Holiday independence = make_holiday("Independence Day", CALENDAR_GREGORIAN, 7, 4, "US");
+    independence.weekday = -1;
+    independence.is_bank_holiday = 1;
+    Holiday founding = make_holiday("Founding Day", CALENDAR_GREGORIAN, 2, 22, "SA");
+    founding.weekday = -1;
+    Holiday school_break = make_holiday("Winter Break", CALENDAR_GREGORIAN, 12, 20, "US");
+    school_break.weekday = -1;
+    school_break.duration_days = 20;
+    school_break.is_public_holiday = 0;
+    holiday_db_add_holiday(db, &christmas);
+    holiday_db_add_holiday(db, &independence);
+    holiday_db_add_holiday(db, &founding);
+    holiday_db_add_holiday(db, &school_break);
+    
+    assert(business_calendar_weekend_mask("SA") == BUSINESS_WEEKEND_FRI_SAT);
+    assert(business_calendar_weekend_mask("US") == BUSINESS_WEEKEND_SAT_SUN);
+    BusinessCalendar* us = business_calendar_create(db, "US", business_calendar_weekend_mask("US"),
+                                                    HOLIDAY_PLANE_BANK, 1995, 2034);
+    BusinessCalendar* sa = business_calendar_create(db, "SA", business_calendar_weekend_mask("SA"),
+                                                    HOLIDAY_PLANE_PUBLIC, 1995, 2034);
+    assert(us != NULL && sa != NULL);
+    
+    // Settlement around Christmas 2024 (a Wednesday); the school break is not a bank holiday
+    long result;
+    long friday = julian_day_from_date(20, 12, 2024);
+    assert(business_calendar_add(us, friday, 1, &result) == CALENDAR_SUCCESS);
+    assert(result == julian_day_from_date(23, 12, 2024));
+    business_calendar_add(us, julian_day_from_date(24, 12, 2024), 1, &result);
+    assert(result == julian_day_from_date(26, 12, 2024));
+    business_calendar_add(us, julian_day_from_date(26, 12, 2024), -1, &result);
+    assert(result == julian_day_from_date(24, 12, 2024));
+    business_calendar_next(us, julian_day_from_date(25, 12, 2024), &result);
+    assert(result == julian_day_from_date(26, 12, 2024));
+    business_calendar_previous(us, julian_day_from_date(22, 12, 2024), &result);
+    assert(result == friday);
+    long count;
+    business_calendar_count(us, julian_day_from_date(23, 12, 2024), julian_day_from_date(30, 12, 2024), &count);
+    assert(count == 4);
+    
+    // A Friday-Saturday weekend, and Founding Day 2024 (a Thursday)
+    long thursday = julian_day_from_date(15, 2, 2024);
+    business_calendar_add(sa, thursday, 1, &result);
+    assert(result == julian_day_from_date(18, 2, 2024));
+    business_calendar_add(sa, julian_day_from_date(21, 2, 2024), 1, &result);
+    assert(result == julian_day_from_date(25, 2, 2024));
+    
+    // Counting and stepping agree with walking day by day, over decades
+    srand(17);
+    for (int i = 0; i < 300; i++) {
+        long start = us->first_jdn + rand() % us->day_count;
+        long span = rand() % 8000;
+        long end = start + span < us->first_jdn + us->day_count ? start + span : us->first_jdn + us->day_count;
+        long walked = 0;
+        for (long jdn = start; jdn < end; jdn++) walked += business_calendar_is_business_day(us, jdn);
+        assert(business_calendar_count(us, start, end, &count) == CALENDAR_SUCCESS && count == walked);
+        business_calendar_count(us, end, start, &count);
+        assert(count == -walked);
+        
+        long n = rand() % 400 - 200;
+        long expected = start, left = n > 0 ? n : -n;
+        long limit = us->first_jdn + us->day_count;
+        int inside = 1;
+        while (n == 0 && inside && !business_calendar_is_business_day(us, expected)) {
+            inside = ++expected < limit;
+        }
+        while (left > 0 && inside) {
+            expected += n > 0 ? 1 : -1;
+            inside = expected >= us->first_jdn && expected < limit;
+            if (business_calendar_is_business_day(us, expected)) left--;
+        }
+        CalendarResult status = business_calendar_add(us, start, n, &result);
+        assert(inside ? status == CALENDAR_SUCCESS && result == expected : status == CALENDAR_ERROR_INVALID_DATE);
+    }
+    
+    // Steps past either end fail
+    assert(business_calendar_add(us, us->first_jdn, -1, &result) == CALENDAR_ERROR_INVALID_DATE);
+    assert(business_calendar_add(us, us->first_jdn - 1, 1, &result) == CALENDAR_ERROR_INVALID_DATE);
+    business_calendar_destroy(us);
+    business_calendar_destroy(sa);
+    holiday_db_destroy(db);
+    
+    printf("    ✓ Business calendar tests passed\n");
+}
+
+// Observed day of the occurrence of a holiday starting on a date
+static long observed_day(HolidayDatabase* db, const char* name, int day, int month, int year) {
+    long jdn = julian_day_from_date(day, month, year);
+    HolidayOccurrence matches[8];
+    int found = 0;
+    holiday_db_find_periods(db, jdn, jdn, NULL, matches, 8, &found);
+    for (int i = 0; i < found; i++) {
+        if (matches[i].jdn == jdn && strcmp(db->holidays[matches[i].holiday].name, name) == 0) {
+            return matches[i].observed_jdn;
+        }
+    }
+    return 0;
+}
+
+void test_holiday_observance(void) {
+    printf("  Testing observed-holiday substitution...\n");
+    
+    HolidayDatabase* db = holiday_db_create();
+    assert(db != NULL);
+    const char* us_names[] = { "New Year's Day", "Independence Day", "Christmas Day" };
+    int us_dates[][2] = { { 1, 1 }, { 4, 7 }, { 25, 12 } };
+    for (int i = 0; i < 3; i++) {
+        Holiday holiday = make_holiday(us_names[i], CALENDAR_GREGORIAN, us_dates[i][1], us_dates[i][0], "US");
+        holiday.weekday = -1;
+        holiday.is_bank_holiday = 1;
+        holiday_db_add_holiday(db, &holiday);
+    }
+    Holiday christmas = make_holiday("Christmas Day", CALENDAR_GREGORIAN, 12, 25, "GB");
+    christmas.weekday = -1;
+    Holiday boxing = make_holiday("Boxing Day", CALENDAR_GREGORIAN, 12, 26, "GB");
+    boxing.weekday = -1;
+    Holiday festival = make_holiday("Festival", CALENDAR_GREGORIAN, 7, 4, "GB");   // A Saturday-starting period in 2026
+    festival.weekday = -1;
+    festival.duration_days = 3;
+    Holiday observance = make_holiday("Observance", CALENDAR_GREGORIAN, 7, 5, "GB");
+    observance.weekday = -1;
+    observance.is_public_holiday = 0;
+    holiday_db_add_holiday(db, &christmas);
+    holiday_db_add_holiday(db, &boxing);
+    holiday_db_add_holiday(db, &festival);
+    holiday_db_add_holiday(db, &observance);
+    
+    // Without rules, every holiday is observed where it falls
+    assert(holiday_db_materialize_range(db, 2020, 2027) == CALENDAR_SUCCESS);
+    const HolidayYear* year_2026 = holiday_db_materialize_year(db, 2026);
+    assert(observed_day(db, "Independence Day", 4, 7, 2026) == julian_day_from_date(4, 7, 2026));
+    
+    // Rules set later move the days of the years already built, in place
+    HolidayObservanceRule us = { "US", BUSINESS_WEEKEND_SAT_SUN, HOLIDAY_OBSERVE_NEAREST, 0 };
+    HolidayObservanceRule gb = { "GB", BUSINESS_WEEKEND_SAT_SUN, HOLIDAY_OBSERVE_FOLLOWING, 1 };
+    assert(holiday_db_set_observance_rule(db, &us) == CALENDAR_SUCCESS);
+    assert(holiday_db_set_observance_rule(db, &gb) == CALENDAR_SUCCESS);
+    assert(holiday_db_materialize_year(db, 2026) == year_2026);
+    assert(observed_day(db, "Independence Day", 4, 7, 2026) == julian_day_from_date(3, 7, 2026));     // Saturday
+    assert(observed_day(db, "Christmas Day", 25, 12, 2022) == julian_day_from_date(26, 12, 2022));    // Sunday
+    assert(observed_day(db, "New Year's Day", 1, 1, 2022) == julian_day_from_date(31, 12, 2021));     // Saturday
+    assert(observed_day(db, "Christmas Day", 25, 12, 2024) == julian_day_from_date(25, 12, 2024));
+    
+    // UK substitutes cascade: Christmas and Boxing Day on a weekend
+    const HolidayYear* year_2021 = holiday_db_materialize_year(db, 2021);
+    int found = 0;
+    const HolidayOccurrence* run;
+    holiday_year_find(year_2021, julian_day_from_date(25, 12, 2021), julian_day_from_date(26, 12, 2021), "GB",
+                      &run, &found);
+    assert(found == 2);
+    assert(run[0].observed_jdn == julian_day_from_date(27, 12, 2021));
+    assert(run[1].observed_jdn == julian_day_from_date(28, 12, 2021));
+    const HolidayYear* year_2022 = holiday_db_materialize_year(db, 2022);
+    holiday_year_find(year_2022, julian_day_from_date(25, 12, 2022), julian_day_from_date(26, 12, 2022), "GB",
+                      &run, &found);
+    assert(found == 2);
+    assert(run[0].observed_jdn == julian_day_from_date(27, 12, 2022));  // Past Boxing Day on the Monday
+    assert(run[1].observed_jdn == julian_day_from_date(26, 12, 2022));
+    
+    // Periods and holidays that are not public stay put
+    holiday_year_find(year_2026, julian_day_from_date(4, 7, 2026), julian_day_from_date(5, 7, 2026), "GB",
+                      &run, &found);
+    assert(found == 2 && run[0].observed_jdn == run[0].jdn && run[1].observed_jdn == run[1].jdn);
+    
+    // Both orders of a year agree
+    for (int y = 2020; y <= 2027; y++) {
+        const HolidayYear* year = holiday_db_materialize_year(db, y);
+        for (uint32_t i = 0; i < year->count; i++) {
+            const HolidayOccurrence* occurrence = &year->occurrences[i];
+            int matched = 0;
+            for (uint32_t j = 0; j < year->count; j++) {
+                const HolidayOccurrence* other = &year->by_country[j];
+                if (other->jdn == occurrence->jdn && other->holiday == occurrence->holiday) {
+                    matched = other->observed_jdn == occurrence->observed_jdn;
+                }
+            }
+            assert(matched);
+        }
+    }
+    
+    // The observed plane and the business calendar take the moved days
+    HolidayBitmap* bitmap = holiday_bitmap_build(db, 2021, 2026);
+    assert(bitmap != NULL);
+    int us_column = holiday_bitmap_column(bitmap, "US");
+    assert(holiday_bitmap_test(bitmap, HOLIDAY_PLANE_OBSERVED, julian_day_from_date(31, 12, 2021), us_column));
+    assert(holiday_bitmap_test(bitmap, HOLIDAY_PLANE_OBSERVED, julian_day_from_date(3, 7, 2026), us_column));
+    assert(!holiday_bitmap_test(bitmap, HOLIDAY_PLANE_OBSERVED, julian_day_from_date(4, 7, 2026), us_column));
+    assert(holiday_bitmap_test(bitmap, HOLIDAY_PLANE_PUBLIC, julian_day_from_date(4, 7, 2026), us_column));
+    holiday_bitmap_destroy(bitmap);
+    
+    BusinessCalendar* calendar = business_calendar_create(db, "US", BUSINESS_WEEKEND_SAT_SUN, HOLIDAY_PLANE_BANK,
+                                                          2021, 2026);
+    assert(calendar != NULL);
+    assert(!business_calendar_is_business_day(calendar, julian_day_from_date(3, 7, 2026)));
+    assert(!business_calendar_is_business_day(calendar, julian_day_from_date(31, 12, 2021)));
+    long result;
+    business_calendar_add(calendar, julian_day_from_date(2, 7, 2026), 1, &result);
+    assert(result == julian_day_from_date(6, 7, 2026));
+    business_calendar_destroy(calendar);
+    holiday_db_destroy(db);
+    
+    printf("    ✓ Observance tests passed\n");
+}
+
+// Version v of the reload tests: v holidays, one of them on 1 January, and
+// US days observed on the nearest weekday
+static HolidayDatabase* handle_version_db(int version) {
+    HolidayDatabase* db = holiday_db_create();
+    assert(db != NULL);
+    HolidayObservanceRule us = { "US", BUSINESS_WEEKEND_SAT_SUN, HOLIDAY_OBSERVE_NEAREST, 0 };
+    holiday_db_set_observance_rule(db, &us);
+    for (int i = 0; i < version; i++) {
+        Holiday holiday = make_holiday("Version Day", CALENDAR_GREGORIAN, 1 + i % 12, 1 + i % 28, "US");
+        holiday.weekday = -1;
+        holiday_db_add_holiday(db, &holiday);
+    }
+    return db;
+}
+
+void test_holiday_handle(void) {
+    printf("  Testing hot-reloadable database handle...\n");
+    
+    HolidayDatabase* first = handle_version_db(1);
+    HolidayHandle* handle = holiday_handle_create(first, 2020, 2030);
+    assert(handle != NULL);
+    assert(holiday_handle_version(handle) == 1);
+    
+    // Versions are built up front, then read-only
+    Holiday extra = make_holiday("Extra", CALENDAR_GREGORIAN, 3, 3, "US");
+    extra.weekday = -1;
+    assert(holiday_db_add_holiday(first, &extra) == CALENDAR_ERROR_CONVERSION_FAILED);
+    assert(holiday_db_set_observance_rule(first, &first->observance_rules[0]) == CALENDAR_ERROR_CONVERSION_FAILED);
+    assert(holiday_db_materialize_range(first, 2019, 2031) == CALENDAR_SUCCESS);
+    assert(holiday_db_materialize_range(first, 2031, 2032) == CALENDAR_ERROR_INVALID_YEAR);
+    assert(holiday_db_materialize_year(first, 2018) == NULL);
+    
+    // Lookups that pad the range read the cached years instead of building
+    HolidayOccurrence periods[4];
+    int period_count = 0;
+    assert(holiday_db_find_periods(first, julian_day_from_date(1, 1, 2019), julian_day_from_date(31, 12, 2019), "US",
+                                   periods, 4, &period_count) == CALENDAR_SUCCESS);
+    assert(period_count == 1 && periods[0].jdn == julian_day_from_date(1, 1, 2019));
+    assert(holiday_db_find_periods(first, julian_day_from_date(1, 1, 2032), julian_day_from_date(2, 1, 2032), "US",
+                                   periods, 4, &period_count) == CALENDAR_ERROR_INVALID_YEAR);
+    const Holiday* occurrences[4];
+    int occurrence_count = 0;
+    assert(holiday_db_find_occurrences(first, julian_day_from_date(1, 1, 2031), "US", occurrences, 4,
+                                       &occurrence_count) == CALENDAR_SUCCESS && occurrence_count == 1);
+    assert(holiday_db_find_occurrences(first, julian_day_from_date(1, 1, 2032), "US", occurrences, 4,
+                                       &occurrence_count) == CALENDAR_ERROR_INVALID_YEAR);
+    HolidayBitmap* bitmap = holiday_bitmap_build(first, 2020, 2030);
+    assert(bitmap != NULL);
+    int us = holiday_bitmap_column(bitmap, "US");
+    assert(holiday_bitmap_test(bitmap, HOLIDAY_PLANE_OBSERVED, julian_day_from_date(31, 12, 2021), us));
+    holiday_bitmap_destroy(bitmap);
+    assert(holiday_bitmap_build(first, 2018, 2030) == NULL);
+    BusinessCalendar* business = business_calendar_create(first, "US", BUSINESS_WEEKEND_SAT_SUN,
+                                                          HOLIDAY_PLANE_PUBLIC, 2020, 2030);
+    assert(business != NULL);
+    assert(!business_calendar_is_business_day(business, julian_day_from_date(31, 12, 2021)));
+    assert(business_calendar_is_business_day(business, julian_day_from_date(30, 12, 2021)));
+    business_calendar_destroy(business);
+    business = business_calendar_create(first, "US", BUSINESS_WEEKEND_SAT_SUN, HOLIDAY_PLANE_PUBLIC, 2019, 2031);
+    assert(business != NULL);
+    assert(!business_calendar_is_business_day(business, julian_day_from_date(1, 1, 2031)));
+    business_calendar_destroy(business);
+    
+    // A reader inside a read keeps its version alive across a publish
+    int reader = holiday_handle_register_reader(handle);
+    assert(reader >= 0);
+    uint64_t version = 0;
+    HolidayDatabase* held = holiday_handle_read_begin(handle, reader, &version);
+    assert(held == first && version == 1);
+    assert(holiday_handle_publish(handle, handle_version_db(2)) == CALENDAR_SUCCESS);
+    assert(holiday_handle_version(handle) == 2);
+    assert(holiday_handle_reclaim(handle) == 1);
+    Date new_year = {1, 1, 2026};
+    const Holiday* matches[4];
+    int found = 0;
+    assert(holiday_db_find_holidays(held, &new_year, CALENDAR_GREGORIAN, "US", matches, 4, &found) ==
+           CALENDAR_SUCCESS);
+    assert(found == 1);
+    holiday_handle_read_end(handle, reader);
+    assert(holiday_handle_reclaim(handle) == 0);
+    HolidayDatabase* current = holiday_handle_read_begin(handle, reader, &version);
+    assert(version == 2 && current->count == 2 && current->frozen);
+    holiday_handle_read_end(handle, reader);
+    holiday_handle_unregister_reader(handle, reader);
+    
+    // Readers and a publisher at once: every read sees one whole version,
+    // and versions never go backwards
+    int failures = 0;
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(4) reduction(+:failures)
+    #endif
+    {
+        int thread = 0;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        #endif
+        if (thread == 0) {
+            for (int v = 3; v <= HANDLE_TEST_VERSIONS; v++) {
+                if (holiday_handle_publish(handle, handle_version_db(v)) != CALENDAR_SUCCESS) failures++;
+            }
+        }
+        int slot = holiday_handle_register_reader(handle);
+        if (slot < 0) failures++;
+        uint64_t seen = 0;
+        while (slot >= 0 && seen < HANDLE_TEST_VERSIONS) {
+            uint64_t number = 0;
+            HolidayDatabase* db = holiday_handle_read_begin(handle, slot, &number);
+            const Holiday* found_holidays[4];
+            int found_count = 0;
+            if ((uint64_t)db->count != number || number < seen) failures++;
+            if (holiday_db_find_holidays(db, &new_year, CALENDAR_GREGORIAN, "US", found_holidays, 4,
+                                         &found_count) != CALENDAR_SUCCESS || found_count != 1) {
+                failures++;
+            }
+            seen = number;
+            holiday_handle_read_end(handle, slot);
+        }
+        if (slot >= 0) holiday_handle_unregister_reader(handle, slot);
+    }
+    assert(failures == 0);
+    assert(holiday_handle_version(handle) == HANDLE_TEST_VERSIONS);
+    assert(holiday_handle_reclaim(handle) == 0);
+    
+    // Reloading from files carries the observance rules over
+    FILE* csv = fopen("test_holidays_reload.csv", "w");
+    assert(csv != NULL);
+    fprintf(csv, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic,Weekday,Offset\n");
+    fprintf(csv, "Independence Day,,0,0,7,4,US,1,-1,0\n");
+    fclose(csv);
+    const char* sources[] = { "test_holidays_reload.csv" };
+    assert(holiday_handle_reload(handle, sources, 1) == CALENDAR_SUCCESS);
+    reader = holiday_handle_register_reader(handle);
+    current = holiday_handle_read_begin(handle, reader, &version);
+    assert(version == HANDLE_TEST_VERSIONS + 1 && current->count == 1);
+    assert(observed_day(current, "Independence Day", 4, 7, 2026) == julian_day_from_date(3, 7, 2026));
+    holiday_handle_read_end(handle, reader);
+    
+    // A failed reload leaves the current version in place
+    const char* missing[] = { "no_such_holidays.csv" };
+    assert(holiday_handle_reload(handle, missing, 1) != CALENDAR_SUCCESS);
+    assert(holiday_handle_version(handle) == HANDLE_TEST_VERSIONS + 1);
+    
+    // So does a snapshot with a damaged header: it is not re-read as CSV
+    HolidayDatabase* source = handle_version_db(50);
+    assert(holiday_snapshot_write("test_holidays_reload.hds", source->holidays, (size_t)source->count) ==
+           CALENDAR_SUCCESS);
+    holiday_db_destroy(source);
+    FILE* snapshot_file = fopen("test_holidays_reload.hds", "r+b");
+    assert(snapshot_file != NULL);
+    uint32_t bad_version = HOLIDAY_SNAPSHOT_FORMAT_VERSION + 1;
+    fseek(snapshot_file, (long)offsetof(HolidaySnapshotFileHeader, version), SEEK_SET);
+    fwrite(&bad_version, sizeof(bad_version), 1, snapshot_file);
+    fclose(snapshot_file);
+    const char* damaged[] = { "test_holidays_reload.hds" };
+    assert(holiday_handle_reload(handle, damaged, 1) == CALENDAR_ERROR_CONVERSION_FAILED);
+    
+    // And a CSV file cut off in the middle of a row
+    csv = fopen("test_holidays_reload.csv", "w");
+    assert(csv != NULL);
+    fprintf(csv, "Name,Description,CalendarType,HolidayType,Month,Day,Country,IsPublic,Weekday,Offset\n");
+    fprintf(csv, "Independence Day,,0,0,7,4,US,1,-1,0\n");
+    fprintf(csv, "Labor Day,,0,4,9");
+    fclose(csv);
+    assert(holiday_handle_reload(handle, sources, 1) == CALENDAR_ERROR_CONVERSION_FAILED);
+    assert(holiday_handle_version(handle) == HANDLE_TEST_VERSIONS + 1);
+    current = holiday_handle_read_begin(handle, reader, &version);
+    assert(version == HANDLE_TEST_VERSIONS + 1 && current->count == 1);
+    holiday_handle_read_end(handle, reader);
+    remove("test_holidays_reload.hds");
+    remove("test_holidays_reload.csv");
+    holiday_handle_unregister_reader(handle, reader);
+    holiday_handle_destroy(handle);
+    
+    printf("    ✓ Database handle tests passed\n");
+}
+
+// Main function for standalone testing
+#ifdef TEST_HOLIDAYS_STANDALONE
+int main(void) {
+    run_holidays_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,241 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../src/religious/solar_day.h"
+#include "../src/religious/zmanim.h"
+#include "../src/religious/prayer_times.h"
+#include "../src/religious/panchang.h"
+#include "../src/astronomy/lunar_calc.h"
+#include "../src/astronomy/solar_calc.h"
+#include "../src/utils/date_utils.h"
+
+void test_solar_day_table(void);
+void test_zmanim(void);
+void test_prayer_times(void);
+void test_panchang(void);
+
+void run_religious_tests(void) {
+    printf("Running Religious Time Tests...\n");
+    
+    test_solar_day_table();
+    test_zmanim();
+    test_prayer_times();
+    test_panchang();
+    
+    printf("✅ All religious time tests passed!\n\n");
+}
+
+void test_solar_day_table(void) {
+    printf("  Testing the shared solar day table...\n");
+    
+    // Interpolated times match the full series to about a second, everywhere
+    // the sun rises, including across the right ascension wrap in March
+    SolarDayTable table;
+    double first_jd = julian_day_from_date(1, 3, 2024);
+    assert(solar_day_table_init(&table, first_jd, 60) == CALENDAR_SUCCESS);
+    for (int d = 0; d < 60; d += 3) {
+        for (double lat = -60.0; lat <= 60.0; lat += 30.0) {
+            for (double lon = -180.0; lon <= 180.0; lon += 45.0) {
+                SolarDay day;
+                assert(solar_day_compute(&table, first_jd + d, lat, lon, &day) == CALENDAR_SUCCESS);
+                assert(fabs(day.transit_jd - solar_calculate_solar_noon(first_jd + d, lon)) * 86400.0 < 2.0);
+                double rise = solar_day_altitude_time(&table, &day, SOLAR_DAY_SUNRISE_ALTITUDE, 0);
+                double set = solar_day_altitude_time(&table, &day, SOLAR_DAY_SUNRISE_ALTITUDE, 1);
+                assert(fabs(rise - solar_calculate_sunrise(first_jd + d, lat, lon)) * 86400.0 < 2.0);
+                assert(fabs(set - solar_calculate_sunset(first_jd + d, lat, lon)) * 86400.0 < 2.0);
+            }
+        }
+    }
+    
+    // Dates outside the table are refused rather than extrapolated
+    SolarDay day;
+    assert(solar_day_compute(&table, first_jd + 90, 0.0, 0.0, &day) == CALENDAR_ERROR_INVALID_DATE);
+    solar_day_table_free(&table);
+    assert(solar_day_table_init(&table, first_jd, 0) == CALENDAR_ERROR_INVALID_DATE);
+    
+    printf("    ✓ Solar day table tests passed\n");
+}
+
+void test_zmanim(void) {
+    printf("  Testing zmanim...\n");
+    
+    // Jerusalem, 2024 March 20 (equinox): sunrise 05:43, sunset 17:51 IST (UTC+2)
+    double jd = julian_day_from_date(20, 3, 2024);
+    Zmanim z;
+    assert(zmanim_calculate(jd, 31.778, 35.235, NULL, &z) == CALENDAR_SUCCESS);
+    double sunrise_local = fmod(z.sunrise + 0.5 + 2.0 / 24.0, 1.0) * 24.0;
+    double sunset_local = fmod(z.sunset + 0.5 + 2.0 / 24.0, 1.0) * 24.0;
+    assert(fabs(sunrise_local - (5.0 + 43.0 / 60.0)) < 2.0 / 60.0);
+    assert(fabs(sunset_local - (17.0 + 51.0 / 60.0)) < 2.0 / 60.0);
+    
+    // The day's order, and the proportional hours of the GRA
+    double order[] = { z.alot_hashachar, z.misheyakir, z.sunrise, z.sof_zman_shma_mga, z.sof_zman_shma_gra,
+                       z.sof_zman_tfila_gra, z.chatzot, z.mincha_gedola, z.mincha_ketana, z.plag_hamincha,
+                       z.candle_lighting, z.sunset, z.tzeit };
+    for (int i = 1; i < (int)(sizeof(order) / sizeof(order[0])); i++) assert(order[i] > order[i - 1]);
+    double hour = (z.sunset - z.sunrise) / 12.0;
+    assert(fabs(z.sof_zman_shma_gra - (z.sunrise + 3.0 * hour)) < 1e-9);
+    assert(fabs(z.plag_hamincha - (z.sunrise + 10.75 * hour)) < 1e-9);
+    assert(fabs(z.candle_lighting - (z.sunset - 18.0 / 1440.0)) < 1e-9);
+    assert(fabs(z.chatzot - (z.sunrise + z.sunset) / 2.0) < 1.0 / 1440.0);
+    
+    // At the equinox alot (16.1 degrees) falls about 72 minutes before sunrise
+    assert(fabs((z.sunrise - z.alot_hashachar) * 1440.0 - 72.0) < 4.0);
+    
+    // Custom angles move only their own times
+    ZmanimParameters params = zmanim_default_parameters();
+    params.tzeit_angle = 7.083;
+    Zmanim custom;
+    assert(zmanim_calculate(jd, 31.778, 35.235, &params, &custom) == CALENDAR_SUCCESS);
+    assert(custom.tzeit < z.tzeit && custom.sunset == z.sunset);
+    
+    // Yearly timetable across places agrees with the single-day path; in
+    // Tromso (69.6 N) the summer has no alot and no sunset
+    double lats[3] = { 31.778, 40.7128, 69.649 }, lons[3] = { 35.235, -74.006, 18.955 };
+    int days = 0;
+    Zmanim* table = zmanim_calculate_timetable(2024, lats, lons, 3, NULL, &days);
+    assert(table != NULL && days == 366);
+    for (int p = 0; p < 3; p++) {
+        for (int d = 0; d < days; d += 61) {
+            Zmanim single;
+            zmanim_calculate(julian_day_from_date(1, 1, 2024) + d, lats[p], lons[p], NULL, &single);
+            assert(fabs(single.sunrise - table[p * days + d].sunrise) < 1.0 / 86400.0);
+            assert(fabs(single.tzeit - table[p * days + d].tzeit) < 1.0 / 86400.0);
+        }
+    }
+    const Zmanim* midsummer = &table[2 * days + 172];   // June 21
+    assert(midsummer->sunset == 0.0 && midsummer->alot_hashachar == 0.0 && midsummer->candle_lighting == 0.0);
+    assert(midsummer->chatzot != 0.0);
+    free(table);
+    
+    printf("    ✓ Zmanim tests passed\n");
+}
+
+void test_prayer_times(void) {
+    printf("  Testing prayer times...\n");
+    
+    // Makkah, 2024 March 20, Umm al-Qura: Fajr about 05:08, Isha 90 minutes after Maghrib
+    double jd = julian_day_from_date(20, 3, 2024);
+    PrayerTimes* times = prayer_calculate_times(jd, 21.4225, 39.8262, PRAYER_METHOD_MAKKAH, 3);
+    assert(times != NULL);
+    char buffer[16];
+    prayer_julian_to_time_string(times->fajr_jd, 3, buffer, sizeof(buffer));
+    assert(strcmp(buffer, "05:08") == 0 || strcmp(buffer, "05:09") == 0);
+    assert(fabs((times->isha_jd - times->maghrib_jd) * 1440.0 - 90.0) < 1e-6);
+    assert(times->fajr_jd < times->sunrise_jd && times->sunrise_jd < times->dhuhr_jd);
+    assert(times->dhuhr_jd < times->asr_jd && times->asr_jd < times->maghrib_jd);
+    assert(times->maghrib_jd < times->midnight_jd && times->midnight_jd < times->tahajjud_jd);
+    
+    // Sunrise and Dhuhr come from the same table as the zmanim
+    Zmanim z;
+    zmanim_calculate(jd, 21.4225, 39.8262, NULL, &z);
+    assert(fabs(times->sunrise_jd - z.sunrise) < 1e-9 && fabs(times->dhuhr_jd - z.chatzot) < 1e-9);
+    prayer_julian_to_12hour_string(times->dhuhr_jd, 3, buffer, sizeof(buffer));
+    assert(strstr(buffer, "PM") != NULL);
+    prayer_destroy_times(times);
+    
+    // Hanafi Asr (shadow twice the length) is later than Shafi
+    assert(prayer_calculate_asr(jd, 40.0, 29.0, 1) > prayer_calculate_asr(jd, 40.0, 29.0, 0));
+    
+    // Above 48 degrees in June, 18-degree twilight never ends; the middle of
+    // the night bounds Fajr and Isha
+    jd = julian_day_from_date(21, 6, 2024);
+    assert(prayer_calculate_fajr(jd, 55.7, 12.6, 18.0) == 0.0);
+    times = prayer_calculate_times(jd, 55.7, 12.6, PRAYER_METHOD_MWL, 2);
+    assert(times != NULL && times->fajr_jd != 0.0 && times->isha_jd != 0.0);
+    assert(times->fajr_jd < times->sunrise_jd && times->isha_jd > times->maghrib_jd);
+    assert(fabs(times->isha_jd - (times->fajr_jd + 1.0)) < 2.0 / 1440.0);
+    prayer_destroy_times(times);
+    
+    // Qibla from New York: about 58.5 degrees, 10,300 km
+    QiblaDirection* qibla = prayer_calculate_qibla(40.7128, -74.0060);
+    assert(qibla != NULL);
+    assert(fabs(qibla->qibla_bearing - 58.48) < 0.1);
+    assert(fabs(qibla->distance_km - 10300.0) < 50.0);
+    prayer_destroy_qibla(qibla);
+    assert(prayer_calculate_qibla(95.0, 0.0) == NULL);
+    assert(prayer_calculate_times(jd, 0.0, 200.0, PRAYER_METHOD_MWL, 0) == NULL);
+    
+    printf("    ✓ Prayer time tests passed\n");
+}
+
+void test_panchang(void) {
+    printf("  Testing panchang...\n");
+    
+    // Lahiri places Spica (Chitra, tropical 203.84 at J2000) at sidereal 180
+    assert(fabs(203.84 - panchang_ayanamsha(2451545.0, PANCHANG_AYANAMSHA_LAHIRI) - 180.0) < 0.05);
+    assert(panchang_ayanamsha(2451545.0, PANCHANG_AYANAMSHA_RAMAN) < panchang_ayanamsha(2451545.0, PANCHANG_AYANAMSHA_LAHIRI));
+    assert(panchang_ayanamsha(2451545.0, PANCHANG_AYANAMSHA_TROPICAL) == 0.0);
+    
+    // Shukla pratipada begins at the new moon and krishna pratipada at the full moon
+    double start = julian_day_from_date(1, 1, 2024) - 0.5;
+    int count = 0;
+    PanchangTransition* transitions = panchang_find_transitions(start, start + 30.0, PANCHANG_AYANAMSHA_LAHIRI, &count);
+    assert(transitions != NULL && count > 100);
+    double new_moon = lunar_find_next_phase(start, 0.0);
+    double full_moon = lunar_find_next_phase(start, 180.0);
+    int found = 0;
+    for (int i = 0; i < count; i++) {
+        if (i > 0) assert(transitions[i].julian_day >= transitions[i - 1].julian_day);
+        if (transitions[i].limb != PANCHANG_TITHI) continue;
+        if (transitions[i].number == 1) found += fabs(transitions[i].julian_day - new_moon) < 5.0 / 86400.0;
+        if (transitions[i].number == 16) found += fabs(transitions[i].julian_day - full_moon) < 5.0 / 86400.0;
+    }
+    assert(found == 2);
+    
+    // Each transition opens the element it reports
+    for (int i = 0; i < count; i += 7) {
+        PanchangElements before, after;
+        panchang_calculate(transitions[i].julian_day - 2.0 / 86400.0, PANCHANG_AYANAMSHA_LAHIRI, &before);
+        panchang_calculate(transitions[i].julian_day + 2.0 / 86400.0, PANCHANG_AYANAMSHA_LAHIRI, &after);
+        int numbers_before[PANCHANG_LIMB_COUNT] = { before.tithi, before.nakshatra, before.yoga, before.karana };
+        int numbers_after[PANCHANG_LIMB_COUNT] = { after.tithi, after.nakshatra, after.yoga, after.karana };
+        assert(numbers_after[transitions[i].limb] == transitions[i].number);
+        assert(numbers_before[transitions[i].limb] != transitions[i].number);
+    }
+    free(transitions);
+    
+    // New Delhi, 2024 January 1 (Monday): Krishna Panchami to 14:29 IST, Magha
+    // to 08:36, Ayushman yoga, Taitila karana at sunrise
+    int days = 0;
+    PanchangDay* year = panchang_calculate_year(2024, 28.61, 77.21, PANCHANG_AYANAMSHA_LAHIRI, &days);
+    assert(year != NULL && days == 366);
+    assert(year[0].vara == 1 && strcmp(panchang_vara_name(year[0].vara), "Somavara") == 0);
+    assert(year[0].tithi == 20 && strcmp(panchang_tithi_name(year[0].tithi), "Panchami") == 0);
+    assert(strcmp(panchang_paksha_name(year[0].tithi), "Krishna") == 0);
+    assert(strcmp(panchang_nakshatra_name(year[0].nakshatra), "Magha") == 0);
+    assert(strcmp(panchang_yoga_name(year[0].yoga), "Ayushman") == 0);
+    assert(strcmp(panchang_karana_name(year[0].karana), "Taitila") == 0);
+    double ist = 5.5 / 24.0;
+    assert(fabs(fmod(year[0].ends[PANCHANG_TITHI] + 0.5 + ist, 1.0) * 1440.0 - (14 * 60 + 29)) < 2.0);
+    assert(fabs(fmod(year[0].ends[PANCHANG_NAKSHATRA] + 0.5 + ist, 1.0) * 1440.0 - (8 * 60 + 36)) < 2.0);
+    
+    // Every day agrees with a direct evaluation at its sunrise
+    for (int d = 0; d < days; d += 5) {
+        PanchangElements at_sunrise;
+        panchang_calculate(year[d].sunrise, PANCHANG_AYANAMSHA_LAHIRI, &at_sunrise);
+        assert(at_sunrise.tithi == year[d].tithi && at_sunrise.nakshatra == year[d].nakshatra);
+        assert(at_sunrise.yoga == year[d].yoga && at_sunrise.karana == year[d].karana);
+        for (int limb = 0; limb < PANCHANG_LIMB_COUNT; limb++) assert(year[d].ends[limb] > year[d].sunrise);
+    }
+    free(year);
+    
+    // Karana names: fixed halves at the ends of the month
+    assert(strcmp(panchang_karana_name(1), "Kimstughna") == 0);
+    assert(strcmp(panchang_karana_name(2), "Bava") == 0);
+    assert(strcmp(panchang_karana_name(57), "Vishti") == 0);
+    assert(strcmp(panchang_karana_name(60), "Naga") == 0);
+    assert(strcmp(panchang_tithi_name(30), "Amavasya") == 0);
+    
+    printf("    ✓ Panchang tests passed\n");
+}
+
+// Main function for standalone testing
+#ifdef TEST_RELIGIOUS_STANDALONE
+int main(void) {
+    run_religious_tests();
+    return 0;
+}
+#endif